@@ -0,0 +1,163 @@
+/**
+ * @file bench_eventBus.cpp
+ * @brief Per-event cost of the dynamic EventBus versus StaticEventBus
+ * 
+ * Publishes the same SensorEvents through both buses, one at a time and in
+ * batches, and reports wall time per event from the first publish until
+ * stop() has drained the queue. The handler sums the readings so the
+ * dispatch cannot be optimised away.
+ * 
+ * Usage: bench_eventBus [event_count]
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "Event/SensorEvent.h"
+#include "EventBus/EventBus.h"
+#include "EventBus/StaticEventBus.h"
+#include "Util/Clock.h"
+
+namespace
+{
+
+constexpr std::size_t kDefaultEventCount = 1000000;  ///< Events per run
+constexpr std::size_t kBatchSize = 1024;              ///< Events per publishBatch call
+
+/**
+ * @brief Builds the record published as event i
+ */
+Event::SensorRecord makeRecord(std::size_t i)
+{
+    Event::SensorRecord record{};
+    record.sequence = i;
+    record.value = static_cast<double>(i % 100);
+    record.type = Event::SensorType::CoSensor;
+    return record;
+}
+
+/**
+ * @brief Prints one result line
+ */
+void report(const char* name, std::size_t events, int64_t elapsed_ns, double checksum)
+{
+    std::cerr << name << ": " << static_cast<double>(elapsed_ns) / static_cast<double>(events)
+              << " ns/event (checksum " << checksum << ")\n";
+}
+
+/**
+ * @brief Dynamic EventBus, one publish() per event
+ */
+double runDynamic(std::size_t events, bool batched)
+{
+    double sum = 0.0;
+    EventBus bus;
+    bus.subscribe([&sum](const Event::Event& event) {
+        if (const auto* sensor_event = Event::event_cast<Event::SensorEvent>(event)) {
+            sum += sensor_event->getValue();
+        }
+    });
+    bus.start();
+
+    const int64_t start = Util::Clock::nowNs();
+    if (batched) {
+        for (std::size_t i = 0; i < events; i += kBatchSize) {
+            std::vector<std::unique_ptr<Event::Event>> batch;
+            batch.reserve(kBatchSize);
+            for (std::size_t j = i; j < events && j < i + kBatchSize; ++j) {
+                batch.emplace_back(std::make_unique<Event::SensorEvent>(makeRecord(j)));
+            }
+            bus.publishBatch(std::move(batch));
+        }
+    } else {
+        for (std::size_t i = 0; i < events; ++i) {
+            bus.publish(std::make_unique<Event::SensorEvent>(makeRecord(i)));
+        }
+    }
+    bus.stop();
+    report(batched ? "EventBus publishBatch      " : "EventBus publish           ",
+           events, Util::Clock::nowNs() - start, sum);
+    return sum;
+}
+
+/**
+ * @brief Dynamic EventBus delivering batches to a subscribeBatch handler
+ */
+double runDynamicBatchHandler(std::size_t events)
+{
+    double sum = 0.0;
+    EventBus bus(EventBus::BatchOptions{kBatchSize, std::chrono::microseconds(0)});
+    bus.subscribeBatch([&sum](const EventBatch& batch) {
+        for (const Event::Event& event : batch) {
+            sum += Event::event_cast<Event::SensorEvent>(event)->getValue();
+        }
+    });
+    bus.start();
+
+    const int64_t start = Util::Clock::nowNs();
+    for (std::size_t i = 0; i < events; i += kBatchSize) {
+        std::vector<std::unique_ptr<Event::Event>> batch;
+        batch.reserve(kBatchSize);
+        for (std::size_t j = i; j < events && j < i + kBatchSize; ++j) {
+            batch.emplace_back(std::make_unique<Event::SensorEvent>(makeRecord(j)));
+        }
+        bus.publishBatch(std::move(batch));
+    }
+    bus.stop();
+    report("EventBus subscribeBatch    ", events, Util::Clock::nowNs() - start, sum);
+    return sum;
+}
+
+/**
+ * @brief StaticEventBus with an inlinable lambda handler
+ */
+double runStatic(std::size_t events, bool batched)
+{
+    double sum = 0.0;
+    StaticEventBus bus(EventList<Event::SensorEvent>{},
+                       [&sum](const Event::SensorEvent& event) { sum += event.getValue(); });
+    bus.start();
+
+    const int64_t start = Util::Clock::nowNs();
+    if (batched) {
+        for (std::size_t i = 0; i < events; i += kBatchSize) {
+            std::vector<Event::SensorEvent> batch;
+            batch.reserve(kBatchSize);
+            for (std::size_t j = i; j < events && j < i + kBatchSize; ++j) {
+                batch.emplace_back(makeRecord(j));
+            }
+            bus.publishBatch(std::move(batch));
+        }
+    } else {
+        for (std::size_t i = 0; i < events; ++i) {
+            bus.publish(Event::SensorEvent(makeRecord(i)));
+        }
+    }
+    bus.stop();
+    report(batched ? "StaticEventBus publishBatch" : "StaticEventBus publish     ",
+           events, Util::Clock::nowNs() - start, sum);
+    return sum;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::size_t events = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : kDefaultEventCount;
+
+    // EventBus logs every publish to stdout; keep that out of the measurement
+    std::streambuf* original = std::cout.rdbuf(nullptr);
+
+    std::cerr << "Events per run: " << events << "\n";
+    runDynamic(events, false);
+    runStatic(events, false);
+    runDynamic(events, true);
+    runDynamicBatchHandler(events);
+    runStatic(events, true);
+
+    std::cout.rdbuf(original);
+    return 0;
+}
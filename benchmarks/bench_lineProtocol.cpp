@@ -0,0 +1,97 @@
+/**
+ * @file bench_lineProtocol.cpp
+ * @brief Parsing throughput of Transport::LineParser at each SIMD level
+ *
+ * Parses an in-memory buffer of line-protocol readings, in read-sized
+ * slices as LineIngestor does, into SensorEvents that are freed after each
+ * slice. Reports time per line and lines per second on one core; the
+ * checksum keeps the events from being optimised away.
+ *
+ * Usage: bench_lineProtocol [line_count]
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Event/SensorEvent.h"
+#include "Transport/LineParser.h"
+#include "Util/Clock.h"
+
+namespace
+{
+
+constexpr std::size_t kDefaultLineCount = 5000000;   ///< Lines per run
+constexpr std::size_t kSliceSize = 64u << 10;         ///< Bytes parsed per call, as LineIngestor reads
+constexpr std::size_t kDeviceCount = 1000;            ///< Devices per type
+
+/**
+ * @brief Builds the input: readings of all types with timestamps
+ */
+std::string makeInput(std::size_t lines)
+{
+    static const char* const kTypes[] = {"CoSensor", "TempSensor", "PressureSensor"};
+    std::string text;
+    text.reserve(lines * 56);
+    int64_t timestamp_ns = 1767225600000000000;
+    for (std::size_t i = 0; i < lines; ++i) {
+        text += kTypes[i % 3];
+        text += ",device=";
+        text += std::to_string(i % kDeviceCount);
+        text += ' ';
+        text += std::to_string(1000 + i % 997);
+        text += '.';
+        text += std::to_string(i % 100);
+        text += ' ';
+        text += std::to_string(timestamp_ns += 1000);
+        text += '\n';
+    }
+    return text;
+}
+
+/**
+ * @brief Parses the whole input at one SIMD level
+ */
+double run(const char* name, Util::SimdLevel level, const std::string& input, std::size_t lines)
+{
+    Transport::LineParser parser(level);
+    Transport::LineParser::Batch batch;
+    double sum = 0.0;
+
+    const int64_t start = Util::Clock::nowNs();
+    std::size_t offset = 0;
+    while (offset < input.size()) {
+        const std::size_t size = std::min(kSliceSize, input.size() - offset);
+        offset += parser.parse(input.data() + offset, size, batch);
+        if (!batch.empty()) {
+            sum += Event::event_cast<Event::SensorEvent>(*batch.back())->getValue();
+            batch.clear();
+        }
+    }
+    const int64_t elapsed_ns = Util::Clock::nowNs() - start;
+
+    std::cerr << name << ": " << static_cast<double>(elapsed_ns) / static_cast<double>(lines) << " ns/line, "
+              << static_cast<double>(lines) * 1e3 / static_cast<double>(elapsed_ns) << " M lines/s ("
+              << parser.getStats().events << " events, checksum " << sum << ")\n";
+    return sum;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : kDefaultLineCount;
+    const std::string input = makeInput(lines);
+    std::cerr << "Parsing " << lines << " lines (" << input.size() / lines << " bytes/line)\n";
+
+    run("Scalar", Util::SimdLevel::Scalar, input, lines);
+    if (Transport::LineParser::detectSimdLevel() >= Util::SimdLevel::SSE2) {
+        run("SSE2  ", Util::SimdLevel::SSE2, input, lines);
+    }
+    if (Transport::LineParser::detectSimdLevel() >= Util::SimdLevel::AVX2) {
+        run("AVX2  ", Util::SimdLevel::AVX2, input, lines);
+    }
+    return 0;
+}
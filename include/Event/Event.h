@@ -1,28 +1,95 @@
 #ifndef EVENT_EVENT_H
 #define EVENT_EVENT_H
 
+#include <cstdint>
+#include <type_traits>
+
 namespace Event
 {
 
+/**
+ * @enum EventType
+ * @brief Compile-time type id of each concrete event class
+ * 
+ * Every concrete event declares `static constexpr EventType kType` and
+ * passes it to the Event constructor. Adding an event class means adding
+ * one value here.
+ */
+enum class EventType : uint16_t {
+    Unknown = 0,  ///< Events that do not declare a type id
+    Sensor        ///< Event::SensorEvent
+};
+
 /**
  * @struct Event
  * @brief Base class for all events in the event-driven system
  * 
  * This is the abstract base class that all event types must inherit from.
  * It provides a virtual destructor to ensure proper cleanup of derived classes
- * when events are handled through base class pointers.
+ * when events are handled through base class pointers, and stores the
+ * EventType of the concrete class so handlers can identify events with an
+ * integer compare (see event_cast()) instead of dynamic_cast. The event-bus
+ * binary can therefore be built without RTTI.
  * 
  * Events are typically created on the heap and passed as unique_ptr to the EventBus
  * for dispatching to registered handlers.
  */
 struct Event
 {
+    /**
+     * @brief Constructs an event of the given type
+     * @param type Type id of the concrete class
+     */
+    explicit Event(EventType type = EventType::Unknown) noexcept
+        : type_(type) {}
+
     /**
      * @brief Virtual destructor for proper polymorphic deletion
      */
     virtual ~Event() = default;
+
+    /**
+     * @brief Gets the type id of the concrete event
+     */
+    EventType getType() const noexcept {
+        return type_;
+    }
+
+private:
+    EventType type_;  ///< Type id of the concrete class
 };
 
+/**
+ * @brief Downcasts an event by comparing type ids
+ * @tparam T Concrete event class declaring `static constexpr EventType kType`
+ * @param event Event to inspect
+ * @return Pointer to event as T, or nullptr if it is of another type
+ * 
+ * Matches the exact concrete type only; intended for leaf event classes.
+ * Costs one integer compare, with no RTTI involved.
+ */
+template<typename T>
+const T* event_cast(const Event& event) noexcept
+{
+    static_assert(std::is_base_of<Event, T>::value, "event_cast target must derive from Event::Event");
+    static_assert(T::kType != EventType::Unknown, "event_cast target must declare a type id");
+    return (event.getType() == T::kType) ? static_cast<const T*>(&event) : nullptr;
+}
+
+/**
+ * @brief Downcasts a mutable event by comparing type ids
+ * @tparam T Concrete event class declaring `static constexpr EventType kType`
+ * @param event Event to inspect
+ * @return Pointer to event as T, or nullptr if it is of another type
+ */
+template<typename T>
+T* event_cast(Event& event) noexcept
+{
+    static_assert(std::is_base_of<Event, T>::value, "event_cast target must derive from Event::Event");
+    static_assert(T::kType != EventType::Unknown, "event_cast target must declare a type id");
+    return (event.getType() == T::kType) ? static_cast<T*>(&event) : nullptr;
+}
+
 } // namespace Event
 
-#endif // EVENT_EVENT_H
\ No newline at end of file
+#endif // EVENT_EVENT_H
@@ -2,35 +2,21 @@
 #define EVENT_SENSOR_EVENT_H
 
 #include <string>
+#include <string_view>
 #include <ctime>
+#include <cstddef>
 #include <cstdint>
-#include <random>
 
 #include "Event.h"
-#include "Util/RandomNumberGenerator.h"
+#include "SensorType.h"
+#include "SensorRecord.h"
+#include "SensorTraits.h"
+#include "Util/BlockPool.h"
+#include "Util/Clock.h"
 
 namespace Event
 {
 
-/**
- * @enum Status
- * @brief Status codes for sensor operations
- */
-enum class Status {
-    OK,    ///< Operation completed successfully
-    ERROR  ///< Operation failed
-};
-
-/**
- * @enum SensorType
- * @brief Types of sensors supported by the system
- */
-enum class SensorType {
-    CoSensor,        ///< Carbon monoxide gas sensor (50-150 ppm range)
-    TempSensor,      ///< Temperature sensor (15-30°C range)
-    PressureSensor   ///< Atmospheric pressure sensor (1013-1033 hPa range)
-};
-
 /**
  * @struct SensorEvent
  * @brief Concrete event representing a sensor reading
@@ -42,44 +28,117 @@ enum class SensorType {
  * - The measured value
  * - Sensor type identification
  * 
- * The class simulates realistic sensor behavior including:
- * - Random variations within expected ranges
- * - Fault simulation (0.0 value with 1% probability)
- * - Type-specific value ranges and characteristics
+ * The event carries observation data only, stored as a compact SensorRecord;
+ * device IDs and type names are rendered to strings when requested. Readings
+ * are produced by SensorSimulator::SensorGenerator, which owns the value
+ * ranges, fault model and random stream.
  */
 struct SensorEvent : public Event
 {
 public:
+    static constexpr EventType kType = EventType::Sensor;  ///< Type id for event_cast()
+
     /**
-     * @brief Constructs a sensor event of the specified type
+     * @brief Constructs an event holding a freshly simulated reading
      * @param type The type of sensor (CoSensor, TempSensor, or PressureSensor)
      * 
-     * Initializes the sensor with appropriate default values, generates a device ID,
-     * captures the current timestamp, and generates an initial reading.
+     * Convenience for tests and one-off publishers: draws one reading from a
+     * new SensorSimulator::SensorGenerator of the given type. Simulators keep
+     * their own generator and use SensorEvent(const SensorRecord&) instead.
      */
-    explicit SensorEvent(SensorType type) {
-        init(type);
-    }
+    explicit SensorEvent(SensorType type);
+
+    /**
+     * @brief Constructs a sensor event from an already generated reading
+     * @param record The reading to publish
+     */
+    explicit SensorEvent(const SensorRecord& record)
+        : Event(kType),
+        record_(record) {}
     
     /**
      * @brief Default destructor
      */
     ~SensorEvent() = default;
 
+    /**
+     * @brief Allocates a SensorEvent from a per-thread block pool
+     * @param size Size of the object; other sizes go to the global operator new
+     * @return Storage for the event
+     *
+     * Events are created by producers and destroyed by the dispatcher, one
+     * per reading, so they bypass malloc: see Util::BlockPool.
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * @brief Returns a SensorEvent's storage to the block pool
+     * @param pointer Storage from operator new
+     * @param size Size of the object
+     */
+    static void operator delete(void* pointer, std::size_t size) noexcept;
+
     /**
      * @brief Gets the unique device identifier
      * @return Device ID string in format "<SensorType>_<number>"
+     * 
+     * Rendered from the integer device ID on every call; prefer
+     * getDeviceNumber() on hot paths.
      */
     std::string getDeviceId() const {
-        return device_id_;
+        return std::string(deviceName(record_.device_id));
+    }
+
+    /**
+     * @brief Gets the device ID without allocating
+     * @return View of the interned device ID, valid for the life of the process
+     */
+    std::string_view getDeviceName() const {
+        return deviceName(record_.device_id);
+    }
+
+    /**
+     * @brief Gets the unit of the reading
+     * @return Static unit string from the type's SensorTraits row (e.g. "ppm")
+     */
+    const char* getUnit() const {
+        const SensorTraits* traits = findSensorTraits(record_.type);
+        return traits ? traits->unit : "";
+    }
+
+    /**
+     * @brief Gets the dense device id
+     * @return Interned id, unique per device across all types; suitable as
+     *         an index into flat per-device arrays
+     */
+    uint32_t getDeviceNumber() const {
+        return record_.device_id;
     }
 
     /**
-     * @brief Gets the timestamp of the sensor reading
+     * @brief Gets the wall-clock time of the sensor reading
      * @return Unix timestamp as time_t
      */
     std::time_t getTimestamp() const {
-        return timestamp_;
+        return static_cast<std::time_t>(getWallTimestampNs() / Util::Clock::kNanosPerSecond);
+    }
+
+    /**
+     * @brief Gets the monotonic timestamp of the sensor reading
+     * @return Nanoseconds in the Util::Clock monotonic domain
+     * 
+     * Use this to order events or measure latency against Util::Clock::nowNs().
+     */
+    int64_t getTimestampNs() const {
+        return record_.timestamp_ns;
+    }
+
+    /**
+     * @brief Gets the wall-clock time of the sensor reading with full resolution
+     * @return Nanoseconds since the Unix epoch
+     */
+    int64_t getWallTimestampNs() const {
+        return Util::Clock::toWallNs(record_.timestamp_ns);
     }
 
     /**
@@ -91,6 +150,19 @@ public:
      */
     std::string getTimestampString(const char* fmt = "%Y-%m-%d %H:%M:%S") const;
 
+    /**
+     * @brief Writes the timestamp as ISO-8601 local time into a buffer
+     * @param buffer Destination, NUL-terminated on success
+     * @param size Size of buffer; Util::TimestampFormatter::kBufferSize always fits
+     * @return Number of characters written, or 0 if the buffer is too small
+     * 
+     * Output looks like "2026-01-03T14:30:45.123+01:00". Uses a per-thread
+     * Util::TimestampFormatter, so repeated calls within the same minute
+     * avoid localtime_r/strftime entirely. Prefer this over
+     * getTimestampString() on hot paths.
+     */
+    std::size_t formatTimestamp(char* buffer, std::size_t size) const;
+
     /**
      * @brief Gets the sensor reading value
      * @return Sensor value in type-specific units:
@@ -100,7 +172,7 @@ public:
      *         Returns 0.0 for fault condition (1% probability)
      */
     double getValue() const {
-        return value_;
+        return record_.value;
     }
 
     /**
@@ -108,16 +180,16 @@ public:
      * @return SensorType enum value
      */
     SensorType getSensorType() const {
-        return sensor_type_;
+        return record_.type;
     }
 
     /**
-     * @brief Recalculates sensor value with new reading
-     * 
-     * Updates the timestamp and generates a new sensor value within the
-     * appropriate range for this sensor type. Includes 1% chance of fault.
+     * @brief Gets the compact record holding this reading
+     * @return Trivially copyable view of the observation data
      */
-    void recalc();
+    const SensorRecord& getRecord() const {
+        return record_;
+    }
 
     /**
      * @brief Compares sensor events by type
@@ -125,44 +197,29 @@ public:
      * @return true if sensor types differ, false if same type
      */
     bool operator!=(const SensorEvent& other) const {
-        return !(sensor_type_ == other.getSensorType());
+        return !(record_.type == other.getSensorType());
     }
 
 private:
-    static constexpr int kSensorIdWidth = 10;   ///< Range for device ID numbering
-    static constexpr float kFaultValue = 0.0f;  ///< Value indicating sensor fault
+    SensorRecord record_;  ///< Observation data of this reading
+};
 
-    /**
-     * @brief Initializes sensor with type-specific parameters
-     * @param type Sensor type to initialize
-     */
-    void init(SensorType type);
-    
-    /**
-     * @brief Sets type-specific configuration
-     * @param type Sensor type
-     * @return Status::OK on success, Status::ERROR for unknown type
-     */
-    Status initType(SensorType type);
-    
-    /**
-     * @brief Captures current system time
-     */
-    void getTimeStamp() {
-        time_t timestamp;
-        time(&timestamp);
-        timestamp_ = timestamp;
-    }
+/// Pool backing SensorEvent's operator new
+using SensorEventPool = Util::BlockPool<sizeof(SensorEvent), alignof(SensorEvent)>;
 
-    SensorType sensor_type_;              ///< Type of this sensor
-    std::string device_id_{};             ///< Unique device identifier
-    std::time_t timestamp_;               ///< Timestamp of measurement
-    std::string sensor_type_string_;      ///< String representation of sensor type
-    double value_;                        ///< Current sensor reading
-    double default_value_;                ///< Base value for this sensor type
-    uint32_t uniform_dist_;               ///< Range of variation around base value
-    Util::RandomNumberGenerator rand_gen_{std::random_device{}()};  ///< RNG for value generation
-};
+inline void* SensorEvent::operator new(std::size_t size)
+{
+    return size == sizeof(SensorEvent) ? SensorEventPool::allocate() : ::operator new(size);
+}
+
+inline void SensorEvent::operator delete(void* pointer, std::size_t size) noexcept
+{
+    if (size == sizeof(SensorEvent)) {
+        SensorEventPool::deallocate(pointer);
+    } else {
+        ::operator delete(pointer);
+    }
+}
 
 } // namespace Event
 
@@ -0,0 +1,49 @@
+#ifndef EVENT_SENSOR_RECORD_H
+#define EVENT_SENSOR_RECORD_H
+
+#include <cstdint>
+#include <type_traits>
+
+#include "SensorType.h"
+
+namespace Event
+{
+
+/**
+ * @struct SensorRecord
+ * @brief Compact, trivially copyable representation of one sensor reading
+ * 
+ * Holds only observation data in 32 bytes (two records per cache line).
+ * Strings are not stored: the type name comes from the SensorType side
+ * table and device_id is a dense id from the global intern table, turned
+ * back into "<SensorType>_<number>" only when rendering (deviceName()).
+ * Records can be copied with memcpy, stored in flat arrays and written to
+ * disk as-is.
+ */
+struct SensorRecord
+{
+    static constexpr uint8_t kFaultFlag = 0x01; ///< Set in flags for a fault reading
+
+    int64_t timestamp_ns;  ///< Time of the measurement, Util::Clock monotonic nanoseconds
+    double value;          ///< Measured value (0.0 for a fault)
+    uint64_t sequence;     ///< Per-device reading counter
+    uint32_t device_id;    ///< Dense interned device id (see internDeviceId())
+    SensorType type;       ///< Type of the producing sensor
+    uint8_t flags;         ///< Bit set of k*Flag values
+    uint16_t reserved;     ///< Padding, always zero
+
+    /**
+     * @brief Checks whether the reading is a simulated sensor fault
+     */
+    bool isFault() const {
+        return (flags & kFaultFlag) != 0;
+    }
+};
+
+static_assert(std::is_trivially_copyable<SensorRecord>::value, "SensorRecord must stay trivially copyable");
+static_assert(std::is_standard_layout<SensorRecord>::value, "SensorRecord must stay standard layout");
+static_assert(sizeof(SensorRecord) == 32, "SensorRecord is expected to be 32 bytes");
+
+} // namespace Event
+
+#endif // EVENT_SENSOR_RECORD_H
@@ -0,0 +1,90 @@
+#ifndef EVENT_SENSOR_TRAITS_H
+#define EVENT_SENSOR_TRAITS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SensorType.h"
+
+namespace Event
+{
+
+/**
+ * @struct SensorTraits
+ * @brief Compile-time description of a sensor type
+ * 
+ * Readings of a type are uniform in [base_value, base_value + range), except
+ * that one reading in fault_one_in (on average) is a fault.
+ */
+struct SensorTraits {
+    SensorType type;        ///< Type described by this row
+    const char* name;       ///< Type name, e.g. "CoSensor"
+    const char* unit;       ///< Unit of the readings, e.g. "ppm"
+    double base_value;      ///< Lowest non-fault reading
+    uint32_t range;         ///< Width of the uniform variation above base_value
+    uint32_t fault_one_in;  ///< Fault probability denominator
+};
+
+/**
+ * @brief Trait table, one row per SensorType in enum order
+ * 
+ * Adding a sensor type means adding its enum value and one row here.
+ */
+inline constexpr SensorTraits kSensorTraits[] = {
+    {SensorType::CoSensor,       "CoSensor",       "ppm", 50.0,    100, 100},
+    {SensorType::TempSensor,     "TempSensor",     "°C",  15.0,    15,  100},
+    {SensorType::PressureSensor, "PressureSensor", "hPa", 1013.25, 20,  100},
+};
+
+/// Number of known sensor types
+inline constexpr std::size_t kSensorTypeCount = sizeof(kSensorTraits) / sizeof(kSensorTraits[0]);
+
+/**
+ * @brief Checks that row i of kSensorTraits describes SensorType i
+ */
+constexpr bool sensorTraitsInEnumOrder()
+{
+    for (std::size_t i = 0; i < kSensorTypeCount; ++i) {
+        if (static_cast<std::size_t>(kSensorTraits[i].type) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(sensorTraitsInEnumOrder(), "kSensorTraits rows must follow SensorType enum order");
+
+/**
+ * @brief Looks up the traits of a sensor type
+ * @param type Sensor type, possibly invalid
+ * @return Row of kSensorTraits, or nullptr for an unknown type
+ */
+constexpr const SensorTraits* findSensorTraits(SensorType type)
+{
+    const std::size_t index = static_cast<std::size_t>(type);
+    return (index < kSensorTypeCount) ? &kSensorTraits[index] : nullptr;
+}
+
+/**
+ * @brief Gets the traits of a sensor type known at compile time
+ * @tparam T Sensor type; an unknown type fails to compile
+ * @return Row of kSensorTraits
+ */
+template<SensorType T>
+constexpr const SensorTraits& sensorTraits()
+{
+    static_assert(static_cast<std::size_t>(T) < kSensorTypeCount, "No SensorTraits row for this SensorType");
+    return kSensorTraits[static_cast<std::size_t>(T)];
+}
+
+/**
+ * @brief Copies the traits of a sensor type known only at run time
+ * @param type Sensor type to describe
+ * @param traits Receives the row on success
+ * @return Status::OK on success, Status::ERROR for unknown type
+ */
+Status getSensorTraits(SensorType type, SensorTraits& traits);
+
+} // namespace Event
+
+#endif // EVENT_SENSOR_TRAITS_H
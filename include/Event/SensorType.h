@@ -0,0 +1,69 @@
+#ifndef EVENT_SENSOR_TYPE_H
+#define EVENT_SENSOR_TYPE_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace Event
+{
+
+/**
+ * @enum Status
+ * @brief Status codes for sensor operations
+ */
+enum class Status {
+    OK,    ///< Operation completed successfully
+    ERROR  ///< Operation failed
+};
+
+/**
+ * @enum SensorType
+ * @brief Types of sensors supported by the system
+ * 
+ * Stored in one byte so it fits the compact SensorRecord layout. Per-type
+ * parameters live in the kSensorTraits table (SensorTraits.h).
+ */
+enum class SensorType : uint8_t {
+    CoSensor,        ///< Carbon monoxide gas sensor (50-150 ppm range)
+    TempSensor,      ///< Temperature sensor (15-30°C range)
+    PressureSensor   ///< Atmospheric pressure sensor (1013-1033 hPa range)
+};
+
+/**
+ * @brief Gets the display name of a sensor type
+ * @param type Sensor type
+ * @return Static type name (e.g. "CoSensor"), or "Unknown"
+ */
+const char* getSensorTypeName(SensorType type);
+
+/**
+ * @brief Renders a device ID for display
+ * @param type Type of the device
+ * @param device_id Integer device identifier
+ * @return Device ID string in format "<SensorType>_<number>"
+ */
+std::string formatDeviceId(SensorType type, uint32_t device_id);
+
+/**
+ * @brief Interns the device ID of a device in Util::InternTable::global()
+ * @param type Type of the device
+ * @param device_number Device number within its type
+ * @return Dense id of "<SensorType>_<number>", shared by every record of that device
+ * 
+ * Costs one lock-free lookup (plus the string formatting) once the device
+ * is known; call it when a device is created, not per reading.
+ */
+uint32_t internDeviceId(SensorType type, uint32_t device_number);
+
+/**
+ * @brief Gets the device ID string of an interned id
+ * @param device_id Id returned by internDeviceId()
+ * @return Device ID (e.g. "CoSensor_3"), valid for the life of the process;
+ *         empty for unknown ids
+ */
+std::string_view deviceName(uint32_t device_id);
+
+} // namespace Event
+
+#endif // EVENT_SENSOR_TYPE_H
@@ -0,0 +1,288 @@
+#ifndef EVENT_WIRE_FORMAT_H
+#define EVENT_WIRE_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "Event/Event.h"
+#include "Event/SensorRecord.h"
+#include "Event/SensorType.h"
+
+namespace Event
+{
+
+/**
+ * @namespace Event::WireFormat
+ * @brief Binary encoding of events shared by the journal, IPC and the network bridge
+ *
+ * An encoded event is an EventHeader followed by the fixed part of its
+ * type's layout (described by a Schema) and the variable-length bytes the
+ * fixed part declares, padded with zeros to kAlignment. The header carries
+ * the event type, the layout version and the size of the fixed part, so a
+ * reader finds the trailing bytes of a newer version that appended fixed
+ * fields and can still read the fields it knows.
+ *
+ * Evolution rules: fields are never moved, resized or reused; new fields
+ * are appended to the fixed part and the version is bumped. Readers accept
+ * any version at or above the one that introduced the fields they read.
+ *
+ * Timestamps are wall-clock nanoseconds, which processes, nodes and
+ * restarts agree on. Device names travel as bytes; device_id is only an
+ * id in the writer's own numbering (e.g. a journal segment's dictionary).
+ * Integers are little-endian (host order on supported targets).
+ */
+namespace WireFormat
+{
+
+constexpr std::size_t kAlignment = 8;          ///< Encoded events start at multiples of this
+constexpr uint16_t kSensorVersion = 1;         ///< Layout version written for SensorEvent
+
+/**
+ * @struct EventHeader
+ * @brief First 8 bytes of every encoded event
+ */
+struct EventHeader
+{
+    uint16_t size;         ///< Bytes of the event, header and trailing bytes included, padding excluded
+    EventType type;        ///< Type of the event
+    uint16_t version;      ///< Layout version of the type
+    uint16_t fixed_size;   ///< Bytes up to the trailing bytes, header included
+};
+
+/**
+ * @struct SensorEventLayout
+ * @brief Fixed part of an encoded SensorEvent (version 1); name_size device name bytes follow
+ */
+struct SensorEventLayout
+{
+    EventHeader header;          ///< type Sensor, version kSensorVersion
+    int64_t wall_timestamp_ns;   ///< Nanoseconds since the Unix epoch
+    double value;                ///< Measured value
+    uint64_t sequence;           ///< SensorRecord::sequence
+    uint32_t device_id;          ///< Device id in the writer's numbering
+    SensorType sensor_type;      ///< Sensor type
+    uint8_t flags;               ///< SensorRecord::flags
+    uint16_t name_size;          ///< Length of the device name; 0 if the container names devices
+};
+
+static_assert(sizeof(EventHeader) == 8, "EventHeader is expected to be 8 bytes");
+static_assert(sizeof(SensorEventLayout) == 40, "SensorEventLayout is expected to be 40 bytes");
+static_assert(std::is_trivially_copyable<SensorEventLayout>::value, "Layouts are copied with memcpy");
+
+constexpr std::size_t kMaxNameSize = UINT16_MAX - sizeof(SensorEventLayout);   ///< Longer names are truncated
+
+/**
+ * @enum FieldKind
+ * @brief Encoding of a schema field
+ */
+enum class FieldKind : uint8_t
+{
+    UInt8,     ///< Unsigned 8-bit integer
+    UInt16,    ///< Unsigned 16-bit integer
+    UInt32,    ///< Unsigned 32-bit integer
+    UInt64,    ///< Unsigned 64-bit integer
+    Int64,     ///< Signed 64-bit integer
+    Float64,   ///< IEEE 754 double
+    Bytes      ///< Variable-length bytes after the fixed part; size given by another field
+};
+
+/**
+ * @struct FieldDescriptor
+ * @brief Name and position of one field of a layout
+ */
+struct FieldDescriptor
+{
+    const char* name;      ///< Field name
+    uint16_t offset;       ///< Byte offset in the event; for Bytes, the offset of its size field
+    uint16_t size;         ///< Field size in bytes; 0 for Bytes
+    FieldKind kind;        ///< Encoding
+    uint16_t since;        ///< Layout version that introduced the field
+};
+
+/**
+ * @struct Schema
+ * @brief Machine-readable description of an event type's layout
+ */
+struct Schema
+{
+    const char* name;                ///< Event type name
+    EventType type;                  ///< EventHeader::type
+    uint16_t version;                ///< Latest layout version
+    uint16_t fixed_size;             ///< EventHeader::fixed_size of the latest version
+    const FieldDescriptor* fields;   ///< Fields in offset order
+    std::size_t field_count;         ///< Number of fields
+};
+
+/**
+ * @brief Gets the schema of SensorEvent
+ */
+const Schema& sensorSchema();
+
+/**
+ * @brief Renders a schema as text, one field per line
+ * @param schema Schema to render
+ * @return Description such as "SensorEvent v1, 40 fixed bytes" followed by the fields
+ */
+std::string describe(const Schema& schema);
+
+/**
+ * @brief Rounds an event size up to kAlignment
+ * @param size Unpadded event size
+ */
+constexpr std::size_t alignEvent(std::size_t size)
+{
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+/**
+ * @brief Bytes an encoded SensorEvent occupies
+ * @param name_size Length of the device name (at most kMaxNameSize)
+ */
+constexpr std::size_t sensorEventSize(std::size_t name_size)
+{
+    return alignEvent(sizeof(SensorEventLayout) + name_size);
+}
+
+/**
+ * @brief Encodes a reading
+ * @param record Reading to encode
+ * @param name Device name to embed; empty when the container names devices by id
+ * @param out Receives sensorEventSize(name.size()) bytes; needs no alignment
+ * @return Bytes written, padding included
+ *
+ * Names longer than kMaxNameSize are truncated.
+ */
+std::size_t encodeSensorEvent(const SensorRecord& record, std::string_view name, void* out);
+
+/**
+ * @class SensorEventView
+ * @brief Read access to an encoded SensorEvent in place
+ *
+ * Accessors load the field straight from the buffer (any alignment), so
+ * decoding allocates nothing and touches only the fields asked for. A view
+ * is only obtained through parse(), which validates the event first, and
+ * stays valid as long as the buffer does.
+ */
+class SensorEventView
+{
+public:
+    /**
+     * @brief Constructs an empty view; use parse()
+     */
+    SensorEventView() = default;
+
+    /**
+     * @brief Validates an encoded SensorEvent and points a view at it
+     * @param data Start of the event
+     * @param size Bytes available from data
+     * @param view Receives the view
+     * @return ERROR if the bytes are not a complete, well-formed SensorEvent
+     */
+    static Status parse(const void* data, std::size_t size, SensorEventView& view);
+
+    /**
+     * @brief Bytes the event occupies, padding included
+     */
+    std::size_t encodedSize() const {
+        return alignEvent(load<uint16_t>(offsetof(EventHeader, size)));
+    }
+
+    /**
+     * @brief Layout version the event was written with
+     */
+    uint16_t version() const {
+        return load<uint16_t>(offsetof(EventHeader, version));
+    }
+
+    /**
+     * @brief Time of the measurement, nanoseconds since the Unix epoch
+     */
+    int64_t wallTimestampNs() const {
+        return load<int64_t>(offsetof(SensorEventLayout, wall_timestamp_ns));
+    }
+
+    /**
+     * @brief Time of the measurement in this process's Util::Clock domain
+     */
+    int64_t timestampNs() const;
+
+    /**
+     * @brief Measured value
+     */
+    double value() const {
+        return load<double>(offsetof(SensorEventLayout, value));
+    }
+
+    /**
+     * @brief Per-device reading counter
+     */
+    uint64_t sequence() const {
+        return load<uint64_t>(offsetof(SensorEventLayout, sequence));
+    }
+
+    /**
+     * @brief Device id in the writer's numbering
+     */
+    uint32_t deviceId() const {
+        return load<uint32_t>(offsetof(SensorEventLayout, device_id));
+    }
+
+    /**
+     * @brief Sensor type
+     */
+    SensorType sensorType() const {
+        return load<SensorType>(offsetof(SensorEventLayout, sensor_type));
+    }
+
+    /**
+     * @brief Bit set of SensorRecord::k*Flag values
+     */
+    uint8_t flags() const {
+        return load<uint8_t>(offsetof(SensorEventLayout, flags));
+    }
+
+    /**
+     * @brief Embedded device name, pointing into the buffer; empty if none
+     */
+    std::string_view deviceName() const {
+        return std::string_view(reinterpret_cast<const char*>(data_) + load<uint16_t>(offsetof(EventHeader, fixed_size)),
+                                load<uint16_t>(offsetof(SensorEventLayout, name_size)));
+    }
+
+    /**
+     * @brief Builds a SensorRecord with the given device id
+     * @param device_id Id to use in this process
+     */
+    SensorRecord toRecord(uint32_t device_id) const;
+
+    /**
+     * @brief Builds a SensorRecord, interning the embedded device name
+     *
+     * Events without a name keep deviceId().
+     */
+    SensorRecord toRecord() const;
+
+private:
+    /**
+     * @brief Loads a field from the buffer
+     * @param offset Byte offset of the field
+     */
+    template<typename T>
+    T load(std::size_t offset) const {
+        T value;
+        std::memcpy(&value, data_ + offset, sizeof(value));
+        return value;
+    }
+
+    const uint8_t* data_{nullptr};   ///< Start of the encoded event
+};
+
+} // namespace WireFormat
+
+} // namespace Event
+
+#endif // EVENT_WIRE_FORMAT_H
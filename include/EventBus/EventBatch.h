@@ -0,0 +1,83 @@
+#ifndef EVENT_BATCH_H
+#define EVENT_BATCH_H
+
+#include <cstddef>
+#include <iterator>
+
+#include "Event/Event.h"
+
+/**
+ * @class EventBatch
+ * @brief Read-only view of the events drained in one EventBus dispatch pass
+ * 
+ * A contiguous span of event pointers; iterating yields const Event&.
+ * The view and the events it refers to are only valid for the duration of
+ * the batch handler call.
+ */
+class EventBatch
+{
+public:
+    /**
+     * @class Iterator
+     * @brief Forward iterator yielding const Event::Event&
+     */
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Event::Event;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Event::Event*;
+        using reference = const Event::Event&;
+
+        explicit Iterator(const Event::Event* const* position) : position_(position) {}
+
+        reference operator*() const { return **position_; }
+        pointer operator->() const { return *position_; }
+        Iterator& operator++() { ++position_; return *this; }
+        Iterator operator++(int) { Iterator previous = *this; ++position_; return previous; }
+        bool operator==(const Iterator& other) const { return position_ == other.position_; }
+        bool operator!=(const Iterator& other) const { return position_ != other.position_; }
+
+    private:
+        const Event::Event* const* position_;  ///< Current element
+    };
+
+    /**
+     * @brief Constructs a view over an array of event pointers
+     * @param events First element
+     * @param size Number of events
+     */
+    EventBatch(const Event::Event* const* events, std::size_t size)
+        : events_(events), size_(size) {}
+
+    /**
+     * @brief Number of events in the batch
+     */
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief Whether the batch is empty
+     */
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Gets the event at a position, in publish order
+     * @param index Position in [0, size())
+     */
+    const Event::Event& operator[](std::size_t index) const { return *events_[index]; }
+
+    /**
+     * @brief Gets the underlying pointer array
+     */
+    const Event::Event* const* data() const { return events_; }
+
+    Iterator begin() const { return Iterator(events_); }
+    Iterator end() const { return Iterator(events_ + size_); }
+
+private:
+    const Event::Event* const* events_;  ///< Event pointers, in publish order
+    std::size_t size_;                   ///< Number of events
+};
+
+#endif // EVENT_BATCH_H
@@ -2,6 +2,8 @@
 #define EVENT_BUS_H
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <vector>
 #include <mutex>
@@ -9,8 +11,17 @@
 #include <thread>
 #include <deque>
 #include <condition_variable>
+#include <cstdint>
+#include <string>
 
 #include "Event/Event.h"
+#include "EventBatch.h"
+#include "Executor.h"
+
+namespace Storage
+{
+class EventJournal;
+}
 
 /**
  * @class EventBus
@@ -22,9 +33,39 @@
  * - Ensures thread-safe event publishing and subscription
  * - Guarantees event ordering (FIFO dispatch)
  * - Gracefully drains all queued events on shutdown
+ * - Drains the queue in batches; batch subscribers get one call per batch
+ * 
+ * Each dispatch pass takes up to BatchOptions::max_batch_size events off
+ * the queue. Per-event handlers are called for each of them in order, then
+ * every batch handler is called once with the whole batch. With a non-zero
+ * BatchOptions::max_latency the worker waits until the batch is full or
+ * its oldest event has waited that long, trading latency for larger
+ * batches; with the default of zero it dispatches whatever is queued.
+ * 
+ * A subscription may name an Executor. Without one its handler runs inline
+ * on the worker thread; with one, the worker hands the executor a task
+ * that shares ownership of the whole batch (no per-event copies or
+ * refcounts) and moves on, so a slow handler on a DedicatedExecutor or a
+ * ThreadPoolExecutor no longer delays the inline handlers. Each
+ * subscription still sees its events in publish order.
+ * 
+ * With a non-zero WatchdogOptions::handler_budget every handler call is
+ * timed with Util::Clock and checked against the budget; per-subscription
+ * timings and over-budget counts are reported by getSubscriptionStats().
+ * With WatchdogOptions::isolate_after set, an inline subscription that
+ * exceeds the budget that many times is moved onto a DedicatedExecutor of
+ * its own so it stops delaying the other subscribers and the queue.
+ * 
+ * An optional Storage::EventJournal (setJournal()) records every event:
+ * the worker appends each batch before handing it to any subscriber, and a
+ * deadline-bounded stop() journals the leftovers before applying the
+ * LeftoverPolicy. Appending is a memcpy into a mapped file; the journal
+ * syncs in the background, so publishing never waits for the disk.
  * 
  * The EventBus must be started with start() before it can dispatch events,
  * and automatically stops in the destructor to ensure clean shutdown.
+ * stop() drains the whole queue; stop(deadline, options) gives up at the
+ * deadline and hands the undispatched events to a LeftoverPolicy instead.
  * 
  * Thread Safety: All public methods are thread-safe and can be called from
  * multiple threads simultaneously.
@@ -32,10 +73,40 @@
 class EventBus
 {
 public:
+    /**
+     * @struct BatchOptions
+     * @brief Controls how the worker groups queued events into batches
+     */
+    struct BatchOptions
+    {
+        std::size_t max_batch_size{256};           ///< Most events dispatched per pass (at least 1)
+        std::chrono::microseconds max_latency{0};  ///< Longest wait for a batch to fill; 0 dispatches at once
+    };
+
+    /**
+     * @struct WatchdogOptions
+     * @brief Controls the slow-handler watchdog
+     * 
+     * The budget applies to a single handler call: one event for a
+     * per-event handler, one whole batch for a batch handler.
+     */
+    struct WatchdogOptions
+    {
+        std::chrono::microseconds handler_budget{0};  ///< Longest acceptable handler call; 0 disables timing
+        uint64_t isolate_after{0};                    ///< Over-budget calls before an inline subscription is isolated; 0 never
+        std::size_t isolation_queue_capacity{DedicatedExecutor::kDefaultCapacity};  ///< Task queue capacity of an isolated subscription's executor
+    };
+
     /**
      * @brief Default constructor
      */
     EventBus() = default;
+
+    /**
+     * @brief Constructs a bus with explicit batching options
+     * @param options Batch size and latency limits
+     */
+    explicit EventBus(BatchOptions options);
     
     /**
      * @brief Destructor - automatically stops the event bus
@@ -51,21 +122,143 @@ public:
      * @brief Type alias for event handler functions
      * 
      * Handlers receive a const reference to the base Event class and can
-     * use dynamic_cast to check for specific event types.
+     * use Event::event_cast to check for specific event types.
      */
     using HandlerType = std::function<void(const Event::Event&)>;
 
+    /**
+     * @brief Type alias for batch handler functions
+     * 
+     * Batch handlers receive every event of a dispatch pass at once, in
+     * publish order, so they can amortise per-call work across events.
+     */
+    using BatchHandlerType = std::function<void(const EventBatch&)>;
+
+    /**
+     * @brief Type alias for the receiver of undispatched events on shutdown
+     * 
+     * Called once with every event still queued, in publish order; the
+     * handler takes ownership. An exception it throws is reported and
+     * swallowed, since stop() is noexcept.
+     */
+    using LeftoverHandler = std::function<void(std::vector<std::unique_ptr<Event::Event>>)>;
+
+    /**
+     * @enum LeftoverPolicy
+     * @brief What stop(deadline, options) does with events it did not dispatch
+     */
+    enum class LeftoverPolicy
+    {
+        Drop,     ///< Destroy them
+        Persist,  ///< Append the sensor readings to ShutdownOptions::persist_path
+        Callback  ///< Hand them to ShutdownOptions::on_leftovers
+    };
+
+    /**
+     * @struct ShutdownOptions
+     * @brief Leftover handling for a deadline-bounded stop
+     * 
+     * Persist appends one entry per Event::SensorEvent: its SensorRecord
+     * with timestamp_ns converted to wall-clock nanoseconds, a uint16_t
+     * device name length and the name bytes, so the file stays meaningful
+     * after a restart. Other event types cannot be persisted and are dropped.
+     */
+    struct ShutdownOptions
+    {
+        LeftoverPolicy leftovers{LeftoverPolicy::Drop};  ///< Policy for undispatched events
+        std::string persist_path;                        ///< File appended to by Persist
+        LeftoverHandler on_leftovers;                    ///< Receiver used by Callback
+    };
+
+    /**
+     * @struct StopReport
+     * @brief Outcome of a stop() call
+     */
+    struct StopReport
+    {
+        uint64_t dispatched{0};     ///< Events dispatched between the stop request and the worker exiting
+        uint64_t leftover{0};       ///< Events still queued when the worker exited
+        uint64_t persisted{0};      ///< Leftovers written to disk by Persist
+        bool deadline_hit{false};   ///< Whether the worker gave up at the deadline
+    };
+
+    /**
+     * @brief Identifier of a subscription, unique per EventBus
+     */
+    using SubscriptionId = uint64_t;
+
     /**
      * @brief Registers a new event handler
      * @param handler Function to be called for each published event
+     * @param executor Where the handler runs; nullptr runs it inline
+     * @return Id of the new subscription
      * 
-     * The handler will be invoked on the EventBus worker thread for every
-     * event published after subscription. Handlers are called in the order
-     * they were subscribed.
+     * Without an executor the handler will be invoked on the EventBus worker
+     * thread for every event published after subscription, and inline
+     * handlers are called in the order they were subscribed. With an
+     * executor the handler runs there, in publish order; a non-sequential
+     * executor (thread pool) is wrapped in a SerialExecutor for this
+     * subscription.
      * 
      * Thread Safety: Can be called from any thread
      */
-    void subscribe(HandlerType handler);
+    SubscriptionId subscribe(HandlerType handler, std::shared_ptr<Executor> executor = nullptr);
+
+    /**
+     * @brief Registers a handler called once per dispatched batch
+     * @param handler Function receiving a view of the batch's events
+     * @param executor Where the handler runs; nullptr runs it inline
+     * @return Id of the new subscription
+     * 
+     * Inline batch handlers run on the worker thread after the inline
+     * per-event handlers of the same batch, in the order they were
+     * subscribed. Batch sizes are bounded by BatchOptions::max_batch_size.
+     * 
+     * Thread Safety: Can be called from any thread
+     */
+    SubscriptionId subscribeBatch(BatchHandlerType handler, std::shared_ptr<Executor> executor = nullptr);
+
+    /**
+     * @brief Changes the batching options
+     * @param options New limits; a max_batch_size of 0 is treated as 1
+     * 
+     * Takes effect from the next dispatch pass.
+     * 
+     * Thread Safety: Can be called from any thread
+     */
+    void setBatchOptions(BatchOptions options);
+
+    /**
+     * @brief Gets the current batching options
+     */
+    BatchOptions getBatchOptions() const;
+
+    /**
+     * @brief Changes the slow-handler watchdog options
+     * @param options New budget and isolation policy; negative budgets disable timing
+     * 
+     * Takes effect from the next dispatch pass. Lowering isolate_after
+     * does not undo isolations that already happened.
+     * 
+     * Thread Safety: Can be called from any thread
+     */
+    void setWatchdogOptions(WatchdogOptions options);
+
+    /**
+     * @brief Gets the current watchdog options
+     */
+    WatchdogOptions getWatchdogOptions() const;
+
+    /**
+     * @brief Attaches a journal that records every published event
+     * @param journal Open journal, or nullptr to stop journaling
+     * 
+     * Takes effect from the next dispatch pass; events already dispatched
+     * are not journaled retroactively.
+     * 
+     * Thread Safety: Can be called from any thread
+     */
+    void setJournal(std::shared_ptr<Storage::EventJournal> journal);
     
     /**
      * @brief Publishes an event to all subscribers
@@ -79,6 +272,19 @@ public:
      */
     void publish(std::unique_ptr<Event::Event> event) noexcept;
 
+    /**
+     * @brief Publishes several events to all subscribers at once
+     * @param events Events to publish, in the order they should be dispatched
+     * 
+     * Equivalent to calling publish() for each event, but the queue lock is
+     * taken and the worker thread is notified only once for the whole batch.
+     * Intended for producers that generate many readings per tick.
+     * 
+     * Thread Safety: Can be called from any thread
+     * @note This method is noexcept and will not throw exceptions
+     */
+    void publishBatch(std::vector<std::unique_ptr<Event::Event>> events) noexcept;
+
     /**
      * @brief Starts the event dispatching worker thread
      * 
@@ -93,15 +299,188 @@ public:
      * @brief Stops the event dispatching and waits for worker thread
      * 
      * Signals the worker thread to stop and waits for all queued events
-     * to be processed. After stop() completes, no more events will be
-     * dispatched until start() is called again.
+     * to be processed, including by subscriptions running on executors.
+     * After stop() completes, no more events will be dispatched until
+     * start() is called again.
      * 
      * Thread Safety: Can be called from any thread
      * @note This method is noexcept and will not throw exceptions
      */
     void stop() noexcept;
 
+    /**
+     * @brief Stops the event dispatching, giving up on the queue at a deadline
+     * @param deadline Time after which no new dispatch pass is started
+     * @param options What to do with the events left in the queue
+     * @return How many events were dispatched and how many were left over
+     * 
+     * The worker keeps dispatching until the queue is empty or the deadline
+     * passes; a pass already running when the deadline passes is finished,
+     * so shutdown overruns it by at most one batch. Events it did not reach
+     * are removed from the queue and handled per options.leftovers. Tasks
+     * already handed to executors still run before this returns.
+     * 
+     * Thread Safety: Can be called from any thread
+     * @note This method is noexcept and will not throw exceptions
+     */
+    StopReport stop(std::chrono::steady_clock::time_point deadline, const ShutdownOptions& options) noexcept;
+
+    /**
+     * @struct Stats
+     * @brief Counters describing the traffic through the bus
+     * 
+     * Queue latency is the time between an event being published and the
+     * worker thread taking it off the queue, measured with Util::Clock.
+     */
+    struct Stats
+    {
+        uint64_t published{0};               ///< Events accepted by publish()/publishBatch()
+        uint64_t dispatched{0};              ///< Events taken off the queue by the worker
+        uint64_t batches{0};                 ///< Dispatch passes (batches) run by the worker
+        int64_t total_queue_latency_ns{0};   ///< Sum of queue latencies of dispatched events
+        int64_t max_queue_latency_ns{0};     ///< Largest queue latency observed
+        uint64_t over_budget_calls{0};       ///< Handler calls that exceeded the watchdog budget
+        uint64_t isolated_subscriptions{0};  ///< Inline subscriptions moved to their own executor
+    };
+
+    /**
+     * @struct SubscriptionStats
+     * @brief Watchdog timings of one subscription
+     * 
+     * Calls are only timed while WatchdogOptions::handler_budget is non-zero.
+     */
+    struct SubscriptionStats
+    {
+        SubscriptionId id{0};          ///< Subscription id
+        bool batch{false};             ///< Whether this is a batch subscription
+        bool on_executor{false};       ///< Whether the handler runs on an executor
+        bool isolated{false};          ///< Whether the watchdog moved it off the worker thread
+        uint64_t calls{0};             ///< Timed handler calls
+        uint64_t over_budget_calls{0}; ///< Timed calls that exceeded the budget
+        int64_t total_ns{0};           ///< Sum of the timed call durations
+        int64_t max_ns{0};             ///< Longest timed call
+    };
+
+    /**
+     * @brief Gets a snapshot of the bus counters
+     * @return Copy of the current statistics
+     * 
+     * Thread Safety: Can be called from any thread
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Gets the watchdog timings of every subscription
+     * @return One entry per subscription, in subscription order
+     * 
+     * Thread Safety: Can be called from any thread
+     */
+    std::vector<SubscriptionStats> getSubscriptionStats() const;
+
 private:
+    /**
+     * @struct QueuedEvent
+     * @brief Queue entry pairing an event with its publish time
+     */
+    struct QueuedEvent
+    {
+        std::unique_ptr<Event::Event> event;  ///< The published event
+        int64_t enqueue_ns;                   ///< Util::Clock::nowNs() at publish
+    };
+
+    /**
+     * @struct HandlerMetrics
+     * @brief Watchdog counters of a subscription
+     * 
+     * Only the thread currently running the handler writes them (the worker,
+     * or the subscription's sequential executor), so plain relaxed
+     * load/store pairs suffice; readers may see a slightly stale snapshot.
+     */
+    struct HandlerMetrics
+    {
+        std::atomic<uint64_t> calls{0};              ///< Timed handler calls
+        std::atomic<uint64_t> over_budget_calls{0};  ///< Timed calls over the budget
+        std::atomic<int64_t> total_ns{0};            ///< Sum of timed durations
+        std::atomic<int64_t> max_ns{0};              ///< Longest timed call
+        std::atomic<bool> isolated{false};           ///< Moved to its own executor by the watchdog
+    };
+
+    /**
+     * @struct Subscription
+     * @brief A registered handler and where it runs
+     */
+    struct Subscription
+    {
+        SubscriptionId id{0};                 ///< Subscription id
+        HandlerType handler;                  ///< Per-event handler, or empty
+        BatchHandlerType batch_handler;       ///< Batch handler, or empty
+        std::shared_ptr<Executor> executor;   ///< nullptr runs inline on the worker
+        std::shared_ptr<HandlerMetrics> metrics{std::make_shared<HandlerMetrics>()};  ///< Shared across isolation
+    };
+
+    /**
+     * @struct SubscriberSet
+     * @brief Immutable snapshot of the subscriptions, grouped by how they run
+     */
+    struct SubscriberSet
+    {
+        std::vector<std::shared_ptr<const Subscription>> inline_handlers;        ///< Inline per-event
+        std::vector<std::shared_ptr<const Subscription>> inline_batch_handlers;  ///< Inline batch
+        std::vector<std::shared_ptr<const Subscription>> executor_handlers;      ///< On executors
+    };
+
+    /**
+     * @struct DispatchedBatch
+     * @brief Events of one dispatch pass, shared with executor tasks
+     */
+    struct DispatchedBatch
+    {
+        std::vector<std::unique_ptr<Event::Event>> events;  ///< Owned events, in publish order
+        std::vector<const Event::Event*> views;             ///< Pointers into events, for EventBatch
+    };
+
+    /**
+     * @brief Adds a subscription to a copy of the subscriber set
+     * @param subscription Subscription to add (id assigned here)
+     * @return Id of the subscription
+     */
+    SubscriptionId addSubscription(Subscription subscription);
+
+    /**
+     * @brief Delivers a batch to one subscription
+     * @param subscription Receiver
+     * @param batch Events of the pass
+     * @param budget_ns Watchdog budget per handler call; 0 skips timing
+     * @return Number of calls that exceeded the budget
+     */
+    static uint64_t deliver(const Subscription& subscription, const DispatchedBatch& batch, int64_t budget_ns);
+
+    /**
+     * @brief Records one timed handler call
+     * @param metrics Counters of the subscription
+     * @param elapsed_ns Duration of the call
+     * @param budget_ns Watchdog budget per call
+     * @return true if the call exceeded the budget
+     */
+    static bool recordCall(HandlerMetrics& metrics, int64_t elapsed_ns, int64_t budget_ns);
+
+    /**
+     * @brief Moves inline subscriptions onto dedicated executors
+     * @param ids Subscriptions to isolate
+     * 
+     * Replaces the subscriber set (copy-on-write); the next dispatch pass
+     * hands these subscriptions their batches through the new executors.
+     */
+    void isolate(const std::vector<SubscriptionId>& ids);
+
+    /**
+     * @brief Appends the sensor readings among events to a file
+     * @param path File to append to
+     * @param events Undispatched events, in publish order
+     * @return Number of readings written
+     */
+    static uint64_t persistEvents(const std::string& path, const std::deque<QueuedEvent>& events);
+
     /**
      * @brief Main event dispatch loop running on worker thread
      * 
@@ -110,14 +489,21 @@ private:
      */
     void dispatchLoop();
 
-    std::vector<HandlerType> handlers_;                         ///< Registered event handlers
-    std::mutex mutex_;                                          ///< Protects shared state
+    /// Registered subscriptions; replaced (copy-on-write) by subscribe()/subscribeBatch()
+    std::shared_ptr<const SubscriberSet> subscribers_{std::make_shared<SubscriberSet>()};
+    SubscriptionId next_subscription_id_{1};                    ///< Id of the next subscription
+    BatchOptions options_;                                      ///< Batching limits
+    WatchdogOptions watchdog_;                                  ///< Slow-handler budget and isolation policy
+    std::shared_ptr<Storage::EventJournal> journal_;            ///< Optional journal stage
+    mutable std::mutex mutex_;                                  ///< Protects shared state
     std::thread worker_thread_;                                 ///< Worker thread for event dispatch
-    std::deque<std::unique_ptr<Event::Event>> event_queue_;    ///< FIFO queue of pending events
+    std::deque<QueuedEvent> event_queue_;                       ///< FIFO queue of pending events
     std::condition_variable cv_;                                ///< Condition variable for queue notifications
     
     bool running_{false};         ///< Whether EventBus is currently running
     bool stop_requested_{false};  ///< Flag to signal worker thread shutdown
+    int64_t stop_deadline_ns_{0}; ///< Util::Clock time after which the worker stops dispatching
+    Stats stats_;                 ///< Traffic counters, protected by mutex_
 };
 
 
@@ -0,0 +1,240 @@
+#ifndef EVENT_BUS_EXECUTOR_H
+#define EVENT_BUS_EXECUTOR_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class Executor
+ * @brief Runs EventBus deliveries for a subscription
+ * 
+ * An executor decides which thread a subscription's handler runs on. The
+ * EventBus hands it one task per dispatched batch; the task shares
+ * ownership of the batch, so events are never copied no matter how many
+ * executors receive them.
+ * 
+ * Thread Safety: All methods are thread-safe.
+ */
+class Executor
+{
+public:
+    using Task = std::function<void()>;  ///< Unit of work
+
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~Executor() = default;
+
+    /**
+     * @brief Schedules a task
+     * @param task Work to run; may block while the executor's queue is full
+     */
+    virtual void execute(Task task) = 0;
+
+    /**
+     * @brief Schedules a task unless that would block or wait on the caller
+     * @param task Work to run; left untouched when not scheduled
+     * @return false if the queue is full or the caller is one of the
+     *         executor's own threads, so the caller should run task itself
+     * 
+     * Lets code that waits for its own tasks (a fork/join) avoid deadlocking
+     * when called from a task of the same executor. The default schedules
+     * with execute().
+     */
+    virtual bool tryExecute(Task& task)
+    {
+        execute(std::move(task));
+        return true;
+    }
+
+    /**
+     * @brief Waits until every task scheduled so far has finished
+     */
+    virtual void drain() = 0;
+
+    /**
+     * @brief Whether tasks run one at a time in submission order
+     * 
+     * The EventBus wraps non-sequential executors in a SerialExecutor per
+     * subscription so each handler still sees its events in order.
+     */
+    virtual bool isSequential() const = 0;
+};
+
+/**
+ * @class InlineExecutor
+ * @brief Runs tasks immediately on the calling (dispatcher) thread
+ */
+class InlineExecutor : public Executor
+{
+public:
+    void execute(Task task) override;
+    void drain() override {}
+    bool isSequential() const override { return true; }
+};
+
+/**
+ * @class DedicatedExecutor
+ * @brief Runs tasks on one thread of its own, fed by a bounded FIFO queue
+ * 
+ * Gives a heavy subscriber (e.g. a disk writer) its own thread so it no
+ * longer delays the dispatcher. When capacity tasks are pending, execute()
+ * blocks: the queue bounds memory and applies backpressure instead of
+ * growing without limit.
+ */
+class DedicatedExecutor : public Executor
+{
+public:
+    static constexpr std::size_t kDefaultCapacity = 1024;  ///< Default pending-task limit
+
+    /**
+     * @brief Starts the executor thread
+     * @param capacity Most pending tasks before execute() blocks (at least 1)
+     */
+    explicit DedicatedExecutor(std::size_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief Runs the remaining tasks and joins the thread
+     */
+    ~DedicatedExecutor() override;
+
+    DedicatedExecutor(const DedicatedExecutor&) = delete;
+    DedicatedExecutor& operator=(const DedicatedExecutor&) = delete;
+
+    void execute(Task task) override;
+    bool tryExecute(Task& task) override;
+    void drain() override;
+    bool isSequential() const override { return true; }
+
+    /**
+     * @brief Number of tasks waiting to run
+     */
+    std::size_t pending() const;
+
+private:
+    /**
+     * @brief Thread body: runs tasks until stopped and empty
+     */
+    void run();
+
+    const std::size_t capacity_;          ///< Pending-task limit
+    mutable std::mutex mutex_;            ///< Protects the fields below
+    std::condition_variable not_empty_;   ///< Signals new tasks or stop
+    std::condition_variable not_full_;    ///< Signals room in the queue
+    std::condition_variable idle_;        ///< Signals queue empty and no task running
+    std::deque<Task> tasks_;              ///< Pending tasks, FIFO
+    bool busy_{false};                    ///< A task is running
+    bool stop_requested_{false};          ///< Thread should exit once empty
+    std::thread thread_;                  ///< Executor thread
+};
+
+/**
+ * @class ThreadPoolExecutor
+ * @brief Runs tasks on a fixed pool of threads shared by several subscriptions
+ * 
+ * Tasks may run concurrently and out of order; the EventBus serialises each
+ * subscription on the pool with a SerialExecutor. The pending queue is
+ * bounded like DedicatedExecutor's.
+ */
+class ThreadPoolExecutor : public Executor
+{
+public:
+    static constexpr std::size_t kDefaultCapacity = 4096;  ///< Default pending-task limit
+
+    /**
+     * @brief Starts the pool
+     * @param threads Number of worker threads (at least 1)
+     * @param capacity Most pending tasks before execute() blocks (at least 1)
+     */
+    explicit ThreadPoolExecutor(std::size_t threads, std::size_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief Runs the remaining tasks and joins all threads
+     */
+    ~ThreadPoolExecutor() override;
+
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    void execute(Task task) override;
+    bool tryExecute(Task& task) override;
+    void drain() override;
+    bool isSequential() const override { return false; }
+
+    /**
+     * @brief Number of worker threads
+     */
+    std::size_t threadCount() const {
+        return threads_.size();
+    }
+
+private:
+    /**
+     * @brief Worker body: runs tasks until stopped and empty
+     */
+    void run();
+
+    const std::size_t capacity_;          ///< Pending-task limit
+    std::mutex mutex_;                    ///< Protects the fields below
+    std::condition_variable not_empty_;   ///< Signals new tasks or stop
+    std::condition_variable not_full_;    ///< Signals room in the queue
+    std::condition_variable idle_;        ///< Signals queue empty and no task running
+    std::deque<Task> tasks_;              ///< Pending tasks
+    std::size_t active_{0};               ///< Tasks currently running
+    bool stop_requested_{false};          ///< Threads should exit once empty
+    std::vector<std::thread> threads_;    ///< Worker threads
+};
+
+/**
+ * @class SerialExecutor
+ * @brief Runs tasks one at a time, in order, on top of another executor
+ * 
+ * A strand: at most one task of this executor is scheduled on the target
+ * at any time, and it runs every queued task before yielding. Lets many
+ * subscriptions share a ThreadPoolExecutor while each keeps FIFO order
+ * and never runs concurrently with itself.
+ * 
+ * Since the target only ever holds one task of the strand, the target's
+ * bound cannot push back on the strand; the strand's own queue is bounded
+ * instead, and execute() blocks while capacity tasks are pending.
+ * 
+ * Must be owned by a std::shared_ptr (scheduled work keeps it alive).
+ */
+class SerialExecutor : public Executor, public std::enable_shared_from_this<SerialExecutor>
+{
+public:
+    static constexpr std::size_t kDefaultCapacity = 1024;  ///< Default pending-task limit
+
+    /**
+     * @brief Constructs a strand on a target executor
+     * @param target Executor that runs the strand's work
+     * @param capacity Most pending tasks before execute() blocks (at least 1)
+     */
+    explicit SerialExecutor(std::shared_ptr<Executor> target, std::size_t capacity = kDefaultCapacity);
+
+    void execute(Task task) override;
+    void drain() override;
+    bool isSequential() const override { return true; }
+
+private:
+    /**
+     * @brief Runs queued tasks until the queue is empty
+     */
+    void runPending();
+
+    std::shared_ptr<Executor> target_;   ///< Executor doing the work
+    const std::size_t capacity_;         ///< Pending-task limit
+    std::mutex mutex_;                   ///< Protects the fields below
+    std::condition_variable not_full_;   ///< Signals room in the queue
+    std::condition_variable idle_;       ///< Signals nothing queued or scheduled
+    std::deque<Task> tasks_;             ///< Tasks not yet run
+    bool scheduled_{false};              ///< runPending() is queued or running on target_
+};
+
+#endif // EVENT_BUS_EXECUTOR_H
@@ -0,0 +1,257 @@
+#ifndef STATIC_EVENT_BUS_H
+#define STATIC_EVENT_BUS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/**
+ * @struct EventList
+ * @brief Compile-time list of the event types a StaticEventBus carries
+ * @tparam Events Event types, stored by value
+ */
+template<typename... Events>
+struct EventList {};
+
+template<typename EventListT, typename... Handlers>
+class StaticEventBus;
+
+/**
+ * @class StaticEventBus
+ * @brief Event bus whose event types and handlers are fixed at compile time
+ * 
+ * Counterpart of the dynamic EventBus for pipelines where every event type
+ * and consumer is known when compiling. Events are stored by value in a
+ * std::variant (no heap allocation, no virtual dispatch, no unique_ptr) and
+ * handlers are stored by value as their concrete types (no std::function),
+ * so the compiler can inline the whole dispatch.
+ * 
+ * Each event is passed to every handler that is invocable with it, in the
+ * order the handlers were given; a handler may accept only some of the
+ * event types. Dispatch runs on a dedicated worker thread, which swaps the
+ * whole pending queue out under the lock and dispatches it without holding
+ * the lock.
+ * 
+ * Semantics match EventBus: FIFO dispatch, start() before events are
+ * dispatched, stop() drains the queue, and the destructor stops the bus.
+ * 
+ * @tparam Events Event types carried by the bus
+ * @tparam Handlers Handler types (lambdas or function objects)
+ * 
+ * Example usage:
+ * @code
+ * StaticEventBus bus(EventList<Event::SensorEvent>{},
+ *                    [](const Event::SensorEvent& event) { ... });
+ * bus.start();
+ * bus.publish(Event::SensorEvent(record));
+ * @endcode
+ * 
+ * Thread Safety: publish(), publishBatch(), start() and stop() can be called
+ * from any thread. Handlers run on the worker thread only.
+ */
+template<typename... Events, typename... Handlers>
+class StaticEventBus<EventList<Events...>, Handlers...>
+{
+public:
+    static_assert(sizeof...(Events) > 0, "StaticEventBus needs at least one event type");
+
+    /// Storage type of a queued event
+    using EventVariant = std::variant<Events...>;
+
+    /**
+     * @brief Constructs a stopped bus with its handlers
+     * @param handlers Handlers, copied or moved into the bus
+     */
+    explicit StaticEventBus(EventList<Events...>, Handlers... handlers)
+        : handlers_(std::move(handlers)...) {}
+
+    /**
+     * @brief Destructor - automatically stops the bus
+     */
+    ~StaticEventBus() {
+        stop();
+    }
+
+    StaticEventBus(const StaticEventBus&) = delete;
+    StaticEventBus& operator=(const StaticEventBus&) = delete;
+
+    /**
+     * @brief Publishes an event to every handler that accepts its type
+     * @param event Event, stored by value
+     * 
+     * Thread Safety: Can be called from any thread
+     */
+    template<typename E>
+    void publish(E&& event)
+    {
+        using Stored = std::decay_t<E>;
+        static_assert((std::is_same<Stored, Events>::value || ...), "Event type is not carried by this StaticEventBus");
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.emplace_back(std::in_place_type<Stored>, std::forward<E>(event));
+            published_++;
+        }
+        cv_.notify_one();
+    }
+
+    /**
+     * @brief Publishes several events of one type under a single lock
+     * @param events Events to publish, in dispatch order
+     * 
+     * Thread Safety: Can be called from any thread
+     */
+    template<typename E>
+    void publishBatch(std::vector<E> events)
+    {
+        static_assert((std::is_same<E, Events>::value || ...), "Event type is not carried by this StaticEventBus");
+        if (events.empty()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.reserve(queue_.size() + events.size());
+            for (auto& event : events) {
+                queue_.emplace_back(std::in_place_type<E>, std::move(event));
+            }
+            published_ += events.size();
+        }
+        cv_.notify_one();
+    }
+
+    /**
+     * @brief Starts the dispatch worker thread; no effect if already running
+     */
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            return;
+        }
+        stop_requested_ = false;
+        running_ = true;
+        worker_thread_ = std::thread(&StaticEventBus::dispatchLoop, this);
+    }
+
+    /**
+     * @brief Stops the worker after draining all queued events
+     * 
+     * Idempotent.
+     */
+    void stop() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return;
+            }
+            stop_requested_ = true;
+        }
+        cv_.notify_one();
+
+        if (worker_thread_.joinable()) {
+            worker_thread_.join();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+
+    /**
+     * @brief Number of events accepted so far
+     */
+    uint64_t publishedCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return published_;
+    }
+
+    /**
+     * @brief Number of events dispatched so far
+     */
+    uint64_t dispatchedCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dispatched_;
+    }
+
+    /**
+     * @brief Gives access to a handler, e.g. to read its results after stop()
+     * @tparam I Position of the handler in the constructor arguments
+     */
+    template<std::size_t I>
+    auto& handler() {
+        return std::get<I>(handlers_);
+    }
+
+private:
+    /**
+     * @brief Calls one handler if it accepts the event's type
+     */
+    template<typename Handler, typename E>
+    static void invokeIfAccepted(Handler& handler, const E& event)
+    {
+        if constexpr (std::is_invocable<Handler&, const E&>::value) {
+            handler(event);
+        }
+    }
+
+    /**
+     * @brief Passes one event to every accepting handler, in order
+     */
+    template<typename E>
+    void dispatchOne(const E& event)
+    {
+        std::apply([&event](auto&... handlers) {
+            (invokeIfAccepted(handlers, event), ...);
+        }, handlers_);
+    }
+
+    /**
+     * @brief Worker loop: swap out the pending queue, dispatch it, repeat
+     */
+    void dispatchLoop()
+    {
+        std::vector<EventVariant> batch;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                dispatched_ += batch.size();
+                batch.clear();
+                cv_.wait(lock, [this] {
+                    return !queue_.empty() || stop_requested_;
+                });
+                if (queue_.empty()) {
+                    break; // Stop requested and nothing left to dispatch
+                }
+                batch.swap(queue_);
+            }
+
+            for (const auto& event : batch) {
+                std::visit([this](const auto& concrete) { dispatchOne(concrete); }, event);
+            }
+        }
+    }
+
+    std::tuple<Handlers...> handlers_;     ///< Handlers, called in order
+    mutable std::mutex mutex_;             ///< Protects the fields below
+    std::condition_variable cv_;           ///< Signals new events or stop
+    std::vector<EventVariant> queue_;      ///< Pending events, FIFO
+    std::thread worker_thread_;            ///< Dispatch worker
+    uint64_t published_{0};                ///< Events accepted
+    uint64_t dispatched_{0};               ///< Events dispatched
+    bool running_{false};                  ///< Whether the worker runs
+    bool stop_requested_{false};           ///< Worker should exit once drained
+};
+
+/// Deduces the handler types: StaticEventBus bus(EventList<A, B>{}, h1, h2);
+template<typename... Events, typename... Handlers>
+StaticEventBus(EventList<Events...>, Handlers...) -> StaticEventBus<EventList<Events...>, Handlers...>;
+
+#endif // STATIC_EVENT_BUS_H
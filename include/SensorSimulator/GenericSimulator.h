@@ -9,6 +9,10 @@
 #include "ISensorSimulator.h"
 #include "EventBus/EventBus.h"
 #include "Event/SensorEvent.h"
+#include "Event/SensorTraits.h"
+#include "SensorGenerator.h"
+#include "Util/Xoshiro256.h"
+#include "Util/RandomStreams.h"
 
 namespace SensorSimulator
 {
@@ -26,7 +30,8 @@ namespace SensorSimulator
  * - How frequently to generate readings (in seconds)
  * 
  * This design enables type-safe sensor simulators with zero runtime overhead for
- * configuration. All sensor logic is handled by the SensorEvent class.
+ * configuration. Readings are produced by a SensorGenerator owned by the simulator;
+ * only the resulting observation is copied into each published SensorEvent.
  * 
  * @tparam T Sensor type from Event::SensorType enum
  * @tparam U Update interval in seconds (how often to generate readings)
@@ -44,14 +49,27 @@ template<Event::SensorType T, uint8_t U>
 class GenericSimulator : public ISensorSimulator
 {
 public:
+    /// Compile-time traits of the simulated type; an unknown T fails to compile
+    static constexpr const Event::SensorTraits& kTraits = Event::sensorTraits<T>();
+
     /**
      * @brief Constructs a sensor simulator
      * @param event_bus Reference to the EventBus where events will be published
      * 
      * The simulator is initially stopped and must be started by calling runSimulation().
+     * Its random stream is taken from Util::RandomStreams::global() at construction.
      */
     explicit GenericSimulator(EventBus& event_bus) 
+        : GenericSimulator(event_bus, Util::RandomStreams::global().next()) {}
+
+    /**
+     * @brief Constructs a sensor simulator with an explicit random stream
+     * @param event_bus Reference to the EventBus where events will be published
+     * @param rand_gen Random stream driving this simulator's readings
+     */
+    GenericSimulator(EventBus& event_bus, const Util::Xoshiro256& rand_gen)
         : event_bus_(event_bus),
+        generator_(kTraits, rand_gen),
         stop_requested_(false) {}
     
     /**
@@ -67,8 +85,8 @@ public:
      * is called.
      * 
      * The simulation loop:
-     * 1. Creates a SensorEvent of type T
-     * 2. Recalculates the sensor value (generates new reading)
+     * 1. Draws the next reading from the simulator's SensorGenerator
+     * 2. Wraps it in a SensorEvent
      * 3. Publishes the event to the EventBus
      * 4. Sleeps for U seconds
      * 5. Checks if stop was requested
@@ -78,12 +96,9 @@ public:
      */
     void runSimulation() override
     {
-        Event::SensorEvent sensor(T);
-
         while(!stop_requested_.load(std::memory_order_acquire))
         {
-            sensor.recalc();
-            event_bus_.publish(std::make_unique<Event::SensorEvent>(sensor));
+            event_bus_.publish(std::make_unique<Event::SensorEvent>(generator_.next()));
             std::this_thread::sleep_for(std::chrono::seconds(U));
         }
     }
@@ -104,6 +119,7 @@ public:
     
 private:
     EventBus& event_bus_;               ///< Reference to the event publishing system
+    SensorGenerator generator_;         ///< Generation model of the simulated sensor
     std::atomic<bool> stop_requested_;  ///< Flag to signal simulation stop
 };
 
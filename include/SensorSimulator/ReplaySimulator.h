@@ -0,0 +1,147 @@
+#ifndef SENSOR_SIMULATOR_REPLAY_SIMULATOR_H
+#define SENSOR_SIMULATOR_REPLAY_SIMULATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "ISensorSimulator.h"
+#include "EventBus/EventBus.h"
+#include "Event/SensorRecord.h"
+#include "Storage/JournalReader.h"
+#include "Storage/TraceReader.h"
+
+namespace SensorSimulator
+{
+
+/**
+ * @class ReplaySimulator
+ * @brief Producer that publishes recorded sensor traffic back into an EventBus
+ *
+ * Reads a Storage::EventJournal directory or a raw record trace file
+ * (both memory-mapped) and publishes the readings in recorded order, so
+ * consumers can be exercised with real arrival patterns instead of the
+ * uniform ticks of GenericSimulator.
+ *
+ * Timing follows the recorded timestamps divided by ReplayOptions::speed
+ * (1 = original timing, 10 = ten times faster); a speed of 0 publishes as
+ * fast as the bus accepts. Readings that are due at the same time are
+ * published together with EventBus::publishBatch().
+ *
+ * Memory stays bounded: before each batch the simulator waits until the
+ * bus has fewer than ReplayOptions::max_in_flight events published but
+ * not yet dispatched, so a slow consumer throttles the replay instead of
+ * letting the queue grow.
+ *
+ * runSimulation() returns when the recording is exhausted (unless
+ * ReplayOptions::loop is set) or stopSimulation() is called, so it can be
+ * managed by a SimulatorManager like the generating simulators.
+ *
+ * Thread Safety: stopSimulation() can be called from any thread while
+ * runSimulation() is executing.
+ */
+class ReplaySimulator : public ISensorSimulator
+{
+public:
+    /**
+     * @struct ReplayOptions
+     * @brief Pace, batching and memory limits of a replay
+     */
+    struct ReplayOptions
+    {
+        double speed{1.0};                ///< Time scale; 0 replays as fast as possible
+        std::size_t batch_size{64};       ///< Most events per publishBatch() call
+        std::size_t max_in_flight{4096};  ///< Bus backlog above which the replay waits
+        bool restamp{false};              ///< Stamp readings with the replay time instead of the recorded one
+        bool loop{false};                 ///< Start over at the end of the recording
+    };
+
+    /**
+     * @brief Constructs a replay of a journal directory or trace file
+     * @param event_bus EventBus to publish to
+     * @param path Storage::EventJournal directory or trace file
+     * @param options Pace, batching and memory limits
+     */
+    ReplaySimulator(EventBus& event_bus, std::string path, ReplayOptions options);
+
+    /**
+     * @brief Constructs a replay at original speed
+     * @param event_bus EventBus to publish to
+     * @param path Storage::EventJournal directory or trace file
+     */
+    ReplaySimulator(EventBus& event_bus, std::string path)
+        : ReplaySimulator(event_bus, std::move(path), ReplayOptions()) {}
+
+    /**
+     * @brief Default destructor
+     */
+    ~ReplaySimulator() override = default;
+
+    /**
+     * @brief Opens the recording
+     * @return ERROR if path is neither a readable journal nor a trace file
+     *
+     * Called by runSimulation() if needed; call it first to report a bad
+     * path before starting.
+     */
+    Event::Status open();
+
+    /**
+     * @brief Publishes the recording, blocking until done or stopped
+     */
+    void runSimulation() override;
+
+    /**
+     * @brief Signals the replay to stop
+     *
+     * runSimulation() returns within one wait slice (at most 50 ms).
+     */
+    void stopSimulation() override;
+
+    /**
+     * @brief Number of readings published so far
+     */
+    uint64_t getReplayedCount() const {
+        return replayed_.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief Reads the next recorded reading from the open source
+     * @param record Receives the reading
+     * @return false at the end of the recording
+     */
+    bool nextRecord(Event::SensorRecord& record);
+
+    /**
+     * @brief Restarts the open source at its first reading
+     */
+    void rewind();
+
+    /**
+     * @brief Publishes the pending batch once the bus backlog allows it
+     * @param batch Events to publish; emptied
+     */
+    void flush(std::vector<std::unique_ptr<Event::Event>>& batch);
+
+    /**
+     * @brief Sleeps until a Util::Clock time or a stop request
+     * @param target_ns Monotonic time to wait for
+     * @return false if stopped while waiting
+     */
+    bool waitUntil(int64_t target_ns);
+
+    EventBus& event_bus_;                               ///< Where readings are published
+    std::string path_;                                  ///< Journal directory or trace file
+    ReplayOptions options_;                             ///< Pace, batching and memory limits
+    std::unique_ptr<Storage::JournalReader> journal_;   ///< Source when path_ is a journal
+    std::unique_ptr<Storage::TraceReader> trace_;       ///< Source when path_ is a trace file
+    std::atomic<bool> stop_requested_{false};           ///< Flag to signal replay stop
+    std::atomic<uint64_t> replayed_{0};                 ///< Readings published
+};
+
+} // namespace SensorSimulator
+
+#endif // SENSOR_SIMULATOR_REPLAY_SIMULATOR_H
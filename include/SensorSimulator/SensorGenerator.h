@@ -0,0 +1,101 @@
+#ifndef SENSOR_SIMULATOR_SENSOR_GENERATOR_H
+#define SENSOR_SIMULATOR_SENSOR_GENERATOR_H
+
+#include <cstdint>
+
+#include "Event/SensorType.h"
+#include "Event/SensorTraits.h"
+#include "Event/SensorRecord.h"
+#include "Util/Xoshiro256.h"
+
+namespace SensorSimulator
+{
+
+/**
+ * @class SensorGenerator
+ * @brief Generation model of one simulated sensor device
+ * 
+ * Owns everything needed to produce readings - the type's base value and
+ * range, the fault model and the random stream - and hands out plain
+ * Event::SensorRecord observations. Published SensorEvents only carry those
+ * records, so consumers never pay for (or copy) generator state.
+ * 
+ * Each generator models a single device: the device number is drawn once at
+ * construction and the record sequence number increases with every reading.
+ * 
+ * Thread Safety: Not thread-safe; each simulator owns its generator.
+ */
+class SensorGenerator
+{
+public:
+    /**
+     * @brief Constructs a generator on the next stream of Util::RandomStreams::global()
+     * @param type The type of sensor to simulate
+     */
+    explicit SensorGenerator(Event::SensorType type);
+
+    /**
+     * @brief Constructs a generator on an explicit random stream
+     * @param type The type of sensor to simulate
+     * @param rand_gen Random stream used for the device number and every reading
+     */
+    SensorGenerator(Event::SensorType type, const Util::Xoshiro256& rand_gen);
+
+    /**
+     * @brief Constructs a generator from a compile-time trait row
+     * @param traits Traits of the sensor type, e.g. Event::sensorTraits<T>()
+     * @param rand_gen Random stream used for the device number and every reading
+     */
+    SensorGenerator(const Event::SensorTraits& traits, const Util::Xoshiro256& rand_gen);
+
+    /**
+     * @brief Produces the next reading of this device
+     * @return Record stamped with the current time, a new value (or fault)
+     *         and the next sequence number
+     */
+    Event::SensorRecord next();
+
+    /**
+     * @brief Gets the type of the simulated sensor
+     */
+    Event::SensorType getSensorType() const {
+        return type_;
+    }
+
+    /**
+     * @brief Gets the device number of the simulated sensor within its type
+     */
+    uint32_t getDeviceNumber() const {
+        return device_number_;
+    }
+
+    /**
+     * @brief Gets the interned device id stamped on every record
+     */
+    uint32_t getDeviceId() const {
+        return device_id_;
+    }
+
+private:
+    /**
+     * @brief Copies the model parameters and creates the device
+     * @param traits Traits of the sensor type
+     */
+    void init(const Event::SensorTraits& traits);
+
+    static constexpr int kSensorIdWidth = 10;   ///< Range for device ID numbering
+    static constexpr double kFaultValue = 0.0;  ///< Value indicating sensor fault
+
+    Event::SensorType type_;      ///< Type of the simulated sensor
+    uint32_t device_number_{0};   ///< Device number drawn at construction
+    uint32_t device_id_{0};       ///< Interned id of the device ID string
+    double base_value_{0.0};      ///< Base value for this sensor type
+    uint32_t range_{0};           ///< Range of variation above the base value
+    uint32_t fault_one_in_{1};    ///< Fault probability denominator
+    uint64_t sequence_{0};        ///< Sequence number of the next reading
+    Util::Xoshiro256 rand_gen_;   ///< Random stream driving the readings
+};
+
+} // namespace SensorSimulator
+
+#endif // SENSOR_SIMULATOR_SENSOR_GENERATOR_H
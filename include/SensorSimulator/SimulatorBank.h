@@ -0,0 +1,238 @@
+#ifndef SENSOR_SIMULATOR_SIMULATOR_BANK_H
+#define SENSOR_SIMULATOR_SIMULATOR_BANK_H
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "ISensorSimulator.h"
+#include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+#include "Event/SensorRecord.h"
+#include "Event/SensorTraits.h"
+#include "Util/Clock.h"
+#include "Util/Xoshiro128.h"
+#include "Util/Xoshiro256.h"
+#include "Util/RandomStreams.h"
+
+namespace SensorSimulator
+{
+
+/**
+ * @class SimulatorBank
+ * @brief Structure-of-arrays simulator generating readings for many sensors per tick
+ *
+ * Where GenericSimulator owns one SensorEvent per simulated device, SimulatorBank
+ * stores N sensors of the same type as parallel arrays (device IDs, base values,
+ * ranges and xoshiro128++ RNG states, one array per state word). Each sensor's RNG is
+ * a non-overlapping Util::Xoshiro128 stream. Every tick generates all N readings in a single
+ * branch-free loop over those arrays, which the compiler can vectorize, and hands
+ * the readings to the EventBus as one batch.
+ *
+ * Readings follow the same model as SensorEvent: a uniform value in
+ * [base, base + range) with a 1-in-fault_one_in chance of a fault (0.0)
+ * reading, all taken from Event::sensorTraits<T>() at compile time.
+ *
+ * @tparam T Sensor type from Event::SensorType enum
+ * @tparam U Update interval in seconds (how often to generate a tick)
+ *
+ * Example usage:
+ * @code
+ * // 10,000 pressure sensors publishing once per second
+ * SimulatorBank<Event::SensorType::PressureSensor, 1> bank(event_bus, 10000);
+ * @endcode
+ *
+ * Thread Safety: stopSimulation() can be called from any thread while
+ * runSimulation() is executing. tick() must not be called concurrently.
+ */
+template<Event::SensorType T, uint8_t U>
+class SimulatorBank : public ISensorSimulator
+{
+public:
+    /**
+     * @brief Constructs a bank of sensors of type T
+     * @param event_bus Reference to the EventBus where readings will be published
+     * @param sensor_count Number of sensors simulated by this bank
+     * @param rand_gen Stream from which the per-sensor streams are derived;
+     *                 taken from Util::RandomStreams::global() by default
+     *
+     * Sensor i gets the device number i (interned as "<Type>_i") and the stream obtained
+     * by jumping a Util::Xoshiro128 seeded from rand_gen i times.
+     */
+    SimulatorBank(EventBus& event_bus, std::size_t sensor_count,
+                  Util::Xoshiro256 rand_gen = Util::RandomStreams::global().next())
+        : event_bus_(event_bus),
+        stop_requested_(false)
+    {
+        device_ids_.reserve(sensor_count);
+        base_values_.assign(sensor_count, kTraits.base_value);
+        ranges_.assign(sensor_count, kTraits.range);
+        for (auto& words : rng_states_) {
+            words.resize(sensor_count);
+        }
+        values_.assign(sensor_count, kFaultValue);
+
+        Util::Xoshiro128 lane(rand_gen.next());
+        for (std::size_t i = 0; i < sensor_count; ++i) {
+            device_ids_.emplace_back(Event::internDeviceId(T, static_cast<uint32_t>(i)));
+            for (int word = 0; word < 4; ++word) {
+                rng_states_[word][i] = lane.state(word);
+            }
+            lane.jump();
+        }
+    }
+
+    /**
+     * @brief Constructs a bank whose streams derive from a plain seed
+     * @param event_bus Reference to the EventBus where readings will be published
+     * @param sensor_count Number of sensors simulated by this bank
+     * @param seed Seed for the per-sensor streams (same seed, same readings)
+     */
+    SimulatorBank(EventBus& event_bus, std::size_t sensor_count, uint64_t seed)
+        : SimulatorBank(event_bus, sensor_count, Util::Xoshiro256(seed)) {}
+
+    /**
+     * @brief Default destructor
+     */
+    ~SimulatorBank() override = default;
+
+    /**
+     * @brief Number of sensors simulated by this bank
+     */
+    std::size_t sensorCount() const {
+        return values_.size();
+    }
+
+    /**
+     * @brief Readings produced by the most recent tick, indexed by sensor
+     */
+    const std::vector<double>& readings() const {
+        return values_;
+    }
+
+    /**
+     * @brief Interned device ids of the simulated sensors, indexed by sensor
+     */
+    const std::vector<uint32_t>& deviceIds() const {
+        return device_ids_;
+    }
+
+    /**
+     * @brief Generates one reading for every sensor without publishing
+     *
+     * Each sensor draws two xoshiro128++ values from its own state: the first
+     * decides the fault, the second picks the value within the range.
+     * The loop body has no data-dependent branches and only touches the
+     * i-th element of each array.
+     */
+    void generate()
+    {
+        const std::size_t count = values_.size();
+        uint32_t* s0 = rng_states_[0].data();
+        uint32_t* s1 = rng_states_[1].data();
+        uint32_t* s2 = rng_states_[2].data();
+        uint32_t* s3 = rng_states_[3].data();
+        const double* bases = base_values_.data();
+        const uint32_t* ranges = ranges_.data();
+        double* values = values_.data();
+
+        for (std::size_t i = 0; i < count; ++i) {
+            uint32_t w0 = s0[i];
+            uint32_t w1 = s1[i];
+            uint32_t w2 = s2[i];
+            uint32_t w3 = s3[i];
+            const uint32_t fault_draw = Util::Xoshiro128::step(w0, w1, w2, w3);
+            const uint32_t x = Util::Xoshiro128::step(w0, w1, w2, w3);
+            s0[i] = w0;
+            s1[i] = w1;
+            s2[i] = w2;
+            s3[i] = w3;
+
+            const uint32_t offset = static_cast<uint32_t>(
+                (static_cast<uint64_t>(x) * static_cast<uint64_t>(ranges[i])) >> 32);
+            const double reading = bases[i] + static_cast<double>(offset);
+            values[i] = (fault_draw < kFaultThreshold) ? kFaultValue : reading;
+        }
+    }
+
+    /**
+     * @brief Generates one reading per sensor and publishes them as a batch
+     *
+     * All readings of a tick share one timestamp and carry the tick count
+     * as their sequence number.
+     */
+    void tick()
+    {
+        generate();
+
+        Event::SensorRecord record{};
+        record.timestamp_ns = Util::Clock::nowNs();
+        record.sequence = sequence_++;
+        record.type = T;
+
+        std::vector<std::unique_ptr<Event::Event>> batch;
+        batch.reserve(values_.size());
+        for (std::size_t i = 0; i < values_.size(); ++i) {
+            record.device_id = device_ids_[i];
+            record.value = values_[i];
+            record.flags = (values_[i] == kFaultValue) ? Event::SensorRecord::kFaultFlag : 0;
+            batch.emplace_back(std::make_unique<Event::SensorEvent>(record));
+        }
+        event_bus_.publishBatch(std::move(batch));
+    }
+
+    /**
+     * @brief Runs the bank simulation loop
+     *
+     * Calls tick() every U seconds until stopSimulation() is called.
+     *
+     * Thread Safety: Safe to call stopSimulation() from another thread
+     */
+    void runSimulation() override
+    {
+        while(!stop_requested_.load(std::memory_order_acquire))
+        {
+            tick();
+            std::this_thread::sleep_for(std::chrono::seconds(U));
+        }
+    }
+
+    /**
+     * @brief Signals the simulation to stop
+     *
+     * Thread Safety: Can be called from any thread concurrently with runSimulation()
+     */
+    void stopSimulation() override
+    {
+        stop_requested_.store(true, std::memory_order_release);
+    }
+
+private:
+    static constexpr const Event::SensorTraits& kTraits = Event::sensorTraits<T>(); ///< Compile-time type traits
+    static constexpr double kFaultValue = 0.0;  ///< Value indicating sensor fault
+    static constexpr uint64_t kFaultOneIn = kTraits.fault_one_in; ///< Fault probability denominator
+    /// Draws below this threshold are faults; matches one_in(kFaultOneIn) for non-power-of-two bounds
+    static constexpr uint32_t kFaultThreshold =
+        static_cast<uint32_t>(((1ull << 32) + kFaultOneIn - 1) / kFaultOneIn);
+    static_assert(kFaultOneIn > 1, "SimulatorBank needs fault_one_in > 1");
+
+    EventBus& event_bus_;               ///< Reference to the event publishing system
+    std::atomic<bool> stop_requested_;  ///< Flag to signal simulation stop
+
+    uint64_t sequence_{0};                 ///< Number of ticks published so far
+
+    std::vector<uint32_t> device_ids_;     ///< Interned device id per sensor
+    std::vector<double> base_values_;      ///< Base value per sensor
+    std::vector<uint32_t> ranges_;         ///< Variation range per sensor
+    std::vector<uint32_t> rng_states_[4];  ///< xoshiro128++ state words, one array per word
+    std::vector<double> values_;           ///< Latest reading per sensor
+};
+
+} // namespace SensorSimulator
+
+#endif // SENSOR_SIMULATOR_SIMULATOR_BANK_H
@@ -0,0 +1,268 @@
+#ifndef STORAGE_ASYNC_FILE_WRITER_H
+#define STORAGE_ASYNC_FILE_WRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Event/SensorType.h"
+
+namespace Storage
+{
+
+/**
+ * @class AsyncFileWriter
+ * @brief Appends to a file without waiting for the disk
+ *
+ * append() copies bytes into the current buffer of a fixed set of
+ * Options::buffer_count buffers and returns. A full buffer is handed to
+ * the kernel as one write at its file offset while the next one fills, so
+ * a sink calling append() from an EventBus handler pays a memcpy per
+ * record instead of a write() system call, and never waits for the disk
+ * unless every buffer is in flight. The buffer count therefore bounds both
+ * the writes outstanding and the memory used.
+ *
+ * Two backends issue the writes:
+ * - IoUring: a ring set up with raw io_uring system calls, with the
+ *   buffers registered once so writes skip per-call page pinning
+ *   (IORING_OP_WRITE_FIXED). Completions are reaped by the appending
+ *   thread, so no extra thread runs.
+ * - ThreadPool: Options::threads threads calling pwrite(), for kernels or
+ *   sandboxes without io_uring.
+ * Backend::Auto tries io_uring and falls back to the thread pool.
+ *
+ * A failed write is reported by the next append(), flush() or close();
+ * the file is then incomplete and the writer accepts no more data.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class AsyncFileWriter
+{
+public:
+    /**
+     * @enum Backend
+     * @brief How writes are issued
+     */
+    enum class Backend : uint8_t
+    {
+        Auto,         ///< io_uring if available, else ThreadPool
+        IoUring,      ///< io_uring with registered buffers
+        ThreadPool    ///< pwrite() on worker threads
+    };
+
+    /**
+     * @struct Options
+     * @brief Buffer sizes and backend selection
+     */
+    struct Options
+    {
+        std::size_t buffer_size{1u << 20};    ///< Bytes per buffer, and per write
+        std::size_t buffer_count{4};          ///< Buffers; one fills while the others are written (at least 2)
+        Backend backend{Backend::Auto};       ///< Requested backend
+        std::size_t threads{2};               ///< Worker threads of the ThreadPool backend
+        bool truncate{false};                 ///< Discard existing contents instead of appending
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters of the writer
+     */
+    struct Stats
+    {
+        uint64_t appended{0};   ///< Bytes passed to append()
+        uint64_t written{0};    ///< Bytes the kernel has written
+        uint64_t writes{0};     ///< Writes issued, resubmitted short writes included
+        uint64_t stalls{0};     ///< Times append() waited for a buffer
+    };
+
+    /**
+     * @brief Constructs a closed writer
+     */
+    AsyncFileWriter();
+
+    /**
+     * @brief Closes the writer, writing out buffered data
+     */
+    ~AsyncFileWriter();
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    /**
+     * @brief Opens (creating if needed) a file for appending
+     * @param path File to write; existing contents are kept unless Options::truncate
+     * @param options Buffer sizes and backend selection
+     * @return ERROR if already open, the file cannot be opened, or the
+     *         requested IoUring backend is unavailable
+     */
+    Event::Status open(const std::string& path, Options options);
+
+    /**
+     * @brief Opens a file with default options
+     * @param path File to write
+     * @return ERROR if already open or the file cannot be opened
+     */
+    Event::Status open(const std::string& path) {
+        return open(path, Options());
+    }
+
+    /**
+     * @brief Copies bytes to the end of the file's buffered contents
+     * @param data Bytes to append
+     * @param size Number of bytes
+     * @return ERROR if the writer is closed or an earlier write failed
+     *
+     * Blocks only while every buffer is being written.
+     */
+    Event::Status append(const void* data, std::size_t size);
+
+    /**
+     * @brief Writes out the partly filled buffer and waits for every write
+     * @return ERROR if the writer is closed or a write failed
+     */
+    Event::Status flush();
+
+    /**
+     * @brief Flushes, then makes the contents durable with fdatasync()
+     * @return ERROR if the writer is closed, a write failed or the sync failed
+     */
+    Event::Status sync();
+
+    /**
+     * @brief Flushes and closes the file
+     * @return ERROR if a write failed; OK on a closed writer
+     *
+     * Does not sync; call sync() first when the data must survive a crash.
+     */
+    Event::Status close();
+
+    /**
+     * @brief Whether open() succeeded and close() has not been called
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Gets the backend in use
+     * @return IoUring or ThreadPool while open; Auto when closed
+     */
+    Backend backend() const;
+
+    /**
+     * @brief Gets the file size including bytes not yet written
+     */
+    uint64_t size() const;
+
+    /**
+     * @brief Gets the counters of the writer
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Whether this kernel lets the process use io_uring
+     */
+    static bool ioUringAvailable();
+
+private:
+    class Ring;
+
+    /**
+     * @struct Buffer
+     * @brief One of the write buffers and the write it is part of
+     */
+    struct Buffer
+    {
+        uint8_t* data{nullptr};    ///< Registered storage of Options::buffer_size bytes
+        std::size_t size{0};       ///< Bytes filled
+        std::size_t done{0};       ///< Bytes written so far
+        uint64_t offset{0};        ///< File offset of data[0]
+    };
+
+    /**
+     * @brief Writes out the partly filled buffer and waits for every write; caller holds mutex_ through lock
+     * @param lock Lock on mutex_
+     * @return ERROR if the writer is closed or a write failed
+     */
+    Event::Status flushLocked(std::unique_lock<std::mutex>& lock);
+
+    /**
+     * @brief Hands the current buffer to the backend; caller holds mutex_
+     */
+    void submitCurrent();
+
+    /**
+     * @brief Issues the write of a buffer's unwritten bytes; caller holds mutex_
+     * @param index Buffer index
+     */
+    void issueWrite(std::size_t index);
+
+    /**
+     * @brief Records a finished write; caller holds mutex_
+     * @param index Buffer index
+     * @param result Bytes written, or a negated errno
+     *
+     * Resubmits the rest of a short write; otherwise returns the buffer.
+     */
+    void completeWrite(std::size_t index, long result);
+
+    /**
+     * @brief Waits until at least one write completes; caller holds mutex_ through lock
+     * @param lock Lock on mutex_, released while the ThreadPool backend waits
+     */
+    void waitForCompletion(std::unique_lock<std::mutex>& lock);
+
+    /**
+     * @brief Reaps io_uring completions; caller holds mutex_
+     * @param wait Whether to block until at least one is available
+     */
+    void reapRing(bool wait);
+
+    /**
+     * @brief ThreadPool worker: pwrite()s queued buffers
+     */
+    void workerLoop();
+
+    /**
+     * @brief Flushes, stops the backend and closes the file; caller holds mutex_ through lock
+     * @param lock Lock on mutex_
+     * @return ERROR if a write failed
+     */
+    Event::Status closeLocked(std::unique_lock<std::mutex>& lock);
+
+    /**
+     * @brief Frees buffer storage
+     */
+    struct FreeStorage
+    {
+        void operator()(uint8_t* storage) const;
+    };
+
+    Options options_;                                  ///< Settings given to open()
+    std::mutex caller_mutex_;                          ///< Serializes open/append/flush/sync/close; taken before mutex_
+    mutable std::mutex mutex_;                         ///< Protects all state below
+    std::condition_variable completed_;                ///< A ThreadPool write finished
+    std::condition_variable queued_;                   ///< A ThreadPool write was queued, or stop
+    int fd_{-1};                                       ///< Open file, -1 when closed
+    Backend backend_{Backend::Auto};                   ///< Backend in use
+    std::unique_ptr<Ring> ring_;                       ///< io_uring state of the IoUring backend
+    std::vector<std::thread> workers_;                 ///< Threads of the ThreadPool backend
+    std::deque<std::size_t> write_queue_;              ///< Buffers waiting for a worker
+    bool stop_workers_{false};                         ///< Asks the workers to exit
+    std::unique_ptr<uint8_t[], FreeStorage> storage_;  ///< All buffers, page aligned
+    std::vector<Buffer> buffers_;                      ///< Buffer slots
+    std::vector<std::size_t> free_;                    ///< Indexes of idle buffers
+    std::size_t current_{SIZE_MAX};                    ///< Buffer being filled, SIZE_MAX if none
+    std::size_t in_flight_{0};                         ///< Buffers being written
+    uint64_t next_offset_{0};                          ///< File offset after the buffered data
+    int error_{0};                                     ///< errno of the first failed write
+    Stats stats_;                                      ///< Counters
+};
+
+} // namespace Storage
+
+#endif // STORAGE_ASYNC_FILE_WRITER_H
@@ -0,0 +1,143 @@
+#ifndef STORAGE_BIT_STREAM_H
+#define STORAGE_BIT_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Storage
+{
+
+/**
+ * @class BitWriter
+ * @brief Appends bit fields, most significant bit first, to a byte vector
+ *
+ * Bits are gathered in a 64-bit accumulator and spilled a byte at a time;
+ * finish() pads the last byte with zero bits.
+ */
+class BitWriter
+{
+public:
+    /**
+     * @brief Constructs a writer appending to out
+     * @param out Destination; existing contents are kept
+     */
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    /**
+     * @brief Appends the low bits of a value
+     * @param value Bits to write (higher bits are ignored)
+     * @param bits Number of bits, 0..64
+     */
+    void write(uint64_t value, unsigned bits)
+    {
+        if (bits > 32) {
+            write(value >> 32, bits - 32);
+            bits = 32;
+        }
+        if (bits == 0) {
+            return;
+        }
+        accumulator_ = (accumulator_ << bits) | (value & ((uint64_t{1} << bits) - 1));
+        pending_ += bits;
+        while (pending_ >= 8) {
+            pending_ -= 8;
+            out_.push_back(static_cast<uint8_t>(accumulator_ >> pending_));
+        }
+    }
+
+    /**
+     * @brief Appends a single bit
+     * @param bit Bit value
+     */
+    void writeBit(bool bit)
+    {
+        write(bit ? 1 : 0, 1);
+    }
+
+    /**
+     * @brief Flushes the last partial byte, zero padded
+     */
+    void finish()
+    {
+        if (pending_ > 0) {
+            out_.push_back(static_cast<uint8_t>(accumulator_ << (8 - pending_)));
+            pending_ = 0;
+        }
+        accumulator_ = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out_;    ///< Destination bytes
+    uint64_t accumulator_{0};      ///< Bits not yet spilled (low pending_ bits)
+    unsigned pending_{0};          ///< Number of bits in accumulator_, below 8 between calls
+};
+
+/**
+ * @class BitReader
+ * @brief Reads bit fields written by BitWriter
+ *
+ * Reading past the end yields zero bits and sets overrun(), so corrupt
+ * input cannot read out of bounds.
+ */
+class BitReader
+{
+public:
+    /**
+     * @brief Constructs a reader over a byte range
+     * @param data First byte
+     * @param size Number of bytes
+     */
+    BitReader(const uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+
+    /**
+     * @brief Reads a bit field
+     * @param bits Number of bits, 0..64
+     * @return The bits, right aligned
+     */
+    uint64_t read(unsigned bits)
+    {
+        uint64_t value = 0;
+        while (bits > 0) {
+            if (position_ >= size_ * 8) {
+                overrun_ = true;
+                return value << bits;
+            }
+            const unsigned offset = static_cast<unsigned>(position_ & 7);
+            const unsigned available = 8 - offset;
+            const unsigned take = bits < available ? bits : available;
+            const uint8_t byte = data_[position_ >> 3];
+            const uint64_t chunk = (byte >> (available - take)) & ((1u << take) - 1);
+            value = (value << take) | chunk;
+            position_ += take;
+            bits -= take;
+        }
+        return value;
+    }
+
+    /**
+     * @brief Reads a single bit
+     */
+    bool readBit()
+    {
+        return read(1) != 0;
+    }
+
+    /**
+     * @brief Whether a read went past the end of the data
+     */
+    bool overrun() const
+    {
+        return overrun_;
+    }
+
+private:
+    const uint8_t* data_;       ///< First byte
+    std::size_t size_;          ///< Number of bytes
+    std::size_t position_{0};   ///< Next bit to read
+    bool overrun_{false};       ///< Set when reading past the end
+};
+
+} // namespace Storage
+
+#endif // STORAGE_BIT_STREAM_H
@@ -0,0 +1,183 @@
+#ifndef STORAGE_COLUMNAR_FORMAT_H
+#define STORAGE_COLUMNAR_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Event/SensorType.h"
+
+namespace Storage
+{
+
+/**
+ * @namespace Storage::ColumnarFormat
+ * @brief On-disk layout and column codecs shared by ColumnarSink and ColumnarReader
+ *
+ * A columnar file ("columns-<number>.col") starts with a FileHeader and
+ * holds blocks of up to a few thousand readings of one device. Each block
+ * stores its readings as four byte-aligned columns, back to back:
+ * - wall-clock timestamps, delta-of-delta encoded (encodeDeltaOfDelta())
+ * - values, XOR encoded as in Facebook's Gorilla (encodeValues())
+ * - device sequence numbers, delta-of-delta encoded
+ * - flags, as a sparse list of (row, flags) pairs (encodeFlags())
+ *
+ * The footer follows the last block: the device dictionary (u16 name
+ * length + name bytes per entry), one BlockInfo per block, and a Trailer
+ * at the very end that locates both. BlockInfo carries the time and value
+ * range of its block, so readers can skip blocks without decoding them.
+ *
+ * All integers are little-endian (host order on supported targets).
+ */
+namespace ColumnarFormat
+{
+
+constexpr char kFileMagic[8] = {'E', 'V', 'C', 'O', 'L', '0', '0', '1'};     ///< FileHeader::magic
+constexpr char kTrailerMagic[8] = {'E', 'V', 'C', 'E', 'N', 'D', '0', '1'};  ///< Trailer::magic
+constexpr uint32_t kVersion = 1;   ///< Layout version
+
+/**
+ * @struct FileHeader
+ * @brief First 32 bytes of a columnar file
+ */
+struct FileHeader
+{
+    char magic[8];          ///< kFileMagic
+    uint32_t version;       ///< kVersion
+    uint32_t header_size;   ///< sizeof(FileHeader)
+    uint64_t reserved[2];   ///< Zero
+};
+
+/**
+ * @struct BlockInfo
+ * @brief Index entry of one block: where its columns are and what they hold
+ */
+struct BlockInfo
+{
+    uint64_t offset;              ///< File offset of the timestamp column
+    int64_t min_timestamp_ns;     ///< Earliest wall-clock timestamp in the block
+    int64_t max_timestamp_ns;     ///< Latest wall-clock timestamp in the block
+    double min_value;             ///< Smallest value (NaN values are ignored)
+    double max_value;             ///< Largest value (NaN values are ignored)
+    uint32_t device;              ///< Position of the device name in the file dictionary
+    uint32_t rows;                ///< Number of readings
+    uint32_t timestamp_bytes;     ///< Size of the timestamp column
+    uint32_t value_bytes;         ///< Size of the value column
+    uint32_t sequence_bytes;      ///< Size of the device sequence column
+    uint32_t flag_bytes;          ///< Size of the flags column
+    uint32_t fault_rows;          ///< Readings with SensorRecord::kFaultFlag set
+    uint32_t reserved;            ///< Zero
+    Event::SensorType type;       ///< Sensor type of every reading in the block
+    uint8_t padding[7];           ///< Zero
+};
+
+/**
+ * @struct Trailer
+ * @brief Last 40 bytes of a finished file
+ */
+struct Trailer
+{
+    uint64_t dictionary_offset;   ///< File offset of the device dictionary
+    uint64_t index_offset;        ///< File offset of the first BlockInfo
+    uint32_t device_count;        ///< Number of dictionary entries
+    uint32_t block_count;         ///< Number of BlockInfo entries
+    uint32_t checksum;            ///< FNV-1a of the dictionary and index bytes
+    uint32_t version;             ///< kVersion
+    char magic[8];                ///< kTrailerMagic
+};
+
+static_assert(sizeof(FileHeader) == 32, "FileHeader is expected to be 32 bytes");
+static_assert(sizeof(BlockInfo) == 80, "BlockInfo is expected to be 80 bytes");
+static_assert(sizeof(Trailer) == 40, "Trailer is expected to be 40 bytes");
+static_assert(std::is_trivially_copyable<BlockInfo>::value, "BlockInfo is copied with memcpy");
+
+/**
+ * @brief Gets the file name of a finished columnar file
+ * @param number Position of the file in its directory
+ * @param extension ".col" for a finished file, ".part" while it is written
+ * @return Name with the number zero-padded so names sort numerically
+ */
+inline std::string fileName(uint64_t number, const char* extension)
+{
+    char name[48];
+    std::snprintf(name, sizeof(name), "columns-%020llu%s", static_cast<unsigned long long>(number), extension);
+    return name;
+}
+
+/**
+ * @brief Appends a delta-of-delta encoded integer column
+ * @param values Integers to encode
+ * @param count Number of values
+ * @param out Receives the column bytes
+ *
+ * The first value is stored in 64 bits. Every later value is stored as
+ * the change of its delta against the previous delta, zigzag encoded and
+ * prefixed by its size class: '0' (unchanged delta), '10' + 7 bits,
+ * '110' + 14 bits, '1110' + 24 bits, '11110' + 36 bits, '11111' + 64 bits.
+ * A series at a fixed interval costs one bit per value.
+ */
+void encodeDeltaOfDelta(const int64_t* values, std::size_t count, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decodes a column written by encodeDeltaOfDelta()
+ * @param data Column bytes
+ * @param size Column size
+ * @param count Number of values in the column
+ * @param values Receives the values (replaced)
+ * @return false if the column is shorter than count values need
+ */
+bool decodeDeltaOfDelta(const uint8_t* data, std::size_t size, std::size_t count, std::vector<int64_t>& values);
+
+/**
+ * @brief Appends a Gorilla XOR encoded value column
+ * @param values Values to encode
+ * @param count Number of values
+ * @param out Receives the column bytes
+ *
+ * The first value is stored in 64 bits. Every later value is XORed with
+ * its predecessor: '0' if equal, '10' + the meaningful bits if they fit
+ * the previous leading/trailing zero window, otherwise '11' + 5 bits of
+ * leading zeros + 6 bits of length + the meaningful bits. Repeated and
+ * slowly changing readings cost a few bits each.
+ */
+void encodeValues(const double* values, std::size_t count, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decodes a column written by encodeValues()
+ * @param data Column bytes
+ * @param size Column size
+ * @param count Number of values in the column
+ * @param values Receives the values (replaced)
+ * @return false if the column is shorter than count values need
+ */
+bool decodeValues(const uint8_t* data, std::size_t size, std::size_t count, std::vector<double>& values);
+
+/**
+ * @brief Appends a sparse flags column
+ * @param flags One flags byte per row
+ * @param count Number of rows
+ * @param out Receives the column bytes
+ *
+ * Stores only rows with non-zero flags, as LEB128 varints: the number of
+ * such rows, then (row gap, flags) per row. Empty when no row has flags.
+ */
+void encodeFlags(const uint8_t* flags, std::size_t count, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decodes a column written by encodeFlags()
+ * @param data Column bytes
+ * @param size Column size
+ * @param count Number of rows
+ * @param flags Receives one flags byte per row (replaced)
+ * @return false if the column is malformed
+ */
+bool decodeFlags(const uint8_t* data, std::size_t size, std::size_t count, std::vector<uint8_t>& flags);
+
+} // namespace ColumnarFormat
+
+} // namespace Storage
+
+#endif // STORAGE_COLUMNAR_FORMAT_H
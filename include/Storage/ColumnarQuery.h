@@ -0,0 +1,184 @@
+#ifndef STORAGE_COLUMNAR_QUERY_H
+#define STORAGE_COLUMNAR_QUERY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Event/SensorRecord.h"
+#include "Event/SensorType.h"
+#include "EventBus/Executor.h"
+#include "Storage/ColumnarReader.h"
+
+namespace Storage
+{
+
+/**
+ * @class ColumnarQuery
+ * @brief Time-range queries over the files of a ColumnarSink directory
+ *
+ * Answers "the readings of device X between t1 and t2" (select()) and
+ * "count/min/max/sum per interval" (aggregate()) without loading the
+ * store into memory:
+ * - Blocks whose device, type, time range or value range cannot match
+ *   the Filter are skipped using the block index alone.
+ * - Only the columns a query needs are decoded: aggregate() reads
+ *   timestamps and values, plus flags only for blocks holding faults, and
+ *   skips timestamps of blocks that lie inside a single bucket.
+ * - The remaining blocks are independent and are decoded in parallel on
+ *   an Executor; results are merged afterwards.
+ *
+ * Files are discovered by refresh(); files finished by the sink later are
+ * not seen until the next refresh().
+ *
+ * Thread Safety: All methods are thread-safe; queries may run concurrently.
+ */
+class ColumnarQuery
+{
+public:
+    /**
+     * @struct Filter
+     * @brief Which readings a query considers
+     *
+     * Times are wall-clock nanoseconds since the Unix epoch, the range is
+     * [from_ns, to_ns). NaN values never match.
+     */
+    struct Filter
+    {
+        std::string device;                                            ///< Device name; empty matches every device
+        std::optional<Event::SensorType> type;                         ///< Sensor type; unset matches every type
+        int64_t from_ns{std::numeric_limits<int64_t>::min()};          ///< First timestamp included
+        int64_t to_ns{std::numeric_limits<int64_t>::max()};            ///< First timestamp excluded
+        double min_value{-std::numeric_limits<double>::infinity()};    ///< Smallest value included
+        double max_value{std::numeric_limits<double>::infinity()};     ///< Largest value included
+        bool include_faults{false};                                    ///< Whether fault readings match
+    };
+
+    /**
+     * @struct Bucket
+     * @brief Aggregate of the matching readings in one interval
+     */
+    struct Bucket
+    {
+        int64_t start_ns{0};   ///< Wall-clock start of the interval
+        uint64_t count{0};     ///< Matching readings
+        double min{0.0};       ///< Smallest value
+        double max{0.0};       ///< Largest value
+        double sum{0.0};       ///< Sum of the values
+
+        /**
+         * @brief Mean of the values
+         */
+        double mean() const {
+            return count == 0 ? 0.0 : sum / static_cast<double>(count);
+        }
+    };
+
+    /**
+     * @struct QueryStats
+     * @brief How much work a query did
+     */
+    struct QueryStats
+    {
+        uint64_t blocks{0};           ///< Blocks in the files
+        uint64_t blocks_scanned{0};   ///< Blocks that had to be decoded
+        uint64_t rows_decoded{0};     ///< Rows of the decoded blocks
+    };
+
+    /**
+     * @brief Constructs a query engine over a sink directory
+     * @param directory ColumnarSink directory
+     * @param executor Runs block scans; nullptr creates a ThreadPoolExecutor
+     *                 with one thread per hardware thread
+     *
+     * Call refresh() before the first query.
+     */
+    explicit ColumnarQuery(std::string directory, std::shared_ptr<Executor> executor = nullptr);
+
+    /**
+     * @brief Picks up the finished files of the directory
+     * @return ERROR if a file could not be opened (it is left out)
+     *
+     * Files already open are kept; queries running meanwhile see the old set.
+     */
+    Event::Status refresh();
+
+    /**
+     * @brief Number of files the queries run over
+     */
+    std::size_t fileCount() const;
+
+    /**
+     * @brief Gets the matching readings
+     * @param filter Readings to return
+     * @param stats If set, receives the work done
+     * @return Readings in timestamp order, with Util::Clock monotonic
+     *         timestamps and device ids interned in this process
+     */
+    std::vector<Event::SensorRecord> select(const Filter& filter, QueryStats* stats = nullptr) const;
+
+    /**
+     * @brief Aggregates the matching readings per interval
+     * @param filter Readings to aggregate
+     * @param bucket_ns Interval length (e.g. 60 s); buckets start at
+     *                  multiples of it since the Unix epoch
+     * @param stats If set, receives the work done
+     * @return Non-empty buckets in time order
+     */
+    std::vector<Bucket> aggregate(const Filter& filter, int64_t bucket_ns, QueryStats* stats = nullptr) const;
+
+private:
+    /**
+     * @struct File
+     * @brief One open file of the directory
+     */
+    struct File
+    {
+        std::string path;                          ///< File path
+        std::shared_ptr<ColumnarReader> reader;    ///< Reader over the file
+    };
+
+    /// Open files; replaced as a whole by refresh()
+    using FileList = std::vector<File>;
+
+    /**
+     * @struct Candidate
+     * @brief Block that survived index pruning
+     */
+    struct Candidate
+    {
+        const ColumnarReader* reader;              ///< File holding the block
+        const ColumnarFormat::BlockInfo* block;    ///< Index entry of the block
+    };
+
+    /**
+     * @brief Finds the blocks a filter may match
+     * @param files Files to search
+     * @param filter Query filter
+     * @param stats If set, receives the block counts
+     * @return Candidate blocks in file order
+     */
+    static std::vector<Candidate> prune(const FileList& files, const Filter& filter, QueryStats* stats);
+
+    /**
+     * @brief Runs one task per candidate and waits for all of them
+     * @param count Number of tasks
+     * @param task Called with each index in [0, count)
+     */
+    template <typename Task>
+    void parallelFor(std::size_t count, const Task& task) const;
+
+    std::string directory_;                     ///< Sink directory
+    std::shared_ptr<Executor> executor_;        ///< Runs block scans
+    mutable std::mutex mutex_;                  ///< Protects files_
+    std::shared_ptr<const FileList> files_;     ///< Current file set
+};
+
+} // namespace Storage
+
+#endif // STORAGE_COLUMNAR_QUERY_H
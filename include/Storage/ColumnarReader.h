@@ -0,0 +1,127 @@
+#ifndef STORAGE_COLUMNAR_READER_H
+#define STORAGE_COLUMNAR_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Event/SensorRecord.h"
+#include "Event/SensorType.h"
+#include "Storage/ColumnarFormat.h"
+
+namespace Storage
+{
+
+/**
+ * @class ColumnarReader
+ * @brief Reader of one finished ColumnarSink file
+ *
+ * Maps the file read-only and loads its block index and device dictionary.
+ * Each column of a block can be decoded on its own, so a query that only
+ * needs timestamps and values never touches the other columns; blocks()
+ * exposes the per-block time and value ranges for skipping whole blocks.
+ *
+ * Thread Safety: After open(), the const methods may be called from any
+ * number of threads at once.
+ */
+class ColumnarReader
+{
+public:
+    /**
+     * @brief Constructs a closed reader
+     */
+    ColumnarReader() = default;
+
+    /**
+     * @brief Unmaps the file
+     */
+    ~ColumnarReader();
+
+    ColumnarReader(const ColumnarReader&) = delete;
+    ColumnarReader& operator=(const ColumnarReader&) = delete;
+
+    /**
+     * @brief Maps a finished columnar file and loads its footer
+     * @param path File written by ColumnarSink (".col")
+     * @return ERROR if the file cannot be mapped or its footer is invalid
+     */
+    Event::Status open(const std::string& path);
+
+    /**
+     * @brief Unmaps the file
+     */
+    void close();
+
+    /**
+     * @brief Gets the finished files of a sink directory
+     * @param directory ColumnarSink directory
+     * @return Paths of the ".col" files, oldest first
+     */
+    static std::vector<std::string> listFiles(const std::string& directory);
+
+    /**
+     * @brief Gets the block index, in file order
+     */
+    const std::vector<ColumnarFormat::BlockInfo>& blocks() const {
+        return blocks_;
+    }
+
+    /**
+     * @brief Gets the name of the device a block belongs to
+     * @param block Entry of blocks()
+     */
+    std::string_view deviceName(const ColumnarFormat::BlockInfo& block) const;
+
+    /**
+     * @brief Decodes the timestamp column of a block
+     * @param block Entry of blocks()
+     * @param timestamps Receives wall-clock nanoseconds, one per row
+     * @return false if the column is corrupt
+     */
+    bool readTimestamps(const ColumnarFormat::BlockInfo& block, std::vector<int64_t>& timestamps) const;
+
+    /**
+     * @brief Decodes the value column of a block
+     * @param block Entry of blocks()
+     * @param values Receives one value per row
+     * @return false if the column is corrupt
+     */
+    bool readValues(const ColumnarFormat::BlockInfo& block, std::vector<double>& values) const;
+
+    /**
+     * @brief Decodes the device sequence column of a block
+     * @param block Entry of blocks()
+     * @param sequences Receives one SensorRecord::sequence per row
+     * @return false if the column is corrupt
+     */
+    bool readSequences(const ColumnarFormat::BlockInfo& block, std::vector<uint64_t>& sequences) const;
+
+    /**
+     * @brief Decodes the flags column of a block
+     * @param block Entry of blocks()
+     * @param flags Receives one SensorRecord::flags byte per row
+     * @return false if the column is corrupt
+     */
+    bool readFlags(const ColumnarFormat::BlockInfo& block, std::vector<uint8_t>& flags) const;
+
+    /**
+     * @brief Decodes every column of a block back into readings
+     * @param block Entry of blocks()
+     * @param records Receives the readings, with Util::Clock monotonic
+     *                timestamps and device ids interned in this process
+     * @return false if a column is corrupt
+     */
+    bool readRecords(const ColumnarFormat::BlockInfo& block, std::vector<Event::SensorRecord>& records) const;
+
+private:
+    const uint8_t* data_{nullptr};                   ///< Mapping of the file
+    std::size_t size_{0};                            ///< File size
+    std::vector<ColumnarFormat::BlockInfo> blocks_;  ///< Block index
+    std::vector<std::string> devices_;               ///< Device dictionary
+};
+
+} // namespace Storage
+
+#endif // STORAGE_COLUMNAR_READER_H
@@ -0,0 +1,210 @@
+#ifndef STORAGE_COLUMNAR_SINK_H
+#define STORAGE_COLUMNAR_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Event/SensorRecord.h"
+#include "Event/SensorType.h"
+#include "EventBus/EventBatch.h"
+#include "EventBus/EventBus.h"
+#include "Storage/AsyncFileWriter.h"
+#include "Storage/ColumnarFormat.h"
+
+namespace Storage
+{
+
+/**
+ * @class ColumnarSink
+ * @brief Compressed columnar store for sensor readings
+ *
+ * Buffers readings per device into column chunks and, once a chunk holds
+ * Options::rows_per_block readings, encodes it as one ColumnarFormat block:
+ * delta-of-delta timestamps, Gorilla XOR values, delta-of-delta device
+ * sequence numbers and sparse flags. Regularly sampled sensors shrink from
+ * 32-byte SensorRecord rows to a few bits per reading.
+ *
+ * Blocks are appended to "columns-<number>.part" in the sink directory.
+ * When the file reaches Options::max_file_size, or on close(), the device
+ * dictionary and block index are written and the file is renamed to
+ * ".col", so readers (see ColumnarReader) only ever see finished files.
+ * Readings still buffered when the process dies are lost, and so is an
+ * unfinished ".part" file.
+ *
+ * Blocks are appended through an AsyncFileWriter, so encoding a block
+ * does not wait for the disk; the file is synced only when it is finished.
+ *
+ * Attach the sink to an EventBus with attach(); give it its own executor
+ * (e.g. DedicatedExecutor) so encoding never runs on the dispatcher. The
+ * sink must outlive the bus's stop().
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class ColumnarSink
+{
+public:
+    /**
+     * @struct Options
+     * @brief Block and file sizes
+     */
+    struct Options
+    {
+        uint32_t rows_per_block{1024};         ///< Readings per device chunk before it is encoded
+        std::size_t max_file_size{64u << 20};  ///< File size at which the next block starts a new file
+        AsyncFileWriter::Options file;         ///< Write buffering of the current file
+    };
+
+    /**
+     * @struct Stats
+     * @brief What the sink has written so far
+     */
+    struct Stats
+    {
+        uint64_t rows{0};             ///< Readings encoded into blocks
+        uint64_t buffered_rows{0};    ///< Readings waiting in chunks
+        uint64_t blocks{0};           ///< Blocks written
+        uint64_t files{0};            ///< Files finished
+        uint64_t encoded_bytes{0};    ///< Column bytes written (excluding headers and footers)
+    };
+
+    /**
+     * @brief Constructs a closed sink
+     */
+    ColumnarSink() = default;
+
+    /**
+     * @brief Closes the sink, writing out every buffered reading
+     */
+    ~ColumnarSink();
+
+    ColumnarSink(const ColumnarSink&) = delete;
+    ColumnarSink& operator=(const ColumnarSink&) = delete;
+
+    /**
+     * @brief Opens (creating if needed) a sink directory
+     * @param directory Directory receiving the columnar files
+     * @param options Block and file sizes
+     * @return ERROR if already open or the directory cannot be created
+     *
+     * New files are numbered after the highest existing one, so a
+     * directory can be reused across runs.
+     */
+    Event::Status open(const std::string& directory, Options options);
+
+    /**
+     * @brief Opens a sink directory with default options
+     * @param directory Directory receiving the columnar files
+     * @return ERROR if already open or the directory cannot be created
+     */
+    Event::Status open(const std::string& directory) {
+        return open(directory, Options());
+    }
+
+    /**
+     * @brief Writes out every buffered reading and finishes the current file
+     * @return ERROR if a write failed
+     *
+     * No effect on a closed sink.
+     */
+    Event::Status close();
+
+    /**
+     * @brief Whether open() succeeded and close() has not been called
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Buffers one reading
+     * @param record Reading to store
+     * @return ERROR if the sink is closed or a full chunk could not be written
+     */
+    Event::Status append(const Event::SensorRecord& record);
+
+    /**
+     * @brief Buffers the sensor readings of a batch
+     * @param batch Events in publish order; non-sensor events are skipped
+     * @return Number of readings buffered
+     *
+     * Takes the sink lock once for the whole batch.
+     */
+    std::size_t append(const EventBatch& batch);
+
+    /**
+     * @brief Encodes every non-empty chunk as a (possibly short) block
+     * @return ERROR if a write failed
+     *
+     * The blocks become readable once their file is finished.
+     */
+    Event::Status flush();
+
+    /**
+     * @brief Subscribes the sink to every batch an EventBus dispatches
+     * @param event_bus Bus to record
+     * @param executor Where encoding runs; nullptr runs it on the dispatcher
+     * @return Id of the subscription
+     */
+    EventBus::SubscriptionId attach(EventBus& event_bus, std::shared_ptr<Executor> executor = nullptr);
+
+    /**
+     * @brief Gets the counters of what has been written
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * @struct Chunk
+     * @brief Buffered columns of one device
+     */
+    struct Chunk
+    {
+        uint32_t device_id{0};             ///< Interned device id
+        Event::SensorType type{};          ///< Sensor type
+        std::vector<int64_t> timestamps;   ///< Wall-clock nanoseconds
+        std::vector<double> values;        ///< Measured values
+        std::vector<int64_t> sequences;    ///< Device sequence numbers
+        std::vector<uint8_t> flags;        ///< SensorRecord::flags
+    };
+
+    /**
+     * @brief Buffers one reading; caller holds mutex_
+     * @param record Reading to store
+     * @return ERROR if a full chunk could not be written
+     */
+    Event::Status appendLocked(const Event::SensorRecord& record);
+
+    /**
+     * @brief Encodes a chunk as a block and empties it; caller holds mutex_
+     * @param chunk Chunk to write
+     * @return ERROR if the file cannot be created or written
+     */
+    Event::Status writeBlock(Chunk& chunk);
+
+    /**
+     * @brief Writes the footer and renames the current file to .col; caller holds mutex_
+     * @return ERROR if the footer cannot be written
+     */
+    Event::Status finishFile();
+
+    std::string directory_;                                ///< Sink directory
+    Options options_;                                      ///< Settings given to open()
+    mutable std::mutex mutex_;                             ///< Protects all state below
+    std::unordered_map<uint64_t, Chunk> chunks_;           ///< Chunks by (device id, type)
+    AsyncFileWriter file_;                                 ///< Current .part file, closed if none
+    uint64_t file_number_{0};                              ///< Number of the current or next file
+    uint64_t file_size_{0};                                ///< Bytes written to the current file
+    std::vector<ColumnarFormat::BlockInfo> index_;         ///< Blocks of the current file
+    std::vector<std::string> dictionary_;                  ///< Device names of the current file
+    std::unordered_map<uint32_t, uint32_t> dictionary_ids_; ///< Device id to dictionary position
+    std::vector<uint8_t> buffer_;                          ///< Encoding scratch space
+    Stats stats_;                                          ///< Counters
+    bool open_{false};                                     ///< Whether the sink is open
+};
+
+} // namespace Storage
+
+#endif // STORAGE_COLUMNAR_SINK_H
@@ -0,0 +1,217 @@
+#ifndef STORAGE_EVENT_JOURNAL_H
+#define STORAGE_EVENT_JOURNAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Event/SensorRecord.h"
+#include "Event/SensorType.h"
+#include "EventBus/EventBatch.h"
+#include "Storage/JournalFormat.h"
+
+namespace Storage
+{
+
+/**
+ * @class EventJournal
+ * @brief Append-only, segmented, memory-mapped log of sensor readings
+ *
+ * Every appended reading gets the next sequence number and is encoded as a
+ * JournalFormat frame straight into a memory-mapped segment file, so the
+ * append path is a memcpy with no system call. Segments are preallocated
+ * to Options::segment_size; when one is full the journal rolls to a new
+ * file named after its first sequence number.
+ *
+ * Durability is group-committed: a background flusher msyncs everything
+ * appended since its last pass, either every Options::sync_interval or as
+ * soon as Options::sync_bytes are pending, and sync() waits for such a
+ * pass. Sealed segments get a sparse index (.idx) written next to them so
+ * JournalReader can seek by sequence number.
+ *
+ * open() recovers an existing directory: the tail segment is scanned, a
+ * torn last frame is cut off and numbering continues after the last valid
+ * reading. A directory holding segments that cannot be read (e.g. written
+ * by an older format version) is refused rather than overwritten. Attach
+ * a journal to an EventBus with EventBus::setJournal() to record every
+ * published event.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class EventJournal
+{
+public:
+    /**
+     * @struct Options
+     * @brief Segment size, index density and group-commit limits
+     */
+    struct Options
+    {
+        std::size_t segment_size{64u << 20};            ///< Bytes per segment file (at least 4 KiB)
+        uint32_t index_interval{1024};                  ///< Readings between sparse index entries
+        std::chrono::milliseconds sync_interval{10};    ///< Longest time appended data stays unsynced
+        std::size_t sync_bytes{1u << 20};               ///< Pending bytes that trigger an early sync
+    };
+
+    /**
+     * @brief Constructs a closed journal
+     */
+    EventJournal() = default;
+
+    /**
+     * @brief Closes the journal, syncing and sealing the current segment
+     */
+    ~EventJournal();
+
+    EventJournal(const EventJournal&) = delete;
+    EventJournal& operator=(const EventJournal&) = delete;
+
+    /**
+     * @brief Opens (creating or recovering) a journal directory
+     * @param directory Directory holding the segment files
+     * @param options Segment and sync settings
+     * @return ERROR if already open, the directory cannot be used, or it
+     *         holds segments this version cannot read
+     */
+    Event::Status open(const std::string& directory, Options options);
+
+    /**
+     * @brief Opens a journal directory with default options
+     * @param directory Directory holding the segment files
+     * @return ERROR if already open or the directory cannot be used
+     */
+    Event::Status open(const std::string& directory) {
+        return open(directory, Options());
+    }
+
+    /**
+     * @brief Syncs and seals the current segment and stops the flusher
+     *
+     * No effect on a closed journal.
+     */
+    void close();
+
+    /**
+     * @brief Whether open() succeeded and close() has not been called
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Appends one reading
+     * @param record Reading to journal; the timestamp is stored as wall time
+     * @return Sequence number assigned, or kNoSequence if the journal is
+     *         closed or a new segment cannot be created
+     */
+    uint64_t append(const Event::SensorRecord& record);
+
+    /**
+     * @brief Appends the sensor readings of a batch
+     * @param batch Events in publish order; non-sensor events are skipped
+     * @return Number of readings appended
+     *
+     * Takes the journal lock once for the whole batch.
+     */
+    std::size_t append(const EventBatch& batch);
+
+    /**
+     * @brief Blocks until every reading appended so far is on disk
+     */
+    void sync();
+
+    /**
+     * @brief Sequence number the next reading will get
+     */
+    uint64_t nextSequence() const;
+
+    /**
+     * @brief Readings with a lower sequence number are known to be on disk
+     */
+    uint64_t durableSequence() const;
+
+    static constexpr uint64_t kNoSequence = UINT64_MAX;    ///< Returned by a failed append()
+    static constexpr std::size_t kMinSegmentSize = 4096;   ///< Smallest accepted segment size
+    static constexpr std::size_t kMaxDeviceNameSize = 255; ///< Longer device names are truncated
+
+private:
+    /**
+     * @struct Segment
+     * @brief One mapped segment file
+     */
+    struct Segment
+    {
+        std::string path;                  ///< Segment file path
+        int fd{-1};                        ///< Open file descriptor
+        char* data{nullptr};               ///< Mapping of the whole file
+        std::size_t capacity{0};           ///< Mapped (and preallocated) size
+        JournalFormat::SegmentInfo info;   ///< Sequence range, write offset, index and devices
+        std::vector<bool> known_devices;   ///< Device ids already declared in this segment
+
+        ~Segment();
+    };
+
+    /**
+     * @brief Creates and maps a new segment; caller holds mutex_
+     * @param first_sequence Sequence number of its first reading
+     * @return ERROR if the file cannot be created or mapped
+     */
+    Event::Status openSegment(uint64_t first_sequence);
+
+    /**
+     * @brief Recovers the segments found in directory_
+     * @param next_sequence Receives the sequence number after the last valid reading
+     * @return ERROR if a segment cannot be read
+     */
+    Event::Status recover(uint64_t& next_sequence);
+
+    /**
+     * @brief Encodes one reading into the current segment; caller holds mutex_
+     * @param record Reading to journal
+     * @return Sequence number, or kNoSequence on failure
+     */
+    uint64_t appendLocked(const Event::SensorRecord& record);
+
+    /**
+     * @brief Copies a frame into the current segment; caller holds mutex_
+     * @param kind Frame kind
+     * @param payload Payload bytes
+     * @param size Payload size
+     */
+    void writeFrame(JournalFormat::FrameKind kind, const void* payload, std::size_t size);
+
+    /**
+     * @brief Syncs a segment that receives no more appends and writes its index
+     * @param segment Segment to seal; unmapped and closed afterwards
+     * @param directory Journal directory
+     */
+    static void seal(Segment& segment, const std::string& directory);
+
+    /**
+     * @brief Background group-commit loop
+     */
+    void flushLoop();
+
+    std::string directory_;                            ///< Journal directory
+    Options options_;                                  ///< Settings given to open()
+    mutable std::mutex mutex_;                         ///< Protects all state below
+    std::condition_variable flush_cv_;                 ///< Wakes the flusher
+    std::condition_variable synced_cv_;                ///< Signalled after each flush pass
+    std::thread flusher_;                              ///< Runs flushLoop()
+    std::shared_ptr<Segment> current_;                 ///< Segment receiving appends
+    std::vector<std::shared_ptr<Segment>> retired_;    ///< Full segments waiting to be sealed
+    std::size_t synced_offset_{0};                     ///< Bytes of current_ already synced
+    uint64_t next_sequence_{0};                        ///< Sequence of the next reading
+    uint64_t durable_sequence_{0};                     ///< Readings below this are synced
+    bool open_{false};                                 ///< Whether the journal is open
+    bool stop_flusher_{false};                         ///< Asks the flusher to exit
+    bool flush_requested_{false};                      ///< sync() or a full buffer wants a pass
+};
+
+} // namespace Storage
+
+#endif // STORAGE_EVENT_JOURNAL_H
@@ -0,0 +1,219 @@
+#ifndef STORAGE_JOURNAL_FORMAT_H
+#define STORAGE_JOURNAL_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Event/SensorType.h"
+#include "Event/WireFormat.h"
+
+namespace Storage
+{
+
+/**
+ * @namespace Storage::JournalFormat
+ * @brief On-disk layout shared by EventJournal and JournalReader
+ *
+ * A journal is a directory of segment files named after the sequence
+ * number of their first reading ("journal-<first sequence>.log"). A
+ * segment starts with a SegmentHeader, followed by 8-byte aligned frames:
+ * a FrameHeader and a payload whose FNV-1a checksum the header carries.
+ * Device frames map a device id to its name before the first
+ * reading that uses it, so each segment is self-describing. A frame of kind
+ * End (all zero, as in the preallocated tail) terminates the segment.
+ *
+ * When a segment is sealed a sidecar "journal-<first sequence>.idx" is
+ * written: an IndexHeader, the sparse index (sequence, offset) pairs and
+ * the segment's device dictionary, so readers can seek without scanning.
+ *
+ * All integers are little-endian (host order on supported targets).
+ */
+namespace JournalFormat
+{
+
+constexpr char kSegmentMagic[8] = {'E', 'V', 'J', 'R', 'N', 'L', '0', '1'};  ///< SegmentHeader::magic
+constexpr char kIndexMagic[8] = {'E', 'V', 'J', 'I', 'D', 'X', '0', '1'};    ///< IndexHeader::magic
+constexpr uint32_t kVersion = 2;               ///< Layout version of segments and indexes; 2 stores Event::WireFormat readings
+constexpr std::size_t kFrameAlignment = 8;     ///< Frames start at multiples of this
+
+/**
+ * @struct SegmentHeader
+ * @brief First 64 bytes of a segment file
+ */
+struct SegmentHeader
+{
+    char magic[8];            ///< kSegmentMagic
+    uint32_t version;         ///< kVersion
+    uint32_t header_size;     ///< sizeof(SegmentHeader)
+    uint64_t first_sequence;  ///< Sequence number of the first reading
+    uint64_t reserved[5];     ///< Zero
+};
+
+/**
+ * @enum FrameKind
+ * @brief Type of a frame
+ */
+enum class FrameKind : uint16_t
+{
+    End = 0,      ///< No more frames in this segment
+    Device = 1,   ///< DevicePayload followed by the name bytes
+    Reading = 2   ///< ReadingPayload
+};
+
+/**
+ * @struct FrameHeader
+ * @brief Precedes every frame payload
+ */
+struct FrameHeader
+{
+    FrameKind kind;       ///< Payload type
+    uint16_t size;        ///< Payload size in bytes, excluding padding
+    uint32_t checksum;    ///< checksum() of the payload
+};
+
+/**
+ * @struct DevicePayload
+ * @brief Fixed part of a Device frame; name_size name bytes follow
+ */
+struct DevicePayload
+{
+    uint32_t device_id;   ///< Id used by readings in this segment
+    uint16_t name_size;   ///< Length of the device name
+    uint16_t reserved;    ///< Zero
+};
+
+/**
+ * @struct ReadingPayload
+ * @brief One journaled sensor reading
+ *
+ * The event carries no name: its device_id refers to an earlier Device
+ * frame. Its timestamp is wall-clock time, which survives a restart.
+ */
+struct ReadingPayload
+{
+    uint64_t sequence;                            ///< Journal sequence number
+    Event::WireFormat::SensorEventLayout event;   ///< Encoded reading
+};
+
+/**
+ * @struct IndexHeader
+ * @brief Start of a sealed segment's .idx sidecar
+ */
+struct IndexHeader
+{
+    char magic[8];            ///< kIndexMagic
+    uint32_t version;         ///< kVersion
+    uint32_t entry_count;     ///< Number of IndexEntry records that follow
+    uint64_t first_sequence;  ///< Same as the segment's
+    uint64_t end_sequence;    ///< One past the last reading in the segment
+    uint64_t used_size;       ///< Bytes of the segment holding frames
+    uint32_t device_count;    ///< Device entries after the index entries
+    uint32_t reserved;        ///< Zero
+};
+
+/**
+ * @struct IndexEntry
+ * @brief Sparse index point: where a reading's frame starts
+ */
+struct IndexEntry
+{
+    uint64_t sequence;  ///< Sequence number of the reading
+    uint64_t offset;    ///< Offset of its FrameHeader in the segment
+};
+
+static_assert(sizeof(SegmentHeader) == 64, "SegmentHeader is expected to be 64 bytes");
+static_assert(sizeof(FrameHeader) == 8, "FrameHeader is expected to be 8 bytes");
+static_assert(sizeof(ReadingPayload) == 48, "ReadingPayload is expected to be 48 bytes");
+static_assert(std::is_trivially_copyable<ReadingPayload>::value, "Payloads are copied with memcpy");
+
+/**
+ * @brief 32-bit FNV-1a hash used as the frame checksum
+ * @param data Bytes to hash
+ * @param size Number of bytes
+ */
+inline uint32_t checksum(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Rounds a frame size up to kFrameAlignment
+ * @param size Header plus payload bytes
+ */
+constexpr std::size_t alignFrame(std::size_t size)
+{
+    return (size + kFrameAlignment - 1) & ~(kFrameAlignment - 1);
+}
+
+/**
+ * @brief Gets the file name of a segment
+ * @param first_sequence Sequence number of its first reading
+ * @param extension ".log" for the segment, ".idx" for its index
+ * @return Name with the sequence zero-padded so names sort numerically
+ */
+inline std::string segmentFileName(uint64_t first_sequence, const char* extension)
+{
+    char name[48];
+    std::snprintf(name, sizeof(name), "journal-%020llu%s",
+                  static_cast<unsigned long long>(first_sequence), extension);
+    return name;
+}
+
+/**
+ * @struct SegmentInfo
+ * @brief What a scan or an index file tells about a segment
+ */
+struct SegmentInfo
+{
+    uint64_t first_sequence{0};   ///< Sequence number of the first reading
+    uint64_t end_sequence{0};     ///< One past the last reading
+    std::size_t used_size{0};     ///< Bytes holding the header and valid frames
+    std::vector<IndexEntry> index;                              ///< Sparse index, ascending
+    std::vector<std::pair<uint32_t, std::string>> devices;      ///< Device dictionary
+};
+
+/**
+ * @brief Walks the frames of a mapped segment
+ * @param data Start of the segment
+ * @param size Mapped size of the segment
+ * @param index_interval Add an index entry every this many readings (at least 1)
+ * @param info Receives the sequence range, valid length, index and devices
+ * @return ERROR if the segment header is invalid
+ *
+ * Stops at an End frame, a truncated frame, a checksum mismatch or a
+ * sequence gap; everything before that point is valid (a torn tail after
+ * a crash is simply cut off).
+ */
+Event::Status scanSegment(const char* data, std::size_t size, uint32_t index_interval, SegmentInfo& info);
+
+/**
+ * @brief Writes a sealed segment's .idx sidecar and fsyncs it
+ * @param path Index file path
+ * @param info Segment description to store
+ * @return ERROR if the file cannot be written
+ */
+Event::Status writeIndexFile(const std::string& path, const SegmentInfo& info);
+
+/**
+ * @brief Reads a .idx sidecar
+ * @param path Index file path
+ * @param info Receives the stored segment description
+ * @return ERROR if the file is missing or malformed
+ */
+Event::Status readIndexFile(const std::string& path, SegmentInfo& info);
+
+} // namespace JournalFormat
+
+} // namespace Storage
+
+#endif // STORAGE_JOURNAL_FORMAT_H
@@ -0,0 +1,143 @@
+#ifndef STORAGE_JOURNAL_READER_H
+#define STORAGE_JOURNAL_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Event/SensorRecord.h"
+#include "Event/SensorType.h"
+#include "Storage/JournalFormat.h"
+
+namespace Storage
+{
+
+/**
+ * @struct JournalEntry
+ * @brief One reading read back from a journal
+ */
+struct JournalEntry
+{
+    uint64_t sequence{0};         ///< Journal sequence number
+    Event::SensorRecord record{}; ///< Reading with a Util::Clock monotonic timestamp and a local device id
+};
+
+/**
+ * @class JournalReader
+ * @brief Sequential reader of an EventJournal directory with seek by sequence
+ *
+ * seek() picks the segment from the file names, then the closest sparse
+ * index entry at or before the sequence, and walks at most
+ * EventJournal::Options::index_interval frames from there. Segments that
+ * are still being written have no index yet; they are scanned once when
+ * first entered.
+ *
+ * Readings come back as Event::SensorRecord: the stored wall-clock time is
+ * converted with Util::Clock::fromWallNs() and device names are re-interned
+ * so device_id works with Event::deviceName() in this process.
+ *
+ * The reader may run while an EventJournal appends to the same directory;
+ * next() then also returns readings written after open().
+ *
+ * Thread Safety: Not thread-safe; use one reader per thread.
+ */
+class JournalReader
+{
+public:
+    /**
+     * @brief Constructs a closed reader
+     */
+    JournalReader() = default;
+
+    /**
+     * @brief Unmaps the current segment
+     */
+    ~JournalReader();
+
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+
+    /**
+     * @brief Opens a journal directory, positioned at its first reading
+     * @param directory Directory written by EventJournal
+     * @return ERROR if the directory holds no segments
+     */
+    Event::Status open(const std::string& directory);
+
+    /**
+     * @brief Positions the reader at a sequence number
+     * @param sequence Sequence of the next reading to return
+     * @return ERROR if sequence is before the first journaled reading
+     *
+     * Seeking past the last reading is allowed; next() then returns false
+     * until that reading is appended.
+     */
+    Event::Status seek(uint64_t sequence);
+
+    /**
+     * @brief Reads the next reading
+     * @param entry Receives the reading
+     * @return false at the end of the journal
+     */
+    bool next(JournalEntry& entry);
+
+    /**
+     * @brief Sequence number of the first reading in the journal
+     */
+    uint64_t firstSequence() const {
+        return segments_.empty() ? 0 : segments_.front();
+    }
+
+    /**
+     * @brief Number of segment files found by open() and later next() calls
+     */
+    std::size_t segmentCount() const {
+        return segments_.size();
+    }
+
+private:
+    /**
+     * @brief Re-lists the segment files of the directory
+     */
+    void listSegments();
+
+    /**
+     * @brief Maps a segment and loads (or builds) its index and devices
+     * @param position Position in segments_
+     * @return ERROR if the segment cannot be mapped or is not a segment
+     */
+    Event::Status loadSegment(std::size_t position);
+
+    /**
+     * @brief Unmaps the current segment
+     */
+    void unmap();
+
+    /**
+     * @brief Records a device frame's name under its journal id
+     * @param journal_id Id in the segment
+     * @param name Device name
+     */
+    void addDevice(uint32_t journal_id, const std::string& name);
+
+    static constexpr std::size_t kNoSegment = SIZE_MAX;  ///< No segment loaded
+
+    std::string directory_;                              ///< Journal directory
+    std::vector<uint64_t> segments_;                     ///< First sequence of each segment, ascending
+    std::size_t position_{kNoSegment};                   ///< Index of the loaded segment in segments_
+    int fd_{-1};                                         ///< Loaded segment file
+    const char* data_{nullptr};                          ///< Mapping of the loaded segment
+    std::size_t size_{0};                                ///< Mapped size
+    std::size_t limit_{0};                               ///< End of valid frames (sealed) or size_
+    std::size_t offset_{0};                              ///< Offset of the next frame
+    uint64_t next_sequence_{0};                          ///< Expected sequence of the next reading
+    uint64_t skip_until_{0};                             ///< Readings below this are skipped after seek()
+    JournalFormat::SegmentInfo info_;                    ///< Index and devices of the loaded segment
+    std::unordered_map<uint32_t, uint32_t> devices_;     ///< Journal device id to local interned id
+};
+
+} // namespace Storage
+
+#endif // STORAGE_JOURNAL_READER_H
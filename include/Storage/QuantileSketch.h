@@ -0,0 +1,124 @@
+#ifndef STORAGE_QUANTILE_SKETCH_H
+#define STORAGE_QUANTILE_SKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "Event/SensorType.h"
+
+namespace Storage
+{
+
+/**
+ * @class QuantileSketch
+ * @brief Mergeable quantile estimator with a relative error bound
+ *
+ * Values are counted in logarithmic bins (as in DDSketch): bin i holds
+ * the magnitudes in (gamma^(i-1), gamma^i] with gamma = (1 + a) / (1 - a)
+ * for relative accuracy a, so quantile() is within a * |true value| of
+ * the exact answer. Two sketches with the same accuracy merge exactly by
+ * adding bin counts, which is what lets rollup buckets be combined into
+ * longer periods.
+ *
+ * Memory is bounded by max_bins: when exceeded, the lowest-magnitude bins
+ * are folded together, trading accuracy for the smallest values only.
+ * Magnitudes below kMinMagnitude count as zero; NaN is ignored.
+ *
+ * Thread Safety: Not thread-safe.
+ */
+class QuantileSketch
+{
+public:
+    static constexpr double kDefaultAccuracy = 0.01;   ///< 1 % relative error
+    static constexpr uint32_t kDefaultMaxBins = 512;   ///< Covers ~4 orders of magnitude at 1 %
+    static constexpr double kMinMagnitude = 1e-9;      ///< Smaller magnitudes count as zero
+
+    /**
+     * @brief Constructs an empty sketch
+     * @param relative_accuracy Relative error bound, clamped to [1e-4, 0.5]
+     * @param max_bins Most bins kept (at least 16)
+     */
+    explicit QuantileSketch(double relative_accuracy = kDefaultAccuracy, uint32_t max_bins = kDefaultMaxBins);
+
+    /**
+     * @brief Counts one value
+     * @param value Value to add; NaN is ignored
+     */
+    void add(double value);
+
+    /**
+     * @brief Adds the counts of another sketch
+     * @param other Sketch built with the same relative accuracy
+     * @return ERROR (and no change) if the accuracies differ
+     */
+    Event::Status merge(const QuantileSketch& other);
+
+    /**
+     * @brief Estimates a quantile
+     * @param q Quantile in [0, 1] (0.5 = median)
+     * @return Estimated value, or NaN for an empty sketch
+     */
+    double quantile(double q) const;
+
+    /**
+     * @brief Number of values counted
+     */
+    uint64_t count() const {
+        return count_;
+    }
+
+    /**
+     * @brief Relative accuracy the sketch was built with
+     */
+    double relativeAccuracy() const {
+        return accuracy_;
+    }
+
+    /**
+     * @brief Appends the sketch in its compact binary form
+     * @param out Destination bytes
+     */
+    void serialize(std::vector<uint8_t>& out) const;
+
+    /**
+     * @brief Rebuilds a sketch written by serialize()
+     * @param data Serialized bytes
+     * @param size Number of bytes
+     * @param sketch Receives the sketch
+     * @return ERROR if the bytes are malformed
+     */
+    static Event::Status deserialize(const uint8_t* data, std::size_t size, QuantileSketch& sketch);
+
+private:
+    /**
+     * @brief Gets the bin of a positive magnitude
+     * @param magnitude Value above kMinMagnitude
+     */
+    int32_t binIndex(double magnitude) const;
+
+    /**
+     * @brief Gets the representative magnitude of a bin
+     * @param index Bin index
+     */
+    double binValue(int32_t index) const;
+
+    /**
+     * @brief Folds the lowest-magnitude bins until at most max_bins_ remain
+     */
+    void collapse();
+
+    double accuracy_;                    ///< Relative accuracy
+    double gamma_;                       ///< Bin growth factor
+    double log_gamma_;                   ///< log(gamma_)
+    uint32_t max_bins_;                  ///< Bin limit
+    std::map<int32_t, uint64_t> positive_;   ///< Counts of positive values per bin
+    std::map<int32_t, uint64_t> negative_;   ///< Counts of negative values per bin (of the magnitude)
+    uint64_t zero_count_{0};             ///< Values with magnitude below kMinMagnitude
+    uint64_t count_{0};                  ///< All values counted
+};
+
+} // namespace Storage
+
+#endif // STORAGE_QUANTILE_SKETCH_H
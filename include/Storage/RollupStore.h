@@ -0,0 +1,283 @@
+#ifndef STORAGE_ROLLUP_STORE_H
+#define STORAGE_ROLLUP_STORE_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Event/SensorRecord.h"
+#include "Event/SensorType.h"
+#include "EventBus/EventBatch.h"
+#include "EventBus/EventBus.h"
+#include "Storage/QuantileSketch.h"
+
+namespace Storage
+{
+
+/**
+ * @enum RollupTier
+ * @brief Resolution of a rollup bucket
+ */
+enum class RollupTier : uint8_t
+{
+    Second,   ///< 1 s buckets
+    Minute,   ///< 1 min buckets
+    Hour      ///< 1 h buckets
+};
+
+/**
+ * @struct Rollup
+ * @brief Aggregate of one device's readings over one bucket
+ */
+struct Rollup
+{
+    std::string device;          ///< Device name
+    Event::SensorType type{};    ///< Sensor type
+    RollupTier tier{};           ///< Bucket resolution
+    int64_t start_ns{0};         ///< Wall-clock start of the bucket
+    uint64_t count{0};           ///< Readings in the bucket
+    double min{0.0};             ///< Smallest value
+    double max{0.0};             ///< Largest value
+    double sum{0.0};             ///< Sum of the values
+    QuantileSketch sketch;       ///< Value distribution
+
+    /**
+     * @brief Mean of the values
+     */
+    double mean() const {
+        return count == 0 ? 0.0 : sum / static_cast<double>(count);
+    }
+
+    /**
+     * @brief Adds one value
+     * @param value Reading value
+     */
+    void add(double value);
+
+    /**
+     * @brief Folds in the aggregate of the same series over the same or
+     *        another period (e.g. to sum up a range)
+     * @param other Aggregate to fold in
+     */
+    void merge(const Rollup& other);
+};
+
+/**
+ * @class RollupStore
+ * @brief Consumer that maintains 1 s / 1 min / 1 h rollups of every device
+ *
+ * Each reading updates, in place, the open bucket of its device and type
+ * at all three resolutions: count, min, max, sum and a QuantileSketch.
+ * A bucket is closed when a reading of the same series falls into a later
+ * bucket, when the series has been idle for Options::idle_timeout, or on
+ * flush() and close(); closed buckets are appended to one file per tier
+ * ("rollup-1s.log", "rollup-1m.log", "rollup-1h.log") in the store
+ * directory. A dashboard query over a day then reads 24 hourly entries per
+ * device instead of 86400 raw readings. An in-memory index of each tier
+ * file, rebuilt by open(), maps every 16 KiB of entries to the bucket
+ * starts they cover, so a query reads only the part of the file holding
+ * its range rather than the whole history.
+ *
+ * Closing early is always safe: entries for the same series and bucket are
+ * merged when queried, which is also how readings that arrive after their
+ * bucket was closed are handled (they are persisted as their own entry).
+ * Fault readings are not aggregated.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class RollupStore
+{
+public:
+    static constexpr std::size_t kTierCount = 3;   ///< Number of RollupTier values
+
+    /**
+     * @struct Options
+     * @brief Closing and sketch settings
+     */
+    struct Options
+    {
+        std::chrono::milliseconds idle_timeout{10000};            ///< Close the buckets of series silent for this long
+        double sketch_accuracy{QuantileSketch::kDefaultAccuracy}; ///< Relative error of the quantiles
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters of the store
+     */
+    struct Stats
+    {
+        uint64_t readings{0};        ///< Readings aggregated
+        uint64_t late_readings{0};   ///< Readings older than their series' open bucket
+        uint64_t open_buckets{0};    ///< Buckets held in memory
+        uint64_t closed_buckets{0};  ///< Entries appended to the tier files
+        uint64_t bytes_queried{0};   ///< Tier file bytes read by query()
+    };
+
+    /**
+     * @brief Gets the bucket length of a tier
+     * @param tier Tier
+     * @return Length in nanoseconds
+     */
+    static int64_t tierWidthNs(RollupTier tier);
+
+    /**
+     * @brief Constructs a closed store
+     */
+    RollupStore() = default;
+
+    /**
+     * @brief Closes the store, persisting the open buckets
+     */
+    ~RollupStore();
+
+    RollupStore(const RollupStore&) = delete;
+    RollupStore& operator=(const RollupStore&) = delete;
+
+    /**
+     * @brief Opens (creating if needed) a rollup directory
+     * @param directory Directory holding the tier files
+     * @param options Closing and sketch settings
+     * @return ERROR if already open or the files cannot be opened
+     *
+     * A torn last entry left by a crash is cut off.
+     */
+    Event::Status open(const std::string& directory, Options options);
+
+    /**
+     * @brief Opens a rollup directory with default options
+     * @param directory Directory holding the tier files
+     * @return ERROR if already open or the files cannot be opened
+     */
+    Event::Status open(const std::string& directory) {
+        return open(directory, Options());
+    }
+
+    /**
+     * @brief Persists every open bucket and closes the files
+     *
+     * No effect on a closed store.
+     */
+    void close();
+
+    /**
+     * @brief Whether open() succeeded and close() has not been called
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Aggregates one reading
+     * @param record Reading; faults are skipped
+     */
+    void add(const Event::SensorRecord& record);
+
+    /**
+     * @brief Aggregates the sensor readings of a batch
+     * @param batch Events in publish order; non-sensor events are skipped
+     *
+     * Takes the store lock once for the whole batch, then closes the
+     * buckets of idle series.
+     */
+    void add(const EventBatch& batch);
+
+    /**
+     * @brief Persists every open bucket now
+     *
+     * Later readings of the same buckets are merged with them at query time.
+     */
+    void flush();
+
+    /**
+     * @brief Subscribes the store to every batch an EventBus dispatches
+     * @param event_bus Bus to aggregate
+     * @param executor Where aggregation runs; nullptr runs it on the dispatcher
+     * @return Id of the subscription
+     */
+    EventBus::SubscriptionId attach(EventBus& event_bus, std::shared_ptr<Executor> executor = nullptr);
+
+    /**
+     * @brief Gets the rollups of a tier in a time range
+     * @param tier Resolution to read
+     * @param device Device name; empty for every device
+     * @param from_ns First bucket start included (wall clock)
+     * @param to_ns First bucket start excluded (wall clock)
+     * @return One merged rollup per series and bucket, persisted and open
+     *         ones alike, ordered by bucket start then device
+     */
+    std::vector<Rollup> query(RollupTier tier, const std::string& device, int64_t from_ns, int64_t to_ns) const;
+
+    /**
+     * @brief Gets the counters of the store
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * @struct Series
+     * @brief Open buckets of one device and type
+     */
+    struct Series
+    {
+        std::array<Rollup, kTierCount> buckets;   ///< Open bucket per tier; count 0 if none
+        int64_t last_update_ns{0};                ///< Util::Clock time of the last reading
+    };
+
+    /**
+     * @struct IndexChunk
+     * @brief Run of consecutive entries in a tier file and the bucket starts they cover
+     */
+    struct IndexChunk
+    {
+        uint64_t offset{0};         ///< File offset of the first entry
+        uint64_t size{0};           ///< Bytes of whole entries
+        int64_t first_start_ns{0};  ///< Earliest bucket start among the entries
+        int64_t last_start_ns{0};   ///< Latest bucket start among the entries
+    };
+
+    /**
+     * @brief Aggregates one reading; caller holds mutex_
+     * @param record Reading to aggregate
+     */
+    void addLocked(const Event::SensorRecord& record);
+
+    /**
+     * @brief Persists the buckets of idle series; caller holds mutex_
+     * @param now_ns Current Util::Clock time
+     */
+    void closeIdleLocked(int64_t now_ns);
+
+    /**
+     * @brief Appends a bucket to its tier file; caller holds mutex_
+     * @param rollup Bucket to persist
+     */
+    void persistLocked(const Rollup& rollup);
+
+    /**
+     * @brief Records a persisted entry in a tier's index; caller holds mutex_
+     * @param tier Tier index
+     * @param start_ns Bucket start of the entry
+     * @param size Encoded size of the entry
+     */
+    void indexLocked(std::size_t tier, int64_t start_ns, std::size_t size);
+
+    std::string directory_;                                ///< Rollup directory
+    Options options_;                                      ///< Settings given to open()
+    mutable std::mutex mutex_;                             ///< Protects all state below
+    std::unordered_map<uint64_t, Series> series_;          ///< Open buckets by (device id, type)
+    std::array<int, kTierCount> fds_{{-1, -1, -1}};        ///< Tier files, opened for appending
+    std::array<std::vector<IndexChunk>, kTierCount> index_; ///< Time index of each tier file
+    std::vector<uint8_t> buffer_;                          ///< Encoding scratch space
+    int64_t last_idle_check_ns_{0};                        ///< When idle series were last closed
+    Stats stats_;                                          ///< Counters
+    mutable uint64_t bytes_queried_{0};                    ///< Stats::bytes_queried, updated by const query()
+    bool open_{false};                                     ///< Whether the store is open
+};
+
+} // namespace Storage
+
+#endif // STORAGE_ROLLUP_STORE_H
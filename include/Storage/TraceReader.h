@@ -0,0 +1,77 @@
+#ifndef STORAGE_TRACE_READER_H
+#define STORAGE_TRACE_READER_H
+
+#include <cstddef>
+#include <string>
+
+#include "Event/SensorRecord.h"
+#include "Event/SensorType.h"
+
+namespace Storage
+{
+
+/**
+ * @class TraceReader
+ * @brief Sequential reader of a raw sensor record trace file
+ *
+ * A trace is the file EventBus::LeftoverPolicy::Persist appends to: per
+ * reading an Event::SensorRecord whose timestamp_ns is wall-clock time,
+ * then a uint16_t device name length and the name bytes. The file is
+ * mapped read-only; readings come back with a Util::Clock monotonic
+ * timestamp and a device_id interned in this process.
+ *
+ * A truncated last entry (a writer that stopped mid-record) ends the trace.
+ *
+ * Thread Safety: Not thread-safe; use one reader per thread.
+ */
+class TraceReader
+{
+public:
+    /**
+     * @brief Constructs a closed reader
+     */
+    TraceReader() = default;
+
+    /**
+     * @brief Unmaps the file
+     */
+    ~TraceReader();
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    /**
+     * @brief Maps a trace file, positioned at its first reading
+     * @param path Trace file
+     * @return ERROR if the file cannot be opened or mapped
+     */
+    Event::Status open(const std::string& path);
+
+    /**
+     * @brief Reads the next reading
+     * @param record Receives the reading
+     * @return false at the end of the trace
+     */
+    bool next(Event::SensorRecord& record);
+
+    /**
+     * @brief Returns to the first reading
+     */
+    void rewind() {
+        offset_ = 0;
+    }
+
+private:
+    /**
+     * @brief Unmaps the file
+     */
+    void close();
+
+    const char* data_{nullptr};   ///< Mapping of the file
+    std::size_t size_{0};         ///< File size
+    std::size_t offset_{0};       ///< Offset of the next entry
+};
+
+} // namespace Storage
+
+#endif // STORAGE_TRACE_READER_H
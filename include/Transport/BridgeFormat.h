@@ -0,0 +1,66 @@
+#ifndef TRANSPORT_BRIDGE_FORMAT_H
+#define TRANSPORT_BRIDGE_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Event/WireFormat.h"
+
+namespace Transport
+{
+
+/**
+ * @namespace Transport::BridgeFormat
+ * @brief Stream layout spoken by BridgeSender and BridgeReceiver
+ *
+ * A connection carries a sequence of length-prefixed frames. Each frame
+ * is a FrameHeader followed by payload_size bytes holding count sensor
+ * events in the Event::WireFormat encoding, each with its device name
+ * embedded: device ids are interned per process. Integers are
+ * little-endian.
+ *
+ * The other direction carries Acks: whenever the receiver has published
+ * frames it writes the running count of frames published from the
+ * connection. The sender keeps every frame until it is acknowledged and
+ * resends the unacknowledged ones on its next connection.
+ */
+namespace BridgeFormat
+{
+
+constexpr uint32_t kFrameMagic = 0x33425645;          ///< "EVB3": FrameHeader::magic, also the layout version
+constexpr uint32_t kAckMagic = 0x4b425645;            ///< "EVBK": Ack::magic
+constexpr uint32_t kMaxPayloadSize = 16u << 20;       ///< Larger frames are rejected as malformed
+
+/**
+ * @struct FrameHeader
+ * @brief Length prefix of a frame
+ */
+struct FrameHeader
+{
+    uint32_t magic;          ///< kFrameMagic
+    uint32_t payload_size;   ///< Bytes after the header
+    uint32_t count;          ///< Events in the payload
+    uint32_t reserved;       ///< Zero
+};
+
+static_assert(sizeof(FrameHeader) == 16, "FrameHeader is expected to be 16 bytes");
+static_assert(sizeof(FrameHeader) % Event::WireFormat::kAlignment == 0, "Events in a frame stay aligned");
+
+/**
+ * @struct Ack
+ * @brief Acknowledgement sent back by the receiver
+ */
+struct Ack
+{
+    uint32_t magic;          ///< kAckMagic
+    uint32_t reserved;       ///< Zero
+    uint64_t frames;         ///< Frames of this connection published so far
+};
+
+static_assert(sizeof(Ack) == 16, "Ack is expected to be 16 bytes");
+
+} // namespace BridgeFormat
+
+} // namespace Transport
+
+#endif // TRANSPORT_BRIDGE_FORMAT_H
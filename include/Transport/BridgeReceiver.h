@@ -0,0 +1,203 @@
+#ifndef TRANSPORT_BRIDGE_RECEIVER_H
+#define TRANSPORT_BRIDGE_RECEIVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Event/SensorType.h"
+#include "EventBus/EventBus.h"
+#include "Transport/SocketAddress.h"
+
+namespace Transport
+{
+
+/**
+ * @class BridgeReceiver
+ * @brief Publishes the readings BridgeSenders on other nodes forward over sockets
+ *
+ * Listens on a TCP or Unix socket address and accepts any number of
+ * senders (up to Options::max_connections). A thread of its own polls all
+ * connections, decodes every complete BridgeFormat frame it reads, interns
+ * the device names in this process and publishes each frame with one
+ * EventBus::publishBatch() call. Readings of one connection keep their
+ * order; readings of different connections interleave by frame.
+ *
+ * Backpressure crosses the network: while the local bus has more than
+ * Options::max_in_flight events queued the receiver stops reading, the
+ * kernel socket buffers fill and the senders block in turn.
+ *
+ * Published frames are acknowledged to the sender with a BridgeFormat::Ack,
+ * so it can resend what a broken connection lost.
+ *
+ * A frame that fails validation closes its connection; a sender then
+ * reconnects and carries on with its next frame.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class BridgeReceiver
+{
+public:
+    /**
+     * @struct Options
+     * @brief Connection and memory limits
+     */
+    struct Options
+    {
+        std::size_t max_in_flight{4096};        ///< Bus backlog above which reading pauses
+        std::size_t max_connections{64};        ///< Connections beyond this are refused
+        std::size_t read_size{256u << 10};      ///< Bytes read from a connection at a time
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters of the receiver
+     */
+    struct Stats
+    {
+        uint64_t connections{0};          ///< Connections accepted
+        uint64_t active_connections{0};   ///< Connections currently open
+        uint64_t frames{0};               ///< Frames published
+        uint64_t received{0};             ///< Readings published on the local bus
+        uint64_t malformed{0};            ///< Frames that failed validation
+    };
+
+    /**
+     * @brief Constructs a closed receiver
+     * @param event_bus EventBus to publish to
+     */
+    explicit BridgeReceiver(EventBus& event_bus) : event_bus_(event_bus) {}
+
+    /**
+     * @brief Closes the receiver
+     */
+    ~BridgeReceiver();
+
+    BridgeReceiver(const BridgeReceiver&) = delete;
+    BridgeReceiver& operator=(const BridgeReceiver&) = delete;
+
+    /**
+     * @brief Listens on an address and starts receiving
+     * @param address "tcp:<host>:<port>" or "unix:<path>"; port 0 picks a free port
+     * @param options Connection and memory limits
+     * @return ERROR if already open, or the address is invalid or unavailable
+     */
+    Event::Status open(const std::string& address, Options options);
+
+    /**
+     * @brief Listens on an address with default options
+     * @param address "tcp:<host>:<port>" or "unix:<path>"
+     * @return ERROR if already open, or the address is invalid or unavailable
+     */
+    Event::Status open(const std::string& address) {
+        return open(address, Options());
+    }
+
+    /**
+     * @brief Stops receiving and closes all connections
+     *
+     * Partially received frames are discarded. No effect on a closed receiver.
+     */
+    void close();
+
+    /**
+     * @brief Whether open() succeeded and close() has not been called
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Gets the address the receiver listens on, with the chosen port
+     * @return Address in the form open() accepts; empty when closed
+     */
+    std::string address() const;
+
+    /**
+     * @brief Gets the counters of the receiver
+     */
+    Stats getStats() const {
+        return Stats{connections_.load(std::memory_order_relaxed),
+                     active_connections_.load(std::memory_order_relaxed),
+                     frames_.load(std::memory_order_relaxed),
+                     received_.load(std::memory_order_relaxed),
+                     malformed_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    /**
+     * @struct Connection
+     * @brief An accepted sender and the bytes read from it but not yet decoded
+     */
+    struct Connection
+    {
+        int fd{-1};                    ///< Non-blocking socket
+        std::vector<uint8_t> buffer;   ///< Read buffer; starts at a frame boundary
+        std::size_t size{0};           ///< Bytes of buffer holding received data
+        uint64_t frames{0};            ///< Frames published from this connection
+        uint64_t acked{0};             ///< Frame count carried by the last Ack queued
+        uint8_t ack[16];               ///< Ack being sent
+        std::size_t ack_sent{0};       ///< Bytes of ack sent
+        std::size_t ack_size{0};       ///< Bytes of ack to send; 0 if none
+
+        /**
+         * @brief Whether an Ack is waiting for socket space
+         */
+        bool ackPending() const {
+            return ack_sent < ack_size || frames > acked;
+        }
+    };
+
+    /**
+     * @brief Receiver thread: accepts connections, reads and publishes frames
+     */
+    void receiveLoop();
+
+    /**
+     * @brief Accepts pending connections
+     */
+    void acceptConnections();
+
+    /**
+     * @brief Reads what a connection has and publishes its complete frames
+     * @param connection Connection with data (or a hang-up) pending
+     * @return false if the connection was closed or sent a malformed frame
+     */
+    bool readConnection(Connection& connection);
+
+    /**
+     * @brief Sends the Ack of a connection's published frames, as far as the socket takes it
+     * @param connection Connection to acknowledge
+     * @return false if the connection broke
+     */
+    static bool sendAck(Connection& connection);
+
+    /**
+     * @brief Decodes and publishes the complete frames at the front of a buffer
+     * @param data Received bytes, starting at a frame boundary
+     * @param size Number of bytes
+     * @param frames Incremented per frame published
+     * @return Bytes consumed, or SIZE_MAX on a malformed frame
+     */
+    std::size_t publishFrames(const uint8_t* data, std::size_t size, uint64_t& frames);
+
+    EventBus& event_bus_;                             ///< Where readings are published
+    Options options_;                                 ///< Settings given to open()
+    mutable std::mutex mutex_;                        ///< Serializes open(), close() and address()
+    SocketAddress address_;                           ///< Bound address
+    int listen_fd_{-1};                               ///< Listening socket
+    std::vector<Connection> open_connections_;        ///< Owned by the receiver thread
+    std::thread thread_;                              ///< Runs receiveLoop()
+    std::atomic<bool> stop_requested_{false};         ///< Asks the thread to exit
+    std::atomic<uint64_t> connections_{0};            ///< Connections accepted
+    std::atomic<uint64_t> active_connections_{0};     ///< Connections open
+    std::atomic<uint64_t> frames_{0};                 ///< Frames published
+    std::atomic<uint64_t> received_{0};               ///< Readings published
+    std::atomic<uint64_t> malformed_{0};              ///< Frames rejected
+};
+
+} // namespace Transport
+
+#endif // TRANSPORT_BRIDGE_RECEIVER_H
@@ -0,0 +1,251 @@
+#ifndef TRANSPORT_BRIDGE_SENDER_H
+#define TRANSPORT_BRIDGE_SENDER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Event/SensorRecord.h"
+#include "Event/SensorType.h"
+#include "EventBus/EventBatch.h"
+#include "EventBus/EventBus.h"
+#include "Transport/SocketAddress.h"
+
+namespace Transport
+{
+
+/**
+ * @class BridgeSender
+ * @brief Forwards the sensor readings of an EventBus to a BridgeReceiver over a socket
+ *
+ * Readings are encoded into the open BridgeFormat frame. A frame is sealed
+ * once it holds Options::batch_size readings, or once the first reading in
+ * it has waited Options::linger, so a quiet node still delivers promptly.
+ * A writer thread of its own sends every sealed frame it has with a single
+ * vectored write (one iovec per frame) and reconnects, every
+ * Options::reconnect_interval, whenever the connection breaks.
+ *
+ * Flow control: at most Options::max_pending_bytes of encoded readings wait
+ * for the socket. When the receiver stops reading (its own bus is backed
+ * up), the socket buffers fill, the writer blocks and send() blocks in
+ * turn, up to Options::send_timeout, before dropping readings. Attached
+ * with a bounded executor, that wait holds back this node's bus.
+ *
+ * Delivery is at least once: a frame stays buffered, and counts against
+ * Options::max_pending_bytes, until the receiver acknowledges having
+ * published it (BridgeFormat::Ack). Frames not acknowledged when a
+ * connection breaks, including those already written to the socket, are
+ * sent again on the next connection. A frame the receiver published but
+ * whose Ack was lost with the connection is therefore delivered twice;
+ * Stats::resent counts the readings sent again.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class BridgeSender
+{
+public:
+    /**
+     * @struct Options
+     * @brief Batching, buffering and reconnection settings
+     */
+    struct Options
+    {
+        std::size_t batch_size{256};                          ///< Readings per frame (at least 1)
+        std::chrono::microseconds linger{1000};               ///< Longest a reading waits for its frame to fill
+        std::size_t max_pending_bytes{4u << 20};              ///< Encoded bytes buffered before send() blocks
+        std::chrono::milliseconds send_timeout{1000};         ///< Longest send() blocks before dropping
+        std::chrono::milliseconds reconnect_interval{100};    ///< Delay between connection attempts
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters of the sender
+     */
+    struct Stats
+    {
+        uint64_t sent{0};          ///< Readings the receiver acknowledged
+        uint64_t dropped{0};       ///< Readings that found no buffer space, or were pending at close()
+        uint64_t resent{0};        ///< Readings written again after a connection broke before their Ack
+        uint64_t frames{0};        ///< Frames the receiver acknowledged
+        uint64_t bytes{0};         ///< Bytes written, resent frames included
+        uint64_t writes{0};        ///< Vectored write calls
+        uint64_t connects{0};      ///< Connections established
+    };
+
+    /**
+     * @brief Constructs a closed sender
+     */
+    BridgeSender() = default;
+
+    /**
+     * @brief Closes the sender
+     */
+    ~BridgeSender();
+
+    BridgeSender(const BridgeSender&) = delete;
+    BridgeSender& operator=(const BridgeSender&) = delete;
+
+    /**
+     * @brief Starts forwarding to a receiver
+     * @param address "tcp:<host>:<port>" or "unix:<path>"
+     * @param options Batching, buffering and reconnection settings
+     * @return ERROR if already open or the address is invalid
+     *
+     * Connecting happens in the background; readings sent before the
+     * receiver is reachable are buffered.
+     */
+    Event::Status open(const std::string& address, Options options);
+
+    /**
+     * @brief Starts forwarding with default options
+     * @param address "tcp:<host>:<port>" or "unix:<path>"
+     * @return ERROR if already open or the address is invalid
+     */
+    Event::Status open(const std::string& address) {
+        return open(address, Options());
+    }
+
+    /**
+     * @brief Sends what is pending (waiting up to Options::send_timeout) and disconnects
+     *
+     * No effect on a closed sender.
+     */
+    void close();
+
+    /**
+     * @brief Whether open() succeeded and close() has not been called
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Whether a connection to the receiver is established
+     */
+    bool isConnected() const;
+
+    /**
+     * @brief Queues one reading
+     * @param record Reading to send
+     * @return ERROR if the sender is closed or the reading was dropped
+     */
+    Event::Status send(const Event::SensorRecord& record);
+
+    /**
+     * @brief Queues the sensor readings of a batch
+     * @param batch Events in publish order; non-sensor events are skipped
+     * @return Number of readings queued
+     *
+     * Takes the sender lock once for the whole batch.
+     */
+    std::size_t send(const EventBatch& batch);
+
+    /**
+     * @brief Seals the open frame and waits until the receiver acknowledged everything queued
+     * @return ERROR if that did not happen within Options::send_timeout
+     */
+    Event::Status flush();
+
+    /**
+     * @brief Subscribes the sender to every batch an EventBus dispatches
+     * @param event_bus Bus to forward
+     * @param executor Where sending runs; nullptr runs it on the dispatcher
+     * @return Id of the subscription
+     */
+    EventBus::SubscriptionId attach(EventBus& event_bus, std::shared_ptr<Executor> executor = nullptr);
+
+    /**
+     * @brief Gets the counters of the sender
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * @struct Frame
+     * @brief A sealed frame waiting to be written
+     */
+    struct Frame
+    {
+        std::vector<uint8_t> bytes;   ///< FrameHeader and payload
+        uint32_t count{0};            ///< Readings in the frame
+    };
+
+    /**
+     * @brief Waits for buffer space and encodes one reading; caller holds lock
+     * @param lock Lock on mutex_
+     * @param record Reading to encode
+     * @param deadline When to give up waiting for space
+     * @return false if the reading was dropped
+     */
+    bool encodeLocked(std::unique_lock<std::mutex>& lock, const Event::SensorRecord& record,
+                      std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Moves the open frame to the sealed queue; caller holds mutex_
+     */
+    void sealLocked();
+
+    /**
+     * @brief Writer thread: writes sealed frames, reconnecting as needed
+     */
+    void writeLoop();
+
+    /**
+     * @brief Ack thread of a connection: releases the frames the receiver acknowledges
+     * @param fd Connected socket
+     */
+    void ackLoop(int fd);
+
+    /**
+     * @brief Removes the acknowledged frames that have been written; caller holds mutex_
+     */
+    void releaseAckedLocked();
+
+    /**
+     * @brief Closes the connection and queues its unacknowledged frames again; caller holds lock
+     * @param lock Lock on mutex_, released while the ack thread is joined
+     */
+    void disconnectLocked(std::unique_lock<std::mutex>& lock);
+
+    /**
+     * @brief Writes frames with vectored writes until done or the connection breaks
+     * @param fd Connected socket
+     * @param frames Frames to write, in order
+     * @param writes Incremented per write call
+     * @param completed Receives the number of frames written in full
+     * @return false if the connection broke
+     */
+    static bool writeFrames(int fd, const std::vector<const Frame*>& frames, uint64_t& writes,
+                            std::size_t& completed);
+
+    SocketAddress address_;                    ///< Receiver address
+    Options options_;                          ///< Settings given to open()
+    mutable std::mutex mutex_;                 ///< Protects all state below
+    std::condition_variable work_cv_;          ///< Wakes the writer
+    std::condition_variable space_cv_;         ///< Signalled when frames have been written
+    std::thread writer_;                       ///< Runs writeLoop()
+    std::vector<uint8_t> open_frame_;          ///< Frame being filled, header space included
+    uint32_t open_count_{0};                   ///< Readings in open_frame_
+    std::chrono::steady_clock::time_point open_since_;   ///< When the first reading entered open_frame_
+    std::deque<Frame> sealed_;                 ///< Frames not yet acknowledged, oldest first
+    std::size_t written_{0};                   ///< Frames at the front of sealed_ written on this connection
+    uint64_t acked_{0};                        ///< Frames acknowledged on this connection
+    uint64_t released_{0};                     ///< Acknowledged frames removed from sealed_ on this connection
+    std::size_t pending_bytes_{0};             ///< Bytes in open_frame_ and sealed_
+    int fd_{-1};                               ///< Connected socket, written by the writer only
+    std::thread ack_reader_;                   ///< Runs ackLoop() for fd_
+    bool broken_{false};                       ///< The ack thread saw the connection end
+    Stats stats_;                              ///< Counters
+    bool open_{false};                         ///< Whether the sender is open
+    bool stopping_{false};                     ///< close() asks the writer to drain and exit
+    bool abandon_{false};                      ///< close() gave up on draining
+};
+
+} // namespace Transport
+
+#endif // TRANSPORT_BRIDGE_SENDER_H
@@ -0,0 +1,200 @@
+#ifndef TRANSPORT_LINE_INGESTOR_H
+#define TRANSPORT_LINE_INGESTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Event/SensorType.h"
+#include "EventBus/EventBus.h"
+#include "Transport/LineParser.h"
+#include "Transport/SocketAddress.h"
+
+namespace Transport
+{
+
+/**
+ * @class LineIngestor
+ * @brief Publishes sensor readings that external sources send in the LineParser protocol
+ *
+ * The source given to open() is either a socket address to listen on
+ * ("unix:<path>" or "tcp:<host>:<port>", for any number of writers, up to
+ * Options::max_connections) or a path to read: a regular file, a named
+ * pipe, or "-" for standard input. A thread of its own polls the source,
+ * parses everything each read returns with a LineParser of the stream and
+ * publishes the resulting events with one EventBus::publishBatch() call.
+ * Readings of one stream keep their order.
+ *
+ * While the local bus has more than Options::max_in_flight events queued
+ * the ingestor stops reading, so socket and pipe writers block in turn
+ * and a file is read only as fast as the bus drains.
+ *
+ * A path source is read to its end (for a pipe, until the last writer
+ * closes it), after which finished() returns true. An incomplete last line
+ * is parsed when its stream ends.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class LineIngestor
+{
+public:
+    /**
+     * @struct Options
+     * @brief Read sizes and limits
+     */
+    struct Options
+    {
+        std::size_t max_in_flight{4096};      ///< Bus backlog above which reading pauses
+        std::size_t max_connections{64};      ///< Connections beyond this are refused
+        std::size_t read_size{64u << 10};     ///< Bytes read at a time; bounds the batch size
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters of the ingestor
+     */
+    struct Stats
+    {
+        uint64_t connections{0};   ///< Streams opened (connections accepted, or the path)
+        uint64_t bytes{0};         ///< Bytes read
+        uint64_t lines{0};         ///< Lines that were not blank or comments
+        uint64_t published{0};     ///< Readings published on the local bus
+        uint64_t malformed{0};     ///< Lines skipped as malformed
+    };
+
+    /**
+     * @brief Constructs a closed ingestor
+     * @param event_bus EventBus to publish to
+     */
+    explicit LineIngestor(EventBus& event_bus) : event_bus_(event_bus) {}
+
+    /**
+     * @brief Closes the ingestor
+     */
+    ~LineIngestor();
+
+    LineIngestor(const LineIngestor&) = delete;
+    LineIngestor& operator=(const LineIngestor&) = delete;
+
+    /**
+     * @brief Opens a source and starts ingesting
+     * @param source "unix:<path>" or "tcp:<host>:<port>" to listen on, a file
+     *               or pipe path, or "-" for standard input
+     * @param options Read sizes and limits
+     * @return ERROR if already open, or the source cannot be opened
+     */
+    Event::Status open(const std::string& source, Options options);
+
+    /**
+     * @brief Opens a source with default options
+     * @param source Socket address, path, or "-"
+     * @return ERROR if already open, or the source cannot be opened
+     */
+    Event::Status open(const std::string& source) {
+        return open(source, Options());
+    }
+
+    /**
+     * @brief Stops ingesting and closes the source
+     *
+     * Incomplete lines are discarded. No effect on a closed ingestor.
+     */
+    void close();
+
+    /**
+     * @brief Whether open() succeeded and close() has not been called
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Whether a path source has been read to its end and published
+     * @return Always false for socket sources
+     */
+    bool finished() const {
+        return finished_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Gets the address a socket source listens on, with the chosen port
+     * @return Address in the form open() accepts; empty for path sources and when closed
+     */
+    std::string address() const;
+
+    /**
+     * @brief Gets the counters of the ingestor
+     */
+    Stats getStats() const {
+        return Stats{connections_.load(std::memory_order_relaxed),
+                     bytes_.load(std::memory_order_relaxed),
+                     lines_.load(std::memory_order_relaxed),
+                     published_.load(std::memory_order_relaxed),
+                     malformed_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    /**
+     * @struct Stream
+     * @brief An open connection or path and the bytes read from it but not yet parsed
+     */
+    struct Stream
+    {
+        int fd{-1};                    ///< Non-blocking descriptor
+        bool owned{true};              ///< Closed by the ingestor (not standard input)
+        std::vector<char> buffer;      ///< Read buffer; starts at a line boundary
+        std::size_t size{0};           ///< Bytes of buffer holding unparsed data
+        std::unique_ptr<LineParser> parser{std::make_unique<LineParser>()};   ///< State of the stream
+    };
+
+    /**
+     * @brief Ingest thread: accepts connections, reads, parses and publishes
+     */
+    void ingestLoop();
+
+    /**
+     * @brief Accepts pending connections
+     */
+    void acceptConnections();
+
+    /**
+     * @brief Reads what a stream has and publishes its complete lines
+     * @param stream Stream with data (or an end) pending
+     * @return false once the stream has ended
+     */
+    bool readStream(Stream& stream);
+
+    /**
+     * @brief Parses and publishes the complete lines in a stream's buffer
+     * @param stream Stream whose buffer to parse
+     */
+    void publishLines(Stream& stream);
+
+    /**
+     * @brief Closes a stream's descriptor if the ingestor owns it
+     */
+    static void closeStream(const Stream& stream);
+
+    EventBus& event_bus_;                         ///< Where readings are published
+    Options options_;                             ///< Settings given to open()
+    mutable std::mutex mutex_;                    ///< Serializes open(), close() and address()
+    bool open_{false};                            ///< open() succeeded and close() has not run
+    SocketAddress address_;                       ///< Bound address of a socket source
+    int listen_fd_{-1};                           ///< Listening socket, -1 for path sources
+    std::vector<Stream> streams_;                 ///< Owned by the ingest thread once started
+    std::thread thread_;                          ///< Runs ingestLoop()
+    std::atomic<bool> stop_requested_{false};     ///< Asks the thread to exit
+    std::atomic<bool> finished_{false};           ///< Path source read to its end
+    std::atomic<uint64_t> connections_{0};        ///< Streams opened
+    std::atomic<uint64_t> bytes_{0};              ///< Bytes read
+    std::atomic<uint64_t> lines_{0};              ///< Lines seen
+    std::atomic<uint64_t> published_{0};          ///< Readings published
+    std::atomic<uint64_t> malformed_{0};          ///< Lines rejected
+};
+
+} // namespace Transport
+
+#endif // TRANSPORT_LINE_INGESTOR_H
@@ -0,0 +1,150 @@
+#ifndef TRANSPORT_LINE_PARSER_H
+#define TRANSPORT_LINE_PARSER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "Event/Event.h"
+#include "Event/SensorRecord.h"
+#include "Event/SensorTraits.h"
+#include "Util/RandomNumberGenerator.h"
+
+namespace Transport
+{
+
+/**
+ * @class LineParser
+ * @brief Parses sensor readings in a text line protocol into SensorEvents
+ *
+ * One reading per line, Influx style:
+ *
+ *     <SensorType>,device=<id>[,<tag>=<value>...] [value=]<number>|fault [<timestamp>]
+ *
+ * e.g. "TempSensor,device=3,site=lab 21.5 1767225600000000000". The type is
+ * a SensorType name; the device tag is required and other tags are
+ * ignored. A numeric id maps to the simulators' "<Type>_<n>" device, any
+ * other id to "<Type>_<id>". "fault" records a fault reading. The
+ * timestamp is wall-clock nanoseconds since the Unix epoch; without it the
+ * reading is stamped when its chunk is parsed. Lines end in "\n" or
+ * "\r\n"; blank lines and lines starting with '#' are skipped. A line that
+ * does not parse is counted in Stats::malformed and skipped.
+ *
+ * Parsing runs in two passes over chunks of up to kChunkSize bytes, as in
+ * simdjson: a SIMD pass records the position of every ' ', ',', '=' and
+ * '\n', and a scalar pass walks those positions to cut each line into
+ * tokens without re-scanning its bytes. Numeric device ids are resolved
+ * through a per-type table and values without exponent use an exact
+ * integer fast path, so a typical line costs no lookups or allocations
+ * beyond its event (which comes from SensorEvent's block pool).
+ *
+ * Sequence numbers count readings per device, from 0, across the life of
+ * the parser. A parser holds the state of one stream (a line may span two
+ * parse() calls); use one parser per connection or file.
+ *
+ * Thread Safety: Not thread-safe.
+ */
+class LineParser
+{
+public:
+    static constexpr std::size_t kChunkSize = 64u << 10;   ///< Bytes indexed per pass; longer lines are malformed
+
+    /// Events produced by parse()
+    using Batch = std::vector<std::unique_ptr<Event::Event>>;
+
+    /**
+     * @struct Stats
+     * @brief Counters of the parser
+     */
+    struct Stats
+    {
+        uint64_t lines{0};       ///< Lines that were not blank or comments
+        uint64_t events{0};      ///< Readings parsed
+        uint64_t malformed{0};   ///< Lines skipped as malformed
+    };
+
+    /**
+     * @brief Constructs a parser using the best SIMD level of the CPU
+     */
+    LineParser() : LineParser(detectSimdLevel()) {}
+
+    /**
+     * @brief Constructs a parser using a given SIMD level
+     * @param level Requested level, clamped to the CPU's capabilities
+     */
+    explicit LineParser(Util::SimdLevel level);
+
+    /**
+     * @brief Parses the complete lines at the front of a buffer
+     * @param data Bytes of the stream, continuing where the last call stopped
+     * @param size Number of bytes
+     * @param out Receives one event per reading, in line order
+     * @return Bytes consumed; the rest is an incomplete last line to pass
+     *         again, followed by more data, in the next call
+     */
+    std::size_t parse(const char* data, std::size_t size, Batch& out);
+
+    /**
+     * @brief Gets the SIMD level used for indexing
+     */
+    Util::SimdLevel simdLevel() const {
+        return simd_level_;
+    }
+
+    /**
+     * @brief Gets the counters of the parser
+     */
+    const Stats& getStats() const {
+        return stats_;
+    }
+
+    /**
+     * @brief Best SIMD level supported by the running CPU
+     */
+    static Util::SimdLevel detectSimdLevel();
+
+private:
+    /**
+     * @brief Records the positions of the structural characters of a chunk
+     * @param data Start of the chunk
+     * @param size Bytes in the chunk, at most kChunkSize
+     * @return Number of positions written to positions_
+     */
+    std::size_t indexChunk(const char* data, std::size_t size);
+
+    /**
+     * @brief Parses one line from its structural positions
+     * @param data Start of the chunk holding the line
+     * @param begin Offset of the first byte of the line
+     * @param end Offset of the line's '\n'
+     * @param separators Positions of the structural characters inside the line
+     * @param count Number of separators
+     * @param out Receives the event
+     * @return false if the line is malformed; blank lines and comments parse
+     */
+    bool parseLine(const char* data, std::size_t begin, std::size_t end,
+                   const uint32_t* separators, std::size_t count, Batch& out);
+
+    /**
+     * @brief Gets the dense id of a device
+     * @param type Type of the device
+     * @param id Device tag value
+     * @return Interned id of "<Type>_<id>"
+     */
+    uint32_t resolveDevice(Event::SensorType type, std::string_view id);
+
+    Util::SimdLevel simd_level_;                  ///< Indexing implementation
+    std::vector<uint32_t> positions_;             ///< Structural positions of the current chunk
+    std::array<std::vector<uint32_t>, Event::kSensorTypeCount> devices_;   ///< Interned ids by type and number
+    std::vector<uint64_t> sequences_;             ///< Next sequence number by device id
+    int64_t chunk_time_ns_{0};                    ///< Timestamp of readings without one
+    bool discarding_{false};                      ///< Skipping the rest of an over-long line
+    Stats stats_;                                 ///< Counters
+};
+
+} // namespace Transport
+
+#endif // TRANSPORT_LINE_PARSER_H
@@ -0,0 +1,107 @@
+#ifndef TRANSPORT_SHM_FORMAT_H
+#define TRANSPORT_SHM_FORMAT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Event/SensorType.h"
+
+namespace Transport
+{
+
+/**
+ * @namespace Transport::ShmFormat
+ * @brief Layout of the shared-memory object behind a ShmRing
+ *
+ * The object starts with a RingHeader followed by the ring itself, a
+ * power-of-two number of bytes. The ring holds 8-byte aligned frames, each
+ * a FrameHeader and its payload; a frame never wraps around the end of the
+ * ring: if it does not fit in the bytes left, a FrameHeader whose size is
+ * kWrapMarker pads them and the frame starts over at offset 0.
+ *
+ * head and tail are byte positions that only grow (the offset in the ring
+ * is position & (capacity - 1)). The producer owns head and publishes whole
+ * frames by advancing it; the consumer owns tail. A frame is therefore
+ * either fully visible or not at all, even if a process dies mid-write.
+ *
+ * The producer's and the consumer's fields sit on separate cache lines so
+ * the two processes do not false-share. The *_seq words are the
+ * futexes a side sleeps on; the other side bumps and wakes them only when
+ * the matching *_waiting flag is set.
+ *
+ * Each frame payload is one sensor event in the Event::WireFormat
+ * encoding with its device name embedded, since device ids are interned
+ * per process.
+ *
+ * All integers are in host order: both processes run on the same host.
+ */
+namespace ShmFormat
+{
+
+constexpr char kRingMagic[8] = {'E', 'V', 'S', 'H', 'M', 'R', '0', '1'};   ///< RingHeader::magic
+constexpr uint32_t kVersion = 2;                     ///< Layout version; 2 carries Event::WireFormat payloads
+constexpr std::size_t kCacheLineSize = 64;           ///< Alignment of the header lines
+constexpr std::size_t kFrameAlignment = 8;           ///< Frames start at multiples of this
+constexpr uint32_t kWrapMarker = UINT32_MAX;         ///< FrameHeader::size of the padding before a wrap
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring positions must be lock-free to be shared");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Futex words must be lock-free to be shared");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex words must be plain 32-bit integers");
+
+/**
+ * @struct RingHeader
+ * @brief Start of the shared-memory object
+ */
+struct RingHeader
+{
+    // Written once by the creator, before ready is set
+    char magic[8];                         ///< kRingMagic
+    uint32_t version;                      ///< kVersion
+    uint32_t header_size;                  ///< sizeof(RingHeader)
+    uint64_t capacity;                     ///< Ring bytes after the header, a power of two
+    std::atomic<uint32_t> ready;           ///< 1 once the header is initialized
+
+    // Producer line
+    alignas(kCacheLineSize) std::atomic<uint64_t> head;   ///< Position after the last published frame
+    std::atomic<int32_t> producer_pid;                    ///< Attached producer process, 0 if none
+    std::atomic<uint32_t> space_seq;                      ///< Futex the producer waits on for space
+    std::atomic<uint32_t> producer_waiting;               ///< 1 while the producer sleeps on space_seq
+    std::atomic<uint32_t> producer_takeovers;             ///< Producers that replaced a dead one
+
+    // Consumer line
+    alignas(kCacheLineSize) std::atomic<uint64_t> tail;   ///< Position of the next frame to consume
+    std::atomic<int32_t> consumer_pid;                    ///< Attached consumer process, 0 if none
+    std::atomic<uint32_t> data_seq;                       ///< Futex the consumer waits on for frames
+    std::atomic<uint32_t> consumer_waiting;               ///< 1 while the consumer sleeps on data_seq
+    std::atomic<uint32_t> consumer_takeovers;             ///< Consumers that replaced a dead one
+};
+
+/**
+ * @struct FrameHeader
+ * @brief Precedes every frame in the ring
+ */
+struct FrameHeader
+{
+    uint32_t size;       ///< Payload size in bytes, excluding padding; kWrapMarker to skip to offset 0
+    uint32_t reserved;   ///< Zero
+};
+
+static_assert(sizeof(RingHeader) == 3 * kCacheLineSize, "RingHeader is expected to be three cache lines");
+static_assert(sizeof(FrameHeader) == 8, "FrameHeader is expected to be 8 bytes");
+
+/**
+ * @brief Bytes a frame occupies in the ring
+ * @param payload_size Payload size
+ */
+constexpr std::size_t frameSize(std::size_t payload_size)
+{
+    return (sizeof(FrameHeader) + payload_size + kFrameAlignment - 1) & ~(kFrameAlignment - 1);
+}
+
+} // namespace ShmFormat
+
+} // namespace Transport
+
+#endif // TRANSPORT_SHM_FORMAT_H
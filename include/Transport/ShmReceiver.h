@@ -0,0 +1,133 @@
+#ifndef TRANSPORT_SHM_RECEIVER_H
+#define TRANSPORT_SHM_RECEIVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Event/SensorType.h"
+#include "EventBus/EventBus.h"
+#include "Transport/ShmRing.h"
+
+namespace Transport
+{
+
+/**
+ * @class ShmReceiver
+ * @brief Publishes the readings a ShmSender in another process forwards
+ *
+ * The consumer side of a shared-memory transport. A thread of its own
+ * sleeps on the ring's futex until frames arrive, decodes up to
+ * Options::batch_size of them in place, interns their device names in this
+ * process and publishes them with one EventBus::publishBatch() call, so
+ * local subscribers see the other process's readings as if they had been
+ * published here.
+ *
+ * Backpressure crosses the process boundary: while the local bus has more
+ * than Options::max_in_flight events queued the receiver stops consuming,
+ * the ring fills up and the sender waits. Frames left in the ring on
+ * close() (or a crash) are received by the next ShmReceiver attached to it.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class ShmReceiver
+{
+public:
+    /**
+     * @struct Options
+     * @brief Ring size, batching and memory limits
+     */
+    struct Options
+    {
+        std::size_t capacity{ShmRing::kDefaultCapacity};   ///< Ring bytes if the ring is created here
+        std::size_t batch_size{256};                        ///< Most events per publishBatch() call
+        std::size_t max_in_flight{4096};                    ///< Bus backlog above which receiving pauses
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters of the receiver
+     */
+    struct Stats
+    {
+        uint64_t received{0};    ///< Readings published on the local bus
+        uint64_t malformed{0};   ///< Frames that did not hold a reading
+    };
+
+    /**
+     * @brief Constructs a closed receiver
+     * @param event_bus EventBus to publish to
+     */
+    explicit ShmReceiver(EventBus& event_bus) : event_bus_(event_bus) {}
+
+    /**
+     * @brief Closes the receiver
+     */
+    ~ShmReceiver();
+
+    ShmReceiver(const ShmReceiver&) = delete;
+    ShmReceiver& operator=(const ShmReceiver&) = delete;
+
+    /**
+     * @brief Creates or attaches to a ring as its consumer and starts receiving
+     * @param name Shared-memory ring name
+     * @param options Ring size, batching and memory limits
+     * @return ERROR if already open or the ring cannot be opened
+     */
+    Event::Status open(const std::string& name, Options options);
+
+    /**
+     * @brief Creates or attaches to a ring with default options
+     * @param name Shared-memory ring name
+     * @return ERROR if already open or the ring cannot be opened
+     */
+    Event::Status open(const std::string& name) {
+        return open(name, Options());
+    }
+
+    /**
+     * @brief Stops receiving and releases the consumer role
+     *
+     * No effect on a closed receiver.
+     */
+    void close();
+
+    /**
+     * @brief Whether open() succeeded and close() has not been called
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Whether a ShmSender process is attached and running
+     */
+    bool senderAlive() const;
+
+    /**
+     * @brief Gets the counters of the receiver
+     */
+    Stats getStats() const {
+        return Stats{received_.load(std::memory_order_relaxed), malformed_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    /**
+     * @brief Receiver thread: waits for frames and publishes them in batches
+     */
+    void receiveLoop();
+
+    EventBus& event_bus_;                         ///< Where readings are published
+    Options options_;                             ///< Settings given to open()
+    mutable std::mutex mutex_;                    ///< Serializes open(), close() and senderAlive()
+    ShmRing ring_;                                ///< Consumer side of the ring
+    std::thread thread_;                          ///< Runs receiveLoop()
+    std::atomic<bool> stop_requested_{false};     ///< Asks the thread to exit
+    std::atomic<uint64_t> received_{0};           ///< Readings published
+    std::atomic<uint64_t> malformed_{0};          ///< Frames rejected
+};
+
+} // namespace Transport
+
+#endif // TRANSPORT_SHM_RECEIVER_H
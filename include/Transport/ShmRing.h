@@ -0,0 +1,238 @@
+#ifndef TRANSPORT_SHM_RING_H
+#define TRANSPORT_SHM_RING_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "Event/SensorType.h"
+#include "Transport/ShmFormat.h"
+
+namespace Transport
+{
+
+/**
+ * @class ShmRing
+ * @brief Single-producer, single-consumer frame ring shared between processes
+ *
+ * The ring lives in a POSIX shared-memory object (shm_open + mmap) laid out
+ * as described by ShmFormat. The producer encodes frames straight into the
+ * mapping with reserve() and publishes them with commit(); the consumer
+ * visits them in place with consume(). No byte passes through the kernel:
+ * system calls are only made to sleep and wake, on futexes in the shared
+ * header, and only when a side actually has to wait.
+ *
+ * Either side may create the object; the other attaches to it. Each role
+ * is claimed by writing the process id into the header. A role held by a
+ * process that no longer exists (it crashed without close()) is taken over
+ * by the next open(), and a waiting side notices a dead peer within one
+ * wait slice (50 ms):
+ * - A dead producer can only have lost frames it had not committed; the
+ *   consumer keeps draining the committed ones.
+ * - A dead consumer releases nothing it had not fully consumed, so frames it
+ *   was visiting are delivered again to the next consumer (at least once).
+ *   Until one attaches, the producer fills the free space and then fails
+ *   immediately instead of waiting.
+ *
+ * The object outlives both processes so either can restart; remove it with
+ * unlink() when the channel is no longer needed.
+ *
+ * Thread Safety: Not thread-safe; each side is used by one thread at a time.
+ */
+class ShmRing
+{
+public:
+    /**
+     * @enum Role
+     * @brief Side of the ring a process attaches as
+     */
+    enum class Role : uint8_t
+    {
+        Producer,   ///< Writes frames
+        Consumer    ///< Reads frames
+    };
+
+    static constexpr std::size_t kDefaultCapacity = 1u << 20;   ///< Default ring size (1 MiB)
+    static constexpr std::size_t kMinCapacity = 4096;           ///< Smallest ring size
+
+    /**
+     * @brief Constructs a closed ring
+     */
+    ShmRing() = default;
+
+    /**
+     * @brief Releases the role and unmaps the ring
+     */
+    ~ShmRing();
+
+    ShmRing(const ShmRing&) = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+
+    /**
+     * @brief Creates or attaches to a named ring and claims a role
+     * @param name Shared-memory object name ("/name"; the slash is added if missing)
+     * @param role Side to attach as
+     * @param capacity Ring bytes if the ring is created here, rounded up to a
+     *        power of two of at least kMinCapacity; ignored when attaching
+     * @return ERROR if already open, the object cannot be mapped, is not a
+     *         ring, or the role is held by a live process
+     */
+    Event::Status open(const std::string& name, Role role, std::size_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief Releases the role, wakes the peer and unmaps the ring
+     *
+     * Frames reserved but not committed are discarded. No effect on a
+     * closed ring.
+     */
+    void close();
+
+    /**
+     * @brief Whether open() succeeded and close() has not been called
+     */
+    bool isOpen() const {
+        return header_ != nullptr;
+    }
+
+    /**
+     * @brief Removes a named ring; processes that have it open keep their mapping
+     * @param name Name given to open()
+     */
+    static void unlink(const std::string& name);
+
+    /**
+     * @brief Whether open() took the role over from a process that had died
+     */
+    bool tookOver() const {
+        return took_over_;
+    }
+
+    /**
+     * @brief Whether the other side is attached by a running process
+     */
+    bool peerAlive() const;
+
+    /**
+     * @brief Ring bytes available to frames
+     */
+    std::size_t capacity() const {
+        return capacity_;
+    }
+
+    /**
+     * @brief Largest payload a frame can carry
+     */
+    std::size_t maxPayloadSize() const {
+        return capacity_ / 2 - sizeof(ShmFormat::FrameHeader);
+    }
+
+    /**
+     * @brief Reserves space for one frame (producer)
+     * @param size Payload size, at most maxPayloadSize()
+     * @param timeout Longest wait for the consumer to free space
+     * @return Where to write the payload, or nullptr if the payload is too
+     *         large, the wait timed out, or no live consumer can free space
+     *
+     * The frame becomes visible at the next commit(). Several frames can be
+     * reserved before one commit(); waiting for space commits them first.
+     */
+    uint8_t* reserve(std::size_t size, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Publishes every reserved frame and wakes a sleeping consumer (producer)
+     */
+    void commit();
+
+    /**
+     * @brief Waits until frames are available (consumer)
+     * @param timeout Longest wait
+     * @return true if at least one frame can be consumed
+     */
+    bool waitReadable(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Visits published frames in order and releases their space (consumer)
+     * @param visit Called as visit(const uint8_t* payload, std::size_t size)
+     *        with a view into the ring, valid only during the call
+     * @param max_frames Most frames to visit
+     * @return Number of frames visited
+     *
+     * Space is released once, after the last visit. A frame header that
+     * cannot have been written by a ShmRing producer discards everything
+     * published so far.
+     */
+    template <typename Visitor>
+    std::size_t consume(Visitor&& visit, std::size_t max_frames)
+    {
+        if (header_ == nullptr || role_ != Role::Consumer) {
+            return 0;
+        }
+        const uint64_t head = header_->head.load(std::memory_order_acquire);
+        uint64_t position = header_->tail.load(std::memory_order_relaxed);
+        std::size_t frames = 0;
+        while (position != head && frames < max_frames)
+        {
+            const std::size_t offset = static_cast<std::size_t>(position & (capacity_ - 1));
+            ShmFormat::FrameHeader frame{};
+            std::memcpy(&frame, ring_ + offset, sizeof(frame));
+            if (frame.size == ShmFormat::kWrapMarker && position + (capacity_ - offset) <= head) {
+                position += capacity_ - offset;
+                continue;
+            }
+            const std::size_t frame_size = ShmFormat::frameSize(frame.size);
+            if (frame.size > maxPayloadSize() || offset + frame_size > capacity_ || position + frame_size > head) {
+                reportCorruption(position);
+                position = head;
+                break;
+            }
+            visit(static_cast<const uint8_t*>(ring_ + offset + sizeof(frame)), static_cast<std::size_t>(frame.size));
+            position += frame_size;
+            frames++;
+        }
+        release(position);
+        return frames;
+    }
+
+private:
+    /**
+     * @brief Maps the object and validates or initializes its header
+     * @param fd Open shared-memory object
+     * @param created Whether this process created it
+     * @param capacity Ring bytes to initialize a created ring with
+     * @return ERROR if the object is not a usable ring
+     */
+    Event::Status map(int fd, bool created, std::size_t capacity);
+
+    /**
+     * @brief Claims the role's pid slot, taking over a dead holder's
+     * @return ERROR if a live process holds the role
+     */
+    Event::Status claimRole();
+
+    /**
+     * @brief Advances tail and wakes a producer waiting for space (consumer)
+     * @param position New tail
+     */
+    void release(uint64_t position);
+
+    /**
+     * @brief Reports a malformed frame header
+     * @param position Where it was found
+     */
+    void reportCorruption(uint64_t position) const;
+
+    std::string name_;                                 ///< Object name given to open()
+    Role role_{Role::Producer};                        ///< Side claimed
+    ShmFormat::RingHeader* header_{nullptr};           ///< Shared header; nullptr when closed
+    uint8_t* ring_{nullptr};                           ///< Ring bytes after the header
+    std::size_t capacity_{0};                          ///< Ring size
+    std::size_t mapped_size_{0};                       ///< Bytes mapped
+    uint64_t write_position_{0};                       ///< Producer: end of the reserved frames
+    bool took_over_{false};                            ///< Whether a dead holder's role was taken
+};
+
+} // namespace Transport
+
+#endif // TRANSPORT_SHM_RING_H
@@ -0,0 +1,151 @@
+#ifndef TRANSPORT_SHM_SENDER_H
+#define TRANSPORT_SHM_SENDER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "Event/SensorRecord.h"
+#include "Event/SensorType.h"
+#include "EventBus/EventBatch.h"
+#include "EventBus/EventBus.h"
+#include "Transport/ShmRing.h"
+
+namespace Transport
+{
+
+/**
+ * @class ShmSender
+ * @brief Forwards the sensor readings of an EventBus to another process
+ *
+ * The producer side of a shared-memory transport: each reading is encoded
+ * in the Event::WireFormat encoding directly into a ShmRing, and a ShmReceiver
+ * in the other process publishes it on that process's EventBus. A batch is
+ * committed at once, so the receiver is woken at most once per batch.
+ *
+ * When the ring is full the sender waits up to Options::send_timeout for
+ * the receiver, then drops the reading. With no live receiver (not started
+ * yet, or crashed) readings fill the ring for the next one to pick up and
+ * are dropped once it is full, so a dead peer never blocks the bus.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class ShmSender
+{
+public:
+    /**
+     * @struct Options
+     * @brief Ring size and backpressure limit
+     */
+    struct Options
+    {
+        std::size_t capacity{ShmRing::kDefaultCapacity};   ///< Ring bytes if the ring is created here
+        std::chrono::milliseconds send_timeout{100};        ///< Longest wait for ring space per reading
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters of the sender
+     */
+    struct Stats
+    {
+        uint64_t sent{0};      ///< Readings committed to the ring
+        uint64_t dropped{0};   ///< Readings that found no space
+    };
+
+    /**
+     * @brief Constructs a closed sender
+     */
+    ShmSender() = default;
+
+    /**
+     * @brief Closes the sender
+     */
+    ~ShmSender();
+
+    ShmSender(const ShmSender&) = delete;
+    ShmSender& operator=(const ShmSender&) = delete;
+
+    /**
+     * @brief Creates or attaches to a ring as its producer
+     * @param name Shared-memory ring name
+     * @param options Ring size and backpressure limit
+     * @return ERROR if already open or the ring cannot be opened
+     */
+    Event::Status open(const std::string& name, Options options);
+
+    /**
+     * @brief Creates or attaches to a ring with default options
+     * @param name Shared-memory ring name
+     * @return ERROR if already open or the ring cannot be opened
+     */
+    Event::Status open(const std::string& name) {
+        return open(name, Options());
+    }
+
+    /**
+     * @brief Releases the producer role
+     *
+     * No effect on a closed sender.
+     */
+    void close();
+
+    /**
+     * @brief Whether open() succeeded and close() has not been called
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Whether a ShmReceiver process is attached and running
+     */
+    bool receiverAlive() const;
+
+    /**
+     * @brief Sends one reading
+     * @param record Reading to send
+     * @return ERROR if the sender is closed or the reading was dropped
+     */
+    Event::Status send(const Event::SensorRecord& record);
+
+    /**
+     * @brief Sends the sensor readings of a batch
+     * @param batch Events in publish order; non-sensor events are skipped
+     * @return Number of readings sent
+     *
+     * Takes the sender lock once and commits once for the whole batch.
+     */
+    std::size_t send(const EventBatch& batch);
+
+    /**
+     * @brief Subscribes the sender to every batch an EventBus dispatches
+     * @param event_bus Bus to forward
+     * @param executor Where sending runs; nullptr runs it on the dispatcher
+     * @return Id of the subscription
+     */
+    EventBus::SubscriptionId attach(EventBus& event_bus, std::shared_ptr<Executor> executor = nullptr);
+
+    /**
+     * @brief Gets the counters of the sender
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief Encodes one reading into the ring without committing; caller holds mutex_
+     * @param record Reading to encode
+     * @return false if it was dropped
+     */
+    bool encodeLocked(const Event::SensorRecord& record);
+
+    Options options_;                 ///< Settings given to open()
+    mutable std::mutex mutex_;        ///< Protects all state below
+    ShmRing ring_;                    ///< Producer side of the ring
+    Stats stats_;                     ///< Counters
+};
+
+} // namespace Transport
+
+#endif // TRANSPORT_SHM_SENDER_H
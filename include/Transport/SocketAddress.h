@@ -0,0 +1,72 @@
+#ifndef TRANSPORT_SOCKET_ADDRESS_H
+#define TRANSPORT_SOCKET_ADDRESS_H
+
+#include <cstdint>
+#include <string>
+
+#include "Event/SensorType.h"
+
+namespace Transport
+{
+
+/**
+ * @struct SocketAddress
+ * @brief Stream socket endpoint written as "tcp:<host>:<port>" or "unix:<path>"
+ *
+ * The bridge classes take addresses in this text form so a command line or
+ * configuration can pick TCP (between nodes) or a Unix socket (between
+ * processes of one node) without code changes.
+ */
+struct SocketAddress
+{
+    /**
+     * @enum Family
+     * @brief Socket family of the address
+     */
+    enum class Family : uint8_t
+    {
+        Tcp,    ///< TCP over IPv4 or IPv6
+        Unix    ///< Unix domain stream socket
+    };
+
+    Family family{Family::Tcp};   ///< Socket family
+    std::string host;             ///< Host name or address (Tcp)
+    uint16_t port{0};             ///< Port; 0 lets listen() pick one (Tcp)
+    std::string path;             ///< Socket file (Unix)
+
+    /**
+     * @brief Parses an address
+     * @param text "tcp:<host>:<port>" or "unix:<path>"; an IPv6 host is
+     *        written in brackets ("tcp:[::1]:9000")
+     * @param address Receives the parsed address
+     * @return ERROR if the text is not a valid address
+     */
+    static Event::Status parse(const std::string& text, SocketAddress& address);
+
+    /**
+     * @brief Formats the address in the form parse() accepts
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Opens a blocking stream socket connected to the address
+     * @return File descriptor, or -1 if the connection failed
+     *
+     * TCP sockets get TCP_NODELAY: the bridge batches on its own.
+     */
+    int connect() const;
+
+    /**
+     * @brief Opens a listening socket bound to the address
+     * @param backlog Pending connection limit
+     * @return File descriptor, or -1 on failure
+     *
+     * A TCP port of 0 is replaced with the port the system chose. A stale
+     * Unix socket file is removed first.
+     */
+    int listen(int backlog);
+};
+
+} // namespace Transport
+
+#endif // TRANSPORT_SOCKET_ADDRESS_H
@@ -0,0 +1,278 @@
+#ifndef UTIL_BLOCK_POOL_H
+#define UTIL_BLOCK_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Util
+{
+
+/**
+ * @class BlockPool
+ * @brief Process-wide pool of fixed-size memory blocks with per-thread caches
+ * @tparam kBlockSize Bytes per block
+ * @tparam kAlignment Alignment of every block
+ *
+ * Meant as the backing store of a class-specific operator new/delete for
+ * small objects that one thread creates and another destroys, such as
+ * events handed from a producer to the dispatcher.
+ *
+ * Each thread allocates from and frees to a cache of its own without
+ * locking. The cache holds two magazines of up to kMagazineBlocks blocks;
+ * when both are full (a thread that mostly frees) one goes to a shared
+ * depot, and when both are empty (a thread that mostly allocates) one is
+ * taken from the depot, or carved from a new slab of kSlabBlocks. The
+ * depot lock is therefore taken once per kMagazineBlocks operations.
+ *
+ * Slabs are never returned to the system: the pool keeps the peak number
+ * of live blocks, which the EventBus backpressure bounds. A thread's cache
+ * goes to the depot when the thread exits.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+template<std::size_t kBlockSize, std::size_t kAlignment = alignof(std::max_align_t)>
+class BlockPool
+{
+public:
+    static constexpr std::size_t kMagazineBlocks = 256;   ///< Blocks moved between a thread and the depot at once
+    static constexpr std::size_t kSlabBlocks = 1024;      ///< Blocks carved from one system allocation
+
+    /**
+     * @brief Gets a block
+     * @return Block of kBlockSize bytes aligned to kAlignment
+     * @throws std::bad_alloc if a new slab cannot be allocated
+     */
+    static void* allocate()
+    {
+        Cache& cache = localCache();
+        if (cache.retired) {
+            return depotAllocate();
+        }
+        if (cache.current.head == nullptr) {
+            if (cache.spare.head != nullptr) {
+                cache.current = cache.spare;
+                cache.spare = Magazine{};
+            } else {
+                cache.current = takeMagazine();
+            }
+        }
+        Block* block = cache.current.head;
+        cache.current.head = block->next;
+        cache.current.count--;
+        return block;
+    }
+
+    /**
+     * @brief Returns a block
+     * @param pointer Block obtained from allocate(), on any thread
+     */
+    static void deallocate(void* pointer) noexcept
+    {
+        Block* block = static_cast<Block*>(pointer);
+        Cache& cache = localCache();
+        if (cache.retired) {
+            depotDeallocate(block);
+            return;
+        }
+        if (cache.current.count >= kMagazineBlocks) {
+            if (cache.spare.head != nullptr) {
+                returnMagazine(cache.spare);
+            }
+            cache.spare = cache.current;
+            cache.current = Magazine{};
+        }
+        block->next = cache.current.head;
+        cache.current.head = block;
+        cache.current.count++;
+    }
+
+    /**
+     * @brief Number of slabs allocated from the system so far
+     */
+    static uint64_t slabCount()
+    {
+        Depot& shared = depot();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        return shared.slabs;
+    }
+
+private:
+    /**
+     * @union Block
+     * @brief Storage of one block; links free blocks together
+     */
+    union Block
+    {
+        Block* next;                                        ///< Next free block
+        alignas(kAlignment) unsigned char bytes[kBlockSize];   ///< Object storage
+    };
+
+    /**
+     * @struct Magazine
+     * @brief Singly linked list of free blocks
+     */
+    struct Magazine
+    {
+        Block* head{nullptr};    ///< First free block
+        std::size_t count{0};    ///< Blocks in the list
+    };
+
+    /**
+     * @struct Depot
+     * @brief Magazines shared by all threads
+     */
+    struct Depot
+    {
+        std::mutex mutex;                ///< Protects the members below
+        std::vector<Magazine> full;      ///< Magazines given back by threads
+        Magazine loose;                  ///< Blocks of exited threads, handed out one at a time
+        uint64_t slabs{0};               ///< Slabs allocated
+    };
+
+    /**
+     * @struct Cache
+     * @brief Blocks owned by one thread; trivially destructible so it outlives the Retirer
+     */
+    struct Cache
+    {
+        Magazine current;       ///< Allocated from and freed to
+        Magazine spare;         ///< Full or empty second magazine
+        bool retired{false};    ///< The thread is exiting: go through the depot
+    };
+
+    /**
+     * @struct Retirer
+     * @brief Hands the cache of an exiting thread to the depot
+     */
+    struct Retirer
+    {
+        ~Retirer()
+        {
+            Depot& shared = depot();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            for (Magazine* magazine : {&cache_.current, &cache_.spare}) {
+                if (magazine->head != nullptr) {
+                    shared.full.push_back(*magazine);
+                }
+                *magazine = Magazine{};
+            }
+            cache_.retired = true;
+        }
+    };
+
+    /**
+     * @brief Gets the depot; never destroyed, as blocks may be freed during static destruction
+     */
+    static Depot& depot()
+    {
+        static Depot* shared = new Depot();
+        return *shared;
+    }
+
+    /**
+     * @brief Gets the calling thread's cache, registering its Retirer on first use
+     */
+    static Cache& localCache()
+    {
+        thread_local Retirer retirer;
+        (void)retirer;
+        return cache_;
+    }
+
+    /**
+     * @brief Takes a magazine from the depot, carving a new slab if it has none
+     * @return Non-empty magazine
+     */
+    static Magazine takeMagazine()
+    {
+        Depot& shared = depot();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        return takeMagazineLocked(shared);
+    }
+
+    /**
+     * @brief Takes a magazine from the depot; caller holds its mutex
+     * @param shared The depot
+     * @return Non-empty magazine
+     */
+    static Magazine takeMagazineLocked(Depot& shared)
+    {
+        if (!shared.full.empty()) {
+            const Magazine magazine = shared.full.back();
+            shared.full.pop_back();
+            return magazine;
+        }
+        if (shared.loose.head != nullptr) {
+            const Magazine magazine = shared.loose;
+            shared.loose = Magazine{};
+            return magazine;
+        }
+        auto* slab = static_cast<Block*>(::operator new(kSlabBlocks * sizeof(Block), std::align_val_t(alignof(Block))));
+        shared.slabs++;
+        for (std::size_t i = 0; i + 1 < kSlabBlocks; ++i) {
+            slab[i].next = &slab[i + 1];
+        }
+        slab[kSlabBlocks - 1].next = nullptr;
+        return Magazine{slab, kSlabBlocks};
+    }
+
+    /**
+     * @brief Gives a magazine to the depot
+     * @param magazine Non-empty magazine
+     */
+    static void returnMagazine(const Magazine& magazine) noexcept
+    {
+        Depot& shared = depot();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        try {
+            shared.full.push_back(magazine);
+        } catch (...) {
+            // Keep the blocks reachable even if the vector cannot grow
+            Block* tail = magazine.head;
+            while (tail->next != nullptr) {
+                tail = tail->next;
+            }
+            tail->next = shared.loose.head;
+            shared.loose.head = magazine.head;
+            shared.loose.count += magazine.count;
+        }
+    }
+
+    /**
+     * @brief Allocates one block through the depot, for exiting threads
+     */
+    static void* depotAllocate()
+    {
+        Depot& shared = depot();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        if (shared.loose.head == nullptr) {
+            shared.loose = takeMagazineLocked(shared);
+        }
+        Block* block = shared.loose.head;
+        shared.loose.head = block->next;
+        shared.loose.count--;
+        return block;
+    }
+
+    /**
+     * @brief Frees one block through the depot, for exiting threads
+     * @param block Block to free
+     */
+    static void depotDeallocate(Block* block) noexcept
+    {
+        Depot& shared = depot();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        block->next = shared.loose.head;
+        shared.loose.head = block;
+        shared.loose.count++;
+    }
+
+    static inline thread_local Cache cache_{};   ///< Calling thread's blocks
+};
+
+} // namespace Util
+
+#endif // UTIL_BLOCK_POOL_H
@@ -0,0 +1,84 @@
+#ifndef UTIL_CLOCK_H
+#define UTIL_CLOCK_H
+
+#include <cstdint>
+
+namespace Util
+{
+
+/**
+ * @enum ClockSource
+ * @brief Hardware or OS source behind Clock::nowNs()
+ */
+enum class ClockSource {
+    Tsc,    ///< Calibrated invariant TSC, re-anchored to the monotonic clock per thread
+    Steady  ///< std::chrono::steady_clock on every call
+};
+
+/**
+ * @class Clock
+ * @brief Fast nanosecond monotonic timestamps with a wall-clock anchor
+ * 
+ * nowNs() returns nanoseconds in the steady (CLOCK_MONOTONIC) domain, which is
+ * shared by all processes on a Linux host. On x86 CPUs with an invariant TSC
+ * it reads the TSC and scales it with a calibrated multiplier; each thread
+ * re-anchors against the monotonic clock every kResyncIntervalNs so
+ * calibration error cannot accumulate. Readings are non-decreasing per thread.
+ * Without an invariant TSC it falls back to std::chrono::steady_clock.
+ * 
+ * Monotonic stamps are what events and the EventBus carry internally. For
+ * display and persistence they are converted with toWallNs(), which adds an
+ * offset between the system and steady clocks captured once (see
+ * resyncWallAnchor()).
+ * 
+ * Thread Safety: All methods are thread-safe.
+ */
+class Clock
+{
+public:
+    static constexpr int64_t kNanosPerSecond = 1000000000;       ///< Nanoseconds per second
+    static constexpr int64_t kResyncIntervalNs = 100000000;      ///< Per-thread TSC re-anchor period (100 ms)
+
+    /**
+     * @brief Current monotonic time
+     * @return Nanoseconds in the steady clock domain
+     */
+    static int64_t nowNs();
+
+    /**
+     * @brief Current wall-clock time derived from the monotonic clock
+     * @return Nanoseconds since the Unix epoch
+     */
+    static int64_t wallNowNs();
+
+    /**
+     * @brief Converts a monotonic timestamp to wall-clock time
+     * @param monotonic_ns Timestamp returned by nowNs()
+     * @return Nanoseconds since the Unix epoch
+     */
+    static int64_t toWallNs(int64_t monotonic_ns);
+
+    /**
+     * @brief Converts a wall-clock timestamp back to the monotonic domain
+     * @param wall_ns Nanoseconds since the Unix epoch
+     * @return Timestamp comparable with nowNs()
+     */
+    static int64_t fromWallNs(int64_t wall_ns);
+
+    /**
+     * @brief Re-captures the offset between the system and steady clocks
+     * 
+     * Call after the system clock has been stepped (e.g. by NTP) so that
+     * toWallNs() follows it. Monotonic timestamps are unaffected.
+     */
+    static void resyncWallAnchor();
+
+    /**
+     * @brief Gets the source used by nowNs()
+     */
+    static ClockSource source();
+};
+
+} // namespace Util
+
+#endif // UTIL_CLOCK_H
@@ -0,0 +1,141 @@
+#ifndef UTIL_INTERN_TABLE_H
+#define UTIL_INTERN_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Util
+{
+
+/**
+ * @class InternTable
+ * @brief Concurrent string intern table mapping names to dense 32-bit ids
+ * 
+ * The first distinct name interned gets id 0, the next id 1 and so on, so
+ * ids can index flat per-name arrays. Names are stored once; records and
+ * events carry only the id and fetch the string when rendering.
+ * 
+ * Readers (find(), name(), and intern() of a name that already exists) are
+ * lock-free: the hash index is an open-addressing array of atomic slots and
+ * names live in fixed-size chunks that never move. Writers serialise on a
+ * mutex. When the index passes half full, a writer builds a table of twice
+ * the capacity and publishes it with a single atomic store; replaced tables
+ * are kept until the InternTable is destroyed so in-flight readers stay
+ * valid (total index memory stays below twice the final table).
+ * 
+ * Thread Safety: All methods are thread-safe.
+ */
+class InternTable
+{
+public:
+    static constexpr uint32_t kInvalidId = UINT32_MAX;    ///< Returned when the table is full
+    static constexpr std::size_t kChunkSize = 1024;        ///< Names per storage chunk
+    static constexpr std::size_t kMaxChunks = 4096;        ///< Capacity limit: kChunkSize * kMaxChunks names
+
+    /**
+     * @brief Constructs an empty table
+     */
+    InternTable();
+
+    /**
+     * @brief Releases all names and index tables
+     */
+    ~InternTable();
+
+    InternTable(const InternTable&) = delete;
+    InternTable& operator=(const InternTable&) = delete;
+
+    /**
+     * @brief Gets the id of a name, adding it if necessary
+     * @param name Name to intern
+     * @return Dense id of name, or kInvalidId if the table is full
+     */
+    uint32_t intern(std::string_view name);
+
+    /**
+     * @brief Looks up a name without adding it
+     * @param name Name to look up
+     * @param id Receives the id on success
+     * @return true if name has been interned
+     */
+    bool find(std::string_view name, uint32_t& id) const;
+
+    /**
+     * @brief Gets the name of an id
+     * @param id Id returned by intern()
+     * @return The interned name, or an empty view for an unknown id
+     * 
+     * The view stays valid for the lifetime of the table.
+     */
+    std::string_view name(uint32_t id) const;
+
+    /**
+     * @brief Number of interned names; valid ids are [0, size())
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Process-wide table used for device ids
+     */
+    static InternTable& global();
+
+private:
+    /**
+     * @struct Entry
+     * @brief Immutable stored name with its hash
+     */
+    struct Entry
+    {
+        std::string name;   ///< Interned name
+        uint64_t hash{0};   ///< Hash of name
+    };
+
+    /**
+     * @struct Index
+     * @brief Open-addressing hash index; slot value is id + 1, 0 when empty
+     */
+    struct Index
+    {
+        explicit Index(std::size_t capacity);
+
+        std::size_t mask;                                  ///< capacity - 1 (capacity is a power of two)
+        std::unique_ptr<std::atomic<uint32_t>[]> slots;    ///< Slot array
+    };
+
+    /**
+     * @brief Hashes a name (FNV-1a, 64-bit)
+     */
+    static uint64_t hash(std::string_view name);
+
+    /**
+     * @brief Gets the stored entry for an id, or nullptr
+     */
+    const Entry* entry(uint32_t id) const;
+
+    /**
+     * @brief Probes an index for a name
+     * @return id on success, kInvalidId if absent
+     */
+    uint32_t probe(const Index& index, std::string_view name, uint64_t name_hash) const;
+
+    /**
+     * @brief Inserts an id into an index (writer only)
+     */
+    static void place(Index& index, uint32_t id, uint64_t name_hash);
+
+    std::atomic<Entry*> chunks_[kMaxChunks];            ///< Name storage, allocated on demand
+    std::atomic<Index*> index_;                         ///< Current hash index
+    std::atomic<uint32_t> size_;                        ///< Number of interned names
+    std::mutex write_mutex_;                            ///< Serialises writers
+    std::vector<std::unique_ptr<Index>> indexes_;       ///< Every index ever published (writer only)
+};
+
+} // namespace Util
+
+#endif // UTIL_INTERN_TABLE_H
@@ -0,0 +1,97 @@
+#ifndef UTIL_PCG_32_H
+#define UTIL_PCG_32_H
+
+#include <cstdint>
+#include <limits>
+
+#include "RandomDistributions.h"
+
+namespace Util
+{
+
+/**
+ * @class Pcg32
+ * @brief PCG-XSH-RR 64/32 generator with selectable streams
+ * 
+ * A 64-bit LCG with a permuted 32-bit output. Generators constructed with
+ * the same seed but different stream selectors produce independent
+ * sequences, and advance() jumps ahead by any distance in O(log n), so a
+ * single seed can be fanned out by stream index or by offset.
+ */
+class Pcg32 : public RandomDistributions<Pcg32>
+{
+public:
+    using result_type = uint32_t; ///< Type of a single draw
+
+    /**
+     * @brief Constructs a generator on a given stream
+     * @param seed Starting state
+     * @param stream Stream selector; only the low 63 bits are significant
+     */
+    Pcg32(uint64_t seed, uint64_t stream = 0)
+        : state_(0),
+        increment_((stream << 1u) | 1u)
+    {
+        next32();
+        state_ += seed;
+        next32();
+    }
+
+    /** @brief Smallest value returned by operator() */
+    static constexpr result_type min() { return 0; }
+
+    /** @brief Largest value returned by operator() */
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief Returns the next 32-bit draw
+     */
+    uint32_t next32()
+    {
+        const uint64_t old_state = state_;
+        state_ = old_state * kMultiplier + increment_;
+        const uint32_t xorshifted = static_cast<uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+        const uint32_t rot = static_cast<uint32_t>(old_state >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    /** @brief Same as next32(), for UniformRandomBitGenerator */
+    result_type operator()()
+    {
+        return next32();
+    }
+
+    /**
+     * @brief Jumps ahead as if next32() had been called delta times
+     * @param delta Number of draws to skip
+     */
+    void advance(uint64_t delta)
+    {
+        uint64_t cur_mult = kMultiplier;
+        uint64_t cur_plus = increment_;
+        uint64_t acc_mult = 1u;
+        uint64_t acc_plus = 0u;
+        while (delta > 0)
+        {
+            if (delta & 1u)
+            {
+                acc_mult *= cur_mult;
+                acc_plus = acc_plus * cur_mult + cur_plus;
+            }
+            cur_plus = (cur_mult + 1) * cur_plus;
+            cur_mult *= cur_mult;
+            delta /= 2;
+        }
+        state_ = acc_mult * state_ + acc_plus;
+    }
+
+private:
+    static constexpr uint64_t kMultiplier = 6364136223846793005ull; ///< LCG multiplier
+
+    uint64_t state_;      ///< LCG state
+    uint64_t increment_;  ///< Odd LCG increment, selects the stream
+};
+
+} // namespace Util
+
+#endif // UTIL_PCG_32_H
@@ -0,0 +1,110 @@
+#ifndef UTIL_RANDOM_DISTRIBUTIONS_H
+#define UTIL_RANDOM_DISTRIBUTIONS_H
+
+#include <cstdint>
+#include <cassert>
+
+namespace Util
+{
+
+/**
+ * @class RandomDistributions
+ * @brief Integer distributions shared by all generators in Util
+ * 
+ * CRTP mixin providing uniform_dist(), one_in() and skewed() on top of any
+ * generator exposing a public `uint32_t next32()` member. Keeps the
+ * distribution logic identical across RandomNumberGenerator, Xoshiro256,
+ * Xoshiro128 and Pcg32.
+ * 
+ * @tparam Derived The generator class deriving from this mixin
+ */
+template<typename Derived>
+class RandomDistributions
+{
+public:
+    /**
+     * @brief Generates a uniformly distributed random integer in the range [0, n)
+     * @param n Upper bound (exclusive) for the random number range. Must be positive.
+     * @return Random integer in [0, n), or 0 if n <= 0
+     * 
+     * Uses optimized bitwise operations for power-of-two ranges, otherwise
+     * uses multiplication and bit shifting for uniform distribution.
+     * 
+     * @warning Asserts if n <= 0 in debug builds
+     */
+    uint32_t uniform_dist(int n)
+    {
+        if (n <= 0)
+        {
+            assert(false && "n must be positive");
+            return 0;
+        }
+
+        if ((n & (n - 1)) == 0)
+        {
+            return draw32() & (n - 1);
+        }
+
+        return (static_cast<uint64_t>(draw32()) * static_cast<uint64_t>(n)) >> 32;
+    }
+
+    /**
+     * @brief Returns true with 1/n probability
+     * @param n Denominator of probability. Must be positive.
+     * @return true with probability 1/n, false otherwise
+     * 
+     * This method is useful for simulating rare events. For example, one_in(100)
+     * returns true approximately 1% of the time.
+     * 
+     * @warning Asserts if n <= 0 in debug builds
+     */
+    bool one_in(int n)
+    {
+        if (n <= 0)
+        {
+            assert(false && "n must be positive");
+            return false;
+        }
+        return (uniform_dist(n) == 0);
+    }
+
+    /**
+     * @brief Generates a skewed random number with exponential distribution
+     * @param max_log Maximum exponent for the range. Must be non-negative.
+     * @return Random number with skewed distribution favoring smaller values
+     * 
+     * Returns a random number in the range [0, 2^k) where k is randomly chosen
+     * from [0, max_log]. This creates a distribution heavily skewed toward smaller
+     * values, useful for simulating realistic load patterns.
+     * 
+     * @warning Asserts if max_log < 0 in debug builds
+     */
+    uint32_t skewed(int max_log)
+    {
+        if (max_log < 0)
+        {
+            assert(false && "max_log must be non-negative");
+            return 0;
+        }
+        return uniform_dist(1 << uniform_dist(max_log + 1));
+    }
+
+protected:
+    /**
+     * @brief Protected destructor - the mixin is never used on its own
+     */
+    ~RandomDistributions() = default;
+
+private:
+    /**
+     * @brief Draws the next 32 random bits from the derived generator
+     */
+    uint32_t draw32()
+    {
+        return static_cast<Derived*>(this)->next32();
+    }
+};
+
+} // namespace Util
+
+#endif // UTIL_RANDOM_DISTRIBUTIONS_H
@@ -2,18 +2,35 @@
 #define RAND_H
 
 #include <cstdint>
+#include <cstddef>
 #include <cassert>
 
+#include "RandomDistributions.h"
+
 namespace Util
 {
 
+/**
+ * @enum SimdLevel
+ * @brief Instruction set used by the bulk RandomNumberGenerator APIs
+ * 
+ * All levels produce bit-identical output for the same seed; they only
+ * differ in speed.
+ */
+enum class SimdLevel {
+    Scalar,  ///< Portable C++ loop over the lanes
+    SSE2,    ///< Two 128-bit vectors of four lanes each
+    AVX2     ///< One 256-bit vector of eight lanes
+};
+
 /**
  * @class RandomNumberGenerator
  * @brief Fast pseudorandom number generator using XorShift32 algorithm
  * 
  * This class provides a simple yet efficient pseudorandom number generator based on
  * the XorShift32 algorithm. It offers methods to generate uniformly distributed integers,
- * check for one-in-n probability events, and generate skewed distributions.
+ * check for one-in-n probability events, and generate skewed distributions
+ * (see RandomDistributions).
  * 
  * The generator is designed for simulation purposes and provides good statistical properties
  * while maintaining high performance through bitwise operations.
@@ -21,7 +38,7 @@ namespace Util
  * @author vabarob
  * @date 2026-01
  */
-class RandomNumberGenerator
+class RandomNumberGenerator : public RandomDistributions<RandomNumberGenerator>
 {
 public:
     /**
@@ -40,73 +57,94 @@ public:
     }
 
     /**
-     * @brief Generates a uniformly distributed random integer in the range [0, n)
-     * @param n Upper bound (exclusive) for the random number range. Must be positive.
-     * @return Random integer in [0, n), or 0 if n <= 0
-     * 
-     * Uses optimized bitwise operations for power-of-two ranges, otherwise
-     * uses multiplication and bit shifting for uniform distribution.
-     * 
-     * @warning Asserts if n <= 0 in debug builds
+     * @brief Draws the next 32 random bits
+     * @return Next value of the XorShift32 sequence
      */
-    uint32_t uniform_dist(int n)
+    uint32_t next32()
     {
-        if (n <= 0)
-        {
-            assert(false && "n must be positive");
-            return 0;
-        }
+        return xorshift32();
+    }
 
-        if ((n & (n - 1)) == 0)
-        {
-            return xorshift32() & (n - 1);
-        }
+    /**
+     * @brief Number of independent XorShift32 lanes used by the bulk APIs
+     */
+    static constexpr std::size_t kBulkLanes = 8;
 
-        return (static_cast<uint64_t>(xorshift32()) * static_cast<uint64_t>(n)) >> 32;
-    }
+    /**
+     * @brief Fills a span with uniformly distributed 32-bit integers
+     * @param out Destination array
+     * @param count Number of values to write
+     * 
+     * Bulk APIs run kBulkLanes XorShift32 lanes, each covering its own
+     * block of this generator's next count draws, so a fill consumes
+     * exactly the draws next32() would have returned, in a different
+     * order. Element k of the span comes from lane k % kBulkLanes, so the
+     * output only depends on the seed and the sequence of calls, never on
+     * the SIMD level in use.
+     */
+    void fill_uniform(uint32_t* out, std::size_t count);
 
     /**
-     * @brief Returns true with 1/n probability
+     * @brief Fills a span with uniformly distributed integers in [0, n)
+     * @param out Destination array
+     * @param count Number of values to write
+     * @param n Upper bound (exclusive). Must be positive.
+     * 
+     * Unlike uniform_dist(), power-of-two bounds are not special-cased:
+     * every value is (x * n) >> 32, which keeps the loop branch-free.
+     * 
+     * @warning Asserts if n == 0 in debug builds
+     */
+    void fill_uniform_dist(uint32_t* out, std::size_t count, uint32_t n);
+
+    /**
+     * @brief Fills a span with Bernoulli flags that are 1 with probability 1/n
+     * @param out Destination array, receives 0 or 1 per element
+     * @param count Number of flags to write
      * @param n Denominator of probability. Must be positive.
-     * @return true with probability 1/n, false otherwise
      * 
-     * This method is useful for simulating rare events. For example, one_in(100)
-     * returns true approximately 1% of the time.
+     * A flag is set exactly when fill_uniform_dist() with the same bound
+     * would have produced 0.
      * 
-     * @warning Asserts if n <= 0 in debug builds
+     * @warning Asserts if n == 0 in debug builds
      */
-    bool one_in(int n)
-    {
-        if (n <= 0)
-        {
-            assert(false && "n must be positive");
-            return false;
-        }
-        return (uniform_dist(n) == 0);
-    }
+    void fill_one_in(uint8_t* out, std::size_t count, uint32_t n);
 
     /**
-     * @brief Generates a skewed random number with exponential distribution
-     * @param max_log Maximum exponent for the range. Must be non-negative.
-     * @return Random number with skewed distribution favoring smaller values
+     * @brief Fills a span with uniformly distributed doubles in [0, 1)
+     * @param out Destination array
+     * @param count Number of values to write
      * 
-     * Returns a random number in the range [0, 2^k) where k is randomly chosen
-     * from [0, max_log]. This creates a distribution heavily skewed toward smaller
-     * values, useful for simulating realistic load patterns.
+     * Each double is built from one 32-bit draw, giving a resolution of 2^-32.
+     */
+    void fill_double(double* out, std::size_t count);
+
+    /**
+     * @brief Gets the SIMD level currently used by the bulk APIs
+     * @return The best level supported by the CPU unless overridden
+     */
+    static SimdLevel bulk_simd_level();
+
+    /**
+     * @brief Overrides the SIMD level used by the bulk APIs
+     * @param level Requested level; clamped to what the CPU supports
      * 
-     * @warning Asserts if max_log < 0 in debug builds
+     * Mainly useful for testing and benchmarking the individual paths.
      */
-    uint32_t skewed(int max_log)
-    {
-        if (max_log < 0)
-        {
-            assert(false && "max_log must be non-negative");
-            return 0;
-        }
-        return uniform_dist(1 << uniform_dist(max_log + 1));
-    }
+    static void set_bulk_simd_level(SimdLevel level);
 
 private:
+    /**
+     * @brief Seeds the bulk lanes from the scalar generator
+     * @param lanes Receives kBulkLanes non-zero lane states
+     * @param count Number of values the bulk call will produce
+     *
+     * Lane j starts j * ceil(count / kBulkLanes) steps into this generator's
+     * sequence, so the lanes walk disjoint blocks of it; the generator is
+     * then advanced past all of them.
+     */
+    void seed_lanes(uint32_t* lanes, std::size_t count);
+
     /**
      * @brief Core XorShift32 algorithm implementation
      * @return Next random 32-bit integer in the sequence
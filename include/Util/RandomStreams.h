@@ -0,0 +1,77 @@
+#ifndef UTIL_RANDOM_STREAMS_H
+#define UTIL_RANDOM_STREAMS_H
+
+#include <cstdint>
+#include <mutex>
+
+#include "Xoshiro256.h"
+
+namespace Util
+{
+
+/**
+ * @class RandomStreams
+ * @brief Fans a single master seed out into non-overlapping generator streams
+ * 
+ * Stream k is Xoshiro256(master_seed) advanced by k jumps of 2^128 draws, so
+ * every stream is disjoint from the others and the whole simulation is
+ * reproducible from one 64-bit seed. Streams are handed out either in
+ * sequence with next() or by index with stream().
+ * 
+ * Simulators take their stream once at construction; the global instance
+ * replaces per-object std::random_device seeding, which is slow and may
+ * block on some platforms.
+ * 
+ * Thread Safety: All public methods are thread-safe. For reproducible runs
+ * next() must be called in a deterministic order (e.g. while building
+ * simulators on the main thread).
+ */
+class RandomStreams
+{
+public:
+    static constexpr uint64_t kDefaultSeed = 0x5eed0f5e75e11505ull; ///< Master seed used unless overridden
+
+    /**
+     * @brief Constructs a stream factory
+     * @param master_seed Seed from which every stream is derived
+     */
+    explicit RandomStreams(uint64_t master_seed = kDefaultSeed);
+
+    /**
+     * @brief Gets the master seed
+     */
+    uint64_t seed() const;
+
+    /**
+     * @brief Restarts the fan-out from a new master seed
+     * @param master_seed New master seed; the next call to next() returns stream 0
+     */
+    void reseed(uint64_t master_seed);
+
+    /**
+     * @brief Hands out the next unused stream
+     * @return Stream k, where k is the number of previous next() calls since (re)seeding
+     */
+    Xoshiro256 next();
+
+    /**
+     * @brief Computes a stream by index, independent of next()
+     * @param index Stream index
+     * @return Stream index, costing index jumps
+     */
+    Xoshiro256 stream(uint64_t index) const;
+
+    /**
+     * @brief Process-wide stream factory used by the simulators
+     */
+    static RandomStreams& global();
+
+private:
+    mutable std::mutex mutex_;  ///< Protects the fields below
+    uint64_t seed_;             ///< Master seed
+    Xoshiro256 root_;           ///< Start of the next stream to hand out
+};
+
+} // namespace Util
+
+#endif // UTIL_RANDOM_STREAMS_H
@@ -0,0 +1,43 @@
+#ifndef UTIL_SPLIT_MIX_64_H
+#define UTIL_SPLIT_MIX_64_H
+
+#include <cstdint>
+
+namespace Util
+{
+
+/**
+ * @class SplitMix64
+ * @brief 64-bit seed expander used to initialize the larger-state generators
+ * 
+ * Turns a single 64-bit seed into a well-mixed stream of 64-bit words, as
+ * recommended by the xoshiro authors for filling xoshiro state. Any seed,
+ * including zero, yields a usable sequence.
+ */
+class SplitMix64
+{
+public:
+    /**
+     * @brief Constructs the expander from a seed
+     * @param seed Any 64-bit value
+     */
+    explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+    /**
+     * @brief Returns the next 64-bit word of the sequence
+     */
+    uint64_t next()
+    {
+        uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t state_; ///< Weyl sequence counter
+};
+
+} // namespace Util
+
+#endif // UTIL_SPLIT_MIX_64_H
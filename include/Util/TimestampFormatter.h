@@ -0,0 +1,110 @@
+#ifndef UTIL_TIMESTAMP_FORMATTER_H
+#define UTIL_TIMESTAMP_FORMATTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Util
+{
+
+/**
+ * @enum TimestampPrecision
+ * @brief Number of fractional-second digits written by TimestampFormatter
+ */
+enum class TimestampPrecision : uint8_t {
+    Seconds = 0,  ///< "14:30:45"
+    Millis = 3,   ///< "14:30:45.123"
+    Micros = 6,   ///< "14:30:45.123456"
+    Nanos = 9     ///< "14:30:45.123456789"
+};
+
+/**
+ * @enum TimestampZone
+ * @brief Time zone used by TimestampFormatter
+ */
+enum class TimestampZone : uint8_t {
+    Local,  ///< Local time with a "+hh:mm" offset suffix
+    Utc     ///< UTC with a "Z" suffix
+};
+
+/**
+ * @class TimestampFormatter
+ * @brief ISO-8601 formatter for nanosecond wall-clock timestamps
+ * 
+ * Produces "YYYY-MM-DDTHH:MM:SS[.fff...]" followed by "Z" or "+hh:mm".
+ * The broken-down date ("YYYY-MM-DDTHH:MM:") and zone suffix are computed
+ * with localtime_r/gmtime_r once per minute and cached; formatting another
+ * timestamp within the same minute only writes the seconds and fraction
+ * digits. Output goes to a caller-provided buffer, so no allocation occurs.
+ * 
+ * Local time offsets are assumed to change only on minute boundaries, which
+ * holds for every zone in use today.
+ * 
+ * Example usage:
+ * @code
+ * Util::TimestampFormatter formatter(Util::TimestampPrecision::Micros);
+ * char buffer[Util::TimestampFormatter::kBufferSize];
+ * formatter.format(Util::Clock::wallNowNs(), buffer, sizeof(buffer));
+ * @endcode
+ * 
+ * Thread Safety: Not thread-safe; keep one instance per thread.
+ */
+class TimestampFormatter
+{
+public:
+    /// Buffer size that fits any output, including the terminating NUL
+    static constexpr std::size_t kBufferSize = 36;
+
+    /**
+     * @brief Constructs a formatter
+     * @param precision Fractional-second digits to write
+     * @param zone Local time with offset, or UTC
+     */
+    explicit TimestampFormatter(TimestampPrecision precision = TimestampPrecision::Millis,
+                                TimestampZone zone = TimestampZone::Local);
+
+    /**
+     * @brief Formats a timestamp into a caller-provided buffer
+     * @param wall_ns Nanoseconds since the Unix epoch
+     * @param buffer Destination, NUL-terminated on success
+     * @param size Size of buffer in bytes
+     * @return Number of characters written (excluding the NUL), or 0 if the
+     *         buffer is too small (buffer is then left untouched)
+     */
+    std::size_t format(int64_t wall_ns, char* buffer, std::size_t size);
+
+    /**
+     * @brief Gets the configured precision
+     */
+    TimestampPrecision getPrecision() const {
+        return precision_;
+    }
+
+    /**
+     * @brief Gets the configured time zone
+     */
+    TimestampZone getZone() const {
+        return zone_;
+    }
+
+private:
+    static constexpr std::size_t kPrefixLength = 17;  ///< Length of "YYYY-MM-DDTHH:MM:"
+    static constexpr int64_t kNoMinute = INT64_MIN;   ///< Cache sentinel
+
+    /**
+     * @brief Recomputes the cached prefix and suffix for a minute
+     * @param minute Minutes since the Unix epoch
+     */
+    void refresh(int64_t minute);
+
+    TimestampPrecision precision_;   ///< Fractional-second digits
+    TimestampZone zone_;             ///< Output time zone
+    int64_t cached_minute_;          ///< Minute the cache was computed for
+    char prefix_[kPrefixLength];     ///< Cached "YYYY-MM-DDTHH:MM:"
+    char suffix_[7];                 ///< Cached "Z" or "+hh:mm"
+    std::size_t suffix_length_;      ///< Characters used in suffix_
+};
+
+} // namespace Util
+
+#endif // UTIL_TIMESTAMP_FORMATTER_H
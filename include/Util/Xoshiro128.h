@@ -0,0 +1,136 @@
+#ifndef UTIL_XOSHIRO_128_H
+#define UTIL_XOSHIRO_128_H
+
+#include <cstdint>
+#include <limits>
+
+#include "RandomDistributions.h"
+#include "SplitMix64.h"
+
+namespace Util
+{
+
+/**
+ * @class Xoshiro128
+ * @brief xoshiro128++ generator: 32-bit outputs with jumpable 128-bit state
+ * 
+ * The 32-bit counterpart of Xoshiro256, with a period of 2^128 - 1. Its
+ * operations are all 32-bit, so many independent states stored as parallel
+ * arrays (see SensorSimulator::SimulatorBank) can be stepped in one
+ * vectorized loop. jump() advances by 2^64 draws, giving non-overlapping
+ * per-lane streams.
+ */
+class Xoshiro128 : public RandomDistributions<Xoshiro128>
+{
+public:
+    using result_type = uint32_t; ///< Type of a single draw
+
+    /**
+     * @brief Constructs a generator from a 64-bit seed
+     * @param seed Any value; expanded into the full state with SplitMix64
+     */
+    explicit Xoshiro128(uint64_t seed)
+    {
+        SplitMix64 expander(seed);
+        const uint64_t lo = expander.next();
+        const uint64_t hi = expander.next();
+        state_[0] = static_cast<uint32_t>(lo);
+        state_[1] = static_cast<uint32_t>(lo >> 32);
+        state_[2] = static_cast<uint32_t>(hi);
+        state_[3] = static_cast<uint32_t>(hi >> 32);
+    }
+
+    /** @brief Smallest value returned by operator() */
+    static constexpr result_type min() { return 0; }
+
+    /** @brief Largest value returned by operator() */
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief Returns the next 32-bit draw
+     */
+    uint32_t next32()
+    {
+        return step(state_[0], state_[1], state_[2], state_[3]);
+    }
+
+    /** @brief Same as next32(), for UniformRandomBitGenerator */
+    result_type operator()()
+    {
+        return next32();
+    }
+
+    /**
+     * @brief Advances one xoshiro128++ state held in separate words
+     * @return The draw produced by this step
+     * 
+     * Shared by next32() and by structure-of-arrays users that keep the
+     * four state words of many generators in parallel arrays.
+     */
+    static uint32_t step(uint32_t& s0, uint32_t& s1, uint32_t& s2, uint32_t& s3)
+    {
+        const uint32_t result = rotl(s0 + s3, 7) + s0;
+        const uint32_t t = s1 << 9;
+
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = rotl(s3, 11);
+
+        return result;
+    }
+
+    /**
+     * @brief Advances the state by 2^64 draws
+     */
+    void jump()
+    {
+        static constexpr uint32_t kJump[] = { 0x8764000bu, 0xf542d2d3u, 0x6fa035c3u, 0x77f2db5bu };
+
+        uint32_t s0 = 0;
+        uint32_t s1 = 0;
+        uint32_t s2 = 0;
+        uint32_t s3 = 0;
+        for (uint32_t word : kJump)
+        {
+            for (int bit = 0; bit < 32; ++bit)
+            {
+                if (word & (1u << bit))
+                {
+                    s0 ^= state_[0];
+                    s1 ^= state_[1];
+                    s2 ^= state_[2];
+                    s3 ^= state_[3];
+                }
+                next32();
+            }
+        }
+        state_[0] = s0;
+        state_[1] = s1;
+        state_[2] = s2;
+        state_[3] = s3;
+    }
+
+    /**
+     * @brief Gets one word of the state
+     * @param index Word index in [0, 4)
+     */
+    uint32_t state(int index) const
+    {
+        return state_[index];
+    }
+
+private:
+    static uint32_t rotl(uint32_t x, int k)
+    {
+        return (x << k) | (x >> (32 - k));
+    }
+
+    uint32_t state_[4]; ///< Generator state, never all zero
+};
+
+} // namespace Util
+
+#endif // UTIL_XOSHIRO_128_H
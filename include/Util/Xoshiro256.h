@@ -0,0 +1,175 @@
+#ifndef UTIL_XOSHIRO_256_H
+#define UTIL_XOSHIRO_256_H
+
+#include <cstdint>
+#include <limits>
+
+#include "RandomDistributions.h"
+#include "SplitMix64.h"
+
+namespace Util
+{
+
+/**
+ * @class Xoshiro256
+ * @brief xoshiro256++ generator with jump functions for parallel streams
+ * 
+ * 256 bits of state and a period of 2^256 - 1. jump() advances the state by
+ * 2^128 draws and long_jump() by 2^192, so copies taken between jumps are
+ * non-overlapping streams: split() returns the current stream and moves this
+ * generator to the next one. This is the generator RandomStreams hands out
+ * to simulators.
+ * 
+ * Satisfies the standard UniformRandomBitGenerator requirements, so it can
+ * also drive <random> distributions.
+ */
+class Xoshiro256 : public RandomDistributions<Xoshiro256>
+{
+public:
+    using result_type = uint64_t; ///< Type of a single draw
+
+    /**
+     * @brief Constructs a generator from a 64-bit seed
+     * @param seed Any value; expanded into the full state with SplitMix64
+     */
+    explicit Xoshiro256(uint64_t seed)
+    {
+        SplitMix64 expander(seed);
+        for (uint64_t& word : state_)
+        {
+            word = expander.next();
+        }
+    }
+
+    /** @brief Smallest value returned by operator() */
+    static constexpr result_type min() { return 0; }
+
+    /** @brief Largest value returned by operator() */
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief Returns the next 64-bit draw
+     */
+    uint64_t next()
+    {
+        const uint64_t result = rotl(state_[0] + state_[3], 23) + state_[0];
+        const uint64_t t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+
+        return result;
+    }
+
+    /**
+     * @brief Returns the upper 32 bits of the next draw
+     */
+    uint32_t next32()
+    {
+        return static_cast<uint32_t>(next() >> 32);
+    }
+
+    /** @brief Same as next(), for UniformRandomBitGenerator */
+    result_type operator()()
+    {
+        return next();
+    }
+
+    /**
+     * @brief Advances the state by 2^128 draws
+     */
+    void jump()
+    {
+        static constexpr uint64_t kJump[] = {
+            0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+        };
+        applyJump(kJump);
+    }
+
+    /**
+     * @brief Advances the state by 2^192 draws
+     * 
+     * Useful to carve out 2^64 top-level partitions (e.g. one per process)
+     * that can each be split further with jump().
+     */
+    void long_jump()
+    {
+        static constexpr uint64_t kLongJump[] = {
+            0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull, 0x77710069854ee241ull, 0x39109bb02acbe635ull
+        };
+        applyJump(kLongJump);
+    }
+
+    /**
+     * @brief Returns the current stream and advances this generator past it
+     * @return A copy of this generator taken before jump()
+     * 
+     * The returned generator can produce 2^128 draws before reaching the
+     * state this generator continues from.
+     */
+    Xoshiro256 split()
+    {
+        Xoshiro256 child = *this;
+        jump();
+        return child;
+    }
+
+    /** @brief Compares full generator states */
+    bool operator==(const Xoshiro256& other) const
+    {
+        return state_[0] == other.state_[0] && state_[1] == other.state_[1]
+            && state_[2] == other.state_[2] && state_[3] == other.state_[3];
+    }
+
+    /** @brief Compares full generator states */
+    bool operator!=(const Xoshiro256& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    /**
+     * @brief Applies a jump polynomial to the state
+     * @param polynomial Four 64-bit words describing the jump distance
+     */
+    void applyJump(const uint64_t (&polynomial)[4])
+    {
+        uint64_t s0 = 0;
+        uint64_t s1 = 0;
+        uint64_t s2 = 0;
+        uint64_t s3 = 0;
+        for (uint64_t word : polynomial)
+        {
+            for (int bit = 0; bit < 64; ++bit)
+            {
+                if (word & (1ull << bit))
+                {
+                    s0 ^= state_[0];
+                    s1 ^= state_[1];
+                    s2 ^= state_[2];
+                    s3 ^= state_[3];
+                }
+                next();
+            }
+        }
+        state_[0] = s0;
+        state_[1] = s1;
+        state_[2] = s2;
+        state_[3] = s3;
+    }
+
+    uint64_t state_[4]; ///< Generator state, never all zero
+};
+
+} // namespace Util
+
+#endif // UTIL_XOSHIRO_256_H
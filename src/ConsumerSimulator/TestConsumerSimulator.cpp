@@ -1,6 +1,7 @@
 #include <thread>
 #include "ConsumerSimulator/TestConsumerSimulator.h"
 #include "Event/SensorEvent.h"
+#include "Util/TimestampFormatter.h"
 
 /**
  * @brief Processes incoming events and logs sensor data
@@ -15,22 +16,26 @@
  */
 void ConsumerSimulator::TestConsumerSimulator::onEvent(const Event::Event& event)
 {
-    if (const auto* sensor_event = dynamic_cast<const Event::SensorEvent*>(&event)) {
+    if (const auto* sensor_event = Event::event_cast<Event::SensorEvent>(event)) {
+        // Format once per event into a stack buffer; both reports reuse it
+        char timestamp[Util::TimestampFormatter::kBufferSize];
+        sensor_event->formatTimestamp(timestamp, sizeof(timestamp));
+
         // Process the sensor event
         if (sensor_event->getSensorType() == Event::SensorType::CoSensor) {
             std::cout << "----------------------------------------" << "\n";
             std::cout << "Processing SensorEvent in TestConsumerSimulator." << "\n";
-            std::cout << "Device ID: " << sensor_event->getDeviceId() << "\n";
-            std::cout << "Timestamp: " << sensor_event->getTimestampString() << "\n";
-            std::cout << "Value: " << sensor_event->getValue() << "\n";
+            std::cout << "Device ID: " << sensor_event->getDeviceName() << "\n";
+            std::cout << "Timestamp: " << timestamp << "\n";
+            std::cout << "Value: " << sensor_event->getValue() << " " << sensor_event->getUnit() << "\n";
             std::cout << "----------------------------------------" << "\r\n";
         }
 
         if (!sensor_event->getValue()) {
             std::cout << "----------------------------------------" << "\n";
             std::cout << "THERE WAS A FAILURE IN THIS SENSOR." << "\n";
-            std::cout << "Device ID: " << sensor_event->getDeviceId() << "\n";
-            std::cout << "Timestamp: " << sensor_event->getTimestampString() << "\n";
+            std::cout << "Device ID: " << sensor_event->getDeviceName() << "\n";
+            std::cout << "Timestamp: " << timestamp << "\n";
             std::cout << "Value: " << sensor_event->getValue() << "\n";
             std::cout << "----------------------------------------" << "\r\n";
         }
@@ -0,0 +1,68 @@
+#include <iostream>
+
+#include "Event/SensorType.h"
+#include "Event/SensorTraits.h"
+#include "Util/InternTable.h"
+
+/**
+ * @brief Copies the traits of a sensor type known only at run time
+ * @param type Sensor type to describe
+ * @param traits Receives the row on success
+ * @return Status::OK on success, Status::ERROR for unknown type
+ */
+Event::Status Event::getSensorTraits(SensorType type, SensorTraits& traits)
+{
+    const SensorTraits* row = findSensorTraits(type);
+    if (!row) {
+        std::cout << "Unknown sensor type!" << "\n";
+        return Status::ERROR;
+    }
+    traits = *row;
+    return Status::OK;
+}
+
+/**
+ * @brief Gets the display name of a sensor type
+ * @param type Sensor type
+ * @return Static type name, or "Unknown" for an invalid type
+ */
+const char* Event::getSensorTypeName(SensorType type)
+{
+    const SensorTraits* row = findSensorTraits(type);
+    return row ? row->name : "Unknown";
+}
+
+/**
+ * @brief Renders a device ID as "<SensorType>_<number>"
+ * @param type Type of the device
+ * @param device_id Integer device identifier
+ * @return Device ID string
+ */
+std::string Event::formatDeviceId(SensorType type, uint32_t device_id)
+{
+    std::string result = getSensorTypeName(type);
+    result += '_';
+    result += std::to_string(device_id);
+    return result;
+}
+
+/**
+ * @brief Interns "<SensorType>_<number>" in the global intern table
+ * @param type Type of the device
+ * @param device_number Device number within its type
+ * @return Dense device id
+ */
+uint32_t Event::internDeviceId(SensorType type, uint32_t device_number)
+{
+    return Util::InternTable::global().intern(formatDeviceId(type, device_number));
+}
+
+/**
+ * @brief Gets the device ID string of an interned id
+ * @param device_id Dense device id
+ * @return Interned device ID, or empty view for unknown ids
+ */
+std::string_view Event::deviceName(uint32_t device_id)
+{
+    return Util::InternTable::global().name(device_id);
+}
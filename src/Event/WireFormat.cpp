@@ -0,0 +1,174 @@
+#include <algorithm>
+
+#include "Event/WireFormat.h"
+#include "Event/SensorTraits.h"
+#include "Util/Clock.h"
+#include "Util/InternTable.h"
+
+namespace
+{
+
+using Event::WireFormat::EventHeader;
+using Event::WireFormat::FieldDescriptor;
+using Event::WireFormat::FieldKind;
+using Event::WireFormat::SensorEventLayout;
+
+/// Fields of SensorEvent, in offset order
+constexpr FieldDescriptor kSensorFields[] = {
+    {"size", offsetof(EventHeader, size), 2, FieldKind::UInt16, 1},
+    {"type", offsetof(EventHeader, type), 2, FieldKind::UInt16, 1},
+    {"version", offsetof(EventHeader, version), 2, FieldKind::UInt16, 1},
+    {"fixed_size", offsetof(EventHeader, fixed_size), 2, FieldKind::UInt16, 1},
+    {"wall_timestamp_ns", offsetof(SensorEventLayout, wall_timestamp_ns), 8, FieldKind::Int64, 1},
+    {"value", offsetof(SensorEventLayout, value), 8, FieldKind::Float64, 1},
+    {"sequence", offsetof(SensorEventLayout, sequence), 8, FieldKind::UInt64, 1},
+    {"device_id", offsetof(SensorEventLayout, device_id), 4, FieldKind::UInt32, 1},
+    {"sensor_type", offsetof(SensorEventLayout, sensor_type), 1, FieldKind::UInt8, 1},
+    {"flags", offsetof(SensorEventLayout, flags), 1, FieldKind::UInt8, 1},
+    {"name_size", offsetof(SensorEventLayout, name_size), 2, FieldKind::UInt16, 1},
+    {"name", offsetof(SensorEventLayout, name_size), 0, FieldKind::Bytes, 1},
+};
+
+constexpr Event::WireFormat::Schema kSensorSchema = {
+    "SensorEvent", Event::EventType::Sensor, Event::WireFormat::kSensorVersion,
+    sizeof(SensorEventLayout), kSensorFields, sizeof(kSensorFields) / sizeof(kSensorFields[0])};
+
+/**
+ * @brief Gets the name of a field kind
+ */
+const char* fieldKindName(FieldKind kind)
+{
+    switch (kind) {
+        case FieldKind::UInt8: return "u8";
+        case FieldKind::UInt16: return "u16";
+        case FieldKind::UInt32: return "u32";
+        case FieldKind::UInt64: return "u64";
+        case FieldKind::Int64: return "i64";
+        case FieldKind::Float64: return "f64";
+        case FieldKind::Bytes: return "bytes";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+/**
+ * @brief Gets the schema of SensorEvent
+ */
+const Event::WireFormat::Schema& Event::WireFormat::sensorSchema()
+{
+    return kSensorSchema;
+}
+
+/**
+ * @brief Renders a schema as text, one field per line
+ * @param schema Schema to render
+ * @return Description such as "SensorEvent v1, 40 fixed bytes" followed by the fields
+ */
+std::string Event::WireFormat::describe(const Schema& schema)
+{
+    std::string text = std::string(schema.name) + " v" + std::to_string(schema.version) + ", " +
+                       std::to_string(schema.fixed_size) + " fixed bytes\n";
+    for (std::size_t i = 0; i < schema.field_count; ++i) {
+        const FieldDescriptor& field = schema.fields[i];
+        text += "  " + std::to_string(field.offset) + " " + field.name + " " + fieldKindName(field.kind);
+        text += field.kind == FieldKind::Bytes ? " (sized by the field at that offset)" : "";
+        text += " since v" + std::to_string(field.since) + "\n";
+    }
+    return text;
+}
+
+/**
+ * @brief Encodes a reading
+ * @param record Reading to encode
+ * @param name Device name to embed; empty when the container names devices by id
+ * @param out Receives sensorEventSize(name.size()) bytes; needs no alignment
+ * @return Bytes written, padding included
+ */
+std::size_t Event::WireFormat::encodeSensorEvent(const SensorRecord& record, std::string_view name, void* out)
+{
+    const std::size_t name_size = std::min(name.size(), kMaxNameSize);
+    SensorEventLayout layout{};
+    layout.header.size = static_cast<uint16_t>(sizeof(layout) + name_size);
+    layout.header.type = EventType::Sensor;
+    layout.header.version = kSensorVersion;
+    layout.header.fixed_size = sizeof(layout);
+    layout.wall_timestamp_ns = Util::Clock::toWallNs(record.timestamp_ns);
+    layout.value = record.value;
+    layout.sequence = record.sequence;
+    layout.device_id = record.device_id;
+    layout.sensor_type = record.type;
+    layout.flags = record.flags;
+    layout.name_size = static_cast<uint16_t>(name_size);
+
+    auto* bytes = static_cast<uint8_t*>(out);
+    const std::size_t size = sensorEventSize(name_size);
+    std::memcpy(bytes, &layout, sizeof(layout));
+    std::memcpy(bytes + sizeof(layout), name.data(), name_size);
+    std::memset(bytes + sizeof(layout) + name_size, 0, size - sizeof(layout) - name_size);
+    return size;
+}
+
+/**
+ * @brief Validates an encoded SensorEvent and points a view at it
+ * @param data Start of the event
+ * @param size Bytes available from data
+ * @param view Receives the view
+ * @return ERROR if the bytes are not a complete, well-formed SensorEvent
+ *
+ * Checks the type, the version, that the fixed part covers version 1, that
+ * the name fits in the declared size, that the padded event fits in size,
+ * and that the sensor type is known.
+ */
+Event::Status Event::WireFormat::SensorEventView::parse(const void* data, std::size_t size, SensorEventView& view)
+{
+    if (size < sizeof(SensorEventLayout)) {
+        return Status::ERROR;
+    }
+    SensorEventLayout layout;
+    std::memcpy(&layout, data, sizeof(layout));
+    const EventHeader& header = layout.header;
+    if (header.type != EventType::Sensor || header.version < 1 || header.fixed_size < sizeof(layout) ||
+        static_cast<std::size_t>(header.fixed_size) + layout.name_size > header.size ||
+        alignEvent(header.size) > size ||
+        static_cast<std::size_t>(layout.sensor_type) >= kSensorTypeCount) {
+        return Status::ERROR;
+    }
+    view.data_ = static_cast<const uint8_t*>(data);
+    return Status::OK;
+}
+
+/**
+ * @brief Time of the measurement in this process's Util::Clock domain
+ */
+int64_t Event::WireFormat::SensorEventView::timestampNs() const
+{
+    return Util::Clock::fromWallNs(wallTimestampNs());
+}
+
+/**
+ * @brief Builds a SensorRecord with the given device id
+ * @param device_id Id to use in this process
+ */
+Event::SensorRecord Event::WireFormat::SensorEventView::toRecord(uint32_t device_id) const
+{
+    SensorEventLayout layout;
+    std::memcpy(&layout, data_, sizeof(layout));
+    SensorRecord record{};
+    record.timestamp_ns = Util::Clock::fromWallNs(layout.wall_timestamp_ns);
+    record.value = layout.value;
+    record.sequence = layout.sequence;
+    record.device_id = device_id;
+    record.type = layout.sensor_type;
+    record.flags = layout.flags;
+    return record;
+}
+
+/**
+ * @brief Builds a SensorRecord, interning the embedded device name
+ */
+Event::SensorRecord Event::WireFormat::SensorEventView::toRecord() const
+{
+    const std::string_view name = deviceName();
+    return toRecord(name.empty() ? deviceId() : Util::InternTable::global().intern(name));
+}
@@ -1,17 +1,241 @@
+#include <algorithm>
+#include <cstdio>
+#include <exception>
 #include <iostream>
+#include <limits>
 #include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+#include "Storage/EventJournal.h"
+#include "Util/Clock.h"
+
+/**
+ * @brief Constructs a bus with explicit batching options
+ * @param options Batch size and latency limits
+ */
+EventBus::EventBus(BatchOptions options)
+{
+    setBatchOptions(options);
+}
 
 /**
  * @brief Registers a new event handler
  * @param handler Function to be called for each event
+ * @param executor Where the handler runs; nullptr runs it inline
+ * @return Id of the subscription
+ * 
+ * Thread-safe registration of event handlers. Inline handlers are stored
+ * in order of subscription and will be invoked in that order for each event.
+ */
+EventBus::SubscriptionId EventBus::subscribe(HandlerType handler, std::shared_ptr<Executor> executor)
+{
+    Subscription subscription;
+    subscription.handler = std::move(handler);
+    subscription.executor = std::move(executor);
+    return addSubscription(std::move(subscription));
+}
+
+/**
+ * @brief Registers a handler called once per dispatched batch
+ * @param handler Function receiving a view of the batch
+ * @param executor Where the handler runs; nullptr runs it inline
+ * @return Id of the subscription
+ */
+EventBus::SubscriptionId EventBus::subscribeBatch(BatchHandlerType handler, std::shared_ptr<Executor> executor)
+{
+    Subscription subscription;
+    subscription.batch_handler = std::move(handler);
+    subscription.executor = std::move(executor);
+    return addSubscription(std::move(subscription));
+}
+
+/**
+ * @brief Adds a subscription to a copy of the subscriber set
+ * @param subscription Subscription to add
+ * @return Assigned id
+ * 
+ * The set is copied and replaced, so a dispatch pass in progress keeps
+ * using the snapshot it started with. Non-sequential executors get a
+ * SerialExecutor of their own so this subscription stays ordered; its
+ * bounded queue makes a slow subscriber on a pool stall dispatch, as a
+ * full DedicatedExecutor does.
+ */
+EventBus::SubscriptionId EventBus::addSubscription(Subscription subscription)
+{
+    if (subscription.executor && !subscription.executor->isSequential()) {
+        subscription.executor = std::make_shared<SerialExecutor>(std::move(subscription.executor));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscription.id = next_subscription_id_++;
+    const SubscriptionId id = subscription.id;
+    auto stored = std::make_shared<const Subscription>(std::move(subscription));
+
+    auto subscribers = std::make_shared<SubscriberSet>(*subscribers_);
+    if (stored->executor) {
+        subscribers->executor_handlers.emplace_back(std::move(stored));
+    } else if (stored->handler) {
+        subscribers->inline_handlers.emplace_back(std::move(stored));
+    } else {
+        subscribers->inline_batch_handlers.emplace_back(std::move(stored));
+    }
+    subscribers_ = std::move(subscribers);
+    return id;
+}
+
+/**
+ * @brief Delivers a batch to one subscription
+ * @param subscription Receiver
+ * @param batch Events of the pass
+ * @param budget_ns Watchdog budget per handler call; 0 skips timing
+ * @return Number of calls that exceeded the budget
+ */
+uint64_t EventBus::deliver(const Subscription& subscription, const DispatchedBatch& batch, int64_t budget_ns)
+{
+    uint64_t over_budget = 0;
+    if (subscription.handler) {
+        for (const auto& event : batch.events) {
+            if (budget_ns == 0) {
+                subscription.handler(*event);
+                continue;
+            }
+            const int64_t start = Util::Clock::nowNs();
+            subscription.handler(*event);
+            over_budget += recordCall(*subscription.metrics, Util::Clock::nowNs() - start, budget_ns);
+        }
+    } else {
+        const EventBatch view(batch.views.data(), batch.views.size());
+        if (budget_ns == 0) {
+            subscription.batch_handler(view);
+            return 0;
+        }
+        const int64_t start = Util::Clock::nowNs();
+        subscription.batch_handler(view);
+        over_budget += recordCall(*subscription.metrics, Util::Clock::nowNs() - start, budget_ns);
+    }
+    return over_budget;
+}
+
+/**
+ * @brief Records one timed handler call
+ * @param metrics Counters of the subscription
+ * @param elapsed_ns Duration of the call
+ * @param budget_ns Watchdog budget per call
+ * @return true if the call exceeded the budget
  * 
- * Thread-safe registration of event handlers. Handlers are stored in
- * order of subscription and will be invoked in that order for each event.
+ * Single writer per subscription, so no read-modify-write atomics needed.
+ */
+bool EventBus::recordCall(HandlerMetrics& metrics, int64_t elapsed_ns, int64_t budget_ns)
+{
+    constexpr auto relaxed = std::memory_order_relaxed;
+    metrics.calls.store(metrics.calls.load(relaxed) + 1, relaxed);
+    metrics.total_ns.store(metrics.total_ns.load(relaxed) + elapsed_ns, relaxed);
+    if (elapsed_ns > metrics.max_ns.load(relaxed)) {
+        metrics.max_ns.store(elapsed_ns, relaxed);
+    }
+    if (elapsed_ns <= budget_ns) {
+        return false;
+    }
+    metrics.over_budget_calls.store(metrics.over_budget_calls.load(relaxed) + 1, relaxed);
+    return true;
+}
+
+/**
+ * @brief Moves inline subscriptions onto dedicated executors
+ * @param ids Subscriptions to isolate
+ * 
+ * Each isolated subscription keeps its id, handler and metrics but gets a
+ * DedicatedExecutor of its own. Events already delivered inline happened
+ * before the executor's first task, so per-subscription order is kept.
+ */
+void EventBus::isolate(const std::vector<SubscriptionId>& ids)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto subscribers = std::make_shared<SubscriberSet>(*subscribers_);
+
+    auto move_isolated = [&](std::vector<std::shared_ptr<const Subscription>>& handlers) {
+        auto it = handlers.begin();
+        while (it != handlers.end())
+        {
+            if (std::find(ids.begin(), ids.end(), (*it)->id) == ids.end()) {
+                ++it;
+                continue;
+            }
+            std::cout << "EventBus isolating slow subscription " << (*it)->id << "..." << "\n";
+            Subscription isolated = **it;
+            isolated.executor = std::make_shared<DedicatedExecutor>(watchdog_.isolation_queue_capacity);
+            isolated.metrics->isolated.store(true, std::memory_order_relaxed);
+            subscribers->executor_handlers.emplace_back(std::make_shared<const Subscription>(std::move(isolated)));
+            stats_.isolated_subscriptions++;
+            it = handlers.erase(it);
+        }
+    };
+    move_isolated(subscribers->inline_handlers);
+    move_isolated(subscribers->inline_batch_handlers);
+    subscribers_ = std::move(subscribers);
+}
+
+/**
+ * @brief Changes the batching options
+ * @param options New limits; max_batch_size is clamped to at least 1
+ */
+void EventBus::setBatchOptions(BatchOptions options)
+{
+    options.max_batch_size = std::max<std::size_t>(options.max_batch_size, 1);
+    if (options.max_latency.count() < 0) {
+        options.max_latency = std::chrono::microseconds(0);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_ = options;
+    }
+    cv_.notify_one();
+}
+
+/**
+ * @brief Gets the current batching options
+ * @return Copy of the options
+ */
+EventBus::BatchOptions EventBus::getBatchOptions() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return options_;
+}
+
+/**
+ * @brief Changes the slow-handler watchdog options
+ * @param options New budget and isolation policy
+ * 
+ * Negative budgets are treated as 0 (watchdog off) and an isolation
+ * queue capacity of 0 as 1.
+ */
+void EventBus::setWatchdogOptions(WatchdogOptions options)
+{
+    if (options.handler_budget.count() < 0) {
+        options.handler_budget = std::chrono::microseconds(0);
+    }
+    options.isolation_queue_capacity = std::max<std::size_t>(options.isolation_queue_capacity, 1);
+    std::lock_guard<std::mutex> lock(mutex_);
+    watchdog_ = options;
+}
+
+/**
+ * @brief Gets the current watchdog options
+ * @return Copy of the options
+ */
+EventBus::WatchdogOptions EventBus::getWatchdogOptions() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return watchdog_;
+}
+
+/**
+ * @brief Attaches a journal that records every published event
+ * @param journal Open journal, or nullptr to stop journaling
  */
-void EventBus::subscribe(HandlerType handler)
+void EventBus::setJournal(std::shared_ptr<Storage::EventJournal> journal)
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    handlers_.emplace_back(std::move(handler));
+    journal_ = std::move(journal);
 }
 
 /**
@@ -24,10 +248,42 @@ void EventBus::subscribe(HandlerType handler)
 void EventBus::publish(std::unique_ptr<Event::Event> event) noexcept
 {
     std::cout << "EventBus publishing event..." << "\n";
+    const int64_t now = Util::Clock::nowNs();
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        event_queue_.emplace_back(std::move(event));
-        cv_.notify_one();
+        event_queue_.push_back(QueuedEvent{std::move(event), now});
+        stats_.published++;
+        // The worker only needs waking to start a batch or when one is full
+        if (event_queue_.size() == 1 || event_queue_.size() >= options_.max_batch_size) {
+            cv_.notify_one();
+        }
+    }
+}
+
+/**
+ * @brief Queues a batch of events for asynchronous dispatch
+ * @param events Events to queue (ownership transferred)
+ * 
+ * Appends all events under a single lock acquisition and wakes the
+ * worker thread once. Relative order within the batch is preserved.
+ */
+void EventBus::publishBatch(std::vector<std::unique_ptr<Event::Event>> events) noexcept
+{
+    if (events.empty()) {
+        return;
+    }
+
+    std::cout << "EventBus publishing batch of " << events.size() << " events..." << "\n";
+    const int64_t now = Util::Clock::nowNs();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& event : events) {
+            event_queue_.push_back(QueuedEvent{std::move(event), now});
+        }
+        stats_.published += events.size();
+        if (event_queue_.size() == events.size() || event_queue_.size() >= options_.max_batch_size) {
+            cv_.notify_one();
+        }
     }
 }
 
@@ -53,67 +309,321 @@ void EventBus::start()
 /**
  * @brief Stops event dispatching and drains queue
  * 
- * Signals stop to worker thread, waits for all queued events to be
- * processed, then joins the thread. Idempotent.
+ * Equivalent to a deadline-bounded stop with no deadline: every queued
+ * event is dispatched. Idempotent.
  */
 void EventBus::stop() noexcept
+{
+    stop(std::chrono::steady_clock::time_point::max(), ShutdownOptions{});
+}
+
+/**
+ * @brief Stops event dispatching, giving up on the queue at a deadline
+ * @param deadline Time after which no new dispatch pass is started
+ * @param options What to do with the events left in the queue
+ * @return Dispatched and leftover counts
+ * 
+ * Signals stop to the worker thread with the deadline, joins it, takes
+ * whatever it left in the queue, drains the executors of executor
+ * subscriptions and finally applies the leftover policy. Idempotent.
+ */
+EventBus::StopReport EventBus::stop(std::chrono::steady_clock::time_point deadline,
+                                    const ShutdownOptions& options) noexcept
 {
     std::cout << "EventBus stopping..." << "\n";
+    StopReport report;
+    uint64_t dispatched_before = 0;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         if (!running_) {
-            return; // Not running
+            return report; // Not running
         }
         stop_requested_ = true;
+        // Util::Clock shares the steady_clock time domain
+        stop_deadline_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        dispatched_before = stats_.dispatched;
         cv_.notify_one();
     }
 
     if (worker_thread_.joinable()) {
         worker_thread_.join();
     }
+
+    std::shared_ptr<const SubscriberSet> subscribers;
+    std::shared_ptr<Storage::EventJournal> journal;
+    std::deque<QueuedEvent> leftovers;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         running_ = false;
+        subscribers = subscribers_;
+        journal = journal_;
+        leftovers.swap(event_queue_);
+        report.dispatched = stats_.dispatched - dispatched_before;
+    }
+    if (journal && !leftovers.empty()) {
+        // Undispatched events were still published; keep the journal complete
+        std::vector<const Event::Event*> views;
+        views.reserve(leftovers.size());
+        for (const auto& queued : leftovers) {
+            views.push_back(queued.event.get());
+        }
+        journal->append(EventBatch(views.data(), views.size()));
+    }
+    // Wait for deliveries already handed to executors
+    for (const auto& subscription : subscribers->executor_handlers) {
+        subscription->executor->drain();
+    }
+
+    report.leftover = leftovers.size();
+    report.deadline_hit = !leftovers.empty();
+    if (leftovers.empty()) {
+        return report;
     }
+    std::cout << "EventBus left " << leftovers.size() << " events undispatched..." << "\n";
+
+    switch (options.leftovers)
+    {
+    case LeftoverPolicy::Drop:
+        break;
+    case LeftoverPolicy::Persist:
+        report.persisted = persistEvents(options.persist_path, leftovers);
+        break;
+    case LeftoverPolicy::Callback:
+        if (options.on_leftovers) {
+            std::vector<std::unique_ptr<Event::Event>> events;
+            events.reserve(leftovers.size());
+            for (auto& queued : leftovers) {
+                events.emplace_back(std::move(queued.event));
+            }
+            // stop() is noexcept: a throwing handler must not terminate the process
+            try {
+                options.on_leftovers(std::move(events));
+            } catch (const std::exception& error) {
+                std::cerr << "EventBus leftover handler failed: " << error.what() << "\n";
+            } catch (...) {
+                std::cerr << "EventBus leftover handler failed" << "\n";
+            }
+        }
+        break;
+    }
+    return report;
+}
+
+/**
+ * @brief Appends the sensor readings among events to a file
+ * @param path File to append to
+ * @param events Undispatched events, in publish order
+ * @return Number of readings written; 0 if the file cannot be opened
+ * 
+ * Monotonic timestamps are meaningless after a restart and interned ids
+ * are per process, so each entry stores the wall-clock time and the
+ * device name next to the raw record.
+ */
+uint64_t EventBus::persistEvents(const std::string& path, const std::deque<QueuedEvent>& events)
+{
+    std::FILE* file = std::fopen(path.c_str(), "ab");
+    if (file == nullptr) {
+        std::cerr << "EventBus failed to open " << path << " for leftover events" << "\n";
+        return 0;
+    }
+
+    uint64_t written = 0;
+    for (const auto& queued : events) {
+        const auto* sensor_event = Event::event_cast<Event::SensorEvent>(*queued.event);
+        if (sensor_event == nullptr) {
+            continue;
+        }
+        Event::SensorRecord record = sensor_event->getRecord();
+        record.timestamp_ns = sensor_event->getWallTimestampNs();
+        const std::string_view name = sensor_event->getDeviceName();
+        const auto name_length = static_cast<uint16_t>(std::min<std::size_t>(name.size(), std::numeric_limits<uint16_t>::max()));
+
+        if (std::fwrite(&record, sizeof(record), 1, file) != 1 ||
+            std::fwrite(&name_length, sizeof(name_length), 1, file) != 1 ||
+            std::fwrite(name.data(), 1, name_length, file) != name_length) {
+            break;
+        }
+        written++;
+    }
+    if (std::fclose(file) != 0) {
+        std::cerr << "EventBus failed to write " << path << "\n";
+    }
+    return written;
+}
+
+/**
+ * @brief Gets a snapshot of the bus counters
+ * @return Copy of the current statistics
+ */
+EventBus::Stats EventBus::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    for (const auto* handlers : {&subscribers_->inline_handlers, &subscribers_->inline_batch_handlers,
+                                 &subscribers_->executor_handlers}) {
+        for (const auto& subscription : *handlers) {
+            stats.over_budget_calls += subscription->metrics->over_budget_calls.load(std::memory_order_relaxed);
+        }
+    }
+    return stats;
+}
+
+/**
+ * @brief Gets the watchdog timings of every subscription
+ * @return One entry per subscription, ordered by id
+ */
+std::vector<EventBus::SubscriptionStats> EventBus::getSubscriptionStats() const
+{
+    std::shared_ptr<const SubscriberSet> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscribers = subscribers_;
+    }
+
+    std::vector<SubscriptionStats> result;
+    for (const auto* handlers : {&subscribers->inline_handlers, &subscribers->inline_batch_handlers,
+                                 &subscribers->executor_handlers}) {
+        for (const auto& subscription : *handlers) {
+            const HandlerMetrics& metrics = *subscription->metrics;
+            SubscriptionStats stats;
+            stats.id = subscription->id;
+            stats.batch = !subscription->handler;
+            stats.on_executor = subscription->executor != nullptr;
+            stats.isolated = metrics.isolated.load(std::memory_order_relaxed);
+            stats.calls = metrics.calls.load(std::memory_order_relaxed);
+            stats.over_budget_calls = metrics.over_budget_calls.load(std::memory_order_relaxed);
+            stats.total_ns = metrics.total_ns.load(std::memory_order_relaxed);
+            stats.max_ns = metrics.max_ns.load(std::memory_order_relaxed);
+            result.push_back(stats);
+        }
+    }
+    std::sort(result.begin(), result.end(),
+              [](const SubscriptionStats& a, const SubscriptionStats& b) { return a.id < b.id; });
+    return result;
 }
 
 /**
  * @brief Main event processing loop (runs on worker thread)
  * 
  * Continuously:
- * 1. Waits for events or stop signal
- * 2. Dequeues event and copies handlers
- * 3. Releases lock before invoking handlers
- * 4. Dispatches event to all registered handlers
- * 5. Repeats until stop requested and queue empty
+ * 1. Waits until a batch is ready: the queue holds max_batch_size events,
+ *    the oldest event has waited max_latency, or stop was requested
+ * 2. Dequeues up to max_batch_size events, recording their queue latency,
+ *    and takes a snapshot of the subscriber set
+ * 3. Releases lock, then appends the batch to the journal if one is set
+ * 4. Hands executor subscriptions one task each, sharing the batch
+ * 5. Calls the inline per-event handlers for each event, then each inline
+ *    batch handler once with the whole batch, timing every call against
+ *    the watchdog budget when one is set
+ * 6. Isolates inline subscriptions that went over budget isolate_after times
+ * 7. Repeats until stop requested and queue empty, or stop requested and
+ *    its deadline passed
  */
 void EventBus::dispatchLoop()
 {
+    auto batch = std::make_shared<DispatchedBatch>();
+
     while (true)
     {
-        std::unique_ptr<Event::Event> event;
-        std::vector<HandlerType> handlers_copy;
+        std::shared_ptr<const SubscriberSet> subscribers;
+        std::shared_ptr<Storage::EventJournal> journal;
+        WatchdogOptions watchdog;
         {
             std::unique_lock<std::mutex> lock(mutex_);
-            cv_.wait(lock, [this] { 
-                return !event_queue_.empty() || stop_requested_; 
-            });
+            while (!stop_requested_ && event_queue_.size() < options_.max_batch_size)
+            {
+                if (event_queue_.empty()) {
+                    cv_.wait(lock);
+                    continue;
+                }
+                const int64_t latency_ns =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(options_.max_latency).count();
+                const int64_t deadline = event_queue_.front().enqueue_ns + latency_ns;
+                if (latency_ns == 0 || Util::Clock::nowNs() >= deadline) {
+                    break; // Oldest event has waited long enough
+                }
+                // Util::Clock shares the steady_clock time domain
+                cv_.wait_until(lock, std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadline)));
+            }
 
-            if (stop_requested_ && event_queue_.empty()) {
+            if (event_queue_.empty()) {
                 break; // Exit the loop if stop is requested and no events are left
             }
+            if (stop_requested_ && Util::Clock::nowNs() >= stop_deadline_ns_) {
+                break; // Shutdown deadline passed; stop() takes the rest
+            }
 
-            if (!event_queue_.empty()) {
-                event = std::move(event_queue_.front());
+            const std::size_t count = std::min(event_queue_.size(), options_.max_batch_size);
+            const int64_t now = Util::Clock::nowNs();
+            for (std::size_t i = 0; i < count; ++i) {
+                QueuedEvent& queued = event_queue_.front();
+                const int64_t latency = now - queued.enqueue_ns;
+                stats_.total_queue_latency_ns += latency;
+                if (latency > stats_.max_queue_latency_ns) {
+                    stats_.max_queue_latency_ns = latency;
+                }
+                batch->views.push_back(queued.event.get());
+                batch->events.emplace_back(std::move(queued.event));
                 event_queue_.pop_front();
-                handlers_copy = handlers_; // Copy handlers to avoid holding the lock during callbacks
+            }
+            stats_.dispatched += count;
+            stats_.batches++;
+
+            subscribers = subscribers_; // Snapshot subscriptions to avoid holding the lock during callbacks
+            watchdog = watchdog_;
+            journal = journal_;
+        }
+
+        // Journal before any subscriber sees the batch
+        if (journal) {
+            journal->append(EventBatch(batch->views.data(), batch->views.size()));
+        }
+        const int64_t budget_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(watchdog.handler_budget).count();
+
+        // Executor tasks share ownership of the batch; the events are not copied
+        for (const auto& subscription : subscribers->executor_handlers) {
+            subscription->executor->execute([subscription, batch, budget_ns]() {
+                deliver(*subscription, *batch, budget_ns);
+            });
+        }
+
+        uint64_t over_budget = 0;
+        for (const auto& event : batch->events) {
+            for (const auto& subscription : subscribers->inline_handlers) {
+                if (budget_ns == 0) {
+                    subscription->handler(*event);
+                    continue;
+                }
+                const int64_t start = Util::Clock::nowNs();
+                subscription->handler(*event);
+                over_budget += recordCall(*subscription->metrics, Util::Clock::nowNs() - start, budget_ns);
             }
         }
+        for (const auto& subscription : subscribers->inline_batch_handlers) {
+            over_budget += deliver(*subscription, *batch, budget_ns);
+        }
 
-        if (event) {
-            for (const auto& handler : handlers_copy) {
-                handler(*event);
+        if (over_budget != 0 && watchdog.isolate_after != 0) {
+            std::vector<SubscriptionId> chronic;
+            for (const auto* handlers : {&subscribers->inline_handlers, &subscribers->inline_batch_handlers}) {
+                for (const auto& subscription : *handlers) {
+                    if (subscription->metrics->over_budget_calls.load(std::memory_order_relaxed) >= watchdog.isolate_after) {
+                        chronic.push_back(subscription->id);
+                    }
+                }
+            }
+            if (!chronic.empty()) {
+                isolate(chronic);
             }
         }
+
+        if (subscribers->executor_handlers.empty()) {
+            // Not shared with any executor: reuse the buffers
+            batch->events.clear();
+            batch->views.clear();
+        } else {
+            batch = std::make_shared<DispatchedBatch>();
+        }
     }
-}
\ No newline at end of file
+}
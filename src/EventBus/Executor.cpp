@@ -0,0 +1,298 @@
+#include <algorithm>
+
+#include "EventBus/Executor.h"
+
+namespace {
+
+/// Pool whose worker is the current thread, if any
+thread_local const ThreadPoolExecutor* current_pool = nullptr;
+
+}
+
+/**
+ * @brief Runs the task on the calling thread
+ * @param task Work to run
+ */
+void InlineExecutor::execute(Task task)
+{
+    task();
+}
+
+/**
+ * @brief Starts the executor thread
+ * @param capacity Pending-task limit, clamped to at least 1
+ */
+DedicatedExecutor::DedicatedExecutor(std::size_t capacity)
+    : capacity_(std::max<std::size_t>(capacity, 1))
+{
+    thread_ = std::thread(&DedicatedExecutor::run, this);
+}
+
+/**
+ * @brief Runs the remaining tasks and joins the thread
+ */
+DedicatedExecutor::~DedicatedExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    not_empty_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+/**
+ * @brief Queues a task, blocking while the queue is full
+ * @param task Work to run on the executor thread
+ */
+void DedicatedExecutor::execute(Task task)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return tasks_.size() < capacity_; });
+        tasks_.push_back(std::move(task));
+    }
+    not_empty_.notify_one();
+}
+
+/**
+ * @brief Queues a task unless the queue is full or the caller is the executor thread
+ * @param task Work to run on the executor thread
+ * @return Whether the task was queued
+ */
+bool DedicatedExecutor::tryExecute(Task& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (std::this_thread::get_id() == thread_.get_id() || tasks_.size() >= capacity_) {
+            return false;
+        }
+        tasks_.push_back(std::move(task));
+    }
+    not_empty_.notify_one();
+    return true;
+}
+
+/**
+ * @brief Waits until the queue is empty and no task is running
+ */
+void DedicatedExecutor::drain()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return tasks_.empty() && !busy_; });
+}
+
+/**
+ * @brief Number of tasks waiting to run
+ * @return Queue length
+ */
+std::size_t DedicatedExecutor::pending() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+/**
+ * @brief Thread body: pops and runs tasks in FIFO order
+ */
+void DedicatedExecutor::run()
+{
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            busy_ = false;
+            if (tasks_.empty()) {
+                idle_.notify_all();
+            }
+            not_empty_.wait(lock, [this] { return !tasks_.empty() || stop_requested_; });
+            if (tasks_.empty()) {
+                break; // Stop requested and nothing left to run
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            busy_ = true;
+        }
+        not_full_.notify_one();
+        task();
+    }
+}
+
+/**
+ * @brief Starts the pool
+ * @param threads Number of worker threads, clamped to at least 1
+ * @param capacity Pending-task limit, clamped to at least 1
+ */
+ThreadPoolExecutor::ThreadPoolExecutor(std::size_t threads, std::size_t capacity)
+    : capacity_(std::max<std::size_t>(capacity, 1))
+{
+    threads = std::max<std::size_t>(threads, 1);
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back(&ThreadPoolExecutor::run, this);
+    }
+}
+
+/**
+ * @brief Runs the remaining tasks and joins all threads
+ */
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    not_empty_.notify_all();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+/**
+ * @brief Queues a task, blocking while the queue is full
+ * @param task Work to run on any pool thread
+ */
+void ThreadPoolExecutor::execute(Task task)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return tasks_.size() < capacity_; });
+        tasks_.push_back(std::move(task));
+    }
+    not_empty_.notify_one();
+}
+
+/**
+ * @brief Queues a task unless the queue is full or the caller is a pool worker
+ * @param task Work to run on any pool thread
+ * @return Whether the task was queued
+ */
+bool ThreadPoolExecutor::tryExecute(Task& task)
+{
+    if (current_pool == this) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.size() >= capacity_) {
+            return false;
+        }
+        tasks_.push_back(std::move(task));
+    }
+    not_empty_.notify_one();
+    return true;
+}
+
+/**
+ * @brief Waits until the queue is empty and no task is running
+ */
+void ThreadPoolExecutor::drain()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return tasks_.empty() && active_ == 0; });
+}
+
+/**
+ * @brief Worker body: pops and runs tasks
+ */
+void ThreadPoolExecutor::run()
+{
+    current_pool = this;
+    bool ran_task = false;
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (ran_task) {
+                active_--;
+                if (tasks_.empty() && active_ == 0) {
+                    idle_.notify_all();
+                }
+            }
+            not_empty_.wait(lock, [this] { return !tasks_.empty() || stop_requested_; });
+            if (tasks_.empty()) {
+                break; // Stop requested and nothing left to run
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            active_++;
+        }
+        not_full_.notify_one();
+        task();
+        ran_task = true;
+    }
+}
+
+/**
+ * @brief Constructs a strand on a target executor
+ * @param target Executor that runs the strand's work
+ * @param capacity Pending-task limit, clamped to at least 1
+ */
+SerialExecutor::SerialExecutor(std::shared_ptr<Executor> target, std::size_t capacity)
+    : target_(std::move(target)), capacity_(std::max<std::size_t>(capacity, 1))
+{
+}
+
+/**
+ * @brief Queues a task, blocking while the queue is full; schedules the
+ *        strand on the target if it is idle
+ * @param task Work to run after every previously queued task
+ * 
+ * A full queue always has runPending() scheduled, which makes room. The
+ * target is called outside the strand's lock because it may block while
+ * its own queue is full.
+ */
+void SerialExecutor::execute(Task task)
+{
+    bool schedule = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return tasks_.size() < capacity_; });
+        tasks_.push_back(std::move(task));
+        if (!scheduled_) {
+            scheduled_ = true;
+            schedule = true;
+        }
+    }
+    if (schedule) {
+        target_->execute([self = shared_from_this()] { self->runPending(); });
+    }
+}
+
+/**
+ * @brief Waits until nothing is queued or scheduled on the target
+ */
+void SerialExecutor::drain()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return tasks_.empty() && !scheduled_; });
+}
+
+/**
+ * @brief Runs queued tasks in order until the queue is empty
+ */
+void SerialExecutor::runPending()
+{
+    while (true)
+    {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (tasks_.empty()) {
+                scheduled_ = false;
+                idle_.notify_all();
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        not_full_.notify_one();
+        task();
+    }
+}
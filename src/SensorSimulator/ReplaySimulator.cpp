@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+#include "SensorSimulator/ReplaySimulator.h"
+#include "Event/SensorEvent.h"
+#include "Util/Clock.h"
+
+namespace
+{
+
+constexpr int64_t kWaitSliceNs = 50 * 1000 * 1000;                 ///< Longest sleep between stop checks
+constexpr auto kBackpressurePoll = std::chrono::microseconds(200);  ///< Sleep while the bus backlog is full
+
+} // namespace
+
+/**
+ * @brief Constructs a replay of a journal directory or trace file
+ * @param event_bus EventBus to publish to
+ * @param path Storage::EventJournal directory or trace file
+ * @param options Pace, batching and memory limits
+ */
+SensorSimulator::ReplaySimulator::ReplaySimulator(EventBus& event_bus, std::string path, ReplayOptions options)
+    : event_bus_(event_bus),
+    path_(std::move(path)),
+    options_(options)
+{
+    options_.batch_size = std::max<std::size_t>(options_.batch_size, 1);
+    options_.max_in_flight = std::max(options_.max_in_flight, options_.batch_size);
+    options_.speed = std::max(options_.speed, 0.0);
+}
+
+/**
+ * @brief Opens the recording
+ * @return ERROR if path is neither a readable journal nor a trace file
+ *
+ * A directory is read as a journal, anything else as a trace file.
+ */
+Event::Status SensorSimulator::ReplaySimulator::open()
+{
+    if (journal_ || trace_) {
+        return Event::Status::OK;
+    }
+
+    std::error_code error;
+    if (std::filesystem::is_directory(path_, error)) {
+        auto journal = std::make_unique<Storage::JournalReader>();
+        if (journal->open(path_) == Event::Status::ERROR) {
+            std::cerr << "ReplaySimulator cannot open journal " << path_ << "\n";
+            return Event::Status::ERROR;
+        }
+        journal_ = std::move(journal);
+    } else {
+        auto trace = std::make_unique<Storage::TraceReader>();
+        if (trace->open(path_) == Event::Status::ERROR) {
+            std::cerr << "ReplaySimulator cannot open trace " << path_ << "\n";
+            return Event::Status::ERROR;
+        }
+        trace_ = std::move(trace);
+    }
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Reads the next recorded reading from the open source
+ * @param record Receives the reading
+ * @return false at the end of the recording
+ */
+bool SensorSimulator::ReplaySimulator::nextRecord(Event::SensorRecord& record)
+{
+    if (journal_) {
+        Storage::JournalEntry entry;
+        if (!journal_->next(entry)) {
+            return false;
+        }
+        record = entry.record;
+        return true;
+    }
+    return trace_->next(record);
+}
+
+/**
+ * @brief Restarts the open source at its first reading
+ */
+void SensorSimulator::ReplaySimulator::rewind()
+{
+    if (journal_) {
+        journal_->seek(journal_->firstSequence());
+    } else {
+        trace_->rewind();
+    }
+}
+
+/**
+ * @brief Publishes the recording, blocking until done or stopped
+ *
+ * The first reading anchors recorded time to the current Util::Clock
+ * time; every later reading is due at anchor + (recorded delta / speed).
+ * Readings already due are collected into one batch (up to batch_size);
+ * the batch is published before sleeping for the next due time. Each
+ * pass of a looped replay is re-anchored.
+ */
+void SensorSimulator::ReplaySimulator::runSimulation()
+{
+    if (open() == Event::Status::ERROR) {
+        return;
+    }
+
+    std::vector<std::unique_ptr<Event::Event>> batch;
+    batch.reserve(options_.batch_size);
+    bool anchored = false;
+    int64_t recorded_start = 0;
+    int64_t replay_start = 0;
+    uint64_t pass_count = 0;
+
+    while (!stop_requested_.load(std::memory_order_acquire))
+    {
+        Event::SensorRecord record;
+        if (!nextRecord(record)) {
+            if (!options_.loop || pass_count == 0) {
+                break; // Done, or an empty recording that would loop forever
+            }
+            flush(batch);
+            rewind();
+            anchored = false;
+            pass_count = 0;
+            continue;
+        }
+        pass_count++;
+
+        if (options_.speed > 0.0) {
+            if (!anchored) {
+                recorded_start = record.timestamp_ns;
+                replay_start = Util::Clock::nowNs();
+                anchored = true;
+            }
+            const auto offset = static_cast<int64_t>(
+                static_cast<double>(record.timestamp_ns - recorded_start) / options_.speed);
+            const int64_t due = replay_start + offset;
+            if (due > Util::Clock::nowNs()) {
+                flush(batch);
+                if (!waitUntil(due)) {
+                    break;
+                }
+            }
+        }
+
+        if (options_.restamp) {
+            record.timestamp_ns = Util::Clock::nowNs();
+        }
+        batch.emplace_back(std::make_unique<Event::SensorEvent>(record));
+        if (batch.size() >= options_.batch_size) {
+            flush(batch);
+        }
+    }
+    flush(batch);
+}
+
+/**
+ * @brief Publishes the pending batch once the bus backlog allows it
+ * @param batch Events to publish; emptied
+ *
+ * The backlog is the bus's published minus dispatched count, so it also
+ * covers events from other producers.
+ */
+void SensorSimulator::ReplaySimulator::flush(std::vector<std::unique_ptr<Event::Event>>& batch)
+{
+    if (batch.empty()) {
+        return;
+    }
+    while (!stop_requested_.load(std::memory_order_acquire))
+    {
+        const EventBus::Stats stats = event_bus_.getStats();
+        if (stats.published - stats.dispatched + batch.size() <= options_.max_in_flight) {
+            break;
+        }
+        std::this_thread::sleep_for(kBackpressurePoll);
+    }
+
+    const std::size_t count = batch.size();
+    event_bus_.publishBatch(std::move(batch));
+    replayed_.fetch_add(count, std::memory_order_relaxed);
+    batch.clear();
+}
+
+/**
+ * @brief Sleeps until a Util::Clock time or a stop request
+ * @param target_ns Monotonic time to wait for
+ * @return false if stopped while waiting
+ */
+bool SensorSimulator::ReplaySimulator::waitUntil(int64_t target_ns)
+{
+    while (!stop_requested_.load(std::memory_order_acquire))
+    {
+        const int64_t now = Util::Clock::nowNs();
+        if (now >= target_ns) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::nanoseconds(std::min(target_ns - now, kWaitSliceNs)));
+    }
+    return false;
+}
+
+/**
+ * @brief Signals the replay to stop
+ */
+void SensorSimulator::ReplaySimulator::stopSimulation()
+{
+    stop_requested_.store(true, std::memory_order_release);
+}
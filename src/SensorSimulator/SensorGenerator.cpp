@@ -0,0 +1,85 @@
+#include <cassert>
+
+#include "SensorSimulator/SensorGenerator.h"
+#include "Util/Clock.h"
+#include "Util/RandomStreams.h"
+
+/**
+ * @brief Constructs a generator on the next global random stream
+ * @param type The sensor type to simulate
+ */
+SensorSimulator::SensorGenerator::SensorGenerator(Event::SensorType type)
+    : SensorGenerator(type, Util::RandomStreams::global().next())
+{
+}
+
+/**
+ * @brief Constructs a generator on an explicit random stream
+ * @param type The sensor type to simulate
+ * @param rand_gen Random stream for this device
+ * 
+ * Looks up the type's row in Event::kSensorTraits at run time.
+ */
+SensorSimulator::SensorGenerator::SensorGenerator(Event::SensorType type, const Util::Xoshiro256& rand_gen)
+    : type_(type),
+    rand_gen_(rand_gen)
+{
+    Event::SensorTraits traits{};
+    if (Event::getSensorTraits(type, traits) == Event::Status::ERROR) {
+        assert(false && "Failed to initialize sensor type");
+        return;
+    }
+    init(traits);
+}
+
+/**
+ * @brief Constructs a generator from a trait row
+ * @param traits Traits of the sensor type, typically Event::sensorTraits<T>()
+ * @param rand_gen Random stream for this device
+ */
+SensorSimulator::SensorGenerator::SensorGenerator(const Event::SensorTraits& traits, const Util::Xoshiro256& rand_gen)
+    : type_(traits.type),
+    rand_gen_(rand_gen)
+{
+    init(traits);
+}
+
+/**
+ * @brief Copies the model parameters and creates the device
+ * @param traits Traits of the sensor type
+ * 
+ * Plain field stores from the trait row, then draws the device number and
+ * interns the device ID.
+ */
+void SensorSimulator::SensorGenerator::init(const Event::SensorTraits& traits)
+{
+    base_value_ = traits.base_value;
+    range_ = traits.range;
+    fault_one_in_ = traits.fault_one_in;
+    device_number_ = rand_gen_.uniform_dist(kSensorIdWidth);
+    device_id_ = Event::internDeviceId(type_, device_number_);
+}
+
+/**
+ * @brief Produces the next reading
+ * @return Observation record for this device
+ * 
+ * With probability 1/fault_one_in the reading is a fault (kFaultValue with
+ * the fault flag set), otherwise a uniform value in [base, base + range).
+ */
+Event::SensorRecord SensorSimulator::SensorGenerator::next()
+{
+    Event::SensorRecord record{};
+    record.timestamp_ns = Util::Clock::nowNs();
+    record.sequence = sequence_++;
+    record.device_id = device_id_;
+    record.type = type_;
+
+    if (rand_gen_.one_in(static_cast<int>(fault_one_in_))) {
+        record.value = kFaultValue; // Simulate a faulty reading
+        record.flags = Event::SensorRecord::kFaultFlag;
+    } else {
+        record.value = base_value_ + static_cast<double>(rand_gen_.uniform_dist(range_));
+    }
+    return record;
+}
@@ -0,0 +1,641 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "Storage/AsyncFileWriter.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define STORAGE_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#else
+#define STORAGE_HAS_IO_URING 0
+#endif
+
+namespace
+{
+
+constexpr std::size_t kStorageAlignment = 4096;   ///< Buffers start on page boundaries
+
+} // namespace
+
+#if STORAGE_HAS_IO_URING
+
+/**
+ * @class Storage::AsyncFileWriter::Ring
+ * @brief Minimal io_uring instance driven through raw system calls
+ *
+ * Maps the submission and completion rings and the SQE array, and
+ * optionally registers the writer's buffers. Used by one thread at a time
+ * (the writer holds its mutex), without SQPOLL, so the kernel only reads
+ * the submission ring inside io_uring_enter().
+ */
+class Storage::AsyncFileWriter::Ring
+{
+public:
+    /**
+     * @brief Sets up a ring
+     * @param entries Submission queue size
+     * @param buffers Buffers to register; none to skip registration
+     * @param buffer_size Bytes per buffer
+     * @return The ring, or nullptr if io_uring is unavailable
+     */
+    static std::unique_ptr<Ring> create(unsigned entries, const std::vector<Buffer>& buffers, std::size_t buffer_size)
+    {
+        io_uring_params params{};
+        const int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) {
+            return nullptr;
+        }
+        std::unique_ptr<Ring> ring(new Ring());
+        ring->fd_ = fd;
+        ring->sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            ring->sq_size_ = ring->cq_size_ = std::max(ring->sq_size_, ring->cq_size_);
+        }
+        ring->sq_ptr_ = ::mmap(nullptr, ring->sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               fd, IORING_OFF_SQ_RING);
+        if (ring->sq_ptr_ == MAP_FAILED) {
+            ring->sq_ptr_ = nullptr;
+            return nullptr;
+        }
+        ring->cq_ptr_ = single_mmap ? ring->sq_ptr_
+                                    : ::mmap(nullptr, ring->cq_size_, PROT_READ | PROT_WRITE,
+                                             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ptr_ == MAP_FAILED) {
+            ring->cq_ptr_ = nullptr;
+            return nullptr;
+        }
+        ring->sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, ring->sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return nullptr;
+        }
+        ring->sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<uint8_t*>(ring->sq_ptr_);
+        ring->sq_entries_ = params.sq_entries;
+        ring->sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        ring->sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        ring->sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        ring->sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        auto* cq = static_cast<uint8_t*>(ring->cq_ptr_);
+        ring->cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        ring->cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        ring->cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        ring->cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // Registration pins the pages once; without it writes still work, unpinned per call
+        if (!buffers.empty()) {
+            std::vector<iovec> iovecs;
+            for (const Buffer& buffer : buffers) {
+                iovecs.push_back(iovec{buffer.data, buffer_size});
+            }
+            ring->fixed_buffers_ = ::syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS,
+                                             iovecs.data(), static_cast<unsigned>(iovecs.size())) == 0;
+        }
+        return ring;
+    }
+
+    /**
+     * @brief Unmaps the rings and closes the io_uring descriptor
+     */
+    ~Ring()
+    {
+        if (sqes_ != nullptr) {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+            ::munmap(cq_ptr_, cq_size_);
+        }
+        if (sq_ptr_ != nullptr) {
+            ::munmap(sq_ptr_, sq_size_);
+        }
+        ::close(fd_);
+    }
+
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    /**
+     * @brief Queues and submits one write
+     * @param fd File to write
+     * @param data Bytes inside registered buffer buffer_index
+     * @param length Number of bytes
+     * @param offset File offset
+     * @param buffer_index Registered buffer holding data; also the completion's user data
+     * @return 0, or a negated errno if the write could not be submitted
+     */
+    int submitWrite(int fd, const uint8_t* data, std::size_t length, uint64_t offset, std::size_t buffer_index)
+    {
+        const unsigned tail = *sq_tail_;
+        if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+            return -EBUSY;
+        }
+        const unsigned slot = tail & sq_mask_;
+        io_uring_sqe& sqe = sqes_[slot];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = fixed_buffers_ ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uint64_t>(data);
+        sqe.len = static_cast<uint32_t>(length);
+        sqe.off = offset;
+        sqe.buf_index = static_cast<uint16_t>(buffer_index);
+        sqe.user_data = buffer_index;
+        sq_array_[slot] = slot;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+        while (true) {
+            if (::syscall(__NR_io_uring_enter, fd_, 1, 0, 0, nullptr, 0) >= 0) {
+                return 0;
+            }
+            if (errno != EINTR) {
+                // Nothing was consumed; take the entry back so it is not submitted later
+                const int error = errno;
+                __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+                return -error;
+            }
+        }
+    }
+
+    /**
+     * @brief Blocks until at least one completion is available
+     */
+    void wait()
+    {
+        while (::syscall(__NR_io_uring_enter, fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno == EINTR) {
+        }
+    }
+
+    /**
+     * @brief Consumes every available completion
+     * @param on_complete Called with (buffer index, result) for each
+     */
+    template <typename Callback>
+    void reap(Callback&& on_complete)
+    {
+        unsigned head = *cq_head_;
+        while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+            const io_uring_cqe cqe = cqes_[head & cq_mask_];
+            ++head;
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+            on_complete(static_cast<std::size_t>(cqe.user_data), static_cast<long>(cqe.res));
+        }
+    }
+
+private:
+    Ring() = default;
+
+    int fd_{-1};                       ///< io_uring descriptor
+    void* sq_ptr_{nullptr};            ///< Submission ring mapping
+    std::size_t sq_size_{0};           ///< Bytes mapped at sq_ptr_
+    void* cq_ptr_{nullptr};            ///< Completion ring mapping (may equal sq_ptr_)
+    std::size_t cq_size_{0};           ///< Bytes mapped at cq_ptr_
+    io_uring_sqe* sqes_{nullptr};      ///< Submission entries
+    std::size_t sqes_size_{0};         ///< Bytes mapped at sqes_
+    unsigned sq_entries_{0};           ///< Submission ring size
+    unsigned* sq_head_{nullptr};       ///< Advanced by the kernel
+    unsigned* sq_tail_{nullptr};       ///< Advanced by the writer
+    unsigned sq_mask_{0};              ///< Ring index mask
+    unsigned* sq_array_{nullptr};      ///< Ring slot to SQE index
+    unsigned* cq_head_{nullptr};       ///< Advanced by the writer
+    unsigned* cq_tail_{nullptr};       ///< Advanced by the kernel
+    unsigned cq_mask_{0};              ///< Ring index mask
+    io_uring_cqe* cqes_{nullptr};      ///< Completion entries
+    bool fixed_buffers_{false};        ///< Buffers are registered
+};
+
+#else // STORAGE_HAS_IO_URING
+
+/**
+ * @class Storage::AsyncFileWriter::Ring
+ * @brief Stand-in where io_uring headers are unavailable; never created
+ */
+class Storage::AsyncFileWriter::Ring
+{
+public:
+    static std::unique_ptr<Ring> create(unsigned, const std::vector<Buffer>&, std::size_t) {
+        return nullptr;
+    }
+    int submitWrite(int, const uint8_t*, std::size_t, uint64_t, std::size_t) {
+        return -ENOSYS;
+    }
+    void wait() {}
+    template <typename Callback>
+    void reap(Callback&&) {}
+};
+
+#endif // STORAGE_HAS_IO_URING
+
+/**
+ * @brief Frees buffer storage
+ */
+void Storage::AsyncFileWriter::FreeStorage::operator()(uint8_t* storage) const
+{
+    std::free(storage);
+}
+
+/**
+ * @brief Constructs a closed writer
+ */
+Storage::AsyncFileWriter::AsyncFileWriter() = default;
+
+/**
+ * @brief Closes the writer, writing out buffered data
+ */
+Storage::AsyncFileWriter::~AsyncFileWriter()
+{
+    close();
+}
+
+/**
+ * @brief Whether this kernel lets the process use io_uring
+ *
+ * Container seccomp profiles commonly block io_uring_setup(); probed once.
+ */
+bool Storage::AsyncFileWriter::ioUringAvailable()
+{
+    static const bool available = Ring::create(1, {}, 0) != nullptr;
+    return available;
+}
+
+/**
+ * @brief Opens (creating if needed) a file for appending
+ * @param path File to write
+ * @param options Buffer sizes and backend selection
+ * @return ERROR if already open, the file cannot be opened, or the
+ *         requested IoUring backend is unavailable
+ */
+Event::Status Storage::AsyncFileWriter::open(const std::string& path, Options options)
+{
+    std::lock_guard<std::mutex> caller(caller_mutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ >= 0) {
+        return Event::Status::ERROR;
+    }
+    options_ = options;
+    options_.buffer_size = std::max<std::size_t>(options_.buffer_size, 1);
+    options_.buffer_count = std::clamp<std::size_t>(options_.buffer_count, 2, UINT16_MAX);
+    options_.threads = std::max<std::size_t>(options_.threads, 1);
+
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (options_.truncate ? O_TRUNC : 0), 0644);
+    const off_t end = fd >= 0 ? ::lseek(fd, 0, SEEK_END) : -1;
+    if (end < 0) {
+        std::cerr << "AsyncFileWriter cannot open " << path << ": " << std::strerror(errno) << "\n";
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return Event::Status::ERROR;
+    }
+
+    const std::size_t bytes = options_.buffer_count * options_.buffer_size;
+    storage_.reset(static_cast<uint8_t*>(
+        std::aligned_alloc(kStorageAlignment, (bytes + kStorageAlignment - 1) / kStorageAlignment * kStorageAlignment)));
+    if (!storage_) {
+        std::cerr << "AsyncFileWriter cannot allocate " << bytes << " bytes of buffers\n";
+        ::close(fd);
+        return Event::Status::ERROR;
+    }
+    buffers_.assign(options_.buffer_count, Buffer{});
+    free_.clear();
+    for (std::size_t i = options_.buffer_count; i-- > 0;) {
+        buffers_[i].data = storage_.get() + i * options_.buffer_size;
+        free_.push_back(i);
+    }
+
+    if (options_.backend != Backend::ThreadPool) {
+        ring_ = Ring::create(static_cast<unsigned>(options_.buffer_count), buffers_, options_.buffer_size);
+    }
+    if (ring_) {
+        backend_ = Backend::IoUring;
+    } else if (options_.backend == Backend::IoUring) {
+        std::cerr << "AsyncFileWriter cannot set up io_uring: " << std::strerror(errno) << "\n";
+        ::close(fd);
+        storage_.reset();
+        buffers_.clear();
+        return Event::Status::ERROR;
+    } else {
+        backend_ = Backend::ThreadPool;
+        stop_workers_ = false;
+        for (std::size_t i = 0; i < options_.threads; ++i) {
+            workers_.emplace_back(&AsyncFileWriter::workerLoop, this);
+        }
+    }
+
+    fd_ = fd;
+    next_offset_ = static_cast<uint64_t>(end);
+    current_ = SIZE_MAX;
+    in_flight_ = 0;
+    error_ = 0;
+    stats_ = Stats{};
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Copies bytes to the end of the file's buffered contents
+ * @param data Bytes to append
+ * @param size Number of bytes
+ * @return ERROR if the writer is closed or an earlier write failed
+ *
+ * caller_mutex_ is held throughout, so an append that waits for a buffer
+ * cannot be split by another thread's append.
+ */
+Event::Status Storage::AsyncFileWriter::append(const void* data, std::size_t size)
+{
+    std::lock_guard<std::mutex> caller(caller_mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (ring_) {
+        reapRing(false);
+    }
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0)
+    {
+        if (fd_ < 0 || error_ != 0) {
+            return Event::Status::ERROR;
+        }
+        if (current_ == SIZE_MAX) {
+            if (free_.empty()) {
+                stats_.stalls++;
+                waitForCompletion(lock);
+                continue;
+            }
+            current_ = free_.back();
+            free_.pop_back();
+            buffers_[current_].size = 0;
+            buffers_[current_].done = 0;
+            buffers_[current_].offset = next_offset_;
+        }
+
+        Buffer& buffer = buffers_[current_];
+        const std::size_t count = std::min(size, options_.buffer_size - buffer.size);
+        std::memcpy(buffer.data + buffer.size, bytes, count);
+        buffer.size += count;
+        next_offset_ += count;
+        stats_.appended += count;
+        bytes += count;
+        size -= count;
+        if (buffer.size == options_.buffer_size) {
+            submitCurrent();
+        }
+    }
+    return fd_ >= 0 && error_ == 0 ? Event::Status::OK : Event::Status::ERROR;
+}
+
+/**
+ * @brief Writes out the partly filled buffer and waits for every write
+ * @return ERROR if the writer is closed or a write failed
+ */
+Event::Status Storage::AsyncFileWriter::flush()
+{
+    std::lock_guard<std::mutex> caller(caller_mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    return flushLocked(lock);
+}
+
+/**
+ * @brief Writes out the partly filled buffer and waits for every write; caller holds mutex_ through lock
+ * @param lock Lock on mutex_
+ * @return ERROR if the writer is closed or a write failed
+ */
+Event::Status Storage::AsyncFileWriter::flushLocked(std::unique_lock<std::mutex>& lock)
+{
+    if (fd_ < 0) {
+        return Event::Status::ERROR;
+    }
+    if (current_ != SIZE_MAX) {
+        submitCurrent();
+    }
+    while (in_flight_ > 0) {
+        waitForCompletion(lock);
+    }
+    return error_ == 0 ? Event::Status::OK : Event::Status::ERROR;
+}
+
+/**
+ * @brief Flushes, then makes the contents durable with fdatasync()
+ * @return ERROR if the writer is closed, a write failed or the sync failed
+ */
+Event::Status Storage::AsyncFileWriter::sync()
+{
+    std::lock_guard<std::mutex> caller(caller_mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (flushLocked(lock) == Event::Status::ERROR) {
+        return Event::Status::ERROR;
+    }
+    if (::fdatasync(fd_) != 0) {
+        std::cerr << "AsyncFileWriter cannot sync: " << std::strerror(errno) << "\n";
+        return Event::Status::ERROR;
+    }
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Flushes and closes the file
+ * @return ERROR if a write failed; OK on a closed writer
+ */
+Event::Status Storage::AsyncFileWriter::close()
+{
+    std::lock_guard<std::mutex> caller(caller_mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        return Event::Status::OK;
+    }
+    return closeLocked(lock);
+}
+
+/**
+ * @brief Whether open() succeeded and close() has not been called
+ */
+bool Storage::AsyncFileWriter::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fd_ >= 0;
+}
+
+/**
+ * @brief Gets the backend in use
+ * @return IoUring or ThreadPool while open; Auto when closed
+ */
+Storage::AsyncFileWriter::Backend Storage::AsyncFileWriter::backend() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return backend_;
+}
+
+/**
+ * @brief Gets the file size including bytes not yet written
+ */
+uint64_t Storage::AsyncFileWriter::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return next_offset_;
+}
+
+/**
+ * @brief Gets the counters of the writer
+ */
+Storage::AsyncFileWriter::Stats Storage::AsyncFileWriter::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+/**
+ * @brief Hands the current buffer to the backend; caller holds mutex_
+ */
+void Storage::AsyncFileWriter::submitCurrent()
+{
+    const std::size_t index = current_;
+    current_ = SIZE_MAX;
+    if (buffers_[index].size == 0) {
+        free_.push_back(index);
+        return;
+    }
+    in_flight_++;
+    issueWrite(index);
+}
+
+/**
+ * @brief Issues the write of a buffer's unwritten bytes; caller holds mutex_
+ * @param index Buffer index
+ */
+void Storage::AsyncFileWriter::issueWrite(std::size_t index)
+{
+    stats_.writes++;
+    if (!ring_) {
+        write_queue_.push_back(index);
+        queued_.notify_one();
+        return;
+    }
+    const Buffer& buffer = buffers_[index];
+    const int result = ring_->submitWrite(fd_, buffer.data + buffer.done, buffer.size - buffer.done,
+                                          buffer.offset + buffer.done, index);
+    if (result < 0) {
+        completeWrite(index, result);
+    }
+}
+
+/**
+ * @brief Records a finished write; caller holds mutex_
+ * @param index Buffer index
+ * @param result Bytes written, or a negated errno
+ */
+void Storage::AsyncFileWriter::completeWrite(std::size_t index, long result)
+{
+    Buffer& buffer = buffers_[index];
+    if (result > 0) {
+        buffer.done += static_cast<std::size_t>(result);
+        stats_.written += static_cast<uint64_t>(result);
+        if (buffer.done < buffer.size) {
+            issueWrite(index);
+            return;
+        }
+    } else if (error_ == 0) {
+        error_ = result < 0 ? static_cast<int>(-result) : EIO;
+        std::cerr << "AsyncFileWriter cannot write at offset " << buffer.offset + buffer.done << ": "
+                  << std::strerror(error_) << "\n";
+    }
+    in_flight_--;
+    free_.push_back(index);
+}
+
+/**
+ * @brief Waits until at least one write completes; caller holds mutex_ through lock
+ * @param lock Lock on mutex_, released while the ThreadPool backend waits
+ *
+ * The IoUring backend waits in io_uring_enter() with the lock held: only
+ * lock holders can reap, so there is nothing for others to do meanwhile.
+ */
+void Storage::AsyncFileWriter::waitForCompletion(std::unique_lock<std::mutex>& lock)
+{
+    if (ring_) {
+        reapRing(true);
+    } else {
+        completed_.wait(lock);
+    }
+}
+
+/**
+ * @brief Reaps io_uring completions; caller holds mutex_
+ * @param wait Whether to block until at least one is available
+ */
+void Storage::AsyncFileWriter::reapRing(bool wait)
+{
+    if (wait) {
+        ring_->wait();
+    }
+    ring_->reap([this](std::size_t index, long result) { completeWrite(index, result); });
+}
+
+/**
+ * @brief ThreadPool worker: pwrite()s queued buffers
+ *
+ * Buffers cover disjoint file ranges, so workers write in parallel.
+ */
+void Storage::AsyncFileWriter::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        queued_.wait(lock, [this] { return stop_workers_ || !write_queue_.empty(); });
+        if (write_queue_.empty()) {
+            return;
+        }
+        const std::size_t index = write_queue_.front();
+        write_queue_.pop_front();
+        const Buffer buffer = buffers_[index];
+        const int fd = fd_;
+        lock.unlock();
+
+        ssize_t written;
+        do {
+            written = ::pwrite(fd, buffer.data + buffer.done, buffer.size - buffer.done,
+                               static_cast<off_t>(buffer.offset + buffer.done));
+        } while (written < 0 && errno == EINTR);
+        const long result = written < 0 ? -static_cast<long>(errno) : static_cast<long>(written);
+
+        lock.lock();
+        completeWrite(index, result);
+        completed_.notify_all();
+    }
+}
+
+/**
+ * @brief Flushes, stops the backend and closes the file; caller holds mutex_ through lock
+ * @param lock Lock on mutex_
+ * @return ERROR if a write failed
+ */
+Event::Status Storage::AsyncFileWriter::closeLocked(std::unique_lock<std::mutex>& lock)
+{
+    flushLocked(lock);
+
+    // caller_mutex_ keeps other callers out until the file is closed
+    const int fd = fd_;
+    fd_ = -1;
+    stop_workers_ = true;
+    queued_.notify_all();
+    std::vector<std::thread> workers = std::move(workers_);
+    workers_.clear();
+    lock.unlock();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    lock.lock();
+
+    ring_.reset();
+    ::close(fd);
+    backend_ = Backend::Auto;
+    buffers_.clear();
+    free_.clear();
+    storage_.reset();
+    return error_ == 0 ? Event::Status::OK : Event::Status::ERROR;
+}
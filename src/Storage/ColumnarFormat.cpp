@@ -0,0 +1,335 @@
+#include <cstring>
+#include <iterator>
+
+#include "Storage/ColumnarFormat.h"
+#include "Storage/BitStream.h"
+
+namespace
+{
+
+/**
+ * @struct DodClass
+ * @brief Size class of a zigzag encoded delta-of-delta
+ */
+struct DodClass
+{
+    uint64_t prefix;        ///< Prefix bits
+    unsigned prefix_bits;   ///< Length of the prefix
+    unsigned value_bits;    ///< Payload bits after the prefix
+};
+
+/// Size classes after the single '0' bit for an unchanged delta, smallest first
+constexpr DodClass kDodClasses[] = {
+    {0x2, 2, 7},    // '10'
+    {0x6, 3, 14},   // '110'
+    {0xE, 4, 24},   // '1110'
+    {0x1E, 5, 36},  // '11110'
+    {0x1F, 5, 64},  // '11111'
+};
+
+/**
+ * @brief Maps a signed difference to an unsigned one, small magnitudes first
+ * @param value Difference, two's complement
+ */
+uint64_t zigzag(uint64_t value)
+{
+    return (value << 1) ^ (0 - (value >> 63));
+}
+
+/**
+ * @brief Inverse of zigzag()
+ * @param value Zigzag encoded difference
+ */
+uint64_t unzigzag(uint64_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+/**
+ * @brief Number of leading zero bits of a non-zero word
+ */
+unsigned leadingZeros(uint64_t value)
+{
+    return static_cast<unsigned>(__builtin_clzll(value));
+}
+
+/**
+ * @brief Number of trailing zero bits of a non-zero word
+ */
+unsigned trailingZeros(uint64_t value)
+{
+    return static_cast<unsigned>(__builtin_ctzll(value));
+}
+
+/**
+ * @brief Appends a LEB128 varint
+ * @param value Integer to append
+ * @param out Destination bytes
+ */
+void writeVarint(uint64_t value, std::vector<uint8_t>& out)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Reads a LEB128 varint
+ * @param data Column bytes
+ * @param size Column size
+ * @param offset Position to read at; advanced past the varint
+ * @param value Receives the integer
+ * @return false if the varint runs past the end
+ */
+bool readVarint(const uint8_t* data, std::size_t size, std::size_t& offset, uint64_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && offset < size; shift += 7) {
+        const uint8_t byte = data[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+/**
+ * @brief Appends a delta-of-delta encoded integer column
+ * @param values Integers to encode
+ * @param count Number of values
+ * @param out Receives the column bytes
+ *
+ * Arithmetic is done on unsigned words, so wrapping differences (e.g. of
+ * sequence numbers stored as int64_t) round-trip exactly.
+ */
+void Storage::ColumnarFormat::encodeDeltaOfDelta(const int64_t* values, std::size_t count, std::vector<uint8_t>& out)
+{
+    if (count == 0) {
+        return;
+    }
+    Storage::BitWriter writer(out);
+    uint64_t previous = static_cast<uint64_t>(values[0]);
+    uint64_t previous_delta = 0;
+    writer.write(previous, 64);
+
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        const uint64_t value = static_cast<uint64_t>(values[i]);
+        const uint64_t delta = value - previous;
+        const uint64_t encoded = zigzag(delta - previous_delta);
+        previous = value;
+        previous_delta = delta;
+
+        if (encoded == 0) {
+            writer.writeBit(false);
+            continue;
+        }
+        for (const DodClass& size_class : kDodClasses)
+        {
+            if (size_class.value_bits == 64 || encoded < (uint64_t{1} << size_class.value_bits)) {
+                writer.write(size_class.prefix, size_class.prefix_bits);
+                writer.write(encoded, size_class.value_bits);
+                break;
+            }
+        }
+    }
+    writer.finish();
+}
+
+/**
+ * @brief Decodes a column written by encodeDeltaOfDelta()
+ * @param data Column bytes
+ * @param size Column size
+ * @param count Number of values in the column
+ * @param values Receives the values (replaced)
+ * @return false if the column is shorter than count values need
+ */
+bool Storage::ColumnarFormat::decodeDeltaOfDelta(const uint8_t* data, std::size_t size, std::size_t count,
+                                                 std::vector<int64_t>& values)
+{
+    values.resize(count);
+    if (count == 0) {
+        return true;
+    }
+    Storage::BitReader reader(data, size);
+    uint64_t previous = reader.read(64);
+    uint64_t previous_delta = 0;
+    values[0] = static_cast<int64_t>(previous);
+
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        uint64_t encoded = 0;
+        if (reader.readBit()) {
+            std::size_t size_class = 0;
+            while (size_class + 1 < std::size(kDodClasses) && reader.readBit()) {
+                size_class++;
+            }
+            encoded = reader.read(kDodClasses[size_class].value_bits);
+        }
+        previous_delta += unzigzag(encoded);
+        previous += previous_delta;
+        values[i] = static_cast<int64_t>(previous);
+    }
+    return !reader.overrun();
+}
+
+/**
+ * @brief Appends a Gorilla XOR encoded value column
+ * @param values Values to encode
+ * @param count Number of values
+ * @param out Receives the column bytes
+ *
+ * Leading zeros are capped at 31 to fit their 5-bit field; a meaningful
+ * length of 64 is stored as 0.
+ */
+void Storage::ColumnarFormat::encodeValues(const double* values, std::size_t count, std::vector<uint8_t>& out)
+{
+    if (count == 0) {
+        return;
+    }
+    Storage::BitWriter writer(out);
+    uint64_t previous = 0;
+    std::memcpy(&previous, &values[0], sizeof(previous));
+    writer.write(previous, 64);
+    unsigned window_leading = 65; // No window yet
+    unsigned window_trailing = 0;
+
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        const uint64_t difference = bits ^ previous;
+        previous = bits;
+
+        if (difference == 0) {
+            writer.writeBit(false);
+            continue;
+        }
+        unsigned leading = leadingZeros(difference);
+        const unsigned trailing = trailingZeros(difference);
+        leading = leading > 31 ? 31 : leading;
+
+        if (window_leading <= 64 && leading >= window_leading && trailing >= window_trailing) {
+            writer.write(0x2, 2); // '10'
+            writer.write(difference >> window_trailing, 64 - window_leading - window_trailing);
+            continue;
+        }
+        const unsigned length = 64 - leading - trailing;
+        writer.write(0x3, 2); // '11'
+        writer.write(leading, 5);
+        writer.write(length & 0x3F, 6);
+        writer.write(difference >> trailing, length);
+        window_leading = leading;
+        window_trailing = trailing;
+    }
+    writer.finish();
+}
+
+/**
+ * @brief Decodes a column written by encodeValues()
+ * @param data Column bytes
+ * @param size Column size
+ * @param count Number of values in the column
+ * @param values Receives the values (replaced)
+ * @return false if the column is shorter than count values need
+ */
+bool Storage::ColumnarFormat::decodeValues(const uint8_t* data, std::size_t size, std::size_t count,
+                                           std::vector<double>& values)
+{
+    values.resize(count);
+    if (count == 0) {
+        return true;
+    }
+    Storage::BitReader reader(data, size);
+    uint64_t previous = reader.read(64);
+    std::memcpy(&values[0], &previous, sizeof(previous));
+    unsigned window_leading = 0;
+    unsigned window_trailing = 0;
+
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        if (reader.readBit()) {
+            if (reader.readBit()) {
+                window_leading = static_cast<unsigned>(reader.read(5));
+                unsigned length = static_cast<unsigned>(reader.read(6));
+                length = length == 0 ? 64 : length;
+                if (window_leading + length > 64) {
+                    return false;
+                }
+                window_trailing = 64 - window_leading - length;
+            }
+            const unsigned length = 64 - window_leading - window_trailing;
+            previous ^= reader.read(length) << window_trailing;
+        }
+        std::memcpy(&values[i], &previous, sizeof(previous));
+    }
+    return !reader.overrun();
+}
+
+/**
+ * @brief Appends a sparse flags column
+ * @param flags One flags byte per row
+ * @param count Number of rows
+ * @param out Receives the column bytes
+ */
+void Storage::ColumnarFormat::encodeFlags(const uint8_t* flags, std::size_t count, std::vector<uint8_t>& out)
+{
+    std::size_t flagged = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        flagged += flags[i] != 0 ? 1 : 0;
+    }
+    if (flagged == 0) {
+        return;
+    }
+    writeVarint(flagged, out);
+    std::size_t next_row = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (flags[i] != 0) {
+            writeVarint(i - next_row, out);
+            out.push_back(flags[i]);
+            next_row = i + 1;
+        }
+    }
+}
+
+/**
+ * @brief Decodes a column written by encodeFlags()
+ * @param data Column bytes
+ * @param size Column size
+ * @param count Number of rows
+ * @param flags Receives one flags byte per row (replaced)
+ * @return false if the column is malformed
+ */
+bool Storage::ColumnarFormat::decodeFlags(const uint8_t* data, std::size_t size, std::size_t count,
+                                          std::vector<uint8_t>& flags)
+{
+    flags.assign(count, 0);
+    if (size == 0) {
+        return true;
+    }
+    std::size_t offset = 0;
+    uint64_t flagged = 0;
+    if (!readVarint(data, size, offset, flagged) || flagged > count) {
+        return false;
+    }
+    uint64_t row = 0;
+    for (uint64_t i = 0; i < flagged; ++i)
+    {
+        uint64_t gap = 0;
+        if (!readVarint(data, size, offset, gap) || offset >= size) {
+            return false;
+        }
+        row += gap;
+        if (row >= count) {
+            return false;
+        }
+        flags[row++] = data[offset++];
+    }
+    return true;
+}
@@ -0,0 +1,377 @@
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <thread>
+
+#include "Storage/ColumnarQuery.h"
+#include "Util/Clock.h"
+#include "Util/InternTable.h"
+
+namespace
+{
+
+/**
+ * @brief Start of the interval holding a timestamp
+ * @param timestamp_ns Wall-clock timestamp
+ * @param bucket_ns Interval length, positive
+ * @return Largest multiple of bucket_ns not after timestamp_ns
+ */
+int64_t bucketStart(int64_t timestamp_ns, int64_t bucket_ns)
+{
+    int64_t remainder = timestamp_ns % bucket_ns;
+    if (remainder < 0) {
+        remainder += bucket_ns;
+    }
+    return timestamp_ns - remainder;
+}
+
+/**
+ * @brief Adds one value to a bucket
+ * @param bucket Bucket to update
+ * @param value Matching value
+ */
+void accumulate(Storage::ColumnarQuery::Bucket& bucket, double value)
+{
+    if (bucket.count == 0) {
+        bucket.min = value;
+        bucket.max = value;
+    } else {
+        bucket.min = std::min(bucket.min, value);
+        bucket.max = std::max(bucket.max, value);
+    }
+    bucket.sum += value;
+    bucket.count++;
+}
+
+/**
+ * @brief Folds one bucket into another covering the same interval
+ * @param into Bucket to update
+ * @param from Partial result of another block
+ */
+void merge(Storage::ColumnarQuery::Bucket& into, const Storage::ColumnarQuery::Bucket& from)
+{
+    if (into.count == 0) {
+        into = from;
+        return;
+    }
+    into.min = std::min(into.min, from.min);
+    into.max = std::max(into.max, from.max);
+    into.sum += from.sum;
+    into.count += from.count;
+}
+
+/**
+ * @brief Checks a decoded row against the row-level parts of a filter
+ * @param filter Query filter
+ * @param timestamp_ns Wall-clock timestamp of the row
+ * @param value Value of the row
+ * @param flags Flags of the row
+ */
+bool matches(const Storage::ColumnarQuery::Filter& filter, int64_t timestamp_ns, double value, uint8_t flags)
+{
+    return timestamp_ns >= filter.from_ns && timestamp_ns < filter.to_ns &&
+           value >= filter.min_value && value <= filter.max_value &&
+           (filter.include_faults || (flags & Event::SensorRecord::kFaultFlag) == 0);
+}
+
+} // namespace
+
+/**
+ * @brief Constructs a query engine over a sink directory
+ * @param directory ColumnarSink directory
+ * @param executor Runs block scans; nullptr creates a ThreadPoolExecutor
+ */
+Storage::ColumnarQuery::ColumnarQuery(std::string directory, std::shared_ptr<Executor> executor)
+    : directory_(std::move(directory)),
+    executor_(std::move(executor)),
+    files_(std::make_shared<const FileList>())
+{
+    if (!executor_) {
+        executor_ = std::make_shared<ThreadPoolExecutor>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+}
+
+/**
+ * @brief Picks up the finished files of the directory
+ * @return ERROR if a file could not be opened (it is left out)
+ *
+ * Builds a new file list, reusing the readers of files already open, and
+ * swaps it in; running queries keep the list they started with.
+ */
+Event::Status Storage::ColumnarQuery::refresh()
+{
+    std::shared_ptr<const FileList> current;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current = files_;
+    }
+
+    auto files = std::make_shared<FileList>();
+    Event::Status status = Event::Status::OK;
+    for (const auto& path : ColumnarReader::listFiles(directory_))
+    {
+        const auto known = std::find_if(current->begin(), current->end(),
+                                        [&path](const File& file) { return file.path == path; });
+        if (known != current->end()) {
+            files->push_back(*known);
+            continue;
+        }
+        auto reader = std::make_shared<ColumnarReader>();
+        if (reader->open(path) == Event::Status::ERROR) {
+            status = Event::Status::ERROR;
+            continue;
+        }
+        files->push_back(File{path, std::move(reader)});
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_ = std::move(files);
+    return status;
+}
+
+/**
+ * @brief Number of files the queries run over
+ */
+std::size_t Storage::ColumnarQuery::fileCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_->size();
+}
+
+/**
+ * @brief Finds the blocks a filter may match
+ * @param files Files to search
+ * @param filter Query filter
+ * @param stats If set, receives the block counts
+ * @return Candidate blocks in file order
+ *
+ * Uses the block index only: device, type, time range, value range and
+ * blocks made up entirely of faults.
+ */
+std::vector<Storage::ColumnarQuery::Candidate> Storage::ColumnarQuery::prune(const FileList& files,
+                                                                             const Filter& filter,
+                                                                             QueryStats* stats)
+{
+    std::vector<Candidate> candidates;
+    uint64_t blocks = 0;
+    for (const File& file : files)
+    {
+        for (const ColumnarFormat::BlockInfo& block : file.reader->blocks())
+        {
+            blocks++;
+            const bool skip =
+                block.max_timestamp_ns < filter.from_ns || block.min_timestamp_ns >= filter.to_ns ||
+                !(block.max_value >= filter.min_value && block.min_value <= filter.max_value) ||
+                (filter.type && block.type != *filter.type) ||
+                (!filter.include_faults && block.fault_rows == block.rows) ||
+                (!filter.device.empty() && file.reader->deviceName(block) != filter.device);
+            if (!skip) {
+                candidates.push_back(Candidate{file.reader.get(), &block});
+            }
+        }
+    }
+    if (stats != nullptr) {
+        *stats = QueryStats{};
+        stats->blocks = blocks;
+        stats->blocks_scanned = candidates.size();
+        for (const Candidate& candidate : candidates) {
+            stats->rows_decoded += candidate.block->rows;
+        }
+    }
+    return candidates;
+}
+
+/**
+ * @brief Runs one task per candidate and waits for all of them
+ * @param count Number of tasks
+ * @param task Called with each index in [0, count)
+ *
+ * Completion is tracked per call rather than with Executor::drain(), so
+ * concurrent queries sharing the executor do not wait for each other.
+ * Tasks the executor will not take without blocking (its queue is full, or
+ * the query itself runs on one of its threads) run on the calling thread.
+ * The first exception a task throws is rethrown once all tasks are done.
+ */
+template <typename Task>
+void Storage::ColumnarQuery::parallelFor(std::size_t count, const Task& task) const
+{
+    if (count <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t remaining = count;
+    std::exception_ptr failure;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Executor::Task run = [&, i]() {
+            // Count the task as finished even if it throws
+            struct Finish
+            {
+                std::mutex& mutex;
+                std::condition_variable& done;
+                std::size_t& remaining;
+                ~Finish()
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (--remaining == 0) {
+                        done.notify_one();
+                    }
+                }
+            } finish{mutex, done, remaining};
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        };
+        if (!executor_->tryExecute(run)) {
+            run();
+        }
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&remaining]() { return remaining == 0; });
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+/**
+ * @brief Gets the matching readings
+ * @param filter Readings to return
+ * @param stats If set, receives the work done
+ * @return Readings in timestamp order
+ *
+ * Timestamps are decoded first; the other columns of a block are decoded
+ * only if at least one of its rows is inside the time range.
+ */
+std::vector<Event::SensorRecord> Storage::ColumnarQuery::select(const Filter& filter, QueryStats* stats) const
+{
+    std::shared_ptr<const FileList> files;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        files = files_;
+    }
+    const std::vector<Candidate> candidates = prune(*files, filter, stats);
+
+    std::vector<std::vector<Event::SensorRecord>> partials(candidates.size());
+    parallelFor(candidates.size(), [&](std::size_t index) {
+        const ColumnarReader& reader = *candidates[index].reader;
+        const ColumnarFormat::BlockInfo& block = *candidates[index].block;
+        std::vector<int64_t> timestamps;
+        std::vector<double> values;
+        std::vector<uint64_t> sequences;
+        std::vector<uint8_t> flags;
+        if (!reader.readTimestamps(block, timestamps) ||
+            std::none_of(timestamps.begin(), timestamps.end(), [&filter](int64_t timestamp) {
+                return timestamp >= filter.from_ns && timestamp < filter.to_ns;
+            })) {
+            return;
+        }
+        if (!reader.readValues(block, values) || !reader.readSequences(block, sequences) ||
+            !reader.readFlags(block, flags)) {
+            return;
+        }
+
+        const uint32_t device_id = Util::InternTable::global().intern(reader.deviceName(block));
+        for (std::size_t row = 0; row < block.rows; ++row)
+        {
+            if (!matches(filter, timestamps[row], values[row], flags[row])) {
+                continue;
+            }
+            Event::SensorRecord record{};
+            record.timestamp_ns = Util::Clock::fromWallNs(timestamps[row]);
+            record.value = values[row];
+            record.sequence = sequences[row];
+            record.device_id = device_id;
+            record.type = block.type;
+            record.flags = flags[row];
+            partials[index].push_back(record);
+        }
+    });
+
+    std::vector<Event::SensorRecord> records;
+    for (auto& partial : partials) {
+        records.insert(records.end(), partial.begin(), partial.end());
+    }
+    std::stable_sort(records.begin(), records.end(),
+                     [](const Event::SensorRecord& a, const Event::SensorRecord& b) {
+                         return a.timestamp_ns < b.timestamp_ns;
+                     });
+    return records;
+}
+
+/**
+ * @brief Aggregates the matching readings per interval
+ * @param filter Readings to aggregate
+ * @param bucket_ns Interval length; buckets start at multiples of it
+ * @param stats If set, receives the work done
+ * @return Non-empty buckets in time order; empty if bucket_ns is not positive
+ *
+ * Sequence numbers are never decoded, flags only for blocks holding
+ * faults, and timestamps only when the block spans several buckets or
+ * crosses the edge of the time range.
+ */
+std::vector<Storage::ColumnarQuery::Bucket> Storage::ColumnarQuery::aggregate(const Filter& filter, int64_t bucket_ns,
+                                                                              QueryStats* stats) const
+{
+    if (bucket_ns <= 0) {
+        return {};
+    }
+    std::shared_ptr<const FileList> files;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        files = files_;
+    }
+    const std::vector<Candidate> candidates = prune(*files, filter, stats);
+
+    std::vector<std::map<int64_t, Bucket>> partials(candidates.size());
+    parallelFor(candidates.size(), [&](std::size_t index) {
+        const ColumnarReader& reader = *candidates[index].reader;
+        const ColumnarFormat::BlockInfo& block = *candidates[index].block;
+        const bool single_bucket =
+            block.min_timestamp_ns >= filter.from_ns && block.max_timestamp_ns < filter.to_ns &&
+            bucketStart(block.min_timestamp_ns, bucket_ns) == bucketStart(block.max_timestamp_ns, bucket_ns);
+        const bool check_flags = !filter.include_faults && block.fault_rows > 0;
+
+        std::vector<int64_t> timestamps;
+        std::vector<double> values;
+        std::vector<uint8_t> flags;
+        if ((!single_bucket && !reader.readTimestamps(block, timestamps)) || !reader.readValues(block, values) ||
+            (check_flags && !reader.readFlags(block, flags))) {
+            return;
+        }
+
+        auto& buckets = partials[index];
+        for (std::size_t row = 0; row < block.rows; ++row)
+        {
+            const int64_t timestamp = single_bucket ? block.min_timestamp_ns : timestamps[row];
+            if (matches(filter, timestamp, values[row], check_flags ? flags[row] : 0)) {
+                Bucket& bucket = buckets[bucketStart(timestamp, bucket_ns)];
+                accumulate(bucket, values[row]);
+            }
+        }
+    });
+
+    std::map<int64_t, Bucket> merged;
+    for (const auto& partial : partials) {
+        for (const auto& entry : partial) {
+            merge(merged[entry.first], entry.second);
+        }
+    }
+    std::vector<Bucket> buckets;
+    buckets.reserve(merged.size());
+    for (auto& entry : merged) {
+        entry.second.start_ns = entry.first;
+        buckets.push_back(entry.second);
+    }
+    return buckets;
+}
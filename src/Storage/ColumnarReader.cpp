@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Storage/ColumnarReader.h"
+#include "Storage/JournalFormat.h"
+#include "Util/Clock.h"
+#include "Util/InternTable.h"
+
+/**
+ * @brief Unmaps the file
+ */
+Storage::ColumnarReader::~ColumnarReader()
+{
+    close();
+}
+
+/**
+ * @brief Unmaps the file
+ */
+void Storage::ColumnarReader::close()
+{
+    if (data_ != nullptr) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+        data_ = nullptr;
+    }
+    size_ = 0;
+    blocks_.clear();
+    devices_.clear();
+}
+
+/**
+ * @brief Maps a finished columnar file and loads its footer
+ * @param path File written by ColumnarSink (".col")
+ * @return ERROR if the file cannot be mapped or its footer is invalid
+ *
+ * The footer is checksummed and every block is checked to lie inside the
+ * data area, so the decoders never read outside the mapping.
+ */
+Event::Status Storage::ColumnarReader::open(const std::string& path)
+{
+    using namespace ColumnarFormat;
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return Event::Status::ERROR;
+    }
+    const off_t size = ::lseek(fd, 0, SEEK_END);
+    if (size >= static_cast<off_t>(sizeof(FileHeader) + sizeof(Trailer))) {
+        void* data = ::mmap(nullptr, static_cast<std::size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            data_ = static_cast<const uint8_t*>(data);
+            size_ = static_cast<std::size_t>(size);
+        }
+    }
+    ::close(fd);
+    if (data_ == nullptr) {
+        return Event::Status::ERROR;
+    }
+
+    FileHeader header{};
+    Trailer trailer{};
+    std::memcpy(&header, data_, sizeof(header));
+    std::memcpy(&trailer, data_ + size_ - sizeof(trailer), sizeof(trailer));
+    const std::size_t footer_end = size_ - sizeof(trailer);
+    bool ok = std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) == 0 && header.version == kVersion &&
+              std::memcmp(trailer.magic, kTrailerMagic, sizeof(kTrailerMagic)) == 0 && trailer.version == kVersion &&
+              trailer.dictionary_offset >= sizeof(header) && trailer.dictionary_offset <= trailer.index_offset &&
+              trailer.index_offset + uint64_t{trailer.block_count} * sizeof(BlockInfo) == footer_end &&
+              JournalFormat::checksum(data_ + trailer.dictionary_offset,
+                                      footer_end - trailer.dictionary_offset) == trailer.checksum;
+
+    std::size_t offset = ok ? static_cast<std::size_t>(trailer.dictionary_offset) : 0;
+    for (uint32_t i = 0; ok && i < trailer.device_count; ++i)
+    {
+        uint16_t name_size = 0;
+        ok = offset + sizeof(name_size) <= trailer.index_offset;
+        if (ok) {
+            std::memcpy(&name_size, data_ + offset, sizeof(name_size));
+            offset += sizeof(name_size);
+            ok = offset + name_size <= trailer.index_offset;
+        }
+        if (ok) {
+            devices_.emplace_back(reinterpret_cast<const char*>(data_ + offset), name_size);
+            offset += name_size;
+        }
+    }
+
+    if (ok) {
+        blocks_.resize(trailer.block_count);
+        std::memcpy(blocks_.data(), data_ + trailer.index_offset, blocks_.size() * sizeof(BlockInfo));
+    }
+    for (const BlockInfo& block : blocks_)
+    {
+        const uint64_t end = block.offset + uint64_t{block.timestamp_bytes} + block.value_bytes +
+                             block.sequence_bytes + block.flag_bytes;
+        ok = ok && block.offset >= sizeof(header) && end <= trailer.dictionary_offset &&
+             block.device < devices_.size();
+    }
+
+    if (!ok) {
+        close();
+        return Event::Status::ERROR;
+    }
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Gets the finished files of a sink directory
+ * @param directory ColumnarSink directory
+ * @return Paths of the ".col" files, oldest first
+ */
+std::vector<std::string> Storage::ColumnarReader::listFiles(const std::string& directory)
+{
+    std::vector<std::string> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("columns-", 0) == 0 && entry.path().extension() == ".col") {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+/**
+ * @brief Gets the name of the device a block belongs to
+ * @param block Entry of blocks()
+ */
+std::string_view Storage::ColumnarReader::deviceName(const ColumnarFormat::BlockInfo& block) const
+{
+    return devices_[block.device];
+}
+
+/**
+ * @brief Decodes the timestamp column of a block
+ * @param block Entry of blocks()
+ * @param timestamps Receives wall-clock nanoseconds, one per row
+ * @return false if the column is corrupt
+ */
+bool Storage::ColumnarReader::readTimestamps(const ColumnarFormat::BlockInfo& block,
+                                             std::vector<int64_t>& timestamps) const
+{
+    return ColumnarFormat::decodeDeltaOfDelta(data_ + block.offset, block.timestamp_bytes, block.rows, timestamps);
+}
+
+/**
+ * @brief Decodes the value column of a block
+ * @param block Entry of blocks()
+ * @param values Receives one value per row
+ * @return false if the column is corrupt
+ */
+bool Storage::ColumnarReader::readValues(const ColumnarFormat::BlockInfo& block, std::vector<double>& values) const
+{
+    const uint8_t* column = data_ + block.offset + block.timestamp_bytes;
+    return ColumnarFormat::decodeValues(column, block.value_bytes, block.rows, values);
+}
+
+/**
+ * @brief Decodes the device sequence column of a block
+ * @param block Entry of blocks()
+ * @param sequences Receives one SensorRecord::sequence per row
+ * @return false if the column is corrupt
+ */
+bool Storage::ColumnarReader::readSequences(const ColumnarFormat::BlockInfo& block,
+                                            std::vector<uint64_t>& sequences) const
+{
+    const uint8_t* column = data_ + block.offset + block.timestamp_bytes + block.value_bytes;
+    std::vector<int64_t> decoded;
+    if (!ColumnarFormat::decodeDeltaOfDelta(column, block.sequence_bytes, block.rows, decoded)) {
+        return false;
+    }
+    sequences.assign(decoded.begin(), decoded.end());
+    return true;
+}
+
+/**
+ * @brief Decodes the flags column of a block
+ * @param block Entry of blocks()
+ * @param flags Receives one SensorRecord::flags byte per row
+ * @return false if the column is corrupt
+ */
+bool Storage::ColumnarReader::readFlags(const ColumnarFormat::BlockInfo& block, std::vector<uint8_t>& flags) const
+{
+    const uint8_t* column = data_ + block.offset + block.timestamp_bytes + block.value_bytes + block.sequence_bytes;
+    return ColumnarFormat::decodeFlags(column, block.flag_bytes, block.rows, flags);
+}
+
+/**
+ * @brief Decodes every column of a block back into readings
+ * @param block Entry of blocks()
+ * @param records Receives the readings (replaced)
+ * @return false if a column is corrupt
+ */
+bool Storage::ColumnarReader::readRecords(const ColumnarFormat::BlockInfo& block,
+                                          std::vector<Event::SensorRecord>& records) const
+{
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    std::vector<uint64_t> sequences;
+    std::vector<uint8_t> flags;
+    if (!readTimestamps(block, timestamps) || !readValues(block, values) ||
+        !readSequences(block, sequences) || !readFlags(block, flags)) {
+        return false;
+    }
+
+    const uint32_t device_id = Util::InternTable::global().intern(deviceName(block));
+    records.resize(block.rows);
+    for (std::size_t i = 0; i < block.rows; ++i)
+    {
+        Event::SensorRecord& record = records[i];
+        record = Event::SensorRecord{};
+        record.timestamp_ns = Util::Clock::fromWallNs(timestamps[i]);
+        record.value = values[i];
+        record.sequence = sequences[i];
+        record.device_id = device_id;
+        record.type = block.type;
+        record.flags = flags[i];
+    }
+    return true;
+}
@@ -0,0 +1,369 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <unistd.h>
+
+#include "Storage/ColumnarSink.h"
+#include "Storage/JournalFormat.h"
+#include "Event/SensorEvent.h"
+#include "Util/Clock.h"
+
+namespace
+{
+
+/**
+ * @brief Appends the raw bytes of a trivially copyable value
+ * @param value Value to append
+ * @param out Destination bytes
+ */
+template <typename T>
+void appendBytes(const T& value, std::vector<uint8_t>& out)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+} // namespace
+
+/**
+ * @brief Closes the sink, writing out every buffered reading
+ */
+Storage::ColumnarSink::~ColumnarSink()
+{
+    close();
+}
+
+/**
+ * @brief Opens (creating if needed) a sink directory
+ * @param directory Directory receiving the columnar files
+ * @param options Block and file sizes
+ * @return ERROR if already open or the directory cannot be created
+ */
+Event::Status Storage::ColumnarSink::open(const std::string& directory, Options options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) {
+        return Event::Status::ERROR;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "ColumnarSink cannot create " << directory << ": " << error.message() << "\n";
+        return Event::Status::ERROR;
+    }
+
+    // Continue numbering after every file, finished or not, left by earlier runs
+    file_number_ = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("columns-", 0) == 0) {
+            const uint64_t number = std::strtoull(name.c_str() + std::strlen("columns-"), nullptr, 10);
+            file_number_ = std::max(file_number_, number + 1);
+        }
+    }
+
+    options.rows_per_block = std::max<uint32_t>(options.rows_per_block, 1);
+    directory_ = directory;
+    options_ = options;
+    stats_ = Stats{};
+    open_ = true;
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Writes out every buffered reading and finishes the current file
+ * @return ERROR if a write failed
+ */
+Event::Status Storage::ColumnarSink::close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) {
+        return Event::Status::OK;
+    }
+
+    Event::Status status = Event::Status::OK;
+    for (auto& entry : chunks_) {
+        if (!entry.second.timestamps.empty() && writeBlock(entry.second) == Event::Status::ERROR) {
+            status = Event::Status::ERROR;
+        }
+    }
+    if (finishFile() == Event::Status::ERROR) {
+        status = Event::Status::ERROR;
+    }
+    chunks_.clear();
+    open_ = false;
+    return status;
+}
+
+/**
+ * @brief Whether open() succeeded and close() has not been called
+ */
+bool Storage::ColumnarSink::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+/**
+ * @brief Buffers one reading
+ * @param record Reading to store
+ * @return ERROR if the sink is closed or a full chunk could not be written
+ */
+Event::Status Storage::ColumnarSink::append(const Event::SensorRecord& record)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) {
+        return Event::Status::ERROR;
+    }
+    return appendLocked(record);
+}
+
+/**
+ * @brief Buffers the sensor readings of a batch
+ * @param batch Events in publish order; non-sensor events are skipped
+ * @return Number of readings buffered
+ */
+std::size_t Storage::ColumnarSink::append(const EventBatch& batch)
+{
+    std::size_t appended = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) {
+        return 0;
+    }
+    for (const Event::Event& event : batch) {
+        const auto* sensor_event = Event::event_cast<Event::SensorEvent>(event);
+        if (sensor_event != nullptr) {
+            appendLocked(sensor_event->getRecord());
+            appended++;
+        }
+    }
+    return appended;
+}
+
+/**
+ * @brief Buffers one reading; caller holds mutex_
+ * @param record Reading to store
+ * @return ERROR if a full chunk could not be written
+ *
+ * Readings are keyed by device and type, so every block holds one series.
+ */
+Event::Status Storage::ColumnarSink::appendLocked(const Event::SensorRecord& record)
+{
+    const uint64_t key = (static_cast<uint64_t>(record.device_id) << 8) | static_cast<uint8_t>(record.type);
+    auto found = chunks_.find(key);
+    if (found == chunks_.end()) {
+        found = chunks_.emplace(key, Chunk{}).first;
+        Chunk& chunk = found->second;
+        chunk.device_id = record.device_id;
+        chunk.type = record.type;
+        chunk.timestamps.reserve(options_.rows_per_block);
+        chunk.values.reserve(options_.rows_per_block);
+        chunk.sequences.reserve(options_.rows_per_block);
+        chunk.flags.reserve(options_.rows_per_block);
+    }
+
+    Chunk& chunk = found->second;
+    chunk.timestamps.push_back(Util::Clock::toWallNs(record.timestamp_ns));
+    chunk.values.push_back(record.value);
+    chunk.sequences.push_back(static_cast<int64_t>(record.sequence));
+    chunk.flags.push_back(record.flags);
+    stats_.buffered_rows++;
+
+    if (chunk.timestamps.size() >= options_.rows_per_block) {
+        return writeBlock(chunk);
+    }
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Encodes every non-empty chunk as a (possibly short) block
+ * @return ERROR if a write failed
+ */
+Event::Status Storage::ColumnarSink::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Event::Status status = Event::Status::OK;
+    for (auto& entry : chunks_) {
+        if (!entry.second.timestamps.empty() && writeBlock(entry.second) == Event::Status::ERROR) {
+            status = Event::Status::ERROR;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Subscribes the sink to every batch an EventBus dispatches
+ * @param event_bus Bus to record
+ * @param executor Where encoding runs; nullptr runs it on the dispatcher
+ * @return Id of the subscription
+ */
+EventBus::SubscriptionId Storage::ColumnarSink::attach(EventBus& event_bus, std::shared_ptr<Executor> executor)
+{
+    return event_bus.subscribeBatch([this](const EventBatch& batch) {
+        append(batch);
+    }, std::move(executor));
+}
+
+/**
+ * @brief Gets the counters of what has been written
+ */
+Storage::ColumnarSink::Stats Storage::ColumnarSink::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+/**
+ * @brief Encodes a chunk as a block and empties it; caller holds mutex_
+ * @param chunk Chunk to write
+ * @return ERROR if the file cannot be created or written
+ *
+ * Starts a new .part file if none is open and finishes the file once it
+ * reaches max_file_size. The chunk is emptied even on failure so a broken
+ * disk cannot make the buffers grow without bound; the failed file is
+ * discarded.
+ */
+Event::Status Storage::ColumnarSink::writeBlock(Chunk& chunk)
+{
+    using namespace ColumnarFormat;
+    const std::size_t rows = chunk.timestamps.size();
+    stats_.buffered_rows -= rows;
+    const auto clear_chunk = [&chunk]() {
+        chunk.timestamps.clear();
+        chunk.values.clear();
+        chunk.sequences.clear();
+        chunk.flags.clear();
+    };
+
+    const std::string part_path = directory_ + "/" + fileName(file_number_, ".part");
+    if (!file_.isOpen()) {
+        AsyncFileWriter::Options file_options = options_.file;
+        file_options.truncate = true;
+        FileHeader header{};
+        std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+        header.version = kVersion;
+        header.header_size = sizeof(header);
+        if (file_.open(part_path, file_options) == Event::Status::ERROR ||
+            file_.append(&header, sizeof(header)) == Event::Status::ERROR) {
+            std::cerr << "ColumnarSink cannot create " << part_path << "\n";
+            if (file_.isOpen()) {
+                file_.close();
+            }
+            clear_chunk();
+            return Event::Status::ERROR;
+        }
+        file_size_ = sizeof(header);
+        index_.clear();
+        dictionary_.clear();
+        dictionary_ids_.clear();
+    }
+
+    auto known = dictionary_ids_.find(chunk.device_id);
+    if (known == dictionary_ids_.end()) {
+        const std::string_view name = Event::deviceName(chunk.device_id);
+        dictionary_.emplace_back(name.substr(0, UINT16_MAX));
+        known = dictionary_ids_.emplace(chunk.device_id, static_cast<uint32_t>(dictionary_.size() - 1)).first;
+    }
+
+    BlockInfo info{};
+    info.offset = file_size_;
+    info.device = known->second;
+    info.rows = static_cast<uint32_t>(rows);
+    info.type = chunk.type;
+    info.min_timestamp_ns = *std::min_element(chunk.timestamps.begin(), chunk.timestamps.end());
+    info.max_timestamp_ns = *std::max_element(chunk.timestamps.begin(), chunk.timestamps.end());
+    info.min_value = NAN;
+    info.max_value = NAN;
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        const double value = chunk.values[i];
+        if (!std::isnan(value)) {
+            info.min_value = std::isnan(info.min_value) ? value : std::min(info.min_value, value);
+            info.max_value = std::isnan(info.max_value) ? value : std::max(info.max_value, value);
+        }
+        if ((chunk.flags[i] & Event::SensorRecord::kFaultFlag) != 0) {
+            info.fault_rows++;
+        }
+    }
+
+    buffer_.clear();
+    encodeDeltaOfDelta(chunk.timestamps.data(), rows, buffer_);
+    info.timestamp_bytes = static_cast<uint32_t>(buffer_.size());
+    encodeValues(chunk.values.data(), rows, buffer_);
+    info.value_bytes = static_cast<uint32_t>(buffer_.size()) - info.timestamp_bytes;
+    encodeDeltaOfDelta(chunk.sequences.data(), rows, buffer_);
+    info.sequence_bytes = static_cast<uint32_t>(buffer_.size()) - info.timestamp_bytes - info.value_bytes;
+    encodeFlags(chunk.flags.data(), rows, buffer_);
+    info.flag_bytes = static_cast<uint32_t>(buffer_.size()) - info.timestamp_bytes - info.value_bytes -
+                      info.sequence_bytes;
+
+    clear_chunk();
+
+    if (file_.append(buffer_.data(), buffer_.size()) == Event::Status::ERROR) {
+        std::cerr << "ColumnarSink cannot write " << part_path << ", discarding it\n";
+        file_.close();
+        ::unlink(part_path.c_str());
+        file_number_++;
+        return Event::Status::ERROR;
+    }
+    file_size_ += buffer_.size();
+    index_.push_back(info);
+    stats_.rows += rows;
+    stats_.blocks++;
+    stats_.encoded_bytes += buffer_.size();
+
+    if (file_size_ >= options_.max_file_size) {
+        return finishFile();
+    }
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Writes the footer and renames the current file to .col; caller holds mutex_
+ * @return ERROR if the footer cannot be written
+ *
+ * The file is fsynced before the rename, so a finished name always refers
+ * to complete contents. No effect when no file is open.
+ */
+Event::Status Storage::ColumnarSink::finishFile()
+{
+    using namespace ColumnarFormat;
+    if (!file_.isOpen()) {
+        return Event::Status::OK;
+    }
+
+    Trailer trailer{};
+    trailer.dictionary_offset = file_size_;
+    buffer_.clear();
+    for (const auto& name : dictionary_) {
+        appendBytes(static_cast<uint16_t>(name.size()), buffer_);
+        buffer_.insert(buffer_.end(), name.begin(), name.end());
+    }
+    trailer.index_offset = file_size_ + buffer_.size();
+    for (const auto& info : index_) {
+        appendBytes(info, buffer_);
+    }
+    trailer.device_count = static_cast<uint32_t>(dictionary_.size());
+    trailer.block_count = static_cast<uint32_t>(index_.size());
+    trailer.checksum = JournalFormat::checksum(buffer_.data(), buffer_.size());
+    trailer.version = kVersion;
+    std::memcpy(trailer.magic, kTrailerMagic, sizeof(kTrailerMagic));
+    appendBytes(trailer, buffer_);
+
+    const std::string part_path = directory_ + "/" + fileName(file_number_, ".part");
+    const bool ok = file_.append(buffer_.data(), buffer_.size()) == Event::Status::OK &&
+                    file_.sync() == Event::Status::OK;
+    file_.close();
+    file_number_++;
+    if (!ok || std::rename(part_path.c_str(), (directory_ + "/" + fileName(file_number_ - 1, ".col")).c_str()) != 0) {
+        std::cerr << "ColumnarSink cannot finish " << part_path << "\n";
+        return Event::Status::ERROR;
+    }
+    stats_.files++;
+    return Event::Status::OK;
+}
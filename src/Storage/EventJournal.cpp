@@ -0,0 +1,498 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Storage/EventJournal.h"
+#include "Event/SensorEvent.h"
+
+namespace
+{
+
+/**
+ * @brief Rounds an offset down to the start of its page
+ * @param offset Byte offset into a mapping
+ */
+std::size_t pageFloor(std::size_t offset)
+{
+    static const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return offset - (offset % page_size);
+}
+
+/**
+ * @brief Rounds an offset up to the next page boundary
+ * @param offset Byte offset into a mapping
+ */
+std::size_t pageCeil(std::size_t offset)
+{
+    static const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return pageFloor(offset + page_size - 1);
+}
+
+} // namespace
+
+/**
+ * @brief Unmaps and closes the segment if seal() has not done so
+ */
+Storage::EventJournal::Segment::~Segment()
+{
+    if (data != nullptr) {
+        ::munmap(data, capacity);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+/**
+ * @brief Closes the journal, syncing and sealing the current segment
+ */
+Storage::EventJournal::~EventJournal()
+{
+    close();
+}
+
+/**
+ * @brief Opens (creating or recovering) a journal directory
+ * @param directory Directory holding the segment files
+ * @param options Segment and sync settings
+ * @return ERROR if already open, the directory cannot be used, or it
+ *         holds segments this version cannot read
+ *
+ * Recovery seals every segment left without an index by a crash, then
+ * starts a fresh segment after the last valid reading.
+ */
+Event::Status Storage::EventJournal::open(const std::string& directory, Options options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) {
+        return Event::Status::ERROR;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "EventJournal cannot create " << directory << ": " << error.message() << "\n";
+        return Event::Status::ERROR;
+    }
+
+    options.segment_size = std::max(options.segment_size, kMinSegmentSize);
+    options.index_interval = std::max<uint32_t>(options.index_interval, 1);
+    directory_ = directory;
+    options_ = options;
+
+    if (recover(next_sequence_) == Event::Status::ERROR) {
+        return Event::Status::ERROR;
+    }
+    durable_sequence_ = next_sequence_;
+    if (openSegment(next_sequence_) == Event::Status::ERROR) {
+        return Event::Status::ERROR;
+    }
+
+    open_ = true;
+    stop_flusher_ = false;
+    flusher_ = std::thread(&EventJournal::flushLoop, this);
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Recovers the segments found in directory_
+ * @param next_sequence Receives the sequence number after the last valid reading
+ * @return ERROR if a segment cannot be read (e.g. an older format version)
+ *
+ * Sealed segments are trusted through their index. A segment without one
+ * was being written when the process stopped: it is scanned, its torn tail
+ * cut off and then sealed like any other. A segment created but never
+ * given a header holds nothing and is removed. Any other segment that
+ * fails to scan is left untouched, so the journal is not reopened on top
+ * of data it would overwrite.
+ */
+Event::Status Storage::EventJournal::recover(uint64_t& next_sequence)
+{
+    std::vector<std::string> logs;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_, error)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("journal-", 0) == 0 && entry.path().extension() == ".log") {
+            logs.push_back(name);
+        }
+    }
+    std::sort(logs.begin(), logs.end());
+
+    next_sequence = 0;
+    for (const auto& name : logs) {
+        const std::string log_path = directory_ + "/" + name;
+        const std::string index_path = log_path.substr(0, log_path.size() - 4) + ".idx";
+
+        JournalFormat::SegmentInfo info;
+        if (JournalFormat::readIndexFile(index_path, info) == Event::Status::OK) {
+            next_sequence = std::max(next_sequence, info.end_sequence);
+            continue;
+        }
+
+        Segment segment;
+        segment.path = log_path;
+        segment.fd = ::open(log_path.c_str(), O_RDWR | O_CLOEXEC);
+        const off_t size = segment.fd >= 0 ? ::lseek(segment.fd, 0, SEEK_END) : -1;
+        if (size < 0) {
+            std::cerr << "EventJournal cannot read " << log_path << ": " << std::strerror(errno) << "\n";
+            return Event::Status::ERROR;
+        }
+        segment.capacity = static_cast<std::size_t>(size);
+        void* data = size == 0 ? nullptr
+                               : ::mmap(nullptr, segment.capacity, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+        if (data == MAP_FAILED) {
+            std::cerr << "EventJournal cannot map " << log_path << ": " << std::strerror(errno) << "\n";
+            return Event::Status::ERROR;
+        }
+        segment.data = static_cast<char*>(data);
+        const std::size_t header_size = std::min(segment.capacity, sizeof(JournalFormat::SegmentHeader));
+        if (std::all_of(segment.data, segment.data + header_size, [](char byte) { return byte == 0; })) {
+            ::unlink(log_path.c_str()); // Crashed between creating the file and writing its header
+            continue;
+        }
+        if (JournalFormat::scanSegment(segment.data, segment.capacity, options_.index_interval,
+                                       segment.info) == Event::Status::ERROR) {
+            std::cerr << "EventJournal cannot read " << log_path << ": not a version "
+                      << JournalFormat::kVersion << " segment\n";
+            return Event::Status::ERROR;
+        }
+        // Zero the torn tail up to the page boundary; seal() punches out the rest
+        const std::size_t tail_end = std::min(pageCeil(segment.info.used_size), segment.capacity);
+        std::memset(segment.data + segment.info.used_size, 0, tail_end - segment.info.used_size);
+        std::cout << "EventJournal recovered " << (segment.info.end_sequence - segment.info.first_sequence)
+                  << " readings from " << name << "\n";
+        next_sequence = std::max(next_sequence, segment.info.end_sequence);
+        seal(segment, directory_);
+    }
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Creates and maps a new segment; caller holds mutex_
+ * @param first_sequence Sequence number of its first reading
+ * @return ERROR if the file cannot be created or mapped
+ *
+ * The file is fully allocated up front so appends through the mapping
+ * cannot hit SIGBUS on a full disk. It must not exist yet: O_EXCL makes
+ * a name clash an error instead of truncating readings already on disk.
+ */
+Event::Status Storage::EventJournal::openSegment(uint64_t first_sequence)
+{
+    auto segment = std::make_shared<Segment>();
+    segment->path = directory_ + "/" + JournalFormat::segmentFileName(first_sequence, ".log");
+    segment->capacity = options_.segment_size;
+    segment->fd = ::open(segment->path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (segment->fd < 0) {
+        std::cerr << "EventJournal cannot create " << segment->path << ": " << std::strerror(errno) << "\n";
+        return Event::Status::ERROR;
+    }
+    const int allocate_error = ::posix_fallocate(segment->fd, 0, static_cast<off_t>(segment->capacity));
+    if (allocate_error != 0) {
+        std::cerr << "EventJournal cannot allocate " << segment->path << ": " << std::strerror(allocate_error) << "\n";
+        ::unlink(segment->path.c_str());
+        return Event::Status::ERROR;
+    }
+    void* data = ::mmap(nullptr, segment->capacity, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+    if (data == MAP_FAILED) {
+        std::cerr << "EventJournal cannot map " << segment->path << "\n";
+        return Event::Status::ERROR;
+    }
+    segment->data = static_cast<char*>(data);
+
+    JournalFormat::SegmentHeader header{};
+    std::memcpy(header.magic, JournalFormat::kSegmentMagic, sizeof(header.magic));
+    header.version = JournalFormat::kVersion;
+    header.header_size = sizeof(header);
+    header.first_sequence = first_sequence;
+    std::memcpy(segment->data, &header, sizeof(header));
+
+    segment->info.first_sequence = first_sequence;
+    segment->info.end_sequence = first_sequence;
+    segment->info.used_size = sizeof(header);
+    current_ = std::move(segment);
+    synced_offset_ = 0;
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Syncs and seals the current segment and stops the flusher
+ */
+void Storage::EventJournal::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_) {
+            return;
+        }
+        open_ = false;
+        stop_flusher_ = true;
+    }
+    flush_cv_.notify_one();
+    if (flusher_.joinable()) {
+        flusher_.join(); // The final pass seals retired segments
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (current_) {
+        seal(*current_, directory_);
+        current_.reset();
+    }
+    durable_sequence_ = next_sequence_;
+    synced_cv_.notify_all();
+}
+
+/**
+ * @brief Whether the journal is open
+ */
+bool Storage::EventJournal::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+/**
+ * @brief Appends one reading
+ * @param record Reading to journal
+ * @return Sequence number assigned, or kNoSequence on failure
+ */
+uint64_t Storage::EventJournal::append(const Event::SensorRecord& record)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return appendLocked(record);
+}
+
+/**
+ * @brief Appends the sensor readings of a batch
+ * @param batch Events in publish order; non-sensor events are skipped
+ * @return Number of readings appended
+ */
+std::size_t Storage::EventJournal::append(const EventBatch& batch)
+{
+    std::size_t appended = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Event::Event& event : batch) {
+        const auto* sensor_event = Event::event_cast<Event::SensorEvent>(event);
+        if (sensor_event != nullptr && appendLocked(sensor_event->getRecord()) != kNoSequence) {
+            appended++;
+        }
+    }
+    return appended;
+}
+
+/**
+ * @brief Encodes one reading into the current segment; caller holds mutex_
+ * @param record Reading to journal
+ * @return Sequence number, or kNoSequence on failure
+ *
+ * Declares the device first if this segment has not seen it, rolls to a
+ * new segment when the frames would not fit, and wakes the flusher once
+ * sync_bytes are pending.
+ */
+uint64_t Storage::EventJournal::appendLocked(const Event::SensorRecord& record)
+{
+    using namespace JournalFormat;
+    if (!open_ || !current_) {
+        return kNoSequence;
+    }
+
+    const std::string_view name = Event::deviceName(record.device_id);
+    const std::size_t name_size = std::min(name.size(), kMaxDeviceNameSize);
+    const bool declare = record.device_id >= current_->known_devices.size() ||
+                         !current_->known_devices[record.device_id];
+    const std::size_t needed = alignFrame(sizeof(FrameHeader) + sizeof(ReadingPayload)) +
+                               (declare ? alignFrame(sizeof(FrameHeader) + sizeof(DevicePayload) + name_size) : 0);
+
+    if (current_->info.used_size + needed > current_->capacity) {
+        if (current_->info.end_sequence == current_->info.first_sequence) {
+            return kNoSequence; // Would not fit an empty segment either
+        }
+        retired_.push_back(std::move(current_));
+        if (openSegment(next_sequence_) == Event::Status::ERROR) {
+            return kNoSequence;
+        }
+        flush_requested_ = true;
+        flush_cv_.notify_one();
+        return appendLocked(record); // Declares the device again in the new segment
+    }
+
+    if (declare) {
+        char buffer[sizeof(DevicePayload) + kMaxDeviceNameSize];
+        DevicePayload device{};
+        device.device_id = record.device_id;
+        device.name_size = static_cast<uint16_t>(name_size);
+        std::memcpy(buffer, &device, sizeof(device));
+        std::memcpy(buffer + sizeof(device), name.data(), name_size);
+        writeFrame(FrameKind::Device, buffer, sizeof(device) + name_size);
+
+        if (record.device_id >= current_->known_devices.size()) {
+            current_->known_devices.resize(record.device_id + 1, false);
+        }
+        current_->known_devices[record.device_id] = true;
+        current_->info.devices.emplace_back(record.device_id, std::string(name.substr(0, name_size)));
+    }
+
+    ReadingPayload reading{};
+    reading.sequence = next_sequence_;
+    Event::WireFormat::encodeSensorEvent(record, {}, &reading.event);
+    if ((next_sequence_ - current_->info.first_sequence) % options_.index_interval == 0) {
+        current_->info.index.push_back(IndexEntry{next_sequence_, current_->info.used_size});
+    }
+    writeFrame(FrameKind::Reading, &reading, sizeof(reading));
+    current_->info.end_sequence = ++next_sequence_;
+
+    if (current_->info.used_size - synced_offset_ >= options_.sync_bytes && !flush_requested_) {
+        flush_requested_ = true;
+        flush_cv_.notify_one();
+    }
+    return reading.sequence;
+}
+
+/**
+ * @brief Copies a frame into the current segment; caller holds mutex_
+ * @param kind Frame kind
+ * @param payload Payload bytes
+ * @param size Payload size
+ *
+ * The payload is written before the header so a concurrent reader never
+ * sees a valid header over a half-written payload.
+ */
+void Storage::EventJournal::writeFrame(JournalFormat::FrameKind kind, const void* payload, std::size_t size)
+{
+    char* frame = current_->data + current_->info.used_size;
+    std::memcpy(frame + sizeof(JournalFormat::FrameHeader), payload, size);
+
+    JournalFormat::FrameHeader header{};
+    header.kind = kind;
+    header.size = static_cast<uint16_t>(size);
+    header.checksum = JournalFormat::checksum(payload, size);
+    std::memcpy(frame, &header, sizeof(header));
+    current_->info.used_size += JournalFormat::alignFrame(sizeof(header) + size);
+}
+
+/**
+ * @brief Syncs a segment that receives no more appends and writes its index
+ * @param segment Segment to seal
+ * @param directory Journal directory
+ *
+ * The file keeps its size (readers may still have it mapped); the unused
+ * tail is returned to the file system by punching a hole. A segment without
+ * readings is removed instead, so its name can be reused.
+ */
+void Storage::EventJournal::seal(Segment& segment, const std::string& directory)
+{
+    const std::string index_path = directory + "/" +
+        JournalFormat::segmentFileName(segment.info.first_sequence, ".idx");
+
+    if (segment.info.end_sequence == segment.info.first_sequence) {
+        ::unlink(segment.path.c_str());
+        ::unlink(index_path.c_str());
+    } else {
+        ::msync(segment.data, segment.info.used_size, MS_SYNC);
+        const std::size_t tail = pageCeil(segment.info.used_size);
+        if (tail < segment.capacity) {
+            ::fallocate(segment.fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                        static_cast<off_t>(tail), static_cast<off_t>(segment.capacity - tail));
+        }
+        ::fsync(segment.fd);
+        if (JournalFormat::writeIndexFile(index_path, segment.info) == Event::Status::ERROR) {
+            std::cerr << "EventJournal cannot write " << index_path << "\n";
+        }
+    }
+
+    ::munmap(segment.data, segment.capacity);
+    segment.data = nullptr;
+    ::close(segment.fd);
+    segment.fd = -1;
+}
+
+/**
+ * @brief Blocks until every reading appended so far is on disk
+ */
+void Storage::EventJournal::sync()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t target = next_sequence_;
+    flush_requested_ = true;
+    flush_cv_.notify_one();
+    synced_cv_.wait(lock, [this, target]() { return durable_sequence_ >= target || !open_; });
+}
+
+/**
+ * @brief Sequence number the next reading will get
+ */
+uint64_t Storage::EventJournal::nextSequence() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return next_sequence_;
+}
+
+/**
+ * @brief Readings with a lower sequence number are known to be on disk
+ */
+uint64_t Storage::EventJournal::durableSequence() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return durable_sequence_;
+}
+
+/**
+ * @brief Background group-commit loop
+ *
+ * Each pass takes everything appended since the previous one - possibly
+ * from many append() calls - and makes it durable with one msync of the
+ * dirty range, after sealing any segments retired in between. Appenders
+ * are never blocked by the sync itself: the lock is released while the
+ * system calls run.
+ */
+void Storage::EventJournal::flushLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        flush_cv_.wait_for(lock, options_.sync_interval, [this]() {
+            return stop_flusher_ || flush_requested_;
+        });
+        flush_requested_ = false;
+        const bool stopping = stop_flusher_;
+
+        std::vector<std::shared_ptr<Segment>> retired;
+        retired.swap(retired_);
+        std::shared_ptr<Segment> segment = current_;
+        const std::size_t from = synced_offset_;
+        const std::size_t to = segment ? segment->info.used_size : 0;
+        const uint64_t sequence = next_sequence_;
+
+        if (retired.empty() && to == from) {
+            durable_sequence_ = std::max(durable_sequence_, sequence);
+            synced_cv_.notify_all();
+            if (stopping) {
+                break;
+            }
+            continue;
+        }
+
+        lock.unlock();
+        for (const auto& full : retired) {
+            seal(*full, directory_);
+        }
+        if (to > from) {
+            const std::size_t start = pageFloor(from);
+            ::msync(segment->data + start, to - start, MS_SYNC);
+        }
+        lock.lock();
+
+        if (segment == current_) {
+            synced_offset_ = std::max(synced_offset_, to);
+        }
+        durable_sequence_ = std::max(durable_sequence_, sequence);
+        synced_cv_.notify_all();
+        if (stopping) {
+            break;
+        }
+    }
+}
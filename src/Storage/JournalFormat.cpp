@@ -0,0 +1,179 @@
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Storage/JournalFormat.h"
+
+namespace
+{
+
+/**
+ * @brief Writes a whole buffer, retrying short writes
+ * @param fd File descriptor
+ * @param data Bytes to write
+ * @param size Number of bytes
+ * @return true if every byte was written
+ */
+bool writeAll(int fd, const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Walks the frames of a mapped segment
+ * @param data Start of the segment
+ * @param size Mapped size of the segment
+ * @param index_interval Add an index entry every this many readings
+ * @param info Receives the sequence range, valid length, index and devices
+ * @return ERROR if the segment header is invalid
+ */
+Event::Status Storage::JournalFormat::scanSegment(const char* data, std::size_t size, uint32_t index_interval,
+                                                  SegmentInfo& info)
+{
+    SegmentHeader header{};
+    if (size < sizeof(header)) {
+        return Event::Status::ERROR;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kSegmentMagic, sizeof(kSegmentMagic)) != 0 || header.version != kVersion) {
+        return Event::Status::ERROR;
+    }
+    index_interval = index_interval == 0 ? 1 : index_interval;
+
+    info = SegmentInfo{};
+    info.first_sequence = header.first_sequence;
+    info.end_sequence = header.first_sequence;
+    std::size_t offset = sizeof(header);
+
+    while (offset + sizeof(FrameHeader) <= size)
+    {
+        FrameHeader frame{};
+        std::memcpy(&frame, data + offset, sizeof(frame));
+        const std::size_t frame_size = alignFrame(sizeof(frame) + frame.size);
+        if (frame.kind == FrameKind::End || offset + frame_size > size) {
+            break;
+        }
+        const char* payload = data + offset + sizeof(frame);
+        if (checksum(payload, frame.size) != frame.checksum) {
+            break; // Torn write
+        }
+
+        if (frame.kind == FrameKind::Device) {
+            DevicePayload device{};
+            if (frame.size < sizeof(device)) {
+                break;
+            }
+            std::memcpy(&device, payload, sizeof(device));
+            if (sizeof(device) + device.name_size > frame.size) {
+                break;
+            }
+            info.devices.emplace_back(device.device_id, std::string(payload + sizeof(device), device.name_size));
+        } else if (frame.kind == FrameKind::Reading) {
+            uint64_t sequence = 0;
+            Event::WireFormat::SensorEventView event;
+            if (frame.size < sizeof(sequence) ||
+                Event::WireFormat::SensorEventView::parse(payload + sizeof(sequence), frame.size - sizeof(sequence),
+                                                          event) == Event::Status::ERROR) {
+                break;
+            }
+            std::memcpy(&sequence, payload, sizeof(sequence));
+            if (sequence != info.end_sequence) {
+                break;
+            }
+            if ((sequence - info.first_sequence) % index_interval == 0) {
+                info.index.push_back(IndexEntry{sequence, offset});
+            }
+            info.end_sequence++;
+        } else {
+            break;
+        }
+        offset += frame_size;
+    }
+    info.used_size = offset;
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Writes a sealed segment's .idx sidecar and fsyncs it
+ * @param path Index file path
+ * @param info Segment description to store
+ * @return ERROR if the file cannot be written
+ */
+Event::Status Storage::JournalFormat::writeIndexFile(const std::string& path, const SegmentInfo& info)
+{
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return Event::Status::ERROR;
+    }
+
+    IndexHeader header{};
+    std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+    header.version = kVersion;
+    header.entry_count = static_cast<uint32_t>(info.index.size());
+    header.first_sequence = info.first_sequence;
+    header.end_sequence = info.end_sequence;
+    header.used_size = info.used_size;
+    header.device_count = static_cast<uint32_t>(info.devices.size());
+
+    bool ok = writeAll(fd, &header, sizeof(header)) &&
+              writeAll(fd, info.index.data(), info.index.size() * sizeof(IndexEntry));
+    for (const auto& device : info.devices) {
+        DevicePayload entry{};
+        entry.device_id = device.first;
+        entry.name_size = static_cast<uint16_t>(device.second.size());
+        ok = ok && writeAll(fd, &entry, sizeof(entry)) && writeAll(fd, device.second.data(), entry.name_size);
+    }
+    ok = ok && ::fsync(fd) == 0;
+    ::close(fd);
+    return ok ? Event::Status::OK : Event::Status::ERROR;
+}
+
+/**
+ * @brief Reads a .idx sidecar
+ * @param path Index file path
+ * @param info Receives the stored segment description
+ * @return ERROR if the file is missing or malformed
+ */
+Event::Status Storage::JournalFormat::readIndexFile(const std::string& path, SegmentInfo& info)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return Event::Status::ERROR;
+    }
+
+    IndexHeader header{};
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, kIndexMagic, sizeof(kIndexMagic)) == 0 &&
+              header.version == kVersion;
+    if (ok) {
+        info = SegmentInfo{};
+        info.first_sequence = header.first_sequence;
+        info.end_sequence = header.end_sequence;
+        info.used_size = static_cast<std::size_t>(header.used_size);
+        info.index.resize(header.entry_count);
+        ok = info.index.empty() ||
+             std::fread(info.index.data(), sizeof(IndexEntry), info.index.size(), file) == info.index.size();
+    }
+    for (uint32_t i = 0; ok && i < header.device_count; ++i) {
+        DevicePayload entry{};
+        ok = std::fread(&entry, sizeof(entry), 1, file) == 1;
+        std::string name(entry.name_size, '\0');
+        ok = ok && (name.empty() || std::fread(&name[0], 1, name.size(), file) == name.size());
+        if (ok) {
+            info.devices.emplace_back(entry.device_id, std::move(name));
+        }
+    }
+    std::fclose(file);
+    return ok ? Event::Status::OK : Event::Status::ERROR;
+}
@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Storage/JournalReader.h"
+#include "Util/InternTable.h"
+
+namespace
+{
+
+constexpr uint32_t kScanIndexInterval = 1024;  ///< Index density when a segment has no .idx yet
+
+} // namespace
+
+/**
+ * @brief Unmaps the current segment
+ */
+Storage::JournalReader::~JournalReader()
+{
+    unmap();
+}
+
+/**
+ * @brief Opens a journal directory, positioned at its first reading
+ * @param directory Directory written by EventJournal
+ * @return ERROR if the directory holds no segments
+ */
+Event::Status Storage::JournalReader::open(const std::string& directory)
+{
+    unmap();
+    directory_ = directory;
+    listSegments();
+    if (segments_.empty()) {
+        return Event::Status::ERROR;
+    }
+    return loadSegment(0);
+}
+
+/**
+ * @brief Re-lists the segment files of the directory
+ *
+ * Picks up segments the writer created since the last listing.
+ */
+void Storage::JournalReader::listSegments()
+{
+    segments_.clear();
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_, error)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("journal-", 0) == 0 && entry.path().extension() == ".log") {
+            segments_.push_back(std::strtoull(name.c_str() + 8, nullptr, 10));
+        }
+    }
+    std::sort(segments_.begin(), segments_.end());
+}
+
+/**
+ * @brief Unmaps the current segment
+ */
+void Storage::JournalReader::unmap()
+{
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    position_ = kNoSegment;
+}
+
+/**
+ * @brief Maps a segment and loads (or builds) its index and devices
+ * @param position Position in segments_
+ * @return ERROR if the segment cannot be mapped or is not a segment
+ *
+ * A sealed segment is read up to the valid length its index records. A
+ * segment without an index may still be growing, so it is read up to the
+ * first invalid frame at the time of each next() call.
+ */
+Event::Status Storage::JournalReader::loadSegment(std::size_t position)
+{
+    unmap();
+    const uint64_t first_sequence = segments_[position];
+    const std::string path = directory_ + "/" + JournalFormat::segmentFileName(first_sequence, ".log");
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    const off_t size = fd_ >= 0 ? ::lseek(fd_, 0, SEEK_END) : -1;
+    if (size < static_cast<off_t>(sizeof(JournalFormat::SegmentHeader))) {
+        unmap();
+        return Event::Status::ERROR;
+    }
+    size_ = static_cast<std::size_t>(size);
+    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+        unmap();
+        return Event::Status::ERROR;
+    }
+    data_ = static_cast<const char*>(data);
+
+    const std::string index_path = directory_ + "/" + JournalFormat::segmentFileName(first_sequence, ".idx");
+    if (JournalFormat::readIndexFile(index_path, info_) == Event::Status::OK) {
+        limit_ = std::min(info_.used_size, size_);
+    } else if (JournalFormat::scanSegment(data_, size_, kScanIndexInterval, info_) == Event::Status::OK) {
+        limit_ = size_;
+    } else {
+        unmap();
+        return Event::Status::ERROR;
+    }
+
+    devices_.clear();
+    for (const auto& device : info_.devices) {
+        addDevice(device.first, device.second);
+    }
+    position_ = position;
+    offset_ = sizeof(JournalFormat::SegmentHeader);
+    next_sequence_ = info_.first_sequence;
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Records a device frame's name under its journal id
+ * @param journal_id Id in the segment
+ * @param name Device name
+ */
+void Storage::JournalReader::addDevice(uint32_t journal_id, const std::string& name)
+{
+    devices_[journal_id] = Util::InternTable::global().intern(name);
+}
+
+/**
+ * @brief Positions the reader at a sequence number
+ * @param sequence Sequence of the next reading to return
+ * @return ERROR if sequence is before the first journaled reading
+ */
+Event::Status Storage::JournalReader::seek(uint64_t sequence)
+{
+    listSegments();
+    if (segments_.empty() || sequence < segments_.front()) {
+        return Event::Status::ERROR;
+    }
+
+    // Last segment starting at or before sequence
+    const auto segment = std::upper_bound(segments_.begin(), segments_.end(), sequence) - 1;
+    if (loadSegment(static_cast<std::size_t>(segment - segments_.begin())) == Event::Status::ERROR) {
+        return Event::Status::ERROR;
+    }
+
+    const auto point = std::upper_bound(info_.index.begin(), info_.index.end(), sequence,
+        [](uint64_t value, const JournalFormat::IndexEntry& entry) { return value < entry.sequence; });
+    if (point != info_.index.begin()) {
+        offset_ = static_cast<std::size_t>((point - 1)->offset);
+        next_sequence_ = (point - 1)->sequence;
+    }
+    skip_until_ = sequence;
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Reads the next reading
+ * @param entry Receives the reading
+ * @return false at the end of the journal
+ *
+ * Walks frames from the current offset, validating checksums, device frame
+ * sizes and sequence continuity; at the end of a segment moves on to the next one if the
+ * writer has created it.
+ */
+bool Storage::JournalReader::next(JournalEntry& entry)
+{
+    using namespace JournalFormat;
+    while (position_ != kNoSegment)
+    {
+        while (offset_ + sizeof(FrameHeader) <= limit_)
+        {
+            FrameHeader frame{};
+            std::memcpy(&frame, data_ + offset_, sizeof(frame));
+            const std::size_t frame_size = alignFrame(sizeof(frame) + frame.size);
+            if (frame.kind == FrameKind::End || offset_ + frame_size > limit_) {
+                break;
+            }
+            const char* payload = data_ + offset_ + sizeof(frame);
+            if (checksum(payload, frame.size) != frame.checksum) {
+                break; // Not fully written yet, or torn
+            }
+
+            if (frame.kind == FrameKind::Device) {
+                DevicePayload device{};
+                if (frame.size < sizeof(device)) {
+                    break;
+                }
+                std::memcpy(&device, payload, sizeof(device));
+                if (sizeof(device) + device.name_size > frame.size) {
+                    break;
+                }
+                addDevice(device.device_id, std::string(payload + sizeof(device), device.name_size));
+                offset_ += frame_size;
+                continue;
+            }
+
+            uint64_t sequence = 0;
+            Event::WireFormat::SensorEventView event;
+            if (frame.kind != FrameKind::Reading || frame.size < sizeof(sequence) ||
+                Event::WireFormat::SensorEventView::parse(payload + sizeof(sequence), frame.size - sizeof(sequence),
+                                                          event) == Event::Status::ERROR) {
+                break;
+            }
+            std::memcpy(&sequence, payload, sizeof(sequence));
+            if (sequence != next_sequence_) {
+                break;
+            }
+            offset_ += frame_size;
+            next_sequence_++;
+            if (sequence < skip_until_) {
+                continue;
+            }
+
+            const auto device = devices_.find(event.deviceId());
+            entry.sequence = sequence;
+            entry.record = event.toRecord(device != devices_.end() ? device->second : Util::InternTable::kInvalidId);
+            return true;
+        }
+
+        // End of this segment: continue in the next one, if there is one yet
+        const uint64_t current = segments_[position_];
+        listSegments();
+        const auto following = std::upper_bound(segments_.begin(), segments_.end(), current);
+        if (following == segments_.end()) {
+            position_ = static_cast<std::size_t>(
+                std::lower_bound(segments_.begin(), segments_.end(), current) - segments_.begin());
+            return false;
+        }
+        if (loadSegment(static_cast<std::size_t>(following - segments_.begin())) == Event::Status::ERROR) {
+            return false;
+        }
+    }
+    return false;
+}
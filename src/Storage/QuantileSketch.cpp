@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+#include "Storage/QuantileSketch.h"
+
+namespace
+{
+
+/**
+ * @struct SketchHeader
+ * @brief Fixed part of a serialized sketch; (int32 index, uint64 count)
+ *        pairs follow, negative bins first, each store in index order
+ */
+struct SketchHeader
+{
+    double accuracy;          ///< Relative accuracy
+    uint32_t max_bins;        ///< Bin limit
+    uint32_t positive_bins;   ///< Number of positive bins
+    uint32_t negative_bins;   ///< Number of negative bins
+    uint32_t reserved;        ///< Zero
+    uint64_t zero_count;      ///< Values counted as zero
+};
+
+constexpr std::size_t kBinSize = sizeof(int32_t) + sizeof(uint64_t);   ///< Serialized size of one bin
+
+/**
+ * @brief Appends the bins of one store
+ * @param bins Store to write
+ * @param out Destination bytes
+ */
+void writeBins(const std::map<int32_t, uint64_t>& bins, std::vector<uint8_t>& out)
+{
+    for (const auto& bin : bins) {
+        uint8_t bytes[kBinSize];
+        std::memcpy(bytes, &bin.first, sizeof(bin.first));
+        std::memcpy(bytes + sizeof(bin.first), &bin.second, sizeof(bin.second));
+        out.insert(out.end(), bytes, bytes + kBinSize);
+    }
+}
+
+/**
+ * @brief Reads the bins of one store
+ * @param data First serialized bin
+ * @param count Number of bins
+ * @param bins Receives the bins
+ * @param total Incremented by the bin counts
+ * @return false if indexes are not strictly increasing or a count is zero
+ */
+bool readBins(const uint8_t* data, uint32_t count, std::map<int32_t, uint64_t>& bins, uint64_t& total)
+{
+    for (uint32_t i = 0; i < count; ++i) {
+        int32_t index = 0;
+        uint64_t bin_count = 0;
+        std::memcpy(&index, data + i * kBinSize, sizeof(index));
+        std::memcpy(&bin_count, data + i * kBinSize + sizeof(index), sizeof(bin_count));
+        if (bin_count == 0 || (!bins.empty() && index <= bins.rbegin()->first)) {
+            return false;
+        }
+        bins.emplace_hint(bins.end(), index, bin_count);
+        total += bin_count;
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Constructs an empty sketch
+ * @param relative_accuracy Relative error bound, clamped to [1e-4, 0.5]
+ * @param max_bins Most bins kept (at least 16)
+ */
+Storage::QuantileSketch::QuantileSketch(double relative_accuracy, uint32_t max_bins)
+    : accuracy_(std::clamp(relative_accuracy, 1e-4, 0.5)),
+    gamma_((1.0 + accuracy_) / (1.0 - accuracy_)),
+    log_gamma_(std::log(gamma_)),
+    max_bins_(std::max<uint32_t>(max_bins, 16))
+{
+}
+
+/**
+ * @brief Gets the bin of a positive magnitude
+ * @param magnitude Value above kMinMagnitude
+ */
+int32_t Storage::QuantileSketch::binIndex(double magnitude) const
+{
+    return static_cast<int32_t>(std::ceil(std::log(magnitude) / log_gamma_));
+}
+
+/**
+ * @brief Gets the representative magnitude of a bin
+ * @param index Bin index
+ *
+ * 2 gamma^i / (gamma + 1) has the same relative distance to both bin edges.
+ */
+double Storage::QuantileSketch::binValue(int32_t index) const
+{
+    return 2.0 * std::exp(index * log_gamma_) / (gamma_ + 1.0);
+}
+
+/**
+ * @brief Counts one value
+ * @param value Value to add; NaN is ignored
+ */
+void Storage::QuantileSketch::add(double value)
+{
+    if (std::isnan(value)) {
+        return;
+    }
+    const double magnitude = std::fabs(value);
+    if (magnitude < kMinMagnitude) {
+        zero_count_++;
+    } else if (value > 0) {
+        positive_[binIndex(magnitude)]++;
+    } else {
+        negative_[binIndex(magnitude)]++;
+    }
+    count_++;
+    if (positive_.size() + negative_.size() > max_bins_) {
+        collapse();
+    }
+}
+
+/**
+ * @brief Adds the counts of another sketch
+ * @param other Sketch built with the same relative accuracy
+ * @return ERROR (and no change) if the accuracies differ
+ */
+Event::Status Storage::QuantileSketch::merge(const QuantileSketch& other)
+{
+    if (other.accuracy_ != accuracy_) {
+        return Event::Status::ERROR;
+    }
+    for (const auto& bin : other.positive_) {
+        positive_[bin.first] += bin.second;
+    }
+    for (const auto& bin : other.negative_) {
+        negative_[bin.first] += bin.second;
+    }
+    zero_count_ += other.zero_count_;
+    count_ += other.count_;
+    collapse();
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Folds the lowest-magnitude bins until at most max_bins_ remain
+ *
+ * Works on the store with more bins; its two lowest bins become one.
+ */
+void Storage::QuantileSketch::collapse()
+{
+    while (positive_.size() + negative_.size() > max_bins_)
+    {
+        auto& bins = positive_.size() >= negative_.size() ? positive_ : negative_;
+        const auto lowest = bins.begin();
+        std::next(lowest)->second += lowest->second;
+        bins.erase(lowest);
+    }
+}
+
+/**
+ * @brief Estimates a quantile
+ * @param q Quantile in [0, 1] (0.5 = median)
+ * @return Estimated value, or NaN for an empty sketch
+ *
+ * Walks the bins from the most negative value up until the cumulative
+ * count passes q * (count - 1).
+ */
+double Storage::QuantileSketch::quantile(double q) const
+{
+    if (count_ == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const double rank = std::clamp(q, 0.0, 1.0) * static_cast<double>(count_ - 1);
+    uint64_t seen = 0;
+    for (auto bin = negative_.rbegin(); bin != negative_.rend(); ++bin) {
+        seen += bin->second;
+        if (static_cast<double>(seen) > rank) {
+            return -binValue(bin->first);
+        }
+    }
+    seen += zero_count_;
+    if (static_cast<double>(seen) > rank) {
+        return 0.0;
+    }
+    for (const auto& bin : positive_) {
+        seen += bin.second;
+        if (static_cast<double>(seen) > rank) {
+            return binValue(bin.first);
+        }
+    }
+    return positive_.empty() ? 0.0 : binValue(positive_.rbegin()->first);
+}
+
+/**
+ * @brief Appends the sketch in its compact binary form
+ * @param out Destination bytes
+ */
+void Storage::QuantileSketch::serialize(std::vector<uint8_t>& out) const
+{
+    SketchHeader header{};
+    header.accuracy = accuracy_;
+    header.max_bins = max_bins_;
+    header.positive_bins = static_cast<uint32_t>(positive_.size());
+    header.negative_bins = static_cast<uint32_t>(negative_.size());
+    header.zero_count = zero_count_;
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&header);
+    out.insert(out.end(), bytes, bytes + sizeof(header));
+    writeBins(negative_, out);
+    writeBins(positive_, out);
+}
+
+/**
+ * @brief Rebuilds a sketch written by serialize()
+ * @param data Serialized bytes
+ * @param size Number of bytes
+ * @param sketch Receives the sketch
+ * @return ERROR if the bytes are malformed
+ */
+Event::Status Storage::QuantileSketch::deserialize(const uint8_t* data, std::size_t size, QuantileSketch& sketch)
+{
+    SketchHeader header{};
+    if (size < sizeof(header)) {
+        return Event::Status::ERROR;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    const uint64_t bins = uint64_t{header.positive_bins} + header.negative_bins;
+    if (!(header.accuracy >= 1e-4 && header.accuracy <= 0.5) || size != sizeof(header) + bins * kBinSize) {
+        return Event::Status::ERROR;
+    }
+
+    QuantileSketch result(header.accuracy, header.max_bins);
+    result.zero_count_ = header.zero_count;
+    uint64_t total = header.zero_count;
+    const uint8_t* negative = data + sizeof(header);
+    const uint8_t* positive = negative + header.negative_bins * kBinSize;
+    if (!readBins(negative, header.negative_bins, result.negative_, total) ||
+        !readBins(positive, header.positive_bins, result.positive_, total)) {
+        return Event::Status::ERROR;
+    }
+    result.count_ = total;
+    sketch = std::move(result);
+    return Event::Status::OK;
+}
@@ -0,0 +1,583 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Storage/RollupStore.h"
+#include "Storage/JournalFormat.h"
+#include "Event/SensorEvent.h"
+#include "Util/Clock.h"
+
+namespace
+{
+
+constexpr int64_t kIdleCheckIntervalNs = 100 * 1000 * 1000;   ///< Least time between idle scans
+constexpr std::size_t kIndexChunkBytes = 16 * 1024;            ///< Tier file bytes covered by one index chunk
+
+/// Tier file names, indexed by RollupTier
+constexpr const char* kTierFileNames[Storage::RollupStore::kTierCount] = {
+    "rollup-1s.log", "rollup-1m.log", "rollup-1h.log"};
+
+/**
+ * @struct EntryHeader
+ * @brief Fixed part of a persisted bucket; the device name and the
+ *        serialized sketch follow
+ */
+struct EntryHeader
+{
+    uint32_t size;             ///< Bytes after the header: name_size + sketch_size
+    uint32_t checksum;         ///< FNV-1a of the entry with this field zeroed
+    int64_t start_ns;          ///< Wall-clock start of the bucket
+    uint64_t count;            ///< Readings in the bucket
+    double min;                ///< Smallest value
+    double max;                ///< Largest value
+    double sum;                ///< Sum of the values
+    uint32_t sketch_size;      ///< Size of the serialized sketch
+    uint16_t name_size;        ///< Length of the device name
+    Event::SensorType type;    ///< Sensor type
+    uint8_t tier;              ///< Storage::RollupTier
+};
+
+static_assert(sizeof(EntryHeader) == 56, "EntryHeader is expected to be 56 bytes");
+
+/**
+ * @brief Start of the bucket holding a timestamp
+ * @param timestamp_ns Wall-clock timestamp
+ * @param width_ns Bucket length, positive
+ */
+int64_t bucketStart(int64_t timestamp_ns, int64_t width_ns)
+{
+    int64_t remainder = timestamp_ns % width_ns;
+    if (remainder < 0) {
+        remainder += width_ns;
+    }
+    return timestamp_ns - remainder;
+}
+
+/**
+ * @brief Computes the checksum of an encoded entry
+ * @param entry Header followed by size bytes; the checksum field is ignored
+ * @param size Total entry size
+ */
+uint32_t entryChecksum(const uint8_t* entry, std::size_t size)
+{
+    std::vector<uint8_t> copy(entry, entry + size);
+    std::memset(copy.data() + offsetof(EntryHeader, checksum), 0, sizeof(uint32_t));
+    return Storage::JournalFormat::checksum(copy.data(), copy.size());
+}
+
+/**
+ * @brief Reads the valid entries in a byte range of a tier file
+ * @param file Open tier file
+ * @param offset Where the first entry starts
+ * @param end Offset to stop at; SIZE_MAX for the end of the file
+ * @param visit Called as visit(rollup, entry_size) for each decoded rollup
+ * @return Offset after the last valid entry
+ *
+ * Stops at a truncated entry or a checksum mismatch.
+ */
+template <typename Visitor>
+std::size_t readEntries(std::FILE* file, std::size_t offset, std::size_t end, const Visitor& visit)
+{
+    if (std::fseek(file, static_cast<long>(offset), SEEK_SET) != 0) {
+        return offset;
+    }
+    std::vector<uint8_t> entry;
+    while (offset < end)
+    {
+        EntryHeader header{};
+        if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+            header.size != uint32_t{header.name_size} + header.sketch_size ||
+            offset + sizeof(header) + header.size > end) {
+            break;
+        }
+        entry.resize(sizeof(header) + header.size);
+        std::memcpy(entry.data(), &header, sizeof(header));
+        if (std::fread(entry.data() + sizeof(header), 1, header.size, file) != header.size ||
+            entryChecksum(entry.data(), entry.size()) != header.checksum) {
+            break;
+        }
+
+        Storage::Rollup rollup;
+        const uint8_t* name = entry.data() + sizeof(header);
+        if (Storage::QuantileSketch::deserialize(name + header.name_size, header.sketch_size, rollup.sketch) ==
+            Event::Status::ERROR) {
+            break;
+        }
+        rollup.device.assign(reinterpret_cast<const char*>(name), header.name_size);
+        rollup.type = header.type;
+        rollup.tier = static_cast<Storage::RollupTier>(header.tier);
+        rollup.start_ns = header.start_ns;
+        rollup.count = header.count;
+        rollup.min = header.min;
+        rollup.max = header.max;
+        rollup.sum = header.sum;
+        visit(rollup, entry.size());
+        offset += entry.size();
+    }
+    return offset;
+}
+
+} // namespace
+
+/**
+ * @brief Adds one value
+ * @param value Reading value
+ */
+void Storage::Rollup::add(double value)
+{
+    if (count == 0) {
+        min = value;
+        max = value;
+    } else {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    sum += value;
+    count++;
+    sketch.add(value);
+}
+
+/**
+ * @brief Folds in the aggregate of the same series over the same or another period
+ * @param other Aggregate to fold in
+ *
+ * The sketch is only merged if both were built with the same accuracy.
+ */
+void Storage::Rollup::merge(const Rollup& other)
+{
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        min = other.min;
+        max = other.max;
+    } else {
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+    sum += other.sum;
+    count += other.count;
+    sketch.merge(other.sketch);
+}
+
+/**
+ * @brief Gets the bucket length of a tier
+ * @param tier Tier
+ * @return Length in nanoseconds
+ */
+int64_t Storage::RollupStore::tierWidthNs(RollupTier tier)
+{
+    switch (tier)
+    {
+        case RollupTier::Second: return Util::Clock::kNanosPerSecond;
+        case RollupTier::Minute: return 60 * Util::Clock::kNanosPerSecond;
+        case RollupTier::Hour: return 3600 * Util::Clock::kNanosPerSecond;
+    }
+    return Util::Clock::kNanosPerSecond;
+}
+
+/**
+ * @brief Closes the store, persisting the open buckets
+ */
+Storage::RollupStore::~RollupStore()
+{
+    close();
+}
+
+/**
+ * @brief Opens (creating if needed) a rollup directory
+ * @param directory Directory holding the tier files
+ * @param options Closing and sketch settings
+ * @return ERROR if already open or the files cannot be opened
+ */
+Event::Status Storage::RollupStore::open(const std::string& directory, Options options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) {
+        return Event::Status::ERROR;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "RollupStore cannot create " << directory << ": " << error.message() << "\n";
+        return Event::Status::ERROR;
+    }
+
+    for (std::size_t tier = 0; tier < kTierCount; ++tier)
+    {
+        const std::string path = directory + "/" + kTierFileNames[tier];
+        index_[tier].clear();
+        std::size_t valid_size = 0;
+        if (std::FILE* file = std::fopen(path.c_str(), "rb")) {
+            valid_size = readEntries(file, 0, SIZE_MAX, [this, tier](const Rollup& rollup, std::size_t size) {
+                indexLocked(tier, rollup.start_ns, size);
+            });
+            std::fclose(file);
+        }
+        if (std::filesystem::exists(path, error) && std::filesystem::file_size(path, error) > valid_size) {
+            std::filesystem::resize_file(path, valid_size, error); // Cut off a torn last entry
+        }
+        fds_[tier] = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fds_[tier] < 0) {
+            std::cerr << "RollupStore cannot open " << path << "\n";
+            for (int& fd : fds_) {
+                if (fd >= 0) {
+                    ::close(fd);
+                    fd = -1;
+                }
+            }
+            return Event::Status::ERROR;
+        }
+    }
+
+    directory_ = directory;
+    options_ = options;
+    stats_ = Stats{};
+    last_idle_check_ns_ = Util::Clock::nowNs();
+    open_ = true;
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Persists every open bucket and closes the files
+ */
+void Storage::RollupStore::close()
+{
+    flush();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) {
+        return;
+    }
+    for (int& fd : fds_) {
+        ::fsync(fd);
+        ::close(fd);
+        fd = -1;
+    }
+    series_.clear();
+    for (std::vector<IndexChunk>& chunks : index_) {
+        chunks.clear();
+    }
+    open_ = false;
+}
+
+/**
+ * @brief Whether open() succeeded and close() has not been called
+ */
+bool Storage::RollupStore::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+/**
+ * @brief Aggregates one reading
+ * @param record Reading; faults are skipped
+ */
+void Storage::RollupStore::add(const Event::SensorRecord& record)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) {
+        addLocked(record);
+    }
+}
+
+/**
+ * @brief Aggregates the sensor readings of a batch
+ * @param batch Events in publish order; non-sensor events are skipped
+ */
+void Storage::RollupStore::add(const EventBatch& batch)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) {
+        return;
+    }
+    for (const Event::Event& event : batch) {
+        const auto* sensor_event = Event::event_cast<Event::SensorEvent>(event);
+        if (sensor_event != nullptr) {
+            addLocked(sensor_event->getRecord());
+        }
+    }
+    closeIdleLocked(Util::Clock::nowNs());
+}
+
+/**
+ * @brief Aggregates one reading; caller holds mutex_
+ * @param record Reading to aggregate
+ *
+ * A reading in a later bucket than the open one closes it; a reading in
+ * an earlier bucket (late) is persisted on its own, to be merged with the
+ * closed bucket at query time.
+ */
+void Storage::RollupStore::addLocked(const Event::SensorRecord& record)
+{
+    if (record.isFault()) {
+        return;
+    }
+    const uint64_t key = (static_cast<uint64_t>(record.device_id) << 8) | static_cast<uint8_t>(record.type);
+    Series& series = series_[key];
+    series.last_update_ns = Util::Clock::nowNs();
+    const int64_t timestamp = Util::Clock::toWallNs(record.timestamp_ns);
+    bool late = false;
+
+    for (std::size_t tier = 0; tier < kTierCount; ++tier)
+    {
+        const int64_t start = bucketStart(timestamp, tierWidthNs(static_cast<RollupTier>(tier)));
+        Rollup& bucket = series.buckets[tier];
+        if (bucket.count > 0 && start < bucket.start_ns) {
+            Rollup single;
+            single.device = bucket.device;
+            single.type = bucket.type;
+            single.tier = bucket.tier;
+            single.start_ns = start;
+            single.sketch = QuantileSketch(options_.sketch_accuracy);
+            single.add(record.value);
+            persistLocked(single);
+            late = true;
+            continue;
+        }
+        if (bucket.count > 0 && start > bucket.start_ns) {
+            persistLocked(bucket);
+            bucket.count = 0;
+        }
+        if (bucket.count == 0) {
+            bucket.device = std::string(Event::deviceName(record.device_id));
+            bucket.type = record.type;
+            bucket.tier = static_cast<RollupTier>(tier);
+            bucket.start_ns = start;
+            bucket.sum = 0.0;
+            bucket.sketch = QuantileSketch(options_.sketch_accuracy);
+        }
+        bucket.add(record.value);
+    }
+    stats_.readings++;
+    stats_.late_readings += late ? 1 : 0;
+}
+
+/**
+ * @brief Persists the buckets of idle series; caller holds mutex_
+ * @param now_ns Current Util::Clock time
+ *
+ * Runs at most every 100 ms. Idle series are forgotten; a reading after
+ * the pause starts fresh buckets.
+ */
+void Storage::RollupStore::closeIdleLocked(int64_t now_ns)
+{
+    if (now_ns - last_idle_check_ns_ < kIdleCheckIntervalNs) {
+        return;
+    }
+    last_idle_check_ns_ = now_ns;
+    const int64_t idle_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(options_.idle_timeout).count();
+    for (auto entry = series_.begin(); entry != series_.end();)
+    {
+        if (now_ns - entry->second.last_update_ns < idle_ns) {
+            ++entry;
+            continue;
+        }
+        for (const Rollup& bucket : entry->second.buckets) {
+            if (bucket.count > 0) {
+                persistLocked(bucket);
+            }
+        }
+        entry = series_.erase(entry);
+    }
+}
+
+/**
+ * @brief Persists every open bucket now
+ */
+void Storage::RollupStore::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) {
+        return;
+    }
+    for (auto& entry : series_) {
+        for (Rollup& bucket : entry.second.buckets) {
+            if (bucket.count > 0) {
+                persistLocked(bucket);
+                bucket.count = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Appends a bucket to its tier file; caller holds mutex_
+ * @param rollup Bucket to persist
+ *
+ * One write() per entry on an O_APPEND descriptor. A failed or short
+ * write is cut off again, so the file stays a sequence of whole entries
+ * and the offsets in the index stay valid.
+ */
+void Storage::RollupStore::persistLocked(const Rollup& rollup)
+{
+    const std::size_t name_size = std::min<std::size_t>(rollup.device.size(), UINT16_MAX);
+    buffer_.assign(sizeof(EntryHeader), 0);
+    buffer_.insert(buffer_.end(), rollup.device.begin(), rollup.device.begin() + name_size);
+    rollup.sketch.serialize(buffer_);
+
+    EntryHeader header{};
+    header.size = static_cast<uint32_t>(buffer_.size() - sizeof(header));
+    header.start_ns = rollup.start_ns;
+    header.count = rollup.count;
+    header.min = rollup.min;
+    header.max = rollup.max;
+    header.sum = rollup.sum;
+    header.sketch_size = static_cast<uint32_t>(header.size - name_size);
+    header.name_size = static_cast<uint16_t>(name_size);
+    header.type = rollup.type;
+    header.tier = static_cast<uint8_t>(rollup.tier);
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+    header.checksum = entryChecksum(buffer_.data(), buffer_.size());
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+
+    const std::size_t tier = static_cast<std::size_t>(rollup.tier);
+    if (::write(fds_[tier], buffer_.data(), buffer_.size()) != static_cast<ssize_t>(buffer_.size())) {
+        std::cerr << "RollupStore cannot write " << kTierFileNames[tier] << "\n";
+        const IndexChunk* last = index_[tier].empty() ? nullptr : &index_[tier].back();
+        if (::ftruncate(fds_[tier], last == nullptr ? 0 : static_cast<off_t>(last->offset + last->size)) != 0) {
+            std::cerr << "RollupStore cannot cut off the failed entry of " << kTierFileNames[tier] << "\n";
+        }
+        return;
+    }
+    indexLocked(tier, rollup.start_ns, buffer_.size());
+    stats_.closed_buckets++;
+}
+
+/**
+ * @brief Records a persisted entry in a tier's index; caller holds mutex_
+ * @param tier Tier index
+ * @param start_ns Bucket start of the entry
+ * @param size Encoded size of the entry
+ *
+ * Entries are added to the last chunk until it covers kIndexChunkBytes.
+ * Buckets are mostly closed in time order, so a chunk spans a short time
+ * range and a query reads only the few chunks overlapping its range; a
+ * late entry just widens the range of the chunk it lands in.
+ */
+void Storage::RollupStore::indexLocked(std::size_t tier, int64_t start_ns, std::size_t size)
+{
+    std::vector<IndexChunk>& chunks = index_[tier];
+    if (chunks.empty() || chunks.back().size >= kIndexChunkBytes) {
+        const uint64_t offset = chunks.empty() ? 0 : chunks.back().offset + chunks.back().size;
+        chunks.push_back(IndexChunk{offset, 0, start_ns, start_ns});
+    }
+    IndexChunk& chunk = chunks.back();
+    chunk.size += size;
+    chunk.first_start_ns = std::min(chunk.first_start_ns, start_ns);
+    chunk.last_start_ns = std::max(chunk.last_start_ns, start_ns);
+}
+
+/**
+ * @brief Subscribes the store to every batch an EventBus dispatches
+ * @param event_bus Bus to aggregate
+ * @param executor Where aggregation runs; nullptr runs it on the dispatcher
+ * @return Id of the subscription
+ */
+EventBus::SubscriptionId Storage::RollupStore::attach(EventBus& event_bus, std::shared_ptr<Executor> executor)
+{
+    return event_bus.subscribeBatch([this](const EventBatch& batch) {
+        add(batch);
+    }, std::move(executor));
+}
+
+/**
+ * @brief Gets the rollups of a tier in a time range
+ * @param tier Resolution to read
+ * @param device Device name; empty for every device
+ * @param from_ns First bucket start included (wall clock)
+ * @param to_ns First bucket start excluded (wall clock)
+ * @return One merged rollup per series and bucket, ordered by bucket start then device
+ *
+ * The open buckets and the extent of the tier file are taken together
+ * under the store lock, and only entries persisted before that point are
+ * read, so a bucket closed while the file is read is not counted twice.
+ * The file is read outside the lock, and only the index chunks whose
+ * bucket starts overlap the range.
+ */
+std::vector<Storage::Rollup> Storage::RollupStore::query(RollupTier tier, const std::string& device,
+                                                         int64_t from_ns, int64_t to_ns) const
+{
+    using Key = std::tuple<int64_t, std::string, uint8_t>;
+    std::map<Key, Rollup> merged;
+    const auto include = [&](const Rollup& rollup, std::size_t) {
+        if (rollup.start_ns < from_ns || rollup.start_ns >= to_ns || (!device.empty() && rollup.device != device)) {
+            return;
+        }
+        const Key key{rollup.start_ns, rollup.device, static_cast<uint8_t>(rollup.type)};
+        const auto found = merged.find(key);
+        if (found == merged.end()) {
+            merged.emplace(key, rollup);
+        } else {
+            found->second.merge(rollup);
+        }
+    };
+
+    std::string path;
+    std::vector<IndexChunk> chunks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_) {
+            return {};
+        }
+        path = directory_ + "/" + kTierFileNames[static_cast<std::size_t>(tier)];
+        for (const IndexChunk& chunk : index_[static_cast<std::size_t>(tier)]) {
+            if (chunk.first_start_ns < to_ns && chunk.last_start_ns >= from_ns) {
+                chunks.push_back(chunk);   // A copy: the last chunk may grow meanwhile
+            }
+        }
+        for (const auto& entry : series_) {
+            const Rollup& bucket = entry.second.buckets[static_cast<std::size_t>(tier)];
+            if (bucket.count > 0) {
+                include(bucket, 0);
+            }
+        }
+    }
+
+    uint64_t bytes_read = 0;
+    if (!chunks.empty()) {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (file != nullptr) {
+            for (const IndexChunk& chunk : chunks) {
+                readEntries(file, chunk.offset, chunk.offset + chunk.size, include);
+                bytes_read += chunk.size;
+            }
+            std::fclose(file);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bytes_queried_ += bytes_read;
+    }
+
+    std::vector<Rollup> rollups;
+    rollups.reserve(merged.size());
+    for (auto& entry : merged) {
+        rollups.push_back(std::move(entry.second));
+    }
+    return rollups;
+}
+
+/**
+ * @brief Gets the counters of the store
+ */
+Storage::RollupStore::Stats Storage::RollupStore::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.bytes_queried = bytes_queried_;
+    for (const auto& entry : series_) {
+        for (const Rollup& bucket : entry.second.buckets) {
+            stats.open_buckets += bucket.count > 0 ? 1 : 0;
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Storage/TraceReader.h"
+#include "Util/Clock.h"
+#include "Util/InternTable.h"
+
+/**
+ * @brief Unmaps the file
+ */
+Storage::TraceReader::~TraceReader()
+{
+    close();
+}
+
+/**
+ * @brief Unmaps the file
+ */
+void Storage::TraceReader::close()
+{
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+    }
+    size_ = 0;
+    offset_ = 0;
+}
+
+/**
+ * @brief Maps a trace file, positioned at its first reading
+ * @param path Trace file
+ * @return ERROR if the file cannot be opened or mapped
+ *
+ * The descriptor is closed right away; the mapping keeps the file alive.
+ * An empty file is a valid, empty trace.
+ */
+Event::Status Storage::TraceReader::open(const std::string& path)
+{
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return Event::Status::ERROR;
+    }
+    const off_t size = ::lseek(fd, 0, SEEK_END);
+    if (size > 0) {
+        void* data = ::mmap(nullptr, static_cast<std::size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            data_ = static_cast<const char*>(data);
+            size_ = static_cast<std::size_t>(size);
+            ::madvise(data, size_, MADV_SEQUENTIAL);
+        }
+    }
+    ::close(fd);
+    return (size == 0 || data_ != nullptr) ? Event::Status::OK : Event::Status::ERROR;
+}
+
+/**
+ * @brief Reads the next reading
+ * @param record Receives the reading
+ * @return false at the end of the trace
+ */
+bool Storage::TraceReader::next(Event::SensorRecord& record)
+{
+    uint16_t name_size = 0;
+    if (offset_ + sizeof(record) + sizeof(name_size) > size_) {
+        return false;
+    }
+    std::memcpy(&record, data_ + offset_, sizeof(record));
+    std::memcpy(&name_size, data_ + offset_ + sizeof(record), sizeof(name_size));
+    const std::size_t name_offset = offset_ + sizeof(record) + sizeof(name_size);
+    if (name_offset + name_size > size_) {
+        return false;
+    }
+
+    record.timestamp_ns = Util::Clock::fromWallNs(record.timestamp_ns);
+    record.device_id = Util::InternTable::global().intern(std::string_view(data_ + name_offset, name_size));
+    offset_ = name_offset + name_size;
+    return true;
+}
@@ -0,0 +1,298 @@
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Transport/BridgeReceiver.h"
+#include "Transport/BridgeFormat.h"
+#include "Event/SensorEvent.h"
+
+namespace
+{
+
+constexpr int kListenBacklog = 64;                          ///< Pending connection limit
+constexpr std::chrono::milliseconds kWaitInterval{50};      ///< Longest poll before re-checking for stop
+constexpr std::chrono::milliseconds kBackpressurePoll{1};   ///< Bus backlog re-check interval
+
+} // namespace
+
+/**
+ * @brief Closes the receiver
+ */
+Transport::BridgeReceiver::~BridgeReceiver()
+{
+    close();
+}
+
+/**
+ * @brief Listens on an address and starts receiving
+ * @param address "tcp:<host>:<port>" or "unix:<path>"; port 0 picks a free port
+ * @param options Connection and memory limits
+ * @return ERROR if already open, or the address is invalid or unavailable
+ */
+Event::Status Transport::BridgeReceiver::open(const std::string& address, Options options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (listen_fd_ >= 0 || SocketAddress::parse(address, address_) == Event::Status::ERROR) {
+        return Event::Status::ERROR;
+    }
+    listen_fd_ = address_.listen(kListenBacklog);
+    if (listen_fd_ < 0) {
+        return Event::Status::ERROR;
+    }
+    ::fcntl(listen_fd_, F_SETFL, ::fcntl(listen_fd_, F_GETFL) | O_NONBLOCK);
+    options_ = options;
+    options_.read_size = options_.read_size == 0 ? 1 : options_.read_size;
+    stop_requested_.store(false, std::memory_order_release);
+    thread_ = std::thread(&BridgeReceiver::receiveLoop, this);
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Stops receiving and closes all connections
+ */
+void Transport::BridgeReceiver::close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (listen_fd_ < 0) {
+        return;
+    }
+    stop_requested_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    if (address_.family == SocketAddress::Family::Unix) {
+        ::unlink(address_.path.c_str());
+    }
+}
+
+/**
+ * @brief Whether open() succeeded and close() has not been called
+ */
+bool Transport::BridgeReceiver::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return listen_fd_ >= 0;
+}
+
+/**
+ * @brief Gets the address the receiver listens on, with the chosen port
+ * @return Address in the form open() accepts; empty when closed
+ */
+std::string Transport::BridgeReceiver::address() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return listen_fd_ >= 0 ? address_.toString() : std::string();
+}
+
+/**
+ * @brief Receiver thread: accepts connections, reads and publishes frames
+ *
+ * While the local bus is backed up no connection is polled for reading, so
+ * nothing is read and the senders' writes stall in the kernel. Acks that
+ * did not fit the socket are polled for space either way.
+ */
+void Transport::BridgeReceiver::receiveLoop()
+{
+    std::vector<pollfd> fds;
+    std::vector<std::size_t> polled;   // Connection index of fds[i + 1]
+    while (!stop_requested_.load(std::memory_order_acquire))
+    {
+        const EventBus::Stats stats = event_bus_.getStats();
+        const bool backed_up = stats.published - stats.dispatched >= options_.max_in_flight;
+
+        fds.clear();
+        polled.clear();
+        fds.push_back(pollfd{listen_fd_, POLLIN, 0});
+        for (std::size_t i = 0; i < open_connections_.size(); ++i) {
+            const short events = static_cast<short>((backed_up ? 0 : POLLIN) |
+                                                    (open_connections_[i].ackPending() ? POLLOUT : 0));
+            if (events != 0) {
+                fds.push_back(pollfd{open_connections_[i].fd, events, 0});
+                polled.push_back(i);
+            }
+        }
+        const auto timeout = backed_up ? kBackpressurePoll : kWaitInterval;
+        if (::poll(fds.data(), fds.size(), static_cast<int>(timeout.count())) <= 0) {
+            continue;
+        }
+
+        // Backwards so closing one does not shift the rest; accepted ones are appended past them
+        for (std::size_t i = fds.size() - 1; i >= 1; --i) {
+            Connection& connection = open_connections_[polled[i - 1]];
+            const short revents = fds[i].revents;
+            if (revents == 0) {
+                continue;
+            }
+            const bool alive = (revents & ~POLLOUT) != 0 ? readConnection(connection) : sendAck(connection);
+            if (!alive) {
+                ::close(connection.fd);
+                open_connections_.erase(open_connections_.begin() + static_cast<std::ptrdiff_t>(polled[i - 1]));
+                active_connections_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+        if (fds[0].revents != 0) {
+            acceptConnections();
+        }
+    }
+
+    for (const Connection& connection : open_connections_) {
+        ::close(connection.fd);
+    }
+    open_connections_.clear();
+    active_connections_.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Accepts pending connections
+ *
+ * Connections beyond Options::max_connections are closed right away; their
+ * senders retry later.
+ */
+void Transport::BridgeReceiver::acceptConnections()
+{
+    while (true)
+    {
+        const int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            return;
+        }
+        if (open_connections_.size() >= options_.max_connections) {
+            ::close(fd);
+            continue;
+        }
+        Connection connection;
+        connection.fd = fd;
+        open_connections_.push_back(std::move(connection));
+        connections_.fetch_add(1, std::memory_order_relaxed);
+        active_connections_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Reads what a connection has and publishes its complete frames
+ * @param connection Connection with data (or a hang-up) pending
+ * @return false if the connection was closed or sent a malformed frame
+ *
+ * One read per call keeps connections fair and lets the backlog check run
+ * between reads. A frame split across reads stays at the front of the
+ * buffer until the rest arrives.
+ */
+bool Transport::BridgeReceiver::readConnection(Connection& connection)
+{
+    if (connection.buffer.size() - connection.size < options_.read_size) {
+        connection.buffer.resize(connection.size + options_.read_size);
+    }
+    const ssize_t count = ::recv(connection.fd, connection.buffer.data() + connection.size,
+                                 connection.buffer.size() - connection.size, 0);
+    if (count < 0) {
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+    if (count == 0) {
+        return false;
+    }
+    connection.size += static_cast<std::size_t>(count);
+
+    const std::size_t consumed = publishFrames(connection.buffer.data(), connection.size, connection.frames);
+    if (consumed == SIZE_MAX) {
+        malformed_.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "BridgeReceiver cannot decode a frame, closing the connection\n";
+        return false;
+    }
+    std::memmove(connection.buffer.data(), connection.buffer.data() + consumed, connection.size - consumed);
+    connection.size -= consumed;
+    return sendAck(connection);
+}
+
+/**
+ * @brief Sends the Ack of a connection's published frames, as far as the socket takes it
+ * @param connection Connection to acknowledge
+ * @return false if the connection broke
+ *
+ * Acks are cumulative, so while one waits for socket space later frames
+ * are folded into the next one instead of queueing more.
+ */
+bool Transport::BridgeReceiver::sendAck(Connection& connection)
+{
+    while (connection.ackPending())
+    {
+        if (connection.ack_sent == connection.ack_size) {
+            const BridgeFormat::Ack ack{BridgeFormat::kAckMagic, 0, connection.frames};
+            std::memcpy(connection.ack, &ack, sizeof(ack));
+            connection.ack_sent = 0;
+            connection.ack_size = sizeof(ack);
+            connection.acked = connection.frames;
+        }
+        const ssize_t sent = ::send(connection.fd, connection.ack + connection.ack_sent,
+                                    connection.ack_size - connection.ack_sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        connection.ack_sent += static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes and publishes the complete frames at the front of a buffer
+ * @param data Received bytes, starting at a frame boundary
+ * @param size Number of bytes
+ * @param frames Incremented per frame published
+ * @return Bytes consumed, or SIZE_MAX on a malformed frame
+ *
+ * A frame is published only once all of its entries have been validated,
+ * so a malformed frame publishes nothing.
+ */
+std::size_t Transport::BridgeReceiver::publishFrames(const uint8_t* data, std::size_t size, uint64_t& frames)
+{
+    using namespace BridgeFormat;
+    std::size_t offset = 0;
+    while (size - offset >= sizeof(FrameHeader))
+    {
+        FrameHeader header{};
+        std::memcpy(&header, data + offset, sizeof(header));
+        if (header.magic != kFrameMagic || header.payload_size > kMaxPayloadSize ||
+            header.count > header.payload_size / sizeof(Event::WireFormat::SensorEventLayout)) {
+            return SIZE_MAX;
+        }
+        if (size - offset - sizeof(header) < header.payload_size) {
+            break;
+        }
+
+        std::size_t position = offset + sizeof(header);
+        const std::size_t end = position + header.payload_size;
+        std::vector<std::unique_ptr<Event::Event>> batch;
+        batch.reserve(header.count);
+        for (uint32_t i = 0; i < header.count; ++i) {
+            Event::WireFormat::SensorEventView view;
+            if (Event::WireFormat::SensorEventView::parse(data + position, end - position, view) ==
+                Event::Status::ERROR) {
+                return SIZE_MAX;
+            }
+            batch.emplace_back(std::make_unique<Event::SensorEvent>(view.toRecord()));
+            position += view.encodedSize();
+        }
+        if (position != end) {
+            return SIZE_MAX;
+        }
+
+        if (!batch.empty()) {
+            received_.fetch_add(batch.size(), std::memory_order_relaxed);
+            event_bus_.publishBatch(std::move(batch));
+        }
+        frames_.fetch_add(1, std::memory_order_relaxed);
+        frames++;
+        offset = end;
+    }
+    return offset;
+}
@@ -0,0 +1,450 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "Transport/BridgeSender.h"
+#include "Transport/BridgeFormat.h"
+#include "Event/SensorEvent.h"
+
+namespace
+{
+
+constexpr std::size_t kMaxFramesPerWrite = 64;   ///< iovecs handed to one sendmsg() call
+
+} // namespace
+
+/**
+ * @brief Closes the sender
+ */
+Transport::BridgeSender::~BridgeSender()
+{
+    close();
+}
+
+/**
+ * @brief Starts forwarding to a receiver
+ * @param address "tcp:<host>:<port>" or "unix:<path>"
+ * @param options Batching, buffering and reconnection settings
+ * @return ERROR if already open or the address is invalid
+ */
+Event::Status Transport::BridgeSender::open(const std::string& address, Options options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_ || SocketAddress::parse(address, address_) == Event::Status::ERROR) {
+        return Event::Status::ERROR;
+    }
+    options_ = options;
+    options_.batch_size = std::max<std::size_t>(options_.batch_size, 1);
+    stats_ = Stats{};
+    open_ = true;
+    stopping_ = false;
+    abandon_ = false;
+    writer_ = std::thread(&BridgeSender::writeLoop, this);
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Sends what is pending (waiting up to Options::send_timeout) and disconnects
+ *
+ * If the receiver does not take everything in time, the connection is shut
+ * down to unblock the writer and the rest is counted as dropped.
+ */
+void Transport::BridgeSender::close()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!open_) {
+        return;
+    }
+    stopping_ = true;
+    work_cv_.notify_all();
+    space_cv_.notify_all();
+    space_cv_.wait_for(lock, options_.send_timeout, [this]() { return sealed_.empty() && open_count_ == 0; });
+
+    abandon_ = true;
+    work_cv_.notify_all();
+    if (fd_ >= 0) {
+        ::shutdown(fd_, SHUT_RDWR);
+    }
+    lock.unlock();
+    writer_.join();
+    lock.lock();
+
+    stats_.dropped += open_count_;
+    for (const Frame& frame : sealed_) {
+        stats_.dropped += frame.count;
+    }
+    sealed_.clear();
+    open_frame_.clear();
+    open_count_ = 0;
+    pending_bytes_ = 0;
+    open_ = false;
+}
+
+/**
+ * @brief Whether open() succeeded and close() has not been called
+ */
+bool Transport::BridgeSender::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+/**
+ * @brief Whether a connection to the receiver is established
+ */
+bool Transport::BridgeSender::isConnected() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fd_ >= 0;
+}
+
+/**
+ * @brief Queues one reading
+ * @param record Reading to send
+ * @return ERROR if the sender is closed or the reading was dropped
+ */
+Event::Status Transport::BridgeSender::send(const Event::SensorRecord& record)
+{
+    const auto deadline = std::chrono::steady_clock::now() + options_.send_timeout;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!open_ || !encodeLocked(lock, record, deadline)) {
+        return Event::Status::ERROR;
+    }
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Queues the sensor readings of a batch
+ * @param batch Events in publish order; non-sensor events are skipped
+ * @return Number of readings queued
+ *
+ * Options::send_timeout bounds the whole call, not each reading.
+ */
+std::size_t Transport::BridgeSender::send(const EventBatch& batch)
+{
+    const auto deadline = std::chrono::steady_clock::now() + options_.send_timeout;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!open_) {
+        return 0;
+    }
+    std::size_t queued = 0;
+    for (const Event::Event& event : batch) {
+        const auto* sensor_event = Event::event_cast<Event::SensorEvent>(event);
+        if (sensor_event != nullptr && encodeLocked(lock, sensor_event->getRecord(), deadline)) {
+            queued++;
+        }
+    }
+    return queued;
+}
+
+/**
+ * @brief Waits for buffer space and encodes one reading; caller holds lock
+ * @param lock Lock on mutex_
+ * @param record Reading to encode
+ * @param deadline When to give up waiting for space
+ * @return false if the reading was dropped
+ *
+ * The first reading of a frame wakes the writer so it can time the linger.
+ */
+bool Transport::BridgeSender::encodeLocked(std::unique_lock<std::mutex>& lock, const Event::SensorRecord& record,
+                                           std::chrono::steady_clock::time_point deadline)
+{
+    using namespace BridgeFormat;
+    const std::string_view name = Event::deviceName(record.device_id);
+    const std::size_t entry_size = Event::WireFormat::sensorEventSize(
+        std::min(name.size(), Event::WireFormat::kMaxNameSize));
+    const bool has_space = space_cv_.wait_until(lock, deadline, [&]() {
+        return stopping_ || pending_bytes_ == 0 || pending_bytes_ + entry_size <= options_.max_pending_bytes;
+    });
+    if (!has_space || stopping_) {
+        stats_.dropped++;
+        return false;
+    }
+
+    if (open_count_ == 0) {
+        open_frame_.reserve(sizeof(FrameHeader) + options_.batch_size * Event::WireFormat::sensorEventSize(24));
+        open_frame_.assign(sizeof(FrameHeader), 0);
+        open_since_ = std::chrono::steady_clock::now();
+        work_cv_.notify_one();
+    }
+    const std::size_t offset = open_frame_.size();
+    open_frame_.resize(offset + entry_size);
+    Event::WireFormat::encodeSensorEvent(record, name, open_frame_.data() + offset);
+    open_count_++;
+    pending_bytes_ += entry_size;
+
+    if (open_count_ >= options_.batch_size || open_frame_.size() + UINT16_MAX > kMaxPayloadSize) {
+        sealLocked();
+        work_cv_.notify_one();
+    }
+    return true;
+}
+
+/**
+ * @brief Moves the open frame to the sealed queue; caller holds mutex_
+ */
+void Transport::BridgeSender::sealLocked()
+{
+    if (open_count_ == 0) {
+        return;
+    }
+    BridgeFormat::FrameHeader header{};
+    header.magic = BridgeFormat::kFrameMagic;
+    header.payload_size = static_cast<uint32_t>(open_frame_.size() - sizeof(header));
+    header.count = open_count_;
+    std::memcpy(open_frame_.data(), &header, sizeof(header));
+    sealed_.push_back(Frame{std::move(open_frame_), open_count_});
+    open_frame_ = std::vector<uint8_t>();
+    open_count_ = 0;
+}
+
+/**
+ * @brief Seals the open frame and waits until the receiver acknowledged everything queued
+ * @return ERROR if that did not happen within Options::send_timeout
+ */
+Event::Status Transport::BridgeSender::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!open_) {
+        return Event::Status::ERROR;
+    }
+    sealLocked();
+    work_cv_.notify_one();
+    const bool written = space_cv_.wait_for(lock, options_.send_timeout, [this]() {
+        return sealed_.empty() && open_count_ == 0;
+    });
+    return written ? Event::Status::OK : Event::Status::ERROR;
+}
+
+/**
+ * @brief Writer thread: writes sealed frames, reconnecting as needed
+ *
+ * Frames stay in sealed_ while being written (deque elements do not move
+ * when senders append or the ack thread pops acknowledged ones) and are
+ * removed only once acknowledged, so a broken connection loses nothing:
+ * every unacknowledged frame goes out again on the next one.
+ */
+void Transport::BridgeSender::writeLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::vector<const Frame*> frames;
+    while (!abandon_)
+    {
+        // Seal the open frame once its first reading has lingered long enough
+        while (written_ == sealed_.size() && !broken_ && !abandon_) {
+            if (open_count_ > 0) {
+                const auto due = open_since_ + options_.linger;
+                if (stopping_ || std::chrono::steady_clock::now() >= due) {
+                    sealLocked();
+                    break;
+                }
+                work_cv_.wait_until(lock, due);
+            } else if (stopping_ && sealed_.empty()) {
+                break;
+            } else {
+                work_cv_.wait(lock);
+            }
+        }
+        if (abandon_ || (stopping_ && sealed_.empty())) {
+            break;
+        }
+        if (broken_) {
+            disconnectLocked(lock);
+            continue;
+        }
+
+        if (fd_ < 0) {
+            lock.unlock();
+            const int fd = address_.connect();
+            lock.lock();
+            if (fd < 0) {
+                work_cv_.wait_for(lock, options_.reconnect_interval, [this]() { return abandon_; });
+                continue;
+            }
+            fd_ = fd;
+            ack_reader_ = std::thread(&BridgeSender::ackLoop, this, fd);
+            stats_.connects++;
+        }
+
+        frames.clear();
+        for (std::size_t i = written_; i < sealed_.size() && frames.size() < kMaxFramesPerWrite; ++i) {
+            frames.push_back(&sealed_[i]);
+        }
+        const int fd = fd_;
+        uint64_t writes = 0;
+        std::size_t completed = 0;
+        lock.unlock();
+        const bool written = writeFrames(fd, frames, writes, completed);
+        lock.lock();
+        stats_.writes += writes;
+        for (std::size_t i = 0; i < completed; ++i) {
+            stats_.bytes += frames[i]->bytes.size();
+        }
+        written_ += completed;
+        releaseAckedLocked();   // Acks may have arrived before written_ covered their frames
+        if (!written) {
+            disconnectLocked(lock);
+        }
+    }
+    if (fd_ >= 0) {
+        disconnectLocked(lock);
+    }
+}
+
+/**
+ * @brief Ack thread of a connection: releases the frames the receiver acknowledges
+ * @param fd Connected socket
+ *
+ * Runs until the connection ends or sends something that is not a valid
+ * Ack, then flags the connection as broken for the writer.
+ */
+void Transport::BridgeSender::ackLoop(int fd)
+{
+    BridgeFormat::Ack ack{};
+    while (true)
+    {
+        const ssize_t count = ::recv(fd, &ack, sizeof(ack), MSG_WAITALL);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count != static_cast<ssize_t>(sizeof(ack)) || ack.magic != BridgeFormat::kAckMagic) {
+            break;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ack.frames < acked_ || ack.frames > released_ + sealed_.size()) {
+            break;
+        }
+        acked_ = ack.frames;
+        releaseAckedLocked();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    broken_ = true;
+    work_cv_.notify_all();
+}
+
+/**
+ * @brief Removes the acknowledged frames that have been written; caller holds mutex_
+ */
+void Transport::BridgeSender::releaseAckedLocked()
+{
+    if (acked_ == released_ || written_ == 0) {
+        return;
+    }
+    while (acked_ > released_ && written_ > 0) {
+        const Frame& frame = sealed_.front();
+        pending_bytes_ -= frame.bytes.size() - sizeof(BridgeFormat::FrameHeader);
+        stats_.sent += frame.count;
+        stats_.frames++;
+        sealed_.pop_front();
+        written_--;
+        released_++;
+    }
+    space_cv_.notify_all();
+    work_cv_.notify_all();
+}
+
+/**
+ * @brief Closes the connection and queues its unacknowledged frames again; caller holds lock
+ * @param lock Lock on mutex_, released while the ack thread is joined
+ *
+ * Frames written but not acknowledged may have been published already;
+ * they are counted in Stats::resent when they go out again.
+ */
+void Transport::BridgeSender::disconnectLocked(std::unique_lock<std::mutex>& lock)
+{
+    ::shutdown(fd_, SHUT_RDWR);
+    std::thread ack_reader = std::move(ack_reader_);
+    lock.unlock();
+    if (ack_reader.joinable()) {
+        ack_reader.join();
+    }
+    lock.lock();
+    releaseAckedLocked();
+    ::close(fd_);
+    fd_ = -1;
+    for (std::size_t i = 0; i < written_; ++i) {
+        stats_.resent += sealed_[i].count;
+    }
+    written_ = 0;
+    acked_ = 0;
+    released_ = 0;
+    broken_ = false;
+}
+
+/**
+ * @brief Writes frames with vectored writes until done or the connection breaks
+ * @param fd Connected socket
+ * @param frames Frames to write, in order
+ * @param writes Incremented per write call
+ * @param completed Receives the number of frames written in full
+ * @return false if the connection broke
+ *
+ * Uses sendmsg() rather than writev() for MSG_NOSIGNAL: a receiver that
+ * went away must not raise SIGPIPE in this process.
+ */
+bool Transport::BridgeSender::writeFrames(int fd, const std::vector<const Frame*>& frames, uint64_t& writes,
+                                          std::size_t& completed)
+{
+    iovec vectors[kMaxFramesPerWrite];
+    std::size_t count = 0;
+    for (const Frame* frame : frames) {
+        vectors[count].iov_base = const_cast<uint8_t*>(frame->bytes.data());
+        vectors[count].iov_len = frame->bytes.size();
+        count++;
+    }
+
+    iovec* next = vectors;
+    completed = 0;
+    while (count > 0)
+    {
+        msghdr message{};
+        message.msg_iov = next;
+        message.msg_iovlen = count;
+        const ssize_t written = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+        writes++;
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        // Skip the fully written vectors and trim a partially written one
+        auto remaining = static_cast<std::size_t>(written);
+        while (count > 0 && remaining >= next->iov_len) {
+            remaining -= next->iov_len;
+            next++;
+            count--;
+            completed++;
+        }
+        if (count > 0) {
+            next->iov_base = static_cast<uint8_t*>(next->iov_base) + remaining;
+            next->iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Subscribes the sender to every batch an EventBus dispatches
+ * @param event_bus Bus to forward
+ * @param executor Where sending runs; nullptr runs it on the dispatcher
+ * @return Id of the subscription
+ */
+EventBus::SubscriptionId Transport::BridgeSender::attach(EventBus& event_bus, std::shared_ptr<Executor> executor)
+{
+    return event_bus.subscribeBatch([this](const EventBatch& batch) {
+        send(batch);
+    }, std::move(executor));
+}
+
+/**
+ * @brief Gets the counters of the sender
+ */
+Transport::BridgeSender::Stats Transport::BridgeSender::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
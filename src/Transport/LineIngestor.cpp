@@ -0,0 +1,266 @@
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Transport/LineIngestor.h"
+
+namespace
+{
+
+constexpr int kListenBacklog = 64;                          ///< Pending connection limit
+constexpr std::chrono::milliseconds kWaitInterval{50};      ///< Longest poll before re-checking for stop
+constexpr std::chrono::milliseconds kBackpressurePoll{1};   ///< Bus backlog re-check interval
+
+/**
+ * @brief Whether a source names a socket address rather than a path
+ */
+bool isSocketSource(const std::string& source)
+{
+    return source.rfind("unix:", 0) == 0 || source.rfind("tcp:", 0) == 0;
+}
+
+} // namespace
+
+/**
+ * @brief Closes the ingestor
+ */
+Transport::LineIngestor::~LineIngestor()
+{
+    close();
+}
+
+/**
+ * @brief Opens a source and starts ingesting
+ * @param source "unix:<path>" or "tcp:<host>:<port>" to listen on, a file
+ *               or pipe path, or "-" for standard input
+ * @param options Read sizes and limits
+ * @return ERROR if already open, or the source cannot be opened
+ *
+ * A named pipe is opened without waiting for a writer; reading starts
+ * when one connects.
+ */
+Event::Status Transport::LineIngestor::open(const std::string& source, Options options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) {
+        return Event::Status::ERROR;
+    }
+    if (isSocketSource(source)) {
+        if (SocketAddress::parse(source, address_) == Event::Status::ERROR) {
+            return Event::Status::ERROR;
+        }
+        listen_fd_ = address_.listen(kListenBacklog);
+        if (listen_fd_ < 0) {
+            return Event::Status::ERROR;
+        }
+        ::fcntl(listen_fd_, F_SETFL, ::fcntl(listen_fd_, F_GETFL) | O_NONBLOCK);
+    } else {
+        Stream stream;
+        stream.owned = source != "-";
+        stream.fd = stream.owned ? ::open(source.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC) : STDIN_FILENO;
+        if (stream.fd < 0) {
+            std::cerr << "LineIngestor cannot open " << source << ": " << std::strerror(errno) << "\n";
+            return Event::Status::ERROR;
+        }
+        streams_.push_back(std::move(stream));
+        connections_.fetch_add(1, std::memory_order_relaxed);
+    }
+    options_ = options;
+    options_.read_size = options_.read_size == 0 ? 1 : options_.read_size;
+    finished_.store(false, std::memory_order_release);
+    stop_requested_.store(false, std::memory_order_release);
+    open_ = true;
+    thread_ = std::thread(&LineIngestor::ingestLoop, this);
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Stops ingesting and closes the source
+ */
+void Transport::LineIngestor::close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) {
+        return;
+    }
+    stop_requested_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        if (address_.family == SocketAddress::Family::Unix) {
+            ::unlink(address_.path.c_str());
+        }
+    }
+    open_ = false;
+}
+
+/**
+ * @brief Whether open() succeeded and close() has not been called
+ */
+bool Transport::LineIngestor::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+/**
+ * @brief Gets the address a socket source listens on, with the chosen port
+ * @return Address in the form open() accepts; empty for path sources and when closed
+ */
+std::string Transport::LineIngestor::address() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return listen_fd_ >= 0 ? address_.toString() : std::string();
+}
+
+/**
+ * @brief Ingest thread: accepts connections, reads, parses and publishes
+ *
+ * While the local bus is backed up no stream is polled, so nothing is read
+ * and writers stall in the kernel.
+ */
+void Transport::LineIngestor::ingestLoop()
+{
+    std::vector<pollfd> fds;
+    while (!stop_requested_.load(std::memory_order_acquire))
+    {
+        const EventBus::Stats stats = event_bus_.getStats();
+        const bool backed_up = stats.published - stats.dispatched >= options_.max_in_flight;
+
+        fds.clear();
+        if (listen_fd_ >= 0) {
+            fds.push_back(pollfd{listen_fd_, POLLIN, 0});
+        }
+        const std::size_t first_stream = fds.size();
+        if (!backed_up) {
+            for (const Stream& stream : streams_) {
+                fds.push_back(pollfd{stream.fd, POLLIN, 0});
+            }
+        }
+        const auto timeout = backed_up ? kBackpressurePoll : kWaitInterval;
+        if (fds.empty()) {
+            std::this_thread::sleep_for(timeout);
+            continue;
+        }
+        if (::poll(fds.data(), fds.size(), static_cast<int>(timeout.count())) <= 0) {
+            continue;
+        }
+
+        // Backwards so closing one does not shift the rest; accepted ones are appended past them
+        for (std::size_t i = fds.size(); i-- > first_stream;) {
+            Stream& stream = streams_[i - first_stream];
+            if (fds[i].revents != 0 && !readStream(stream)) {
+                closeStream(stream);
+                streams_.erase(streams_.begin() + static_cast<std::ptrdiff_t>(i - first_stream));
+                if (listen_fd_ < 0) {
+                    finished_.store(true, std::memory_order_release);
+                }
+            }
+        }
+        if (listen_fd_ >= 0 && fds[0].revents != 0) {
+            acceptConnections();
+        }
+    }
+
+    for (const Stream& stream : streams_) {
+        closeStream(stream);
+    }
+    streams_.clear();
+}
+
+/**
+ * @brief Accepts pending connections
+ *
+ * Connections beyond Options::max_connections are closed right away.
+ */
+void Transport::LineIngestor::acceptConnections()
+{
+    while (true)
+    {
+        const int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            return;
+        }
+        if (streams_.size() >= options_.max_connections) {
+            ::close(fd);
+            continue;
+        }
+        Stream stream;
+        stream.fd = fd;
+        streams_.push_back(std::move(stream));
+        connections_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Reads what a stream has and publishes its complete lines
+ * @param stream Stream with data (or an end) pending
+ * @return false once the stream has ended
+ *
+ * One read per call keeps streams fair and lets the backlog check run
+ * between reads. At the end of the stream an unterminated last line is
+ * given its '\n' and parsed.
+ */
+bool Transport::LineIngestor::readStream(Stream& stream)
+{
+    if (stream.buffer.size() - stream.size < options_.read_size) {
+        stream.buffer.resize(stream.size + options_.read_size);
+    }
+    const ssize_t count = ::read(stream.fd, stream.buffer.data() + stream.size, stream.buffer.size() - stream.size);
+    if (count < 0) {
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+    if (count == 0) {
+        if (stream.size > 0) {
+            stream.buffer[stream.size++] = '\n';
+            publishLines(stream);
+        }
+        return false;
+    }
+    bytes_.fetch_add(static_cast<uint64_t>(count), std::memory_order_relaxed);
+    stream.size += static_cast<std::size_t>(count);
+    publishLines(stream);
+    return true;
+}
+
+/**
+ * @brief Parses and publishes the complete lines in a stream's buffer
+ * @param stream Stream whose buffer to parse
+ */
+void Transport::LineIngestor::publishLines(Stream& stream)
+{
+    const LineParser::Stats before = stream.parser->getStats();
+    LineParser::Batch batch;
+    const std::size_t consumed = stream.parser->parse(stream.buffer.data(), stream.size, batch);
+    const LineParser::Stats& after = stream.parser->getStats();
+    lines_.fetch_add(after.lines - before.lines, std::memory_order_relaxed);
+    malformed_.fetch_add(after.malformed - before.malformed, std::memory_order_relaxed);
+
+    if (!batch.empty()) {
+        published_.fetch_add(batch.size(), std::memory_order_relaxed);
+        event_bus_.publishBatch(std::move(batch));
+    }
+    std::memmove(stream.buffer.data(), stream.buffer.data() + consumed, stream.size - consumed);
+    stream.size -= consumed;
+}
+
+/**
+ * @brief Closes a stream's descriptor if the ingestor owns it
+ */
+void Transport::LineIngestor::closeStream(const Stream& stream)
+{
+    if (stream.owned) {
+        ::close(stream.fd);
+    }
+}
@@ -0,0 +1,410 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <string>
+
+#include "Transport/LineParser.h"
+#include "Event/SensorEvent.h"
+#include "Event/SensorType.h"
+#include "Util/Clock.h"
+#include "Util/InternTable.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TRANSPORT_LINE_HAS_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define TRANSPORT_LINE_HAS_X86_SIMD 0
+#endif
+
+namespace
+{
+
+constexpr uint32_t kUnresolved = UINT32_MAX;           ///< Empty slot of a device table
+constexpr uint64_t kMaxTableDevice = 1u << 20;         ///< Larger device numbers bypass the tables
+constexpr int kMaxExactDigits = 15;                    ///< Digits a double holds exactly
+
+/// Powers of ten up to 10^kMaxExactDigits, all exact in a double
+constexpr double kPow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                             1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+/**
+ * @brief Whether a byte separates tokens
+ */
+inline bool isStructural(char c)
+{
+    return c == ' ' || c == ',' || c == '=' || c == '\n';
+}
+
+/**
+ * @brief Records structural positions one byte at a time
+ * @param data Start of the chunk
+ * @param begin First offset to examine
+ * @param size Bytes in the chunk
+ * @param positions Receives the positions
+ * @param count Positions already recorded
+ * @return Positions recorded in total
+ */
+std::size_t scalarIndex(const char* data, std::size_t begin, std::size_t size, uint32_t* positions, std::size_t count)
+{
+    for (std::size_t i = begin; i < size; ++i) {
+        positions[count] = static_cast<uint32_t>(i);
+        count += isStructural(data[i]) ? 1 : 0;
+    }
+    return count;
+}
+
+#if TRANSPORT_LINE_HAS_X86_SIMD
+
+/**
+ * @brief Appends the positions of the set bits of a 64-byte block mask
+ */
+inline std::size_t flattenMask(uint64_t mask, uint32_t base, uint32_t* positions, std::size_t count)
+{
+    while (mask != 0) {
+        positions[count++] = base + static_cast<uint32_t>(__builtin_ctzll(mask));
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+__attribute__((target("avx2"))) inline uint32_t avx2Structural(const char* data)
+{
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    const __m256i hits = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(','))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('=')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n'))));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+}
+
+__attribute__((target("avx2"))) std::size_t avx2Index(const char* data, std::size_t size, uint32_t* positions, std::size_t& count)
+{
+    std::size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const uint64_t mask = avx2Structural(data + i) | (static_cast<uint64_t>(avx2Structural(data + i + 32)) << 32);
+        count = flattenMask(mask, static_cast<uint32_t>(i), positions, count);
+    }
+    return i;
+}
+
+__attribute__((target("sse2"))) inline uint64_t sse2Structural(const char* data)
+{
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const __m128i hits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(','))),
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('=')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'))));
+    return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(hits)));
+}
+
+__attribute__((target("sse2"))) std::size_t sse2Index(const char* data, std::size_t size, uint32_t* positions, std::size_t& count)
+{
+    std::size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const uint64_t mask = sse2Structural(data + i) | (sse2Structural(data + i + 16) << 16) |
+                              (sse2Structural(data + i + 32) << 32) | (sse2Structural(data + i + 48) << 48);
+        count = flattenMask(mask, static_cast<uint32_t>(i), positions, count);
+    }
+    return i;
+}
+
+#endif // TRANSPORT_LINE_HAS_X86_SIMD
+
+/**
+ * @brief Parses a decimal integer of at most 19 digits
+ * @return false if the token is empty, too long or not all digits
+ */
+bool parseUnsigned(std::string_view token, uint64_t& value)
+{
+    if (token.empty() || token.size() > 19) {
+        return false;
+    }
+    uint64_t result = 0;
+    for (const char c : token) {
+        const unsigned digit = static_cast<unsigned char>(c) - static_cast<unsigned>('0');
+        if (digit > 9) {
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+    value = result;
+    return true;
+}
+
+/**
+ * @brief Parses a reading value
+ * @return false unless the whole token is a finite number
+ *
+ * Plain decimals of up to 15 digits are converted as one integer divided
+ * by a power of ten; both are exact doubles, so the result is correctly
+ * rounded. Anything else (exponents, long mantissas) goes to from_chars.
+ */
+bool parseValue(std::string_view token, double& value)
+{
+    const char* p = token.data();
+    const char* end = p + token.size();
+    const bool negative = p != end && *p == '-';
+    p += negative ? 1 : 0;
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int fraction = -1;
+    for (; p != end; ++p) {
+        const unsigned digit = static_cast<unsigned char>(*p) - static_cast<unsigned>('0');
+        if (digit <= 9) {
+            mantissa = mantissa * 10 + digit;
+            digits++;
+            fraction += fraction >= 0 ? 1 : 0;
+        } else if (*p == '.' && fraction < 0) {
+            fraction = 0;
+        } else {
+            break;
+        }
+    }
+    if (p == end && digits > 0 && digits <= kMaxExactDigits) {
+        const double magnitude = static_cast<double>(mantissa) / kPow10[fraction > 0 ? fraction : 0];
+        value = negative ? -magnitude : magnitude;
+        return true;
+    }
+
+    const auto result = std::from_chars(token.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end && std::isfinite(value);
+}
+
+/**
+ * @brief Finds the traits of a sensor type by name
+ * @return Traits row, or nullptr for an unknown name
+ */
+const Event::SensorTraits* findTypeByName(std::string_view name)
+{
+    for (const Event::SensorTraits& traits : Event::kSensorTraits) {
+        if (name == traits.name) {
+            return &traits;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+/**
+ * @brief Best SIMD level supported by the running CPU
+ */
+Util::SimdLevel Transport::LineParser::detectSimdLevel()
+{
+#if TRANSPORT_LINE_HAS_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        return Util::SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return Util::SimdLevel::SSE2;
+    }
+#endif
+    return Util::SimdLevel::Scalar;
+}
+
+/**
+ * @brief Constructs a parser using a given SIMD level
+ * @param level Requested level, clamped to the CPU's capabilities
+ */
+Transport::LineParser::LineParser(Util::SimdLevel level)
+    : simd_level_(std::min(level, detectSimdLevel())),
+    positions_(kChunkSize)
+{
+}
+
+/**
+ * @brief Parses the complete lines at the front of a buffer
+ * @param data Bytes of the stream, continuing where the last call stopped
+ * @param size Number of bytes
+ * @param out Receives one event per reading, in line order
+ * @return Bytes consumed; the rest is an incomplete last line
+ *
+ * A whole chunk without a line end is consumed and the line it belongs to
+ * is counted as malformed and skipped up to its '\n'.
+ */
+std::size_t Transport::LineParser::parse(const char* data, std::size_t size, Batch& out)
+{
+    std::size_t offset = 0;
+    while (offset < size)
+    {
+        const char* chunk = data + offset;
+        const std::size_t length = std::min(size - offset, kChunkSize);
+        const std::size_t count = indexChunk(chunk, length);
+
+        // Separators past the last '\n' belong to an incomplete line
+        std::size_t complete = count;
+        while (complete > 0 && chunk[positions_[complete - 1]] != '\n') {
+            complete--;
+        }
+        if (complete == 0) {
+            if (length < kChunkSize) {
+                break;
+            }
+            if (!discarding_) {
+                stats_.lines++;
+                stats_.malformed++;
+                discarding_ = true;
+            }
+            offset += length;
+            continue;
+        }
+
+        chunk_time_ns_ = Util::Clock::nowNs();
+        std::size_t begin = 0;
+        std::size_t first = 0;
+        for (std::size_t i = 0; i < complete; ++i) {
+            if (chunk[positions_[i]] != '\n') {
+                continue;
+            }
+            const std::size_t end = positions_[i];
+            if (discarding_) {
+                discarding_ = false;
+            } else if (!parseLine(chunk, begin, end, positions_.data() + first, i - first, out)) {
+                stats_.malformed++;
+            }
+            begin = end + 1;
+            first = i + 1;
+        }
+        offset += begin;
+    }
+    return offset;
+}
+
+/**
+ * @brief Records the positions of the structural characters of a chunk
+ * @param data Start of the chunk
+ * @param size Bytes in the chunk, at most kChunkSize
+ * @return Number of positions written to positions_
+ *
+ * The SIMD paths classify 64 bytes per step into a bit mask and append
+ * its set bits; the scalar loop finishes the tail.
+ */
+std::size_t Transport::LineParser::indexChunk(const char* data, std::size_t size)
+{
+    std::size_t count = 0;
+    std::size_t done = 0;
+#if TRANSPORT_LINE_HAS_X86_SIMD
+    switch (simd_level_)
+    {
+        case Util::SimdLevel::AVX2: done = avx2Index(data, size, positions_.data(), count); break;
+        case Util::SimdLevel::SSE2: done = sse2Index(data, size, positions_.data(), count); break;
+        case Util::SimdLevel::Scalar: break;
+    }
+#endif
+    return scalarIndex(data, done, size, positions_.data(), count);
+}
+
+/**
+ * @brief Parses one line from its structural positions
+ * @param data Start of the chunk holding the line
+ * @param begin Offset of the first byte of the line
+ * @param end Offset of the line's '\n'
+ * @param separators Positions of the structural characters inside the line
+ * @param count Number of separators
+ * @param out Receives the event
+ * @return false if the line is malformed; blank lines and comments parse
+ */
+bool Transport::LineParser::parseLine(const char* data, std::size_t begin, std::size_t end,
+                                      const uint32_t* separators, std::size_t count, Batch& out)
+{
+    if (end > begin && data[end - 1] == '\r') {
+        end--;
+    }
+    if (begin == end || data[begin] == '#') {
+        return true;
+    }
+    stats_.lines++;
+    const auto token = [data](std::size_t from, std::size_t to) {
+        return std::string_view(data + from, to - from);
+    };
+
+    // Type, then ",key=value" tags up to the first space
+    if (count < 3 || data[separators[0]] != ',') {
+        return false;
+    }
+    const Event::SensorTraits* traits = findTypeByName(token(begin, separators[0]));
+    if (traits == nullptr) {
+        return false;
+    }
+    std::string_view device;
+    std::size_t i = 0;
+    while (i < count && data[separators[i]] == ',') {
+        if (i + 1 >= count || data[separators[i + 1]] != '=') {
+            return false;
+        }
+        const std::size_t value_end = i + 2 < count ? separators[i + 2] : end;
+        if (token(separators[i] + 1, separators[i + 1]) == "device") {
+            device = token(separators[i + 1] + 1, value_end);
+        }
+        i += 2;
+    }
+    if (i >= count || data[separators[i]] != ' ' || device.empty()) {
+        return false;
+    }
+
+    // The value field, optionally named "value"
+    std::size_t field_begin = separators[i++] + 1;
+    if (i < count && data[separators[i]] == '=') {
+        if (token(field_begin, separators[i]) != "value") {
+            return false;
+        }
+        field_begin = separators[i++] + 1;
+    }
+    const std::string_view field = token(field_begin, i < count ? separators[i] : end);
+
+    Event::SensorRecord record{};
+    if (field == "fault") {
+        record.flags = Event::SensorRecord::kFaultFlag;
+    } else if (!parseValue(field, record.value)) {
+        return false;
+    }
+
+    // An optional timestamp ends the line
+    record.timestamp_ns = chunk_time_ns_;
+    if (i < count) {
+        uint64_t wall_ns = 0;
+        if (data[separators[i]] != ' ' || i + 1 != count ||
+            !parseUnsigned(token(separators[i] + 1, end), wall_ns) || wall_ns > static_cast<uint64_t>(INT64_MAX)) {
+            return false;
+        }
+        record.timestamp_ns = Util::Clock::fromWallNs(static_cast<int64_t>(wall_ns));
+    }
+
+    record.type = traits->type;
+    record.device_id = resolveDevice(traits->type, device);
+    if (record.device_id >= sequences_.size()) {
+        sequences_.resize(record.device_id + 1, 0);
+    }
+    record.sequence = sequences_[record.device_id]++;
+    out.emplace_back(std::make_unique<Event::SensorEvent>(record));
+    stats_.events++;
+    return true;
+}
+
+/**
+ * @brief Gets the dense id of a device
+ * @param type Type of the device
+ * @param id Device tag value
+ * @return Interned id of "<Type>_<id>"
+ *
+ * Numbers without leading zeros are looked up in a table per type, filled
+ * by Event::internDeviceId() on first sight. Other ids are interned on
+ * every line, which takes a string build and a hash lookup.
+ */
+uint32_t Transport::LineParser::resolveDevice(Event::SensorType type, std::string_view id)
+{
+    uint64_t number = 0;
+    if (parseUnsigned(id, number) && number < kMaxTableDevice && (id.size() == 1 || id[0] != '0')) {
+        std::vector<uint32_t>& table = devices_[static_cast<std::size_t>(type)];
+        if (number >= table.size()) {
+            table.resize(number + 1, kUnresolved);
+        }
+        if (table[number] == kUnresolved) {
+            table[number] = Event::internDeviceId(type, static_cast<uint32_t>(number));
+        }
+        return table[number];
+    }
+    std::string name = Event::getSensorTypeName(type);
+    name += '_';
+    name += id;
+    return Util::InternTable::global().intern(name);
+}
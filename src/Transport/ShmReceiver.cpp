@@ -0,0 +1,118 @@
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "Transport/ShmReceiver.h"
+#include "Event/SensorEvent.h"
+#include "Event/WireFormat.h"
+
+namespace
+{
+
+constexpr std::chrono::milliseconds kWaitInterval{50};         ///< Longest sleep before re-checking for stop
+constexpr std::chrono::milliseconds kBackpressurePoll{1};      ///< Bus backlog re-check interval
+
+} // namespace
+
+/**
+ * @brief Closes the receiver
+ */
+Transport::ShmReceiver::~ShmReceiver()
+{
+    close();
+}
+
+/**
+ * @brief Creates or attaches to a ring as its consumer and starts receiving
+ * @param name Shared-memory ring name
+ * @param options Ring size, batching and memory limits
+ * @return ERROR if already open or the ring cannot be opened
+ */
+Event::Status Transport::ShmReceiver::open(const std::string& name, Options options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ring_.isOpen() || ring_.open(name, ShmRing::Role::Consumer, options.capacity) == Event::Status::ERROR) {
+        return Event::Status::ERROR;
+    }
+    options_ = options;
+    options_.batch_size = options_.batch_size == 0 ? 1 : options_.batch_size;
+    stop_requested_.store(false, std::memory_order_release);
+    thread_ = std::thread(&ShmReceiver::receiveLoop, this);
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Stops receiving and releases the consumer role
+ */
+void Transport::ShmReceiver::close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ring_.isOpen()) {
+        return;
+    }
+    stop_requested_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    ring_.close();
+}
+
+/**
+ * @brief Whether open() succeeded and close() has not been called
+ */
+bool Transport::ShmReceiver::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_.isOpen();
+}
+
+/**
+ * @brief Whether a ShmSender process is attached and running
+ */
+bool Transport::ShmReceiver::senderAlive() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_.peerAlive();
+}
+
+/**
+ * @brief Receiver thread: waits for frames and publishes them in batches
+ *
+ * Frames are decoded straight from the ring into SensorEvents; the ring
+ * space is released once per batch.
+ */
+void Transport::ShmReceiver::receiveLoop()
+{
+    std::vector<std::unique_ptr<Event::Event>> batch;
+    batch.reserve(options_.batch_size);
+    const auto decode = [this, &batch](const uint8_t* payload, std::size_t size) {
+        Event::WireFormat::SensorEventView view;
+        if (Event::WireFormat::SensorEventView::parse(payload, size, view) == Event::Status::ERROR ||
+            view.encodedSize() != size) {
+            malformed_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        batch.emplace_back(std::make_unique<Event::SensorEvent>(view.toRecord()));
+    };
+
+    while (!stop_requested_.load(std::memory_order_acquire))
+    {
+        if (!ring_.waitReadable(kWaitInterval)) {
+            continue;
+        }
+        // Leave the frames in the ring while the local bus is backed up
+        const EventBus::Stats stats = event_bus_.getStats();
+        if (stats.published - stats.dispatched >= options_.max_in_flight) {
+            std::this_thread::sleep_for(kBackpressurePoll);
+            continue;
+        }
+
+        ring_.consume(decode, options_.batch_size);
+        if (!batch.empty()) {
+            received_.fetch_add(batch.size(), std::memory_order_relaxed);
+            event_bus_.publishBatch(std::move(batch));
+            batch.clear();
+            batch.reserve(options_.batch_size);
+        }
+    }
+}
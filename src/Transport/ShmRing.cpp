@@ -0,0 +1,406 @@
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Transport/ShmRing.h"
+
+namespace
+{
+
+constexpr std::chrono::milliseconds kWaitSlice{50};          ///< Longest futex sleep between peer checks
+constexpr std::chrono::milliseconds kAttachTimeout{1000};    ///< Longest wait for a creator to initialize
+
+/**
+ * @brief Sleeps while a shared futex word holds an expected value
+ * @param word Futex word in the shared mapping
+ * @param expected Value read before deciding to sleep
+ * @param timeout Longest sleep
+ *
+ * Returns at once if the word already changed; spurious wakeups are fine
+ * because every caller re-checks its condition.
+ */
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout)
+{
+    timespec relative{};
+    relative.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+    relative.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &relative, nullptr, 0);
+}
+
+/**
+ * @brief Wakes every process sleeping on a shared futex word
+ * @param word Futex word in the shared mapping
+ */
+void futexWake(std::atomic<uint32_t>& word)
+{
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+/**
+ * @brief Whether a process id belongs to a running process
+ * @param pid Process id from the header; 0 means no process
+ */
+bool processAlive(int32_t pid)
+{
+    return pid > 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+}
+
+/**
+ * @brief Gets the shm_open() name of a ring
+ * @param name Name with or without the leading slash
+ */
+std::string objectName(const std::string& name)
+{
+    return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+/**
+ * @brief Rounds a requested ring size up to a power of two
+ * @param requested Requested bytes
+ */
+std::size_t ringCapacity(std::size_t requested)
+{
+    std::size_t capacity = Transport::ShmRing::kMinCapacity;
+    while (capacity < requested) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+} // namespace
+
+/**
+ * @brief Releases the role and unmaps the ring
+ */
+Transport::ShmRing::~ShmRing()
+{
+    close();
+}
+
+/**
+ * @brief Creates or attaches to a named ring and claims a role
+ * @param name Shared-memory object name ("/name"; the slash is added if missing)
+ * @param role Side to attach as
+ * @param capacity Ring bytes if the ring is created here; ignored when attaching
+ * @return ERROR if already open, the object cannot be mapped, is not a
+ *         ring, or the role is held by a live process
+ */
+Event::Status Transport::ShmRing::open(const std::string& name, Role role, std::size_t capacity)
+{
+    if (header_ != nullptr) {
+        return Event::Status::ERROR;
+    }
+    const std::string object = objectName(name);
+    bool created = true;
+    int fd = ::shm_open(object.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        created = false;
+        fd = ::shm_open(object.c_str(), O_RDWR, 0600);
+    }
+    if (fd < 0) {
+        std::cerr << "ShmRing cannot open " << object << ": " << std::strerror(errno) << "\n";
+        return Event::Status::ERROR;
+    }
+
+    const Event::Status status = map(fd, created, capacity);
+    ::close(fd);
+    if (status == Event::Status::ERROR) {
+        if (created) {
+            ::shm_unlink(object.c_str());
+        }
+        return Event::Status::ERROR;
+    }
+
+    name_ = object;
+    role_ = role;
+    took_over_ = false;
+    if (claimRole() == Event::Status::ERROR) {
+        ::munmap(header_, mapped_size_);
+        header_ = nullptr;
+        ring_ = nullptr;
+        return Event::Status::ERROR;
+    }
+    write_position_ = header_->head.load(std::memory_order_acquire);
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Maps the object and validates or initializes its header
+ * @param fd Open shared-memory object
+ * @param created Whether this process created it
+ * @param capacity Ring bytes to initialize a created ring with
+ * @return ERROR if the object is not a usable ring
+ *
+ * The creator sizes the object and publishes the header by setting ready;
+ * an attaching process waits up to one second for that to happen.
+ */
+Event::Status Transport::ShmRing::map(int fd, bool created, std::size_t capacity)
+{
+    using namespace ShmFormat;
+    if (created) {
+        capacity = ringCapacity(capacity);
+        mapped_size_ = sizeof(RingHeader) + capacity;
+        if (::ftruncate(fd, static_cast<off_t>(mapped_size_)) != 0) {
+            std::cerr << "ShmRing cannot size the ring: " << std::strerror(errno) << "\n";
+            return Event::Status::ERROR;
+        }
+    } else {
+        // The creator may still be between shm_open() and setting ready
+        const auto deadline = std::chrono::steady_clock::now() + kAttachTimeout;
+        struct stat info{};
+        while (::fstat(fd, &info) == 0 && info.st_size < static_cast<off_t>(sizeof(RingHeader)) &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (info.st_size < static_cast<off_t>(sizeof(RingHeader))) {
+            std::cerr << "ShmRing cannot attach: the ring was never initialized\n";
+            return Event::Status::ERROR;
+        }
+        mapped_size_ = static_cast<std::size_t>(info.st_size);
+    }
+
+    void* data = ::mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        std::cerr << "ShmRing cannot map the ring: " << std::strerror(errno) << "\n";
+        return Event::Status::ERROR;
+    }
+    header_ = static_cast<RingHeader*>(data);
+
+    if (created) {
+        // ftruncate() zero-filled the object, which is the initial state of every counter
+        std::memcpy(header_->magic, kRingMagic, sizeof(kRingMagic));
+        header_->version = kVersion;
+        header_->header_size = sizeof(RingHeader);
+        header_->capacity = capacity;
+        header_->ready.store(1, std::memory_order_release);
+    } else {
+        const auto deadline = std::chrono::steady_clock::now() + kAttachTimeout;
+        while (header_->ready.load(std::memory_order_acquire) == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        capacity = static_cast<std::size_t>(header_->capacity);
+        if (header_->ready.load(std::memory_order_acquire) == 0 ||
+            std::memcmp(header_->magic, kRingMagic, sizeof(kRingMagic)) != 0 || header_->version != kVersion ||
+            header_->header_size != sizeof(RingHeader) || capacity < kMinCapacity ||
+            (capacity & (capacity - 1)) != 0 || sizeof(RingHeader) + capacity > mapped_size_) {
+            std::cerr << "ShmRing cannot attach: not a version " << kVersion << " ring\n";
+            ::munmap(data, mapped_size_);
+            header_ = nullptr;
+            return Event::Status::ERROR;
+        }
+    }
+    ring_ = static_cast<uint8_t*>(data) + sizeof(RingHeader);
+    capacity_ = capacity;
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Claims the role's pid slot, taking over a dead holder's
+ * @return ERROR if a live process holds the role
+ */
+Event::Status Transport::ShmRing::claimRole()
+{
+    const bool producer = role_ == Role::Producer;
+    auto& slot = producer ? header_->producer_pid : header_->consumer_pid;
+    const auto self = static_cast<int32_t>(::getpid());
+    int32_t holder = slot.load(std::memory_order_acquire);
+    while (true)
+    {
+        if (holder != 0 && processAlive(holder)) {
+            std::cerr << "ShmRing cannot attach to " << name_ << ": process " << holder << " is its "
+                      << (producer ? "producer" : "consumer") << "\n";
+            return Event::Status::ERROR;
+        }
+        if (slot.compare_exchange_strong(holder, self, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+    if (holder != 0) {
+        // The previous holder died without close(); its waiting flag is stale
+        took_over_ = true;
+        (producer ? header_->producer_takeovers : header_->consumer_takeovers).fetch_add(1);
+        (producer ? header_->producer_waiting : header_->consumer_waiting).store(0);
+    }
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Releases the role, wakes the peer and unmaps the ring
+ */
+void Transport::ShmRing::close()
+{
+    if (header_ == nullptr) {
+        return;
+    }
+    const bool producer = role_ == Role::Producer;
+    int32_t self = static_cast<int32_t>(::getpid());
+    (producer ? header_->producer_pid : header_->consumer_pid).compare_exchange_strong(self, 0);
+
+    // Let a sleeping peer notice promptly that this side is gone
+    auto& peer_seq = producer ? header_->data_seq : header_->space_seq;
+    peer_seq.fetch_add(1);
+    futexWake(peer_seq);
+
+    ::munmap(header_, mapped_size_);
+    header_ = nullptr;
+    ring_ = nullptr;
+    capacity_ = 0;
+    mapped_size_ = 0;
+}
+
+/**
+ * @brief Removes a named ring; processes that have it open keep their mapping
+ * @param name Name given to open()
+ */
+void Transport::ShmRing::unlink(const std::string& name)
+{
+    ::shm_unlink(objectName(name).c_str());
+}
+
+/**
+ * @brief Whether the other side is attached by a running process
+ */
+bool Transport::ShmRing::peerAlive() const
+{
+    if (header_ == nullptr) {
+        return false;
+    }
+    const auto& slot = role_ == Role::Producer ? header_->consumer_pid : header_->producer_pid;
+    return processAlive(slot.load(std::memory_order_acquire));
+}
+
+/**
+ * @brief Reserves space for one frame (producer)
+ * @param size Payload size, at most maxPayloadSize()
+ * @param timeout Longest wait for the consumer to free space
+ * @return Where to write the payload, or nullptr if the payload is too
+ *         large, the wait timed out, or no live consumer can free space
+ *
+ * A frame that would cross the end of the ring is preceded by a wrap
+ * marker and starts at offset 0 instead. While waiting, the producer
+ * sleeps on space_seq in slices of kWaitSlice and gives up as soon as the
+ * consumer is found dead.
+ */
+uint8_t* Transport::ShmRing::reserve(std::size_t size, std::chrono::milliseconds timeout)
+{
+    using namespace ShmFormat;
+    if (header_ == nullptr || role_ != Role::Producer || size > maxPayloadSize()) {
+        return nullptr;
+    }
+    const std::size_t frame_size = frameSize(size);
+    std::size_t offset = static_cast<std::size_t>(write_position_ & (capacity_ - 1));
+    const std::size_t padding = capacity_ - offset < frame_size ? capacity_ - offset : 0;
+    const uint64_t needed = padding + frame_size;
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (write_position_ + needed - header_->tail.load(std::memory_order_acquire) > capacity_)
+    {
+        commit(); // The consumer can only free space for frames it can see
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline || !peerAlive()) {
+            return nullptr;
+        }
+        const uint32_t seq = header_->space_seq.load(std::memory_order_acquire);
+        header_->producer_waiting.store(1);
+        if (write_position_ + needed - header_->tail.load() > capacity_) {
+            futexWait(header_->space_seq, seq, std::min<std::chrono::nanoseconds>(deadline - now, kWaitSlice));
+        }
+        header_->producer_waiting.store(0, std::memory_order_relaxed);
+    }
+
+    if (padding > 0) {
+        const FrameHeader wrap{kWrapMarker, 0};
+        std::memcpy(ring_ + offset, &wrap, sizeof(wrap));
+        write_position_ += padding;
+        offset = 0;
+    }
+    const FrameHeader frame{static_cast<uint32_t>(size), 0};
+    std::memcpy(ring_ + offset, &frame, sizeof(frame));
+    write_position_ += frame_size;
+    return ring_ + offset + sizeof(frame);
+}
+
+/**
+ * @brief Publishes every reserved frame and wakes a sleeping consumer (producer)
+ *
+ * The head store and the waiting-flag load are sequentially consistent, as
+ * are the consumer's flag store and head re-check, so either the consumer
+ * sees the new head or this side sees it waiting.
+ */
+void Transport::ShmRing::commit()
+{
+    if (header_ == nullptr || role_ != Role::Producer ||
+        header_->head.load(std::memory_order_relaxed) == write_position_) {
+        return;
+    }
+    header_->head.store(write_position_);
+    if (header_->consumer_waiting.load() != 0) {
+        header_->data_seq.fetch_add(1, std::memory_order_release);
+        futexWake(header_->data_seq);
+    }
+}
+
+/**
+ * @brief Waits until frames are available (consumer)
+ * @param timeout Longest wait
+ * @return true if at least one frame can be consumed
+ */
+bool Transport::ShmRing::waitReadable(std::chrono::milliseconds timeout)
+{
+    if (header_ == nullptr || role_ != Role::Consumer) {
+        return false;
+    }
+    const uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (header_->head.load(std::memory_order_acquire) == tail)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        const uint32_t seq = header_->data_seq.load(std::memory_order_acquire);
+        header_->consumer_waiting.store(1);
+        if (header_->head.load() == tail) {
+            futexWait(header_->data_seq, seq, std::min<std::chrono::nanoseconds>(deadline - now, kWaitSlice));
+        }
+        header_->consumer_waiting.store(0, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+/**
+ * @brief Advances tail and wakes a producer waiting for space (consumer)
+ * @param position New tail
+ */
+void Transport::ShmRing::release(uint64_t position)
+{
+    if (position == header_->tail.load(std::memory_order_relaxed)) {
+        return;
+    }
+    header_->tail.store(position);
+    if (header_->producer_waiting.load() != 0) {
+        header_->space_seq.fetch_add(1, std::memory_order_release);
+        futexWake(header_->space_seq);
+    }
+}
+
+/**
+ * @brief Reports a malformed frame header
+ * @param position Where it was found
+ */
+void Transport::ShmRing::reportCorruption(uint64_t position) const
+{
+    std::cerr << "ShmRing " << name_ << " has a malformed frame at position " << position
+              << "; dropping the published frames\n";
+}
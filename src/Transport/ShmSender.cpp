@@ -0,0 +1,135 @@
+#include <algorithm>
+
+#include "Transport/ShmSender.h"
+#include "Event/SensorEvent.h"
+#include "Event/WireFormat.h"
+
+/**
+ * @brief Closes the sender
+ */
+Transport::ShmSender::~ShmSender()
+{
+    close();
+}
+
+/**
+ * @brief Creates or attaches to a ring as its producer
+ * @param name Shared-memory ring name
+ * @param options Ring size and backpressure limit
+ * @return ERROR if already open or the ring cannot be opened
+ */
+Event::Status Transport::ShmSender::open(const std::string& name, Options options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ring_.isOpen() || ring_.open(name, ShmRing::Role::Producer, options.capacity) == Event::Status::ERROR) {
+        return Event::Status::ERROR;
+    }
+    options_ = options;
+    stats_ = Stats{};
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Releases the producer role
+ */
+void Transport::ShmSender::close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_.close();
+}
+
+/**
+ * @brief Whether open() succeeded and close() has not been called
+ */
+bool Transport::ShmSender::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_.isOpen();
+}
+
+/**
+ * @brief Whether a ShmReceiver process is attached and running
+ */
+bool Transport::ShmSender::receiverAlive() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_.peerAlive();
+}
+
+/**
+ * @brief Sends one reading
+ * @param record Reading to send
+ * @return ERROR if the sender is closed or the reading was dropped
+ */
+Event::Status Transport::ShmSender::send(const Event::SensorRecord& record)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ring_.isOpen() || !encodeLocked(record)) {
+        return Event::Status::ERROR;
+    }
+    ring_.commit();
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Sends the sensor readings of a batch
+ * @param batch Events in publish order; non-sensor events are skipped
+ * @return Number of readings sent
+ */
+std::size_t Transport::ShmSender::send(const EventBatch& batch)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ring_.isOpen()) {
+        return 0;
+    }
+    std::size_t sent = 0;
+    for (const Event::Event& event : batch) {
+        const auto* sensor_event = Event::event_cast<Event::SensorEvent>(event);
+        if (sensor_event != nullptr && encodeLocked(sensor_event->getRecord())) {
+            sent++;
+        }
+    }
+    ring_.commit();
+    return sent;
+}
+
+/**
+ * @brief Encodes one reading into the ring without committing; caller holds mutex_
+ * @param record Reading to encode
+ * @return false if it was dropped
+ */
+bool Transport::ShmSender::encodeLocked(const Event::SensorRecord& record)
+{
+    const std::string_view name = Event::deviceName(record.device_id);
+    const std::size_t size = Event::WireFormat::sensorEventSize(std::min(name.size(), Event::WireFormat::kMaxNameSize));
+    uint8_t* payload = ring_.reserve(size, options_.send_timeout);
+    if (payload == nullptr) {
+        stats_.dropped++;
+        return false;
+    }
+    Event::WireFormat::encodeSensorEvent(record, name, payload);
+    stats_.sent++;
+    return true;
+}
+
+/**
+ * @brief Subscribes the sender to every batch an EventBus dispatches
+ * @param event_bus Bus to forward
+ * @param executor Where sending runs; nullptr runs it on the dispatcher
+ * @return Id of the subscription
+ */
+EventBus::SubscriptionId Transport::ShmSender::attach(EventBus& event_bus, std::shared_ptr<Executor> executor)
+{
+    return event_bus.subscribeBatch([this](const EventBatch& batch) {
+        send(batch);
+    }, std::move(executor));
+}
+
+/**
+ * @brief Gets the counters of the sender
+ */
+Transport::ShmSender::Stats Transport::ShmSender::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
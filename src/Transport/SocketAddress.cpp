@@ -0,0 +1,198 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Transport/SocketAddress.h"
+
+namespace
+{
+
+/**
+ * @brief Fills a sockaddr_un with a socket path
+ * @param path Socket file
+ * @param address Receives the address
+ * @return false if the path does not fit
+ */
+bool unixAddress(const std::string& path, sockaddr_un& address)
+{
+    address = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+/**
+ * @brief Resolves a TCP host and port
+ * @param host Host name or address
+ * @param port Port
+ * @param passive Whether the result is for bind()
+ * @return Address list to free with freeaddrinfo(), or nullptr
+ */
+addrinfo* resolve(const std::string& host, uint16_t port, bool passive)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    addrinfo* result = nullptr;
+    const std::string service = std::to_string(port);
+    if (::getaddrinfo(host.empty() ? nullptr : host.c_str(), service.c_str(), &hints, &result) != 0) {
+        return nullptr;
+    }
+    return result;
+}
+
+} // namespace
+
+/**
+ * @brief Parses an address
+ * @param text "tcp:<host>:<port>" or "unix:<path>"
+ * @param address Receives the parsed address
+ * @return ERROR if the text is not a valid address
+ */
+Event::Status Transport::SocketAddress::parse(const std::string& text, SocketAddress& address)
+{
+    SocketAddress result;
+    if (text.compare(0, 5, "unix:") == 0) {
+        result.family = Family::Unix;
+        result.path = text.substr(5);
+        sockaddr_un check{};
+        if (!unixAddress(result.path, check)) {
+            return Event::Status::ERROR;
+        }
+    } else if (text.compare(0, 4, "tcp:") == 0) {
+        const std::size_t colon = text.rfind(':');
+        if (colon <= 4) {
+            return Event::Status::ERROR;
+        }
+        result.family = Family::Tcp;
+        result.host = text.substr(4, colon - 4);
+        if (result.host.size() >= 2 && result.host.front() == '[' && result.host.back() == ']') {
+            result.host = result.host.substr(1, result.host.size() - 2);
+        }
+        const std::string port = text.substr(colon + 1);
+        char* end = nullptr;
+        const unsigned long value = std::strtoul(port.c_str(), &end, 10);
+        if (result.host.empty() || port.empty() || *end != '\0' || value > UINT16_MAX) {
+            return Event::Status::ERROR;
+        }
+        result.port = static_cast<uint16_t>(value);
+    } else {
+        return Event::Status::ERROR;
+    }
+    address = std::move(result);
+    return Event::Status::OK;
+}
+
+/**
+ * @brief Formats the address in the form parse() accepts
+ */
+std::string Transport::SocketAddress::toString() const
+{
+    if (family == Family::Unix) {
+        return "unix:" + path;
+    }
+    const bool ipv6 = host.find(':') != std::string::npos;
+    return "tcp:" + (ipv6 ? "[" + host + "]" : host) + ":" + std::to_string(port);
+}
+
+/**
+ * @brief Opens a blocking stream socket connected to the address
+ * @return File descriptor, or -1 if the connection failed
+ */
+int Transport::SocketAddress::connect() const
+{
+    if (family == Family::Unix) {
+        sockaddr_un address{};
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || !unixAddress(path, address) ||
+            ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            return -1;
+        }
+        return fd;
+    }
+
+    addrinfo* addresses = resolve(host, port, false);
+    int fd = -1;
+    for (addrinfo* entry = addresses; entry != nullptr && fd < 0; entry = entry->ai_next) {
+        fd = ::socket(entry->ai_family, entry->ai_socktype | SOCK_CLOEXEC, entry->ai_protocol);
+        if (fd >= 0 && ::connect(fd, entry->ai_addr, entry->ai_addrlen) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    if (addresses != nullptr) {
+        ::freeaddrinfo(addresses);
+    }
+    if (fd >= 0) {
+        const int enable = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+    return fd;
+}
+
+/**
+ * @brief Opens a listening socket bound to the address
+ * @param backlog Pending connection limit
+ * @return File descriptor, or -1 on failure
+ */
+int Transport::SocketAddress::listen(int backlog)
+{
+    if (family == Family::Unix) {
+        sockaddr_un address{};
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && unixAddress(path, address)) {
+            ::unlink(path.c_str()); // Left behind by a previous run
+            if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0 &&
+                ::listen(fd, backlog) == 0) {
+                return fd;
+            }
+        }
+        std::cerr << "SocketAddress cannot listen on " << toString() << ": " << std::strerror(errno) << "\n";
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return -1;
+    }
+
+    addrinfo* addresses = resolve(host, port, true);
+    int fd = -1;
+    for (addrinfo* entry = addresses; entry != nullptr && fd < 0; entry = entry->ai_next) {
+        fd = ::socket(entry->ai_family, entry->ai_socktype | SOCK_CLOEXEC, entry->ai_protocol);
+        const int enable = 1;
+        if (fd >= 0 && (::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) != 0 ||
+                        ::bind(fd, entry->ai_addr, entry->ai_addrlen) != 0 || ::listen(fd, backlog) != 0)) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    if (addresses != nullptr) {
+        ::freeaddrinfo(addresses);
+    }
+    if (fd < 0) {
+        std::cerr << "SocketAddress cannot listen on " << toString() << ": " << std::strerror(errno) << "\n";
+        return -1;
+    }
+
+    sockaddr_storage bound{};
+    socklen_t size = sizeof(bound);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&bound), &size) == 0) {
+        port = ntohs(bound.ss_family == AF_INET6 ? reinterpret_cast<const sockaddr_in6*>(&bound)->sin6_port
+                                                 : reinterpret_cast<const sockaddr_in*>(&bound)->sin_port);
+    }
+    return fd;
+}
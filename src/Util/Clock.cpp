@@ -0,0 +1,228 @@
+#include <atomic>
+#include <chrono>
+
+#include "Util/Clock.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define UTIL_CLOCK_HAS_TSC 1
+#include <cpuid.h>
+#include <x86intrin.h>
+#else
+#define UTIL_CLOCK_HAS_TSC 0
+#endif
+
+namespace
+{
+
+constexpr int64_t kCalibrationNs = 2000000; ///< Spin time used to measure the TSC frequency (2 ms)
+
+/**
+ * @brief Reads std::chrono::steady_clock in nanoseconds
+ */
+int64_t steadyNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Reads std::chrono::system_clock in nanoseconds
+ */
+int64_t systemNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Measures system_clock - steady_clock, bracketing the system read
+ */
+int64_t measureWallOffset()
+{
+    const int64_t before = steadyNowNs();
+    const int64_t wall = systemNowNs();
+    const int64_t after = steadyNowNs();
+    return wall - (before + (after - before) / 2);
+}
+
+/**
+ * @struct TscCalibration
+ * @brief Process-wide TSC scaling, computed once on first use
+ */
+struct TscCalibration
+{
+    bool usable{false};       ///< Invariant TSC present and calibration succeeded
+    uint64_t mult{0};         ///< Nanoseconds per tick in 32.32 fixed point
+    uint64_t resync_ticks{0}; ///< kResyncIntervalNs expressed in ticks
+};
+
+#if UTIL_CLOCK_HAS_TSC
+
+/**
+ * @brief Checks CPUID for an invariant (constant-rate, non-stop) TSC
+ */
+bool hasInvariantTsc()
+{
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (!__get_cpuid(0x80000000u, &eax, &ebx, &ecx, &edx) || eax < 0x80000007u)
+    {
+        return false;
+    }
+    __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+}
+
+/**
+ * @brief Measures the TSC frequency against steady_clock
+ */
+TscCalibration calibrate()
+{
+    TscCalibration calibration;
+    if (!hasInvariantTsc())
+    {
+        return calibration;
+    }
+
+    const int64_t ns_start = steadyNowNs();
+    const uint64_t tsc_start = __rdtsc();
+    int64_t ns_end = ns_start;
+    while (ns_end - ns_start < kCalibrationNs)
+    {
+        ns_end = steadyNowNs();
+    }
+    const uint64_t tsc_end = __rdtsc();
+
+    if (tsc_end <= tsc_start)
+    {
+        return calibration;
+    }
+
+    const uint64_t ticks = tsc_end - tsc_start;
+    calibration.mult = (static_cast<uint64_t>(ns_end - ns_start) << 32) / ticks;
+    if (calibration.mult == 0)
+    {
+        return calibration;
+    }
+    calibration.resync_ticks = (static_cast<uint64_t>(Util::Clock::kResyncIntervalNs) << 32) / calibration.mult;
+    calibration.usable = true;
+    return calibration;
+}
+
+#else
+
+TscCalibration calibrate()
+{
+    return TscCalibration{};
+}
+
+#endif // UTIL_CLOCK_HAS_TSC
+
+const TscCalibration& tscCalibration()
+{
+    static const TscCalibration calibration = calibrate();
+    return calibration;
+}
+
+std::atomic<int64_t>& wallOffset()
+{
+    static std::atomic<int64_t> offset{measureWallOffset()};
+    return offset;
+}
+
+} // namespace
+
+/**
+ * @brief Current monotonic time
+ * @return Nanoseconds in the steady clock domain
+ * 
+ * TSC path: ns = anchor_ns + (tsc - anchor_tsc) * mult, with the per-thread
+ * anchor refreshed from steady_clock once the TSC has advanced past
+ * resync_ticks. The result is clamped so a thread never sees time go back
+ * across a re-anchor.
+ */
+int64_t Util::Clock::nowNs()
+{
+#if UTIL_CLOCK_HAS_TSC
+    const TscCalibration& calibration = tscCalibration();
+    if (calibration.usable)
+    {
+        struct Anchor
+        {
+            uint64_t tsc{0};
+            int64_t ns{0};
+            int64_t last{0};
+            bool valid{false};
+        };
+        thread_local Anchor anchor;
+
+        const uint64_t tsc = __rdtsc();
+        if (!anchor.valid || tsc - anchor.tsc > calibration.resync_ticks)
+        {
+            anchor.ns = steadyNowNs();
+            anchor.tsc = __rdtsc();
+            anchor.valid = true;
+        }
+
+        const uint64_t elapsed_ticks = (tsc > anchor.tsc) ? tsc - anchor.tsc : 0;
+        const int64_t elapsed_ns = static_cast<int64_t>(
+            (static_cast<unsigned __int128>(elapsed_ticks) * calibration.mult) >> 32);
+        int64_t now = anchor.ns + elapsed_ns;
+        if (now < anchor.last)
+        {
+            now = anchor.last;
+        }
+        anchor.last = now;
+        return now;
+    }
+#endif
+    return steadyNowNs();
+}
+
+/**
+ * @brief Current wall-clock time derived from the monotonic clock
+ * @return Nanoseconds since the Unix epoch
+ */
+int64_t Util::Clock::wallNowNs()
+{
+    return toWallNs(nowNs());
+}
+
+/**
+ * @brief Converts a monotonic timestamp to wall-clock time
+ * @param monotonic_ns Timestamp returned by nowNs()
+ * @return Nanoseconds since the Unix epoch
+ */
+int64_t Util::Clock::toWallNs(int64_t monotonic_ns)
+{
+    return monotonic_ns + wallOffset().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Converts a wall-clock timestamp to the monotonic domain
+ * @param wall_ns Nanoseconds since the Unix epoch
+ * @return Monotonic nanoseconds
+ */
+int64_t Util::Clock::fromWallNs(int64_t wall_ns)
+{
+    return wall_ns - wallOffset().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Re-captures the system/steady clock offset
+ */
+void Util::Clock::resyncWallAnchor()
+{
+    wallOffset().store(measureWallOffset(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the source used by nowNs()
+ * @return ClockSource::Tsc when an invariant TSC was calibrated
+ */
+Util::ClockSource Util::Clock::source()
+{
+    return tscCalibration().usable ? ClockSource::Tsc : ClockSource::Steady;
+}
@@ -0,0 +1,213 @@
+#include "Util/InternTable.h"
+
+namespace
+{
+
+constexpr std::size_t kInitialCapacity = 256; ///< Initial index slots (power of two)
+
+} // namespace
+
+/**
+ * @brief Allocates an index with all slots empty
+ * @param capacity Number of slots, a power of two
+ */
+Util::InternTable::Index::Index(std::size_t capacity)
+    : mask(capacity - 1),
+    slots(new std::atomic<uint32_t>[capacity])
+{
+    for (std::size_t i = 0; i < capacity; ++i) {
+        slots[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Constructs an empty table with a small initial index
+ */
+Util::InternTable::InternTable()
+    : size_(0)
+{
+    for (auto& chunk : chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    indexes_.emplace_back(std::make_unique<Index>(kInitialCapacity));
+    index_.store(indexes_.back().get(), std::memory_order_release);
+}
+
+/**
+ * @brief Releases name chunks; indexes are released by indexes_
+ */
+Util::InternTable::~InternTable()
+{
+    for (auto& chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief FNV-1a over the bytes of name
+ * @param name Name to hash
+ * @return 64-bit hash
+ */
+uint64_t Util::InternTable::hash(std::string_view name)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (char c : name) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+/**
+ * @brief Gets the stored entry for an id
+ * @param id Interned id
+ * @return Entry pointer, or nullptr for an id not yet published
+ */
+const Util::InternTable::Entry* Util::InternTable::entry(uint32_t id) const
+{
+    if (id >= size_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    const Entry* chunk = chunks_[id / kChunkSize].load(std::memory_order_acquire);
+    return chunk ? &chunk[id % kChunkSize] : nullptr;
+}
+
+/**
+ * @brief Probes an index for a name (lock-free)
+ * @param index Index to search
+ * @param name Name to find
+ * @param name_hash hash(name)
+ * @return id on success, kInvalidId if absent
+ * 
+ * A slot is published only after its entry is complete, so any id read
+ * here refers to a fully constructed entry.
+ */
+uint32_t Util::InternTable::probe(const Index& index, std::string_view name, uint64_t name_hash) const
+{
+    for (std::size_t slot = name_hash & index.mask;; slot = (slot + 1) & index.mask) {
+        const uint32_t value = index.slots[slot].load(std::memory_order_acquire);
+        if (value == 0) {
+            return kInvalidId;
+        }
+        const uint32_t id = value - 1;
+        const Entry* candidate = entry(id);
+        if (candidate && candidate->hash == name_hash && candidate->name == name) {
+            return id;
+        }
+    }
+}
+
+/**
+ * @brief Inserts an id into the first free slot of its probe sequence
+ * @param index Index to modify (must have a free slot)
+ * @param id Id to insert
+ * @param name_hash Hash of the id's name
+ */
+void Util::InternTable::place(Index& index, uint32_t id, uint64_t name_hash)
+{
+    std::size_t slot = name_hash & index.mask;
+    while (index.slots[slot].load(std::memory_order_relaxed) != 0) {
+        slot = (slot + 1) & index.mask;
+    }
+    index.slots[slot].store(id + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Looks up a name without adding it (lock-free)
+ * @param name Name to look up
+ * @param id Receives the id on success
+ * @return true if found
+ */
+bool Util::InternTable::find(std::string_view name, uint32_t& id) const
+{
+    const uint32_t found = probe(*index_.load(std::memory_order_acquire), name, hash(name));
+    if (found == kInvalidId) {
+        return false;
+    }
+    id = found;
+    return true;
+}
+
+/**
+ * @brief Gets the id of a name, adding it if necessary
+ * @param name Name to intern
+ * @return Dense id, or kInvalidId if the table is full
+ * 
+ * Fast path is a lock-free find(). On a miss the writer lock is taken, the
+ * lookup repeated against the current index, and the name appended: the
+ * entry is written first, then size_ and the index slot are published.
+ */
+uint32_t Util::InternTable::intern(std::string_view name)
+{
+    const uint64_t name_hash = hash(name);
+    uint32_t id = probe(*index_.load(std::memory_order_acquire), name, name_hash);
+    if (id != kInvalidId) {
+        return id;
+    }
+
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    Index* index = index_.load(std::memory_order_relaxed);
+    id = probe(*index, name, name_hash);
+    if (id != kInvalidId) {
+        return id;
+    }
+
+    id = size_.load(std::memory_order_relaxed);
+    if (id >= kChunkSize * kMaxChunks) {
+        return kInvalidId;
+    }
+
+    Entry* chunk = chunks_[id / kChunkSize].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new Entry[kChunkSize];
+        chunks_[id / kChunkSize].store(chunk, std::memory_order_release);
+    }
+    Entry& stored = chunk[id % kChunkSize];
+    stored.name.assign(name.data(), name.size());
+    stored.hash = name_hash;
+    size_.store(id + 1, std::memory_order_release);
+
+    // Keep the load factor at or below 1/2
+    if ((static_cast<std::size_t>(id) + 1) * 2 > index->mask + 1) {
+        auto grown = std::make_unique<Index>((index->mask + 1) * 2);
+        for (uint32_t existing = 0; existing <= id; ++existing) {
+            place(*grown, existing, entry(existing)->hash);
+        }
+        index = grown.get();
+        indexes_.emplace_back(std::move(grown));
+        index_.store(index, std::memory_order_release);
+    } else {
+        place(*index, id, name_hash);
+    }
+    return id;
+}
+
+/**
+ * @brief Gets the name of an id (lock-free)
+ * @param id Interned id
+ * @return Interned name, or empty view for unknown ids
+ */
+std::string_view Util::InternTable::name(uint32_t id) const
+{
+    const Entry* stored = entry(id);
+    return stored ? std::string_view(stored->name) : std::string_view();
+}
+
+/**
+ * @brief Number of interned names
+ * @return Count; valid ids are [0, size())
+ */
+std::size_t Util::InternTable::size() const
+{
+    return size_.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Process-wide table used for device ids
+ * @return Reference to the singleton table
+ */
+Util::InternTable& Util::InternTable::global()
+{
+    static InternTable table;
+    return table;
+}
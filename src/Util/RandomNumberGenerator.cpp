@@ -0,0 +1,516 @@
+#include <atomic>
+
+#include "Util/RandomNumberGenerator.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define UTIL_RNG_HAS_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define UTIL_RNG_HAS_X86_SIMD 0
+#endif
+
+namespace
+{
+
+constexpr std::size_t kLanes = Util::RandomNumberGenerator::kBulkLanes;
+constexpr double kTwoPowMinus32 = 1.0 / 4294967296.0;
+
+/**
+ * @brief Advances one XorShift32 lane and returns its new state
+ */
+inline uint32_t laneStep(uint32_t& state)
+{
+    state ^= (state << 13);
+    state ^= (state >> 17);
+    state ^= (state << 5);
+    return state;
+}
+
+/**
+ * @struct JumpTable
+ * @brief XorShift32 step matrices over GF(2) for every power-of-two distance
+ *
+ * powers[i][b] is the state reached 2^i steps after the state with only bit
+ * b set. The step is linear, so any jump is the XOR of these columns.
+ */
+struct JumpTable
+{
+    uint32_t powers[32][32];
+};
+
+/**
+ * @brief Applies a step matrix to a state
+ */
+inline uint32_t applyMatrix(const uint32_t* columns, uint32_t state)
+{
+    uint32_t result = 0;
+    for (unsigned b = 0; state != 0; ++b, state >>= 1)
+    {
+        if (state & 1u)
+        {
+            result ^= columns[b];
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Builds the jump table once, by repeated squaring of the one-step matrix
+ */
+const JumpTable& jumpTable()
+{
+    static const JumpTable table = [] {
+        JumpTable built{};
+        for (unsigned b = 0; b < 32; ++b)
+        {
+            uint32_t state = 1u << b;
+            built.powers[0][b] = laneStep(state);
+        }
+        for (unsigned i = 1; i < 32; ++i)
+        {
+            for (unsigned b = 0; b < 32; ++b)
+            {
+                built.powers[i][b] = applyMatrix(built.powers[i - 1], built.powers[i - 1][b]);
+            }
+        }
+        return built;
+    }();
+    return table;
+}
+
+/**
+ * @brief Advances a XorShift32 state by a number of steps in O(log steps)
+ * @param state Non-zero state
+ * @param steps Distance; the period is 2^32 - 1, so larger distances wrap
+ */
+uint32_t jumpAhead(uint32_t state, uint64_t steps)
+{
+    steps %= 0xFFFFFFFFull;
+    const JumpTable& table = jumpTable();
+    for (unsigned i = 0; steps != 0; ++i, steps >>= 1)
+    {
+        if (steps & 1u)
+        {
+            state = applyMatrix(table.powers[i], state);
+        }
+    }
+    return state;
+}
+
+/**
+ * @brief Smallest x that is NOT flagged by one_in(n), i.e. ceil(2^32 / n)
+ *
+ * (x * n) >> 32 == 0 holds exactly for x below this threshold.
+ */
+inline uint64_t oneInThreshold(uint32_t n)
+{
+    return ((1ull << 32) + n - 1) / n;
+}
+
+/**
+ * @brief Portable lane loop shared by every bulk API
+ * @param lanes kLanes lane states, advanced in place
+ * @param begin First output index to produce
+ * @param count Total number of outputs
+ * @param emit Called as emit(index, draw) for every index in [begin, count)
+ *
+ * Index k is always produced by lane k % kLanes, which is what keeps the
+ * SIMD paths (handling whole groups) and this tail loop bit-identical.
+ */
+template<typename Emit>
+void scalarLanes(uint32_t* lanes, std::size_t begin, std::size_t count, Emit&& emit)
+{
+    for (std::size_t k = begin; k < count; k += kLanes)
+    {
+        for (std::size_t j = 0; j < kLanes && k + j < count; ++j)
+        {
+            emit(k + j, laneStep(lanes[j]));
+        }
+    }
+}
+
+#if UTIL_RNG_HAS_X86_SIMD
+
+/* ----------------------------- AVX2: 1 x 8 lanes ----------------------------- */
+
+__attribute__((target("avx2"))) inline __m256i avx2Step(__m256i s)
+{
+    s = _mm256_xor_si256(s, _mm256_slli_epi32(s, 13));
+    s = _mm256_xor_si256(s, _mm256_srli_epi32(s, 17));
+    s = _mm256_xor_si256(s, _mm256_slli_epi32(s, 5));
+    return s;
+}
+
+__attribute__((target("avx2"))) inline __m256i avx2MulHi(__m256i x, __m256i n)
+{
+    const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(x, n), 32);
+    const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), n);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+__attribute__((target("avx2"))) std::size_t avx2Uniform(uint32_t* lanes, uint32_t* out, std::size_t count)
+{
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+    std::size_t k = 0;
+    for (; k + kLanes <= count; k += kLanes)
+    {
+        s = avx2Step(s);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), s);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), s);
+    return k;
+}
+
+__attribute__((target("avx2"))) std::size_t avx2UniformDist(uint32_t* lanes, uint32_t* out, std::size_t count, uint32_t n)
+{
+    const __m256i bound = _mm256_set1_epi32(static_cast<int>(n));
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+    std::size_t k = 0;
+    for (; k + kLanes <= count; k += kLanes)
+    {
+        s = avx2Step(s);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), avx2MulHi(s, bound));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), s);
+    return k;
+}
+
+__attribute__((target("avx2"))) std::size_t avx2OneIn(uint32_t* lanes, uint8_t* out, std::size_t count, uint32_t threshold)
+{
+    const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+    const __m256i limit = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(threshold)), sign);
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+    std::size_t k = 0;
+    for (; k + kLanes <= count; k += kLanes)
+    {
+        s = avx2Step(s);
+        const __m256i below = _mm256_cmpgt_epi32(limit, _mm256_xor_si256(s, sign));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(below)));
+        for (std::size_t j = 0; j < kLanes; ++j)
+        {
+            out[k + j] = static_cast<uint8_t>((mask >> j) & 1u);
+        }
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), s);
+    return k;
+}
+
+__attribute__((target("avx2"))) std::size_t avx2Double(uint32_t* lanes, double* out, std::size_t count)
+{
+    const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m256d offset = _mm256_set1_pd(2147483648.0);
+    const __m256d scale = _mm256_set1_pd(kTwoPowMinus32);
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+    std::size_t k = 0;
+    for (; k + kLanes <= count; k += kLanes)
+    {
+        s = avx2Step(s);
+        // Unsigned to double: flip the sign bit, convert as signed, add 2^31 back
+        const __m128i lo = _mm_xor_si128(_mm256_castsi256_si128(s), sign);
+        const __m128i hi = _mm_xor_si128(_mm256_extracti128_si256(s, 1), sign);
+        _mm256_storeu_pd(out + k, _mm256_mul_pd(_mm256_add_pd(_mm256_cvtepi32_pd(lo), offset), scale));
+        _mm256_storeu_pd(out + k + 4, _mm256_mul_pd(_mm256_add_pd(_mm256_cvtepi32_pd(hi), offset), scale));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), s);
+    return k;
+}
+
+/* ----------------------------- SSE2: 2 x 4 lanes ----------------------------- */
+
+__attribute__((target("sse2"))) inline __m128i sse2Step(__m128i s)
+{
+    s = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+    s = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+    s = _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+    return s;
+}
+
+__attribute__((target("sse2"))) inline __m128i sse2MulHi(__m128i x, __m128i n)
+{
+    const __m128i odd_mask = _mm_set_epi32(-1, 0, -1, 0);
+    const __m128i even = _mm_srli_epi64(_mm_mul_epu32(x, n), 32);
+    const __m128i odd = _mm_and_si128(_mm_mul_epu32(_mm_srli_epi64(x, 32), n), odd_mask);
+    return _mm_or_si128(even, odd);
+}
+
+__attribute__((target("sse2"))) std::size_t sse2Uniform(uint32_t* lanes, uint32_t* out, std::size_t count)
+{
+    __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+    __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes + 4));
+    std::size_t k = 0;
+    for (; k + kLanes <= count; k += kLanes)
+    {
+        s0 = sse2Step(s0);
+        s1 = sse2Step(s1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), s0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 4), s1);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), s0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + 4), s1);
+    return k;
+}
+
+__attribute__((target("sse2"))) std::size_t sse2UniformDist(uint32_t* lanes, uint32_t* out, std::size_t count, uint32_t n)
+{
+    const __m128i bound = _mm_set1_epi32(static_cast<int>(n));
+    __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+    __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes + 4));
+    std::size_t k = 0;
+    for (; k + kLanes <= count; k += kLanes)
+    {
+        s0 = sse2Step(s0);
+        s1 = sse2Step(s1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), sse2MulHi(s0, bound));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 4), sse2MulHi(s1, bound));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), s0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + 4), s1);
+    return k;
+}
+
+__attribute__((target("sse2"))) std::size_t sse2OneIn(uint32_t* lanes, uint8_t* out, std::size_t count, uint32_t threshold)
+{
+    const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i limit = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(threshold)), sign);
+    __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+    __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes + 4));
+    std::size_t k = 0;
+    for (; k + kLanes <= count; k += kLanes)
+    {
+        s0 = sse2Step(s0);
+        s1 = sse2Step(s1);
+        const __m128i below0 = _mm_cmpgt_epi32(limit, _mm_xor_si128(s0, sign));
+        const __m128i below1 = _mm_cmpgt_epi32(limit, _mm_xor_si128(s1, sign));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(below0)))
+            | (static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(below1))) << 4);
+        for (std::size_t j = 0; j < kLanes; ++j)
+        {
+            out[k + j] = static_cast<uint8_t>((mask >> j) & 1u);
+        }
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), s0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + 4), s1);
+    return k;
+}
+
+__attribute__((target("sse2"))) inline void sse2StoreDoubles(double* out, __m128i s)
+{
+    const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128d offset = _mm_set1_pd(2147483648.0);
+    const __m128d scale = _mm_set1_pd(kTwoPowMinus32);
+    const __m128i flipped = _mm_xor_si128(s, sign);
+    const __m128i upper = _mm_shuffle_epi32(flipped, _MM_SHUFFLE(1, 0, 3, 2));
+    _mm_storeu_pd(out, _mm_mul_pd(_mm_add_pd(_mm_cvtepi32_pd(flipped), offset), scale));
+    _mm_storeu_pd(out + 2, _mm_mul_pd(_mm_add_pd(_mm_cvtepi32_pd(upper), offset), scale));
+}
+
+__attribute__((target("sse2"))) std::size_t sse2Double(uint32_t* lanes, double* out, std::size_t count)
+{
+    __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+    __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes + 4));
+    std::size_t k = 0;
+    for (; k + kLanes <= count; k += kLanes)
+    {
+        s0 = sse2Step(s0);
+        s1 = sse2Step(s1);
+        sse2StoreDoubles(out + k, s0);
+        sse2StoreDoubles(out + k + 4, s1);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), s0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + 4), s1);
+    return k;
+}
+
+#endif // UTIL_RNG_HAS_X86_SIMD
+
+/**
+ * @brief Best SIMD level supported by the running CPU
+ */
+Util::SimdLevel detectSimdLevel()
+{
+#if UTIL_RNG_HAS_X86_SIMD
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return Util::SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return Util::SimdLevel::SSE2;
+    }
+#endif
+    return Util::SimdLevel::Scalar;
+}
+
+/**
+ * @brief Process-wide SIMD level used by the bulk APIs
+ */
+std::atomic<Util::SimdLevel>& activeSimdLevel()
+{
+    static std::atomic<Util::SimdLevel> level{detectSimdLevel()};
+    return level;
+}
+
+} // namespace
+
+/**
+ * @brief Seeds the bulk lanes from disjoint blocks of the scalar sequence
+ * @param lanes Receives kBulkLanes non-zero lane states
+ * @param count Number of values the bulk call will produce
+ */
+void Util::RandomNumberGenerator::seed_lanes(uint32_t* lanes, std::size_t count)
+{
+    const uint64_t block = (static_cast<uint64_t>(count) + kBulkLanes - 1) / kBulkLanes;
+    lanes[0] = seed_;
+    for (std::size_t i = 1; i < kBulkLanes; ++i)
+    {
+        lanes[i] = jumpAhead(lanes[i - 1], block);
+    }
+    seed_ = jumpAhead(lanes[kBulkLanes - 1], block);
+}
+
+/**
+ * @brief Fills a span with raw 32-bit draws
+ * @param out Destination array
+ * @param count Number of values to write
+ */
+void Util::RandomNumberGenerator::fill_uniform(uint32_t* out, std::size_t count)
+{
+    uint32_t lanes[kBulkLanes];
+    seed_lanes(lanes, count);
+
+    std::size_t done = 0;
+#if UTIL_RNG_HAS_X86_SIMD
+    switch (bulk_simd_level())
+    {
+        case SimdLevel::AVX2: done = avx2Uniform(lanes, out, count); break;
+        case SimdLevel::SSE2: done = sse2Uniform(lanes, out, count); break;
+        default: break;
+    }
+#endif
+    scalarLanes(lanes, done, count, [out](std::size_t k, uint32_t x) {
+        out[k] = x;
+    });
+}
+
+/**
+ * @brief Fills a span with bounded integers using multiply-shift reduction
+ * @param out Destination array
+ * @param count Number of values to write
+ * @param n Upper bound (exclusive)
+ */
+void Util::RandomNumberGenerator::fill_uniform_dist(uint32_t* out, std::size_t count, uint32_t n)
+{
+    if (n == 0)
+    {
+        assert(false && "n must be positive");
+        return;
+    }
+
+    uint32_t lanes[kBulkLanes];
+    seed_lanes(lanes, count);
+
+    std::size_t done = 0;
+#if UTIL_RNG_HAS_X86_SIMD
+    switch (bulk_simd_level())
+    {
+        case SimdLevel::AVX2: done = avx2UniformDist(lanes, out, count, n); break;
+        case SimdLevel::SSE2: done = sse2UniformDist(lanes, out, count, n); break;
+        default: break;
+    }
+#endif
+    scalarLanes(lanes, done, count, [out, n](std::size_t k, uint32_t x) {
+        out[k] = static_cast<uint32_t>((static_cast<uint64_t>(x) * n) >> 32);
+    });
+}
+
+/**
+ * @brief Fills a span with 1-in-n Bernoulli flags
+ * @param out Destination array
+ * @param count Number of flags to write
+ * @param n Denominator of probability
+ *
+ * n == 1 is handled up front since its threshold (2^32) does not fit the
+ * 32-bit compare used by the lane loops.
+ */
+void Util::RandomNumberGenerator::fill_one_in(uint8_t* out, std::size_t count, uint32_t n)
+{
+    if (n == 0)
+    {
+        assert(false && "n must be positive");
+        return;
+    }
+
+    uint32_t lanes[kBulkLanes];
+    seed_lanes(lanes, count);
+
+    if (n == 1)
+    {
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            out[k] = 1;
+        }
+        return;
+    }
+
+    const uint32_t threshold = static_cast<uint32_t>(oneInThreshold(n));
+
+    std::size_t done = 0;
+#if UTIL_RNG_HAS_X86_SIMD
+    switch (bulk_simd_level())
+    {
+        case SimdLevel::AVX2: done = avx2OneIn(lanes, out, count, threshold); break;
+        case SimdLevel::SSE2: done = sse2OneIn(lanes, out, count, threshold); break;
+        default: break;
+    }
+#endif
+    scalarLanes(lanes, done, count, [out, threshold](std::size_t k, uint32_t x) {
+        out[k] = static_cast<uint8_t>(x < threshold);
+    });
+}
+
+/**
+ * @brief Fills a span with doubles in [0, 1)
+ * @param out Destination array
+ * @param count Number of values to write
+ */
+void Util::RandomNumberGenerator::fill_double(double* out, std::size_t count)
+{
+    uint32_t lanes[kBulkLanes];
+    seed_lanes(lanes, count);
+
+    std::size_t done = 0;
+#if UTIL_RNG_HAS_X86_SIMD
+    switch (bulk_simd_level())
+    {
+        case SimdLevel::AVX2: done = avx2Double(lanes, out, count); break;
+        case SimdLevel::SSE2: done = sse2Double(lanes, out, count); break;
+        default: break;
+    }
+#endif
+    scalarLanes(lanes, done, count, [out](std::size_t k, uint32_t x) {
+        out[k] = static_cast<double>(x) * kTwoPowMinus32;
+    });
+}
+
+/**
+ * @brief Gets the SIMD level used by the bulk APIs
+ * @return Active SIMD level
+ */
+Util::SimdLevel Util::RandomNumberGenerator::bulk_simd_level()
+{
+    return activeSimdLevel().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Overrides the SIMD level used by the bulk APIs
+ * @param level Requested level, clamped to the CPU's capabilities
+ */
+void Util::RandomNumberGenerator::set_bulk_simd_level(SimdLevel level)
+{
+    const SimdLevel supported = detectSimdLevel();
+    if (static_cast<int>(level) > static_cast<int>(supported))
+    {
+        level = supported;
+    }
+    activeSimdLevel().store(level, std::memory_order_relaxed);
+}
@@ -0,0 +1,67 @@
+#include "Util/RandomStreams.h"
+
+/**
+ * @brief Constructs a stream factory positioned at stream 0
+ * @param master_seed Seed from which every stream is derived
+ */
+Util::RandomStreams::RandomStreams(uint64_t master_seed)
+    : seed_(master_seed),
+    root_(master_seed)
+{
+}
+
+/**
+ * @brief Gets the master seed
+ * @return Seed passed at construction or to the last reseed()
+ */
+uint64_t Util::RandomStreams::seed() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return seed_;
+}
+
+/**
+ * @brief Restarts the fan-out from a new master seed
+ * @param master_seed New master seed
+ */
+void Util::RandomStreams::reseed(uint64_t master_seed)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    seed_ = master_seed;
+    root_ = Xoshiro256(master_seed);
+}
+
+/**
+ * @brief Hands out the next unused stream
+ * @return Current root stream; the root then jumps 2^128 draws ahead
+ */
+Util::Xoshiro256 Util::RandomStreams::next()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return root_.split();
+}
+
+/**
+ * @brief Computes a stream by index
+ * @param index Stream index
+ * @return Xoshiro256(seed) advanced by index jumps
+ */
+Util::Xoshiro256 Util::RandomStreams::stream(uint64_t index) const
+{
+    Xoshiro256 generator(seed());
+    for (uint64_t i = 0; i < index; ++i)
+    {
+        generator.jump();
+    }
+    return generator;
+}
+
+/**
+ * @brief Process-wide stream factory
+ * @return Lazily constructed instance seeded with kDefaultSeed
+ */
+Util::RandomStreams& Util::RandomStreams::global()
+{
+    static RandomStreams instance;
+    return instance;
+}
@@ -0,0 +1,167 @@
+#include <climits>
+#include <cstring>
+#include <ctime>
+
+#include "Util/TimestampFormatter.h"
+
+namespace
+{
+
+constexpr int64_t kNanosPerSecond = 1000000000;
+
+/// Divisors turning nanoseconds into 0, 3, 6 or 9 fractional digits
+constexpr int64_t kFractionDivisor[10] = {
+    1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1
+};
+
+/**
+ * @brief Floor division for possibly negative timestamps
+ */
+int64_t floorDiv(int64_t value, int64_t divisor)
+{
+    int64_t quotient = value / divisor;
+    if ((value % divisor) != 0 && (value < 0)) {
+        quotient--;
+    }
+    return quotient;
+}
+
+/**
+ * @brief Writes value as exactly width zero-padded decimal digits
+ */
+void writeDigits(char* out, uint64_t value, int width)
+{
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + (value % 10));
+        value /= 10;
+    }
+}
+
+/**
+ * @brief Days since 1970-01-01 of a proleptic Gregorian date
+ * 
+ * Used to derive the local UTC offset from a broken-down time without
+ * relying on non-standard tm fields.
+ */
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day)
+{
+    year -= (month <= 2) ? 1 : 0;
+    const int64_t era = floorDiv(year, 400);
+    const unsigned year_of_era = static_cast<unsigned>(year - era * 400);
+    const unsigned day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + static_cast<int64_t>(day_of_era) - 719468;
+}
+
+} // namespace
+
+/**
+ * @brief Constructs a formatter
+ * @param precision Fractional-second digits to write
+ * @param zone Local time with offset, or UTC
+ */
+Util::TimestampFormatter::TimestampFormatter(TimestampPrecision precision, TimestampZone zone)
+    : precision_(precision),
+    zone_(zone),
+    cached_minute_(kNoMinute),
+    prefix_{},
+    suffix_{},
+    suffix_length_(0)
+{
+}
+
+/**
+ * @brief Formats a timestamp into a caller-provided buffer
+ * @param wall_ns Nanoseconds since the Unix epoch
+ * @param buffer Destination, NUL-terminated on success
+ * @param size Size of buffer in bytes
+ * @return Characters written excluding the NUL, or 0 if buffer is too small
+ */
+std::size_t Util::TimestampFormatter::format(int64_t wall_ns, char* buffer, std::size_t size)
+{
+    const int digits = static_cast<int>(precision_);
+    const std::size_t length = kPrefixLength + 2 + (digits > 0 ? 1 + digits : 0) +
+        ((zone_ == TimestampZone::Utc) ? 1 : 6);
+    if (buffer == nullptr || size < length + 1) {
+        return 0;
+    }
+
+    const int64_t seconds = floorDiv(wall_ns, kNanosPerSecond);
+    const int64_t nanos = wall_ns - seconds * kNanosPerSecond;
+    const int64_t minute = floorDiv(seconds, 60);
+    if (minute != cached_minute_) {
+        refresh(minute);
+    }
+
+    char* out = buffer;
+    std::memcpy(out, prefix_, kPrefixLength);
+    out += kPrefixLength;
+    writeDigits(out, static_cast<uint64_t>(seconds - minute * 60), 2);
+    out += 2;
+    if (digits > 0) {
+        *out++ = '.';
+        writeDigits(out, static_cast<uint64_t>(nanos / kFractionDivisor[digits]), digits);
+        out += digits;
+    }
+    std::memcpy(out, suffix_, suffix_length_);
+    out += suffix_length_;
+    *out = '\0';
+    return static_cast<std::size_t>(out - buffer);
+}
+
+/**
+ * @brief Recomputes the cached prefix and suffix for a minute
+ * @param minute Minutes since the Unix epoch
+ * 
+ * This is the only place the C library time conversion runs.
+ */
+void Util::TimestampFormatter::refresh(int64_t minute)
+{
+    const std::time_t time = static_cast<std::time_t>(minute * 60);
+    std::tm tm_buf{};
+#ifdef _WIN32
+    if (zone_ == TimestampZone::Utc) {
+        gmtime_s(&tm_buf, &time);
+    } else {
+        localtime_s(&tm_buf, &time);
+    }
+#else
+    if (zone_ == TimestampZone::Utc) {
+        gmtime_r(&time, &tm_buf);
+    } else {
+        localtime_r(&time, &tm_buf);
+    }
+#endif
+
+    writeDigits(prefix_, static_cast<uint64_t>(tm_buf.tm_year + 1900) % 10000, 4);
+    prefix_[4] = '-';
+    writeDigits(prefix_ + 5, static_cast<uint64_t>(tm_buf.tm_mon + 1), 2);
+    prefix_[7] = '-';
+    writeDigits(prefix_ + 8, static_cast<uint64_t>(tm_buf.tm_mday), 2);
+    prefix_[10] = 'T';
+    writeDigits(prefix_ + 11, static_cast<uint64_t>(tm_buf.tm_hour), 2);
+    prefix_[13] = ':';
+    writeDigits(prefix_ + 14, static_cast<uint64_t>(tm_buf.tm_min), 2);
+    prefix_[16] = ':';
+
+    if (zone_ == TimestampZone::Utc) {
+        suffix_[0] = 'Z';
+        suffix_length_ = 1;
+    } else {
+        const int64_t local_minutes =
+            daysFromCivil(tm_buf.tm_year + 1900, static_cast<unsigned>(tm_buf.tm_mon + 1),
+                          static_cast<unsigned>(tm_buf.tm_mday)) * 1440 +
+            tm_buf.tm_hour * 60 + tm_buf.tm_min;
+        int64_t offset = local_minutes - minute;
+        suffix_[0] = (offset < 0) ? '-' : '+';
+        if (offset < 0) {
+            offset = -offset;
+        }
+        writeDigits(suffix_ + 1, static_cast<uint64_t>(offset / 60) % 100, 2);
+        suffix_[3] = ':';
+        writeDigits(suffix_ + 4, static_cast<uint64_t>(offset % 60), 2);
+        suffix_length_ = 6;
+    }
+
+    cached_minute_ = minute;
+}
@@ -2,13 +2,24 @@
 #include <thread>
 #include <chrono>
 #include <csignal>
+#include <cstdlib>
+#include <cstring>
 
 #include "SensorSimulator/SimulatorManager.h"
 #include "SensorSimulator/GasSensorSimulator.h"
 #include "SensorSimulator/TemperatureSensorSimulator.h"
 #include "SensorSimulator/PressureSensorSimulator.h"
+#include "SensorSimulator/ReplaySimulator.h"
 #include "EventBus/EventBus.h"
 #include "ConsumerSimulator/TestConsumerSimulator.h"
+#include "Storage/ColumnarSink.h"
+#include "Storage/RollupStore.h"
+#include "Transport/BridgeReceiver.h"
+#include "Transport/BridgeSender.h"
+#include "Transport/LineIngestor.h"
+#include "Transport/ShmReceiver.h"
+#include "Transport/ShmSender.h"
+#include "Util/RandomStreams.h"
 
 static volatile std::sig_atomic_t g_stop_requested = 0;
 
@@ -20,18 +31,157 @@ static void onSignal(int)
 int main(int argc, const char** argv)
 {
     std::signal(SIGINT, onSignal);  // Ctrl+C
+
+    // Every simulator stream derives from one master seed: "--seed <n>" reproduces a run
+    // "--replay <journal dir or trace file> [--speed <x>]" replays recorded traffic instead
+    // "--columnar <dir>" stores every reading in compressed columnar files
+    // "--rollup <dir>" maintains 1 s / 1 min / 1 h rollups of every device
+    // "--shm-send <ring>" forwards every reading to another process over shared memory
+    // "--shm-receive <ring>" publishes the readings another process forwards instead of simulating
+    // "--bridge-send <tcp:host:port|unix:path>" forwards every reading to another node
+    // "--bridge-receive <tcp:host:port|unix:path>" publishes the readings other nodes forward instead of simulating
+    // "--ingest <file|pipe|-|tcp:host:port|unix:path>" publishes line-protocol readings instead of simulating
+    const char* replay_path = nullptr;
+    const char* columnar_path = nullptr;
+    const char* rollup_path = nullptr;
+    const char* shm_send_name = nullptr;
+    const char* shm_receive_name = nullptr;
+    const char* bridge_send_address = nullptr;
+    const char* bridge_receive_address = nullptr;
+    const char* ingest_source = nullptr;
+    SensorSimulator::ReplaySimulator::ReplayOptions replay_options;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--seed") == 0)
+        {
+            Util::RandomStreams::global().reseed(std::strtoull(argv[i + 1], nullptr, 0));
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0)
+        {
+            replay_path = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--speed") == 0)
+        {
+            replay_options.speed = std::strtod(argv[i + 1], nullptr);
+        }
+        else if (std::strcmp(argv[i], "--columnar") == 0)
+        {
+            columnar_path = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--rollup") == 0)
+        {
+            rollup_path = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--shm-send") == 0)
+        {
+            shm_send_name = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--shm-receive") == 0)
+        {
+            shm_receive_name = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--bridge-send") == 0)
+        {
+            bridge_send_address = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--bridge-receive") == 0)
+        {
+            bridge_receive_address = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--ingest") == 0)
+        {
+            ingest_source = argv[i + 1];
+        }
+    }
+    std::cout << "Using master seed " << Util::RandomStreams::global().seed() << "\n";
+
     SensorSimulator::SimulatorManager simulator_manager;
     EventBus event_bus;
 
     // Add simulators to the manager
-    simulator_manager.addSimulator(std::make_unique<SensorSimulator::GasSensorSimulator>(event_bus));
-    simulator_manager.addSimulator(std::make_unique<SensorSimulator::TemperatureSensorSimulator>(event_bus));
-    simulator_manager.addSimulator(std::make_unique<SensorSimulator::PressureSensorSimulator>(event_bus));
+    if (replay_path != nullptr)
+    {
+        auto replay = std::make_unique<SensorSimulator::ReplaySimulator>(event_bus, replay_path, replay_options);
+        if (replay->open() == Event::Status::ERROR)
+        {
+            return 1;
+        }
+        simulator_manager.addSimulator(std::move(replay));
+    }
+    else if (shm_receive_name == nullptr && bridge_receive_address == nullptr &&
+             ingest_source == nullptr) // Otherwise readings come from elsewhere
+    {
+        simulator_manager.addSimulator(std::make_unique<SensorSimulator::GasSensorSimulator>(event_bus));
+        simulator_manager.addSimulator(std::make_unique<SensorSimulator::TemperatureSensorSimulator>(event_bus));
+        simulator_manager.addSimulator(std::make_unique<SensorSimulator::PressureSensorSimulator>(event_bus));
+    }
 
     ConsumerSimulator::TestConsumerSimulator test_consumer(event_bus);
 
+    Storage::ColumnarSink columnar_sink;
+    if (columnar_path != nullptr)
+    {
+        if (columnar_sink.open(columnar_path) == Event::Status::ERROR)
+        {
+            return 1;
+        }
+        columnar_sink.attach(event_bus, std::make_shared<DedicatedExecutor>());
+    }
+
+    Storage::RollupStore rollup_store;
+    if (rollup_path != nullptr)
+    {
+        if (rollup_store.open(rollup_path) == Event::Status::ERROR)
+        {
+            return 1;
+        }
+        rollup_store.attach(event_bus, std::make_shared<DedicatedExecutor>());
+    }
+
+    Transport::ShmSender shm_sender;
+    if (shm_send_name != nullptr)
+    {
+        if (shm_sender.open(shm_send_name) == Event::Status::ERROR)
+        {
+            return 1;
+        }
+        shm_sender.attach(event_bus, std::make_shared<DedicatedExecutor>());
+    }
+
+    Transport::BridgeSender bridge_sender;
+    if (bridge_send_address != nullptr)
+    {
+        if (bridge_sender.open(bridge_send_address) == Event::Status::ERROR)
+        {
+            return 1;
+        }
+        bridge_sender.attach(event_bus, std::make_shared<DedicatedExecutor>());
+    }
+
     event_bus.start();
 
+    Transport::ShmReceiver shm_receiver(event_bus);
+    if (shm_receive_name != nullptr && shm_receiver.open(shm_receive_name) == Event::Status::ERROR)
+    {
+        return 1;
+    }
+
+    Transport::BridgeReceiver bridge_receiver(event_bus);
+    if (bridge_receive_address != nullptr)
+    {
+        if (bridge_receiver.open(bridge_receive_address) == Event::Status::ERROR)
+        {
+            return 1;
+        }
+        std::cout << "Receiving readings on " << bridge_receiver.address() << "\n";
+    }
+
+    Transport::LineIngestor line_ingestor(event_bus);
+    if (ingest_source != nullptr && line_ingestor.open(ingest_source) == Event::Status::ERROR)
+    {
+        return 1;
+    }
+
     // Start all simulators
     simulator_manager.startAll();
 
@@ -48,8 +198,52 @@ int main(int argc, const char** argv)
 
     // Stop all simulators
     simulator_manager.stopAll();
+    shm_receiver.close();
+    bridge_receiver.close();
+    line_ingestor.close();
+
+    // Bounded shutdown: whatever is still queued after the grace period is dropped
+    const auto report = event_bus.stop(std::chrono::steady_clock::now() + std::chrono::seconds(2),
+                                       EventBus::ShutdownOptions{});
+    std::cout << "Dispatched " << report.dispatched << " events on shutdown, dropped "
+              << report.leftover << "\n";
+
+    if (columnar_sink.isOpen())
+    {
+        columnar_sink.close();
+        const auto stats = columnar_sink.getStats();
+        std::cout << "Stored " << stats.rows << " readings in " << stats.encoded_bytes << " bytes of columns\n";
+    }
 
-    event_bus.stop();
+    if (shm_sender.isOpen())
+    {
+        shm_sender.close();
+        const auto stats = shm_sender.getStats();
+        std::cout << "Forwarded " << stats.sent << " readings over shared memory, dropped " << stats.dropped << "\n";
+    }
+
+    if (bridge_sender.isOpen())
+    {
+        bridge_sender.close();
+        const auto stats = bridge_sender.getStats();
+        std::cout << "Forwarded " << stats.sent << " readings in " << stats.frames << " frames over the bridge, dropped "
+                  << stats.dropped << ", resent " << stats.resent << "\n";
+    }
+
+    if (ingest_source != nullptr)
+    {
+        const auto stats = line_ingestor.getStats();
+        std::cout << "Ingested " << stats.published << " readings from " << stats.lines << " lines, skipped "
+                  << stats.malformed << " malformed\n";
+    }
+
+    if (rollup_store.isOpen())
+    {
+        rollup_store.close();
+        const auto stats = rollup_store.getStats();
+        std::cout << "Aggregated " << stats.readings << " readings into " << stats.closed_buckets
+                  << " rollup buckets\n";
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+#ifndef TESTS_TEST_HELPERS_H
+#define TESTS_TEST_HELPERS_H
+
+/**
+ * @file testHelpers.h
+ * @brief Helpers shared by the storage and transport test suites
+ *
+ * - waitFor(): polling for a condition reached on another thread or process
+ * - makeRecord(): building sensor readings, either live (stamped now) or at
+ *   a wall-clock time
+ * - ScratchPathTest: fixture base owning a path under ::testing::TempDir()
+ * - RecordingBusTest: fixture base adding a started EventBus that records
+ *   every reading it dispatches
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+#include "Util/Clock.h"
+
+namespace TestHelpers
+{
+
+/**
+ * @brief Polls a condition until it holds or the timeout passes
+ * @param condition Condition to wait for
+ * @param timeout Longest time to wait
+ * @return Whether it held
+ */
+inline bool waitFor(const std::function<bool()>& condition,
+                    std::chrono::milliseconds timeout = std::chrono::seconds(10))
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * @brief Builds a live reading of device "TempSensor_<device>"
+ * @param device Device number
+ * @param sequence Reading counter, also used as the value
+ * @return Reading stamped with Util::Clock::nowNs()
+ */
+inline Event::SensorRecord makeRecord(uint32_t device, uint64_t sequence)
+{
+    Event::SensorRecord record{};
+    record.timestamp_ns = Util::Clock::nowNs();
+    record.value = static_cast<double>(sequence);
+    record.sequence = sequence;
+    record.device_id = Event::internDeviceId(Event::SensorType::TempSensor, device);
+    record.type = Event::SensorType::TempSensor;
+    return record;
+}
+
+/**
+ * @brief Builds a reading of device "<type>_<device>" at a wall-clock time
+ * @param device Device number
+ * @param wall_ns Wall-clock timestamp
+ * @param value Reading value
+ * @param sequence Device sequence number
+ * @param type Sensor type
+ * @return Reading whose timestamp_ns is wall_ns on the monotonic clock
+ */
+inline Event::SensorRecord makeRecord(uint32_t device, int64_t wall_ns, double value, uint64_t sequence = 0,
+                                      Event::SensorType type = Event::SensorType::TempSensor)
+{
+    Event::SensorRecord record{};
+    record.timestamp_ns = Util::Clock::fromWallNs(wall_ns);
+    record.value = value;
+    record.sequence = sequence;
+    record.device_id = Event::internDeviceId(type, device);
+    record.type = type;
+    return record;
+}
+
+/**
+ * @class ScratchPathTest
+ * @brief Test fixture base giving each test a scratch path of its own
+ *
+ * path_ is "<TempDir><prefix><test name>"; nothing exists there when the
+ * test starts, and whatever the test created there (a file, a socket or a
+ * directory tree) is removed when it ends.
+ */
+class ScratchPathTest : public ::testing::Test
+{
+protected:
+    /**
+     * @brief Constructs the fixture
+     * @param prefix Start of the path's file name, naming the suite
+     */
+    explicit ScratchPathTest(std::string prefix) : prefix_(std::move(prefix)) {}
+
+    /** @brief Picks the path and clears anything left there */
+    void SetUp() override
+    {
+        path_ = ::testing::TempDir() + prefix_ +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::remove_all(path_);
+    }
+
+    /** @brief Removes the path */
+    void TearDown() override
+    {
+        std::filesystem::remove_all(path_);
+    }
+
+    std::string path_;   ///< Scratch file, socket or directory of the test
+
+private:
+    std::string prefix_;   ///< Start of the path's file name
+};
+
+/**
+ * @class RecordingBusTest
+ * @brief Test fixture base adding a bus that records what it dispatches
+ *
+ * Every event the bus dispatches must be a SensorEvent; its reading is
+ * appended to records_.
+ */
+class RecordingBusTest : public ScratchPathTest
+{
+protected:
+    /**
+     * @brief Constructs the fixture
+     * @param prefix Start of the scratch path's file name, naming the suite
+     */
+    explicit RecordingBusTest(std::string prefix) : ScratchPathTest(std::move(prefix)) {}
+
+    /** @brief Picks the scratch path and starts the recording bus */
+    void SetUp() override
+    {
+        ScratchPathTest::SetUp();
+        event_bus_.subscribe([this](const Event::Event& event) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            records_.push_back(Event::event_cast<Event::SensorEvent>(event)->getRecord());
+        });
+        event_bus_.start();
+    }
+
+    /** @brief Stops the bus and removes the scratch path */
+    void TearDown() override
+    {
+        event_bus_.stop();
+        ScratchPathTest::TearDown();
+    }
+
+    /** @brief Number of readings dispatched so far */
+    std::size_t receivedCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_.size();
+    }
+
+    EventBus event_bus_;                          ///< Recording bus
+    std::mutex mutex_;                            ///< Protects records_
+    std::vector<Event::SensorRecord> records_;    ///< Readings dispatched on event_bus_
+};
+
+} // namespace TestHelpers
+
+#endif // TESTS_TEST_HELPERS_H
@@ -0,0 +1,134 @@
+/**
+ * @file tests_clock.cpp
+ * @brief Unit tests for the Util::Clock timestamp source
+ * 
+ * Test suite covering:
+ * - Monotonic, nanosecond-resolution readings from nowNs()
+ * - Agreement with std::chrono::steady_clock across threads
+ * - Wall-clock conversion through the anchor and its inverse
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "Util/Clock.h"
+
+/**
+ * @class ClockTest
+ * @brief Test fixture for Clock tests
+ */
+class ClockTest : public ::testing::Test
+{
+protected:
+    /** @brief Returns steady_clock in nanoseconds for comparison */
+    static int64_t steadyNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /** @brief Returns system_clock in nanoseconds for comparison */
+    static int64_t systemNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+};
+
+TEST_F(ClockTest, NowIsNonDecreasing)
+{
+    int64_t previous = Util::Clock::nowNs();
+    for (int i = 0; i < 100000; ++i)
+    {
+        const int64_t now = Util::Clock::nowNs();
+        ASSERT_GE(now, previous);
+        previous = now;
+    }
+}
+
+TEST_F(ClockTest, HasSubMicrosecondResolution)
+{
+    // Within a tight loop at least some consecutive readings must differ by
+    // less than a microsecond, which a second- or millisecond-clock cannot do.
+    int fine_steps = 0;
+    int64_t previous = Util::Clock::nowNs();
+    for (int i = 0; i < 10000; ++i)
+    {
+        const int64_t now = Util::Clock::nowNs();
+        if (now > previous && now - previous < 1000)
+        {
+            fine_steps++;
+        }
+        previous = now;
+    }
+    EXPECT_GT(fine_steps, 0);
+}
+
+TEST_F(ClockTest, TracksSteadyClock)
+{
+    // Same time domain: each reading falls between two steady_clock reads,
+    // with a millisecond of slack for calibration error.
+    for (int i = 0; i < 5; ++i)
+    {
+        const int64_t steady_before = steadyNs();
+        const int64_t now = Util::Clock::nowNs();
+        const int64_t steady_after = steadyNs();
+
+        EXPECT_GE(now, steady_before - 1000000);
+        EXPECT_LE(now, steady_after + 1000000);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+TEST_F(ClockTest, ThreadsShareTimeDomain)
+{
+    std::vector<int64_t> readings(4);
+    std::vector<std::thread> threads;
+    const int64_t start = Util::Clock::nowNs();
+    for (std::size_t t = 0; t < readings.size(); ++t)
+    {
+        threads.emplace_back([&readings, t]() {
+            readings[t] = Util::Clock::nowNs();
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    const int64_t end = Util::Clock::nowNs();
+
+    for (int64_t reading : readings)
+    {
+        EXPECT_GE(reading, start - 1000000);
+        EXPECT_LE(reading, end + 1000000);
+    }
+}
+
+TEST_F(ClockTest, WallConversionMatchesSystemClock)
+{
+    const int64_t system_before = systemNs();
+    const int64_t wall = Util::Clock::wallNowNs();
+    const int64_t system_after = systemNs();
+
+    EXPECT_GE(wall, system_before - 1000000);
+    EXPECT_LE(wall, system_after + 1000000);
+}
+
+TEST_F(ClockTest, WallConversionRoundTrips)
+{
+    const int64_t mono = Util::Clock::nowNs();
+    EXPECT_EQ(Util::Clock::fromWallNs(Util::Clock::toWallNs(mono)), mono);
+
+    Util::Clock::resyncWallAnchor();
+    const int64_t system_before = systemNs();
+    const int64_t wall = Util::Clock::wallNowNs();
+    EXPECT_GE(wall, system_before - 1000000);
+    EXPECT_LE(wall, systemNs() + 1000000);
+}
+
+TEST_F(ClockTest, ReportsSource)
+{
+    const Util::ClockSource source = Util::Clock::source();
+    EXPECT_TRUE(source == Util::ClockSource::Tsc || source == Util::ClockSource::Steady);
+}
@@ -0,0 +1,265 @@
+/**
+ * @file tests_columnarQuery.cpp
+ * @brief Unit tests for Storage::ColumnarQuery
+ *
+ * Test suite covering:
+ * - Device and time-range selection, and block pruning through the index
+ * - Per-interval aggregates checked against a brute-force scan
+ * - Fault and value-range filters
+ * - Identical results on an inline and a thread-pool executor, and
+ *   concurrent queries
+ * - Queries issued from a task of their own (one-thread) pool
+ * - Picking up files finished after the first refresh()
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Storage/ColumnarQuery.h"
+#include "Storage/ColumnarSink.h"
+#include "EventBus/Executor.h"
+#include "Event/SensorEvent.h"
+#include "Util/Clock.h"
+#include "testHelpers.h"
+
+using TestHelpers::makeRecord;
+
+/**
+ * @class ColumnarQueryTest
+ * @brief Test fixture that fills a sink directory with three devices
+ *
+ * Reading i of a device is at kBase + i seconds with value i % 60 plus
+ * 1000 per device number; every 500th reading is a fault.
+ */
+class ColumnarQueryTest : public TestHelpers::ScratchPathTest
+{
+protected:
+    static constexpr int64_t kBase = 1767225600000000000LL;   ///< 2026-01-01T00:00:00Z
+    static constexpr int64_t kSecond = 1000000000LL;          ///< One second in nanoseconds
+    static constexpr uint64_t kRows = 3000;                   ///< Readings per device
+
+    /** @brief Names the sink directory "columnar_query_<test name>" */
+    ColumnarQueryTest() : ScratchPathTest("columnar_query_") {}
+
+    /** @brief Writes kRows readings, one per second, for three devices */
+    void SetUp() override
+    {
+        ScratchPathTest::SetUp();
+
+        Storage::ColumnarSink sink;
+        Storage::ColumnarSink::Options options;
+        options.rows_per_block = 256;
+        options.max_file_size = 16u << 10; // Several files
+        ASSERT_EQ(sink.open(path_, options), Event::Status::OK);
+        for (uint64_t i = 0; i < kRows; ++i)
+        {
+            Event::SensorRecord records[] = {
+                makeRecord(0, timeOf(i), valueOf(0, i), i, Event::SensorType::PressureSensor),
+                makeRecord(1, timeOf(i), valueOf(1, i), i, Event::SensorType::PressureSensor),
+                makeRecord(0, timeOf(i), valueOf(0, i), i, Event::SensorType::CoSensor),
+            };
+            for (Event::SensorRecord& record : records)
+            {
+                if (isFault(i)) {
+                    record.flags = Event::SensorRecord::kFaultFlag;
+                    record.value = 0.0;
+                }
+                sink.append(record);
+            }
+        }
+        ASSERT_EQ(sink.close(), Event::Status::OK);
+    }
+
+    /** @brief Wall-clock time of reading i */
+    static int64_t timeOf(uint64_t i)
+    {
+        return kBase + static_cast<int64_t>(i) * kSecond;
+    }
+
+    /** @brief Value of reading i of a device, unless it is a fault */
+    static double valueOf(uint32_t device, uint64_t i)
+    {
+        return static_cast<double>(i % 60) + 1000.0 * device;
+    }
+
+    /** @brief Whether reading i of every device is a fault */
+    static bool isFault(uint64_t i)
+    {
+        return i % 500 == 7;
+    }
+};
+
+TEST_F(ColumnarQueryTest, SelectsDeviceTimeRange)
+{
+    Storage::ColumnarQuery query(path_);
+    ASSERT_EQ(query.refresh(), Event::Status::OK);
+    EXPECT_GT(query.fileCount(), 1u);
+
+    Storage::ColumnarQuery::Filter filter;
+    filter.device = "PressureSensor_1";
+    filter.from_ns = kBase + 1000 * kSecond;
+    filter.to_ns = kBase + 1200 * kSecond;
+    filter.include_faults = true;
+    Storage::ColumnarQuery::QueryStats stats;
+    const auto records = query.select(filter, &stats);
+
+    ASSERT_EQ(records.size(), 200u);
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        EXPECT_EQ(Util::Clock::toWallNs(records[i].timestamp_ns), kBase + static_cast<int64_t>(1000 + i) * kSecond);
+        EXPECT_EQ(records[i].sequence, 1000 + i);
+        EXPECT_EQ(Event::deviceName(records[i].device_id), "PressureSensor_1");
+    }
+    EXPECT_TRUE(records[7].isFault());
+    EXPECT_EQ(stats.blocks, 3u * ((kRows + 255) / 256));
+    EXPECT_LE(stats.blocks_scanned, 2u); // 200 s fall into at most two 256-row blocks
+}
+
+TEST_F(ColumnarQueryTest, AggregatesPerMinute)
+{
+    Storage::ColumnarQuery query(path_);
+    ASSERT_EQ(query.refresh(), Event::Status::OK);
+
+    Storage::ColumnarQuery::Filter filter;
+    filter.type = Event::SensorType::PressureSensor;
+    filter.from_ns = kBase + 90 * kSecond;
+    const auto buckets = query.aggregate(filter, 60 * kSecond);
+
+    // Brute force over the same readings
+    std::map<int64_t, Storage::ColumnarQuery::Bucket> expected;
+    for (uint32_t device = 0; device < 2; ++device)
+    {
+        for (uint64_t i = 90; i < kRows; ++i)
+        {
+            if (isFault(i)) {
+                continue;
+            }
+            const double value = valueOf(device, i);
+            const int64_t start = kBase + static_cast<int64_t>(i / 60) * 60 * kSecond;
+            auto& bucket = expected[start];
+            bucket.min = bucket.count == 0 ? value : std::min(bucket.min, value);
+            bucket.max = bucket.count == 0 ? value : std::max(bucket.max, value);
+            bucket.sum += value;
+            bucket.count++;
+        }
+    }
+
+    ASSERT_EQ(buckets.size(), expected.size());
+    for (const auto& bucket : buckets)
+    {
+        const auto& reference = expected.at(bucket.start_ns);
+        EXPECT_EQ(bucket.count, reference.count);
+        EXPECT_EQ(bucket.min, reference.min);
+        EXPECT_EQ(bucket.max, reference.max);
+        EXPECT_DOUBLE_EQ(bucket.sum, reference.sum);
+    }
+    EXPECT_EQ(buckets.front().start_ns, kBase + 60 * kSecond);
+    EXPECT_EQ(buckets.front().count, 60u); // Seconds 90..119 of both devices
+    EXPECT_EQ(buckets.back().max, 1059.0);
+
+    EXPECT_TRUE(query.aggregate(filter, 0).empty());
+}
+
+TEST_F(ColumnarQueryTest, FiltersFaultsAndValues)
+{
+    Storage::ColumnarQuery query(path_);
+    ASSERT_EQ(query.refresh(), Event::Status::OK);
+
+    Storage::ColumnarQuery::Filter filter;
+    filter.device = "CoSensor_0";
+    EXPECT_EQ(query.select(filter).size(), kRows - kRows / 500);
+    filter.include_faults = true;
+    const auto with_faults = query.select(filter);
+    ASSERT_EQ(with_faults.size(), kRows);
+    EXPECT_TRUE(with_faults[7].isFault());
+
+    Storage::ColumnarQuery::Filter high;
+    high.min_value = 1000.0; // Only PressureSensor_1 reaches it
+    Storage::ColumnarQuery::QueryStats stats;
+    const auto records = query.select(high, &stats);
+    EXPECT_EQ(records.size(), kRows - kRows / 500);
+    EXPECT_EQ(stats.blocks_scanned, (kRows + 255) / 256);
+    for (const auto& record : records)
+    {
+        EXPECT_EQ(Event::deviceName(record.device_id), "PressureSensor_1");
+    }
+}
+
+TEST_F(ColumnarQueryTest, ParallelScanMatchesInlineScan)
+{
+    Storage::ColumnarQuery inline_query(path_, std::make_shared<InlineExecutor>());
+    Storage::ColumnarQuery pooled_query(path_, std::make_shared<ThreadPoolExecutor>(4));
+    ASSERT_EQ(inline_query.refresh(), Event::Status::OK);
+    ASSERT_EQ(pooled_query.refresh(), Event::Status::OK);
+
+    Storage::ColumnarQuery::Filter filter;
+    filter.from_ns = kBase + 100 * kSecond;
+    filter.to_ns = kBase + 2500 * kSecond;
+    const auto expected = inline_query.select(filter);
+    const auto expected_buckets = inline_query.aggregate(filter, 3600 * kSecond);
+    ASSERT_EQ(expected_buckets.size(), 1u);
+
+    std::vector<std::thread> clients;
+    for (int client = 0; client < 3; ++client)
+    {
+        clients.emplace_back([&]() {
+            const auto records = pooled_query.select(filter);
+            ASSERT_EQ(records.size(), expected.size());
+            for (std::size_t i = 0; i < records.size(); ++i)
+            {
+                EXPECT_EQ(records[i].timestamp_ns, expected[i].timestamp_ns);
+            }
+            const auto buckets = pooled_query.aggregate(filter, 3600 * kSecond);
+            ASSERT_EQ(buckets.size(), 1u);
+            EXPECT_EQ(buckets[0].count, expected_buckets[0].count);
+            EXPECT_DOUBLE_EQ(buckets[0].sum, expected_buckets[0].sum);
+        });
+    }
+    for (auto& client : clients)
+    {
+        client.join();
+    }
+}
+
+TEST_F(ColumnarQueryTest, QueryFromOwnPoolWorkerCompletes)
+{
+    // With one worker, a query waiting on that worker for its block scans
+    // would never finish unless it runs them itself
+    auto pool = std::make_shared<ThreadPoolExecutor>(1);
+    Storage::ColumnarQuery inline_query(path_, std::make_shared<InlineExecutor>());
+    Storage::ColumnarQuery pooled_query(path_, pool);
+    ASSERT_EQ(inline_query.refresh(), Event::Status::OK);
+    ASSERT_EQ(pooled_query.refresh(), Event::Status::OK);
+
+    Storage::ColumnarQuery::Filter filter;
+    const std::size_t expected = inline_query.select(filter).size();
+    std::size_t selected = 0;
+    pool->execute([&]() { selected = pooled_query.select(filter).size(); });
+    pool->drain();
+
+    EXPECT_EQ(selected, expected);
+}
+
+TEST_F(ColumnarQueryTest, RefreshPicksUpNewFiles)
+{
+    Storage::ColumnarQuery query(path_);
+    ASSERT_EQ(query.refresh(), Event::Status::OK);
+    const std::size_t files = query.fileCount();
+
+    Storage::ColumnarQuery::Filter filter;
+    filter.device = "TempSensor_9";
+    EXPECT_TRUE(query.select(filter).empty());
+
+    Storage::ColumnarSink sink;
+    ASSERT_EQ(sink.open(path_), Event::Status::OK);
+    sink.append(makeRecord(9, timeOf(1), valueOf(9, 1), 1, Event::SensorType::TempSensor));
+    ASSERT_EQ(sink.close(), Event::Status::OK);
+
+    EXPECT_TRUE(query.select(filter).empty());
+    ASSERT_EQ(query.refresh(), Event::Status::OK);
+    EXPECT_EQ(query.fileCount(), files + 1);
+    EXPECT_EQ(query.select(filter).size(), 1u);
+}
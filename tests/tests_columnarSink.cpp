@@ -0,0 +1,330 @@
+/**
+ * @file tests_columnarSink.cpp
+ * @brief Unit tests for Storage::ColumnarSink, Storage::ColumnarReader and the column codecs
+ *
+ * Test suite covering:
+ * - Delta-of-delta, Gorilla XOR and sparse flag codecs on edge cases
+ * - Round trip of readings through sink files, per device
+ * - Compression of regularly sampled series against 32-byte records
+ * - Block index ranges, file rotation and numbering across runs
+ * - Recording an EventBus, and rejecting damaged files
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Storage/ColumnarSink.h"
+#include "Storage/ColumnarReader.h"
+#include "Storage/ColumnarFormat.h"
+#include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+#include "Util/Clock.h"
+#include "testHelpers.h"
+
+using TestHelpers::makeRecord;
+
+/**
+ * @class ColumnarSinkTest
+ * @brief Test fixture giving each test an empty sink directory
+ */
+class ColumnarSinkTest : public TestHelpers::ScratchPathTest
+{
+protected:
+    /** @brief Names the sink directory "columnar_<test name>" */
+    ColumnarSinkTest() : ScratchPathTest("columnar_") {}
+
+    /**
+     * @brief Reads every reading of every finished file, grouped by device name
+     */
+    std::map<std::string, std::vector<Event::SensorRecord>> readAll()
+    {
+        std::map<std::string, std::vector<Event::SensorRecord>> devices;
+        for (const auto& path : Storage::ColumnarReader::listFiles(path_))
+        {
+            Storage::ColumnarReader reader;
+            EXPECT_EQ(reader.open(path), Event::Status::OK);
+            for (const auto& block : reader.blocks())
+            {
+                std::vector<Event::SensorRecord> records;
+                EXPECT_TRUE(reader.readRecords(block, records));
+                auto& series = devices[std::string(reader.deviceName(block))];
+                series.insert(series.end(), records.begin(), records.end());
+            }
+        }
+        return devices;
+    }
+
+    /**
+     * @brief Total size of the finished files
+     */
+    uint64_t totalFileSize()
+    {
+        uint64_t size = 0;
+        for (const auto& path : Storage::ColumnarReader::listFiles(path_))
+        {
+            size += std::filesystem::file_size(path);
+        }
+        return size;
+    }
+
+    static constexpr int64_t kBase = 1767225600000000000LL;                  ///< 2026-01-01T00:00:00Z
+    static constexpr Event::SensorType kType = Event::SensorType::CoSensor;  ///< Type of every test reading
+};
+
+TEST_F(ColumnarSinkTest, CodecsRoundTripEdgeCases)
+{
+    using namespace Storage::ColumnarFormat;
+    const std::vector<int64_t> integers = {
+        0, 1, 2, 3, 1000, -5, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(),
+        42, 42, 42, 1LL << 40, (1LL << 40) + 64, (1LL << 40) + 128, -1};
+    std::vector<uint8_t> bytes;
+    encodeDeltaOfDelta(integers.data(), integers.size(), bytes);
+    std::vector<int64_t> decoded_integers;
+    ASSERT_TRUE(decodeDeltaOfDelta(bytes.data(), bytes.size(), integers.size(), decoded_integers));
+    EXPECT_EQ(decoded_integers, integers);
+    EXPECT_FALSE(decodeDeltaOfDelta(bytes.data(), bytes.size() / 2, integers.size(), decoded_integers));
+
+    std::vector<double> values = {0.0, -0.0, 1.5, 1.5, 1.75, -1e300, std::numeric_limits<double>::infinity(),
+                                  std::numeric_limits<double>::quiet_NaN(), 3.0, 3.0000000001, 1e-310};
+    std::mt19937_64 random(7);
+    std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+    for (int i = 0; i < 200; ++i)
+    {
+        values.push_back(distribution(random));
+    }
+    bytes.clear();
+    encodeValues(values.data(), values.size(), bytes);
+    std::vector<double> decoded_values;
+    ASSERT_TRUE(decodeValues(bytes.data(), bytes.size(), values.size(), decoded_values));
+    ASSERT_EQ(decoded_values.size(), values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_EQ(std::memcmp(&decoded_values[i], &values[i], sizeof(double)), 0) << "value " << i;
+    }
+
+    std::vector<uint8_t> flags(300, 0);
+    flags[0] = 1;
+    flags[129] = 3;
+    flags[299] = 1;
+    bytes.clear();
+    encodeFlags(flags.data(), flags.size(), bytes);
+    std::vector<uint8_t> decoded_flags;
+    ASSERT_TRUE(decodeFlags(bytes.data(), bytes.size(), flags.size(), decoded_flags));
+    EXPECT_EQ(decoded_flags, flags);
+    bytes.clear();
+    encodeFlags(decoded_flags.data(), 0, bytes);
+    EXPECT_TRUE(bytes.empty());
+}
+
+TEST_F(ColumnarSinkTest, RoundTripsReadingsPerDevice)
+{
+    Storage::ColumnarSink sink;
+    Storage::ColumnarSink::Options options;
+    options.rows_per_block = 500;
+    ASSERT_EQ(sink.open(path_, options), Event::Status::OK);
+
+    std::mt19937_64 random(11);
+    std::uniform_int_distribution<int64_t> jitter(-2000000, 2000000);
+    std::uniform_real_distribution<double> noise(-0.5, 0.5);
+    std::map<std::string, std::vector<Event::SensorRecord>> expected;
+    for (uint64_t i = 0; i < 1300; ++i)
+    {
+        for (uint32_t device = 0; device < 3; ++device)
+        {
+            Event::SensorRecord record = makeRecord(device, kBase + static_cast<int64_t>(i) * 1000000000LL + jitter(random),
+                                                    100.0 * device + noise(random), i, kType);
+            if (i % 97 == 0) {
+                record.flags = Event::SensorRecord::kFaultFlag;
+                record.value = 0.0;
+            }
+            ASSERT_EQ(sink.append(record), Event::Status::OK);
+            expected[std::string(Event::deviceName(record.device_id))].push_back(record);
+        }
+    }
+    EXPECT_EQ(sink.getStats().blocks, 6u);  // Two full blocks per device so far
+    EXPECT_EQ(sink.getStats().buffered_rows, 900u);
+    ASSERT_EQ(sink.close(), Event::Status::OK);
+    EXPECT_EQ(sink.getStats().rows, 3900u);
+    EXPECT_EQ(sink.getStats().files, 1u);
+
+    const auto actual = readAll();
+    ASSERT_EQ(actual.size(), 3u);
+    for (const auto& device : expected)
+    {
+        const auto& records = actual.at(device.first);
+        ASSERT_EQ(records.size(), device.second.size());
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            EXPECT_EQ(Util::Clock::toWallNs(records[i].timestamp_ns), Util::Clock::toWallNs(device.second[i].timestamp_ns));
+            EXPECT_EQ(records[i].value, device.second[i].value);
+            EXPECT_EQ(records[i].sequence, device.second[i].sequence);
+            EXPECT_EQ(records[i].flags, device.second[i].flags);
+            EXPECT_EQ(records[i].type, Event::SensorType::CoSensor);
+            EXPECT_EQ(Event::deviceName(records[i].device_id), device.first);
+        }
+    }
+}
+
+TEST_F(ColumnarSinkTest, CompressesRegularSeriesTenfold)
+{
+    Storage::ColumnarSink sink;
+    ASSERT_EQ(sink.open(path_), Event::Status::OK);
+
+    // One reading per second per device; values step slowly like a real sensor
+    const uint64_t rows_per_device = 10000;
+    for (uint64_t i = 0; i < rows_per_device; ++i)
+    {
+        for (uint32_t device = 0; device < 4; ++device)
+        {
+            const double value = 20.0 + 0.25 * static_cast<double>((i / 16 + device) % 12);
+            sink.append(makeRecord(device, kBase + static_cast<int64_t>(i) * 1000000000LL, value, i, kType));
+        }
+    }
+    ASSERT_EQ(sink.close(), Event::Status::OK);
+
+    const uint64_t raw_size = 4 * rows_per_device * sizeof(Event::SensorRecord);
+    const uint64_t file_size = totalFileSize();
+    ASSERT_GT(file_size, 0u);
+    EXPECT_GE(raw_size / file_size, 10u) << "raw " << raw_size << " bytes, columnar " << file_size << " bytes";
+    EXPECT_EQ(readAll().at("CoSensor_2").size(), rows_per_device);
+}
+
+TEST_F(ColumnarSinkTest, BlockIndexCarriesRanges)
+{
+    Storage::ColumnarSink sink;
+    Storage::ColumnarSink::Options options;
+    options.rows_per_block = 100;
+    ASSERT_EQ(sink.open(path_, options), Event::Status::OK);
+    for (uint64_t i = 0; i < 250; ++i)
+    {
+        Event::SensorRecord record = makeRecord(5, kBase + static_cast<int64_t>(i) * 1000, static_cast<double>(i), i, kType);
+        record.flags = (i == 120) ? Event::SensorRecord::kFaultFlag : 0;
+        sink.append(record);
+    }
+    sink.append(makeRecord(6, kBase, std::numeric_limits<double>::quiet_NaN(), 0, kType));
+    ASSERT_EQ(sink.close(), Event::Status::OK);
+
+    const auto files = Storage::ColumnarReader::listFiles(path_);
+    ASSERT_EQ(files.size(), 1u);
+    Storage::ColumnarReader reader;
+    ASSERT_EQ(reader.open(files[0]), Event::Status::OK);
+    std::vector<Storage::ColumnarFormat::BlockInfo> device_blocks;
+    for (const auto& block : reader.blocks())
+    {
+        if (reader.deviceName(block) == "CoSensor_5") {
+            device_blocks.push_back(block);
+        } else {
+            EXPECT_EQ(reader.deviceName(block), "CoSensor_6");
+            EXPECT_TRUE(std::isnan(block.min_value));
+        }
+    }
+    ASSERT_EQ(device_blocks.size(), 3u);
+    EXPECT_EQ(device_blocks[0].rows, 100u);
+    EXPECT_EQ(device_blocks[1].min_timestamp_ns, kBase + 100000);
+    EXPECT_EQ(device_blocks[1].max_timestamp_ns, kBase + 199000);
+    EXPECT_EQ(device_blocks[1].min_value, 100.0);
+    EXPECT_EQ(device_blocks[1].max_value, 199.0);
+    EXPECT_EQ(device_blocks[1].fault_rows, 1u);
+    EXPECT_EQ(device_blocks[2].rows, 50u);
+
+    std::vector<double> values;
+    ASSERT_TRUE(reader.readValues(device_blocks[2], values));
+    EXPECT_EQ(values.front(), 200.0);
+    EXPECT_EQ(values.back(), 249.0);
+}
+
+TEST_F(ColumnarSinkTest, RotatesFilesAndContinuesNumbering)
+{
+    Storage::ColumnarSink::Options options;
+    options.rows_per_block = 64;
+    options.max_file_size = 1; // Every block finishes its file
+    {
+        Storage::ColumnarSink sink;
+        ASSERT_EQ(sink.open(path_, options), Event::Status::OK);
+        for (uint64_t i = 0; i < 64 * 3; ++i)
+        {
+            sink.append(makeRecord(1, kBase + static_cast<int64_t>(i), 1.0, i, kType));
+        }
+        EXPECT_EQ(sink.getStats().files, 3u);
+        EXPECT_EQ(Storage::ColumnarReader::listFiles(path_).size(), 3u);
+    }
+
+    Storage::ColumnarSink sink;
+    ASSERT_EQ(sink.open(path_, options), Event::Status::OK);
+    sink.append(makeRecord(1, kBase, 1.0, 0, kType));
+    ASSERT_EQ(sink.flush(), Event::Status::OK);
+    EXPECT_EQ(Storage::ColumnarReader::listFiles(path_).size(), 4u);
+    EXPECT_TRUE(std::filesystem::exists(path_ + "/" + Storage::ColumnarFormat::fileName(3, ".col")));
+
+    options.max_file_size = 1u << 20;
+    Storage::ColumnarSink unfinished;
+    ASSERT_EQ(unfinished.open(path_ + "_unfinished", options), Event::Status::OK);
+    unfinished.append(makeRecord(1, kBase, 1.0, 0, kType));
+    unfinished.flush();
+    EXPECT_TRUE(Storage::ColumnarReader::listFiles(path_ + "_unfinished").empty()); // Still a .part file
+    unfinished.close();
+    EXPECT_EQ(Storage::ColumnarReader::listFiles(path_ + "_unfinished").size(), 1u);
+    std::filesystem::remove_all(path_ + "_unfinished");
+}
+
+TEST_F(ColumnarSinkTest, RecordsEventBusTraffic)
+{
+    Storage::ColumnarSink sink;
+    ASSERT_EQ(sink.open(path_), Event::Status::OK);
+    {
+        EventBus event_bus;
+        sink.attach(event_bus, std::make_shared<DedicatedExecutor>());
+        event_bus.start();
+        for (uint64_t i = 0; i < 1000; ++i)
+        {
+            event_bus.publish(std::make_unique<Event::SensorEvent>(
+                makeRecord(static_cast<uint32_t>(i % 2), kBase + static_cast<int64_t>(i) * 1000, 1.0, i / 2, kType)));
+        }
+        event_bus.stop();
+    }
+    ASSERT_EQ(sink.close(), Event::Status::OK);
+    EXPECT_FALSE(sink.isOpen());
+
+    const auto devices = readAll();
+    ASSERT_EQ(devices.size(), 2u);
+    EXPECT_EQ(devices.at("CoSensor_0").size(), 500u);
+    EXPECT_EQ(devices.at("CoSensor_1").back().sequence, 499u);
+}
+
+TEST_F(ColumnarSinkTest, RejectsDamagedFile)
+{
+    Storage::ColumnarSink sink;
+    ASSERT_EQ(sink.open(path_), Event::Status::OK);
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+        sink.append(makeRecord(1, kBase + static_cast<int64_t>(i), 2.0, i, kType));
+    }
+    ASSERT_EQ(sink.close(), Event::Status::OK);
+    const std::string path = Storage::ColumnarReader::listFiles(path_).at(0);
+
+    Storage::ColumnarReader reader;
+    ASSERT_EQ(reader.open(path), Event::Status::OK);
+    reader.close();
+
+    const auto size = std::filesystem::file_size(path);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(size - sizeof(Storage::ColumnarFormat::Trailer) - 4));
+        file.put('\x7f'); // Inside the block index
+    }
+    EXPECT_EQ(reader.open(path), Event::Status::ERROR);
+    EXPECT_TRUE(reader.blocks().empty());
+
+    std::filesystem::resize_file(path, size / 2);
+    EXPECT_EQ(reader.open(path), Event::Status::ERROR);
+    EXPECT_EQ(reader.open(path_ + "/missing.col"), Event::Status::ERROR);
+}
@@ -10,6 +10,11 @@
  * - Error handling: stop without start, multiple starts/stops
  * - Queue management: event ordering, queue draining on stop
  * - Concurrency: multiple threads publishing simultaneously
+ * - Batch subscriptions: ordering, size and latency knobs, stop flush
+ * - Executor subscriptions: isolation, shared events, per-subscription order
+ * - Slow-handler watchdog: per-subscription timings and automatic isolation
+ * - Deadline-bounded stop: drop, persist and callback leftover policies,
+ *   including a throwing callback
  * 
  * Tests use atomic counters for thread-safe verification and include
  * timing controls to ensure proper async behavior.
@@ -20,6 +25,11 @@
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <stdexcept>
 #include "EventBus/EventBus.h"
 #include "Event/SensorEvent.h"
 
@@ -329,3 +339,567 @@ TEST_F(EventBusTest, DestructorStopsEventBus)
     
     EXPECT_TRUE(handler_called.load());
 }
+
+TEST_F(EventBusTest, StatsCountPublishedAndDispatched)
+{
+    event_bus_->subscribe([](const Event::Event&) {});
+    event_bus_->start();
+
+    event_bus_->publish(std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor));
+    std::vector<std::unique_ptr<Event::Event>> batch;
+    for (int i = 0; i < 9; ++i)
+    {
+        batch.emplace_back(std::make_unique<Event::SensorEvent>(Event::SensorType::TempSensor));
+    }
+    event_bus_->publishBatch(std::move(batch));
+    event_bus_->stop();
+
+    const EventBus::Stats stats = event_bus_->getStats();
+    EXPECT_EQ(stats.published, 10u);
+    EXPECT_EQ(stats.dispatched, 10u);
+    EXPECT_GE(stats.total_queue_latency_ns, 0);
+    EXPECT_GE(stats.max_queue_latency_ns, 0);
+    EXPECT_LE(stats.max_queue_latency_ns, stats.total_queue_latency_ns);
+}
+
+TEST_F(EventBusTest, StatsMeasureQueueLatency)
+{
+    event_bus_->subscribe([](const Event::Event&) {});
+
+    // Published before start: the event waits in the queue at least 20 ms
+    event_bus_->publish(std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    event_bus_->start();
+    event_bus_->stop();
+
+    const EventBus::Stats stats = event_bus_->getStats();
+    EXPECT_EQ(stats.dispatched, 1u);
+    EXPECT_GE(stats.max_queue_latency_ns, 20000000);
+}
+
+TEST_F(EventBusTest, BatchHandlerReceivesAllEventsInOrder)
+{
+    std::vector<uint64_t> sequences;
+    event_bus_->subscribeBatch([&sequences](const EventBatch& batch) {
+        for (const Event::Event& event : batch)
+        {
+            sequences.push_back(Event::event_cast<Event::SensorEvent>(event)->getRecord().sequence);
+        }
+    });
+
+    std::vector<std::unique_ptr<Event::Event>> events;
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        Event::SensorRecord record{};
+        record.sequence = i;
+        events.emplace_back(std::make_unique<Event::SensorEvent>(record));
+    }
+    event_bus_->publishBatch(std::move(events));
+    event_bus_->start();
+    event_bus_->stop();
+
+    ASSERT_EQ(sequences.size(), 1000u);
+    for (uint64_t i = 0; i < sequences.size(); ++i)
+    {
+        EXPECT_EQ(sequences[i], i);
+    }
+}
+
+TEST_F(EventBusTest, BatchSizeIsBounded)
+{
+    event_bus_->setBatchOptions(EventBus::BatchOptions{64, std::chrono::microseconds(0)});
+    std::vector<std::size_t> sizes;
+    event_bus_->subscribeBatch([&sizes](const EventBatch& batch) {
+        sizes.push_back(batch.size());
+    });
+
+    std::vector<std::unique_ptr<Event::Event>> events;
+    for (int i = 0; i < 200; ++i)
+    {
+        events.emplace_back(std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor));
+    }
+    event_bus_->publishBatch(std::move(events));
+    event_bus_->start();
+    event_bus_->stop();
+
+    // Queued before start, so the worker drains full batches
+    ASSERT_EQ(sizes.size(), 4u);
+    EXPECT_EQ(sizes[0], 64u);
+    EXPECT_EQ(sizes[3], 8u);
+    EXPECT_EQ(event_bus_->getStats().batches, 4u);
+}
+
+TEST_F(EventBusTest, LatencyKnobGroupsEvents)
+{
+    event_bus_->setBatchOptions(EventBus::BatchOptions{1000, std::chrono::milliseconds(200)});
+    std::atomic<int> batches{0};
+    std::atomic<int> events{0};
+    event_bus_->subscribeBatch([&batches, &events](const EventBatch& batch) {
+        batches++;
+        events += static_cast<int>(batch.size());
+    });
+    event_bus_->start();
+
+    for (int i = 0; i < 10; ++i)
+    {
+        event_bus_->publish(std::make_unique<Event::SensorEvent>(Event::SensorType::TempSensor));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(batches.load(), 0); // Still waiting for the batch to fill
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    EXPECT_EQ(batches.load(), 1);
+    EXPECT_EQ(events.load(), 10);
+}
+
+TEST_F(EventBusTest, StopFlushesPendingBatch)
+{
+    event_bus_->setBatchOptions(EventBus::BatchOptions{1000, std::chrono::seconds(10)});
+    std::atomic<int> events{0};
+    event_bus_->subscribeBatch([&events](const EventBatch& batch) {
+        events += static_cast<int>(batch.size());
+    });
+    event_bus_->start();
+
+    for (int i = 0; i < 5; ++i)
+    {
+        event_bus_->publish(std::make_unique<Event::SensorEvent>(Event::SensorType::PressureSensor));
+    }
+    event_bus_->stop();
+
+    EXPECT_EQ(events.load(), 5);
+}
+
+TEST_F(EventBusTest, EventAndBatchHandlersBothRun)
+{
+    int per_event = 0;
+    int batched = 0;
+    std::vector<std::string> calls;
+    event_bus_->subscribe([&per_event, &calls](const Event::Event&) {
+        per_event++;
+        calls.push_back("event");
+    });
+    event_bus_->subscribeBatch([&batched, &calls](const EventBatch& batch) {
+        batched += static_cast<int>(batch.size());
+        calls.push_back("batch");
+    });
+
+    std::vector<std::unique_ptr<Event::Event>> events;
+    events.emplace_back(std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor));
+    events.emplace_back(std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor));
+    event_bus_->publishBatch(std::move(events));
+    event_bus_->start();
+    event_bus_->stop();
+
+    EXPECT_EQ(per_event, 2);
+    EXPECT_EQ(batched, 2);
+    EXPECT_EQ(calls, (std::vector<std::string>{"event", "event", "batch"}));
+}
+
+TEST_F(EventBusTest, BatchOptionsAreClamped)
+{
+    EventBus bus(EventBus::BatchOptions{0, std::chrono::microseconds(-5)});
+    const EventBus::BatchOptions options = bus.getBatchOptions();
+
+    EXPECT_EQ(options.max_batch_size, 1u);
+    EXPECT_EQ(options.max_latency.count(), 0);
+}
+
+TEST_F(EventBusTest, SubscriptionIdsAreUnique)
+{
+    const EventBus::SubscriptionId first = event_bus_->subscribe([](const Event::Event&) {});
+    const EventBus::SubscriptionId second = event_bus_->subscribeBatch([](const EventBatch&) {});
+    const EventBus::SubscriptionId third =
+        event_bus_->subscribe([](const Event::Event&) {}, std::make_shared<DedicatedExecutor>());
+
+    EXPECT_NE(first, second);
+    EXPECT_NE(second, third);
+    EXPECT_NE(first, third);
+}
+
+TEST_F(EventBusTest, SlowExecutorHandlerDoesNotDelayInlineHandler)
+{
+    std::atomic<int> fast_count{0};
+    std::atomic<int> slow_count{0};
+    std::atomic<bool> release{false};
+
+    event_bus_->subscribe([&fast_count](const Event::Event&) { fast_count++; });
+    event_bus_->subscribe([&slow_count, &release](const Event::Event&) {
+        while (!release.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        slow_count++;
+    }, std::make_shared<DedicatedExecutor>());
+
+    event_bus_->start();
+    for (int i = 0; i < 20; ++i)
+    {
+        event_bus_->publish(std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor));
+    }
+
+    // The inline handler keeps up while the executor handler is blocked
+    for (int i = 0; i < 200 && fast_count.load() < 20; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(fast_count.load(), 20);
+    EXPECT_EQ(slow_count.load(), 0);
+
+    release = true;
+    event_bus_->stop();
+    EXPECT_EQ(slow_count.load(), 20); // stop() waits for executor deliveries
+}
+
+TEST_F(EventBusTest, ExecutorsShareEventsWithoutCopying)
+{
+    std::mutex mutex;
+    std::vector<const Event::Event*> seen_a;
+    std::vector<const Event::Event*> seen_b;
+
+    event_bus_->subscribe([&mutex, &seen_a](const Event::Event& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        seen_a.push_back(&event);
+    }, std::make_shared<DedicatedExecutor>());
+    event_bus_->subscribeBatch([&mutex, &seen_b](const EventBatch& batch) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const Event::Event& event : batch)
+        {
+            seen_b.push_back(&event);
+        }
+    }, std::make_shared<DedicatedExecutor>());
+
+    std::vector<std::unique_ptr<Event::Event>> events;
+    for (int i = 0; i < 10; ++i)
+    {
+        events.emplace_back(std::make_unique<Event::SensorEvent>(Event::SensorType::TempSensor));
+    }
+    event_bus_->publishBatch(std::move(events));
+    event_bus_->start();
+    event_bus_->stop();
+
+    ASSERT_EQ(seen_a.size(), 10u);
+    EXPECT_EQ(seen_a, seen_b);
+}
+
+TEST_F(EventBusTest, PoolSubscriptionsKeepPublishOrder)
+{
+    auto pool = std::make_shared<ThreadPoolExecutor>(3);
+    std::vector<uint64_t> order_a;
+    std::vector<uint64_t> order_b;
+
+    event_bus_->setBatchOptions(EventBus::BatchOptions{16, std::chrono::microseconds(0)});
+    event_bus_->subscribe([&order_a](const Event::Event& event) {
+        order_a.push_back(Event::event_cast<Event::SensorEvent>(event)->getRecord().sequence);
+    }, pool);
+    event_bus_->subscribe([&order_b](const Event::Event& event) {
+        order_b.push_back(Event::event_cast<Event::SensorEvent>(event)->getRecord().sequence);
+    }, pool);
+
+    event_bus_->start();
+    for (uint64_t i = 0; i < 500; ++i)
+    {
+        Event::SensorRecord record{};
+        record.sequence = i;
+        event_bus_->publish(std::make_unique<Event::SensorEvent>(record));
+    }
+    event_bus_->stop();
+
+    ASSERT_EQ(order_a.size(), 500u);
+    ASSERT_EQ(order_b.size(), 500u);
+    for (uint64_t i = 0; i < 500; ++i)
+    {
+        EXPECT_EQ(order_a[i], i);
+        EXPECT_EQ(order_b[i], i);
+    }
+}
+
+TEST_F(EventBusTest, SlowPoolSubscriptionStallsDispatch)
+{
+    constexpr int kEvents = 3000;
+    auto pool = std::make_shared<ThreadPoolExecutor>(2);
+    std::atomic<bool> release{false};
+    std::atomic<int> count{0};
+
+    event_bus_->setBatchOptions(EventBus::BatchOptions{1, std::chrono::microseconds(0)});
+    event_bus_->subscribe([&release, &count](const Event::Event&) {
+        while (!release.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        count++;
+    }, pool);
+
+    std::vector<std::unique_ptr<Event::Event>> events;
+    for (int i = 0; i < kEvents; ++i)
+    {
+        events.emplace_back(std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor));
+    }
+    event_bus_->publishBatch(std::move(events));
+    event_bus_->start();
+
+    // The subscription's strand fills up and the dispatcher waits for it
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const EventBus::Stats stats = event_bus_->getStats();
+    EXPECT_LE(stats.dispatched, SerialExecutor::kDefaultCapacity + 2);
+    EXPECT_LT(stats.dispatched, static_cast<uint64_t>(kEvents));
+
+    release = true;
+    event_bus_->stop();
+    EXPECT_EQ(count.load(), kEvents);
+}
+
+TEST_F(EventBusTest, WatchdogIsOffByDefault)
+{
+    event_bus_->subscribe([](const Event::Event&) {});
+    event_bus_->start();
+    event_bus_->publish(std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor));
+    event_bus_->stop();
+
+    auto stats = event_bus_->getSubscriptionStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].calls, 0u);
+    EXPECT_EQ(event_bus_->getStats().over_budget_calls, 0u);
+}
+
+TEST_F(EventBusTest, WatchdogReportsSlowHandlers)
+{
+    event_bus_->setWatchdogOptions(EventBus::WatchdogOptions{std::chrono::microseconds(1000), 0});
+    auto fast = event_bus_->subscribe([](const Event::Event&) {});
+    auto slow = event_bus_->subscribeBatch([](const EventBatch&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    });
+
+    event_bus_->start();
+    for (int i = 0; i < 3; ++i)
+    {
+        event_bus_->publish(std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // One batch per event
+    }
+    event_bus_->stop();
+
+    auto stats = event_bus_->getSubscriptionStats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].id, fast);
+    EXPECT_EQ(stats[0].calls, 3u);
+    EXPECT_FALSE(stats[0].batch);
+    EXPECT_EQ(stats[1].id, slow);
+    EXPECT_TRUE(stats[1].batch);
+    EXPECT_EQ(stats[1].calls, 3u);
+    EXPECT_EQ(stats[1].over_budget_calls, 3u);
+    EXPECT_GE(stats[1].max_ns, 3000000);
+    EXPECT_GE(stats[1].total_ns, 9000000);
+    EXPECT_FALSE(stats[1].isolated);
+    EXPECT_EQ(event_bus_->getStats().over_budget_calls, stats[0].over_budget_calls + 3u);
+}
+
+TEST_F(EventBusTest, WatchdogIsolatesChronicallySlowHandler)
+{
+    event_bus_->setWatchdogOptions(EventBus::WatchdogOptions{std::chrono::microseconds(1000), 2});
+    std::vector<uint64_t> slow_order;
+    std::atomic<int> fast_count{0};
+    std::thread::id worker_id;
+    std::thread::id slow_id;
+
+    event_bus_->subscribe([&fast_count, &worker_id](const Event::Event&) {
+        worker_id = std::this_thread::get_id();
+        fast_count++;
+    });
+    auto slow = event_bus_->subscribe([&slow_order, &slow_id](const Event::Event& event) {
+        slow_id = std::this_thread::get_id();
+        slow_order.push_back(Event::event_cast<Event::SensorEvent>(event)->getRecord().sequence);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+
+    event_bus_->start();
+    for (uint64_t i = 0; i < 6; ++i)
+    {
+        Event::SensorRecord record{};
+        record.sequence = i;
+        event_bus_->publish(std::make_unique<Event::SensorEvent>(record));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5)); // One batch per event
+    }
+    event_bus_->stop();
+
+    EXPECT_EQ(fast_count, 6);
+    ASSERT_EQ(slow_order.size(), 6u);
+    for (uint64_t i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(slow_order[i], i);
+    }
+    EXPECT_NE(slow_id, worker_id); // Last events ran on the isolated executor
+
+    auto stats = event_bus_->getSubscriptionStats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[1].id, slow);
+    EXPECT_TRUE(stats[1].isolated);
+    EXPECT_TRUE(stats[1].on_executor);
+    EXPECT_FALSE(stats[0].isolated);
+    EXPECT_EQ(stats[1].calls, 6u);
+    EXPECT_EQ(event_bus_->getStats().isolated_subscriptions, 1u);
+}
+
+TEST_F(EventBusTest, WatchdogOptionsAreClamped)
+{
+    event_bus_->setWatchdogOptions(EventBus::WatchdogOptions{std::chrono::microseconds(-5), 3, 0});
+    auto options = event_bus_->getWatchdogOptions();
+
+    EXPECT_EQ(options.handler_budget.count(), 0);
+    EXPECT_EQ(options.isolate_after, 3u);
+    EXPECT_EQ(options.isolation_queue_capacity, 1u);
+}
+
+TEST_F(EventBusTest, DeadlineStopWithoutBacklogDispatchesEverything)
+{
+    std::atomic<int> count{0};
+    event_bus_->subscribe([&count](const Event::Event&) { count++; });
+
+    event_bus_->start();
+    for (int i = 0; i < 20; ++i)
+    {
+        event_bus_->publish(std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor));
+    }
+    auto report = event_bus_->stop(std::chrono::steady_clock::now() + std::chrono::seconds(10),
+                                   EventBus::ShutdownOptions{});
+
+    EXPECT_EQ(count, 20);
+    EXPECT_EQ(report.leftover, 0u);
+    EXPECT_FALSE(report.deadline_hit);
+    EXPECT_LE(report.dispatched, 20u);
+}
+
+TEST_F(EventBusTest, DeadlineStopHandsLeftoversToCallback)
+{
+    std::atomic<int> count{0};
+    event_bus_->setBatchOptions(EventBus::BatchOptions{1, std::chrono::microseconds(0)});
+    event_bus_->subscribe([&count](const Event::Event&) {
+        count++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+
+    for (uint64_t i = 0; i < 200; ++i)
+    {
+        Event::SensorRecord record{};
+        record.sequence = i;
+        event_bus_->publish(std::make_unique<Event::SensorEvent>(record));
+    }
+
+    std::vector<uint64_t> leftover_sequences;
+    EventBus::ShutdownOptions options;
+    options.leftovers = EventBus::LeftoverPolicy::Callback;
+    options.on_leftovers = [&leftover_sequences](std::vector<std::unique_ptr<Event::Event>> events) {
+        for (const auto& event : events)
+        {
+            leftover_sequences.push_back(Event::event_cast<Event::SensorEvent>(*event)->getRecord().sequence);
+        }
+    };
+
+    event_bus_->start();
+    const auto started = std::chrono::steady_clock::now();
+    auto report = event_bus_->stop(started + std::chrono::milliseconds(20), options);
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_TRUE(report.deadline_hit);
+    EXPECT_GT(report.leftover, 0u);
+    EXPECT_EQ(report.dispatched + report.leftover, 200u);
+    EXPECT_EQ(static_cast<uint64_t>(count.load()), report.dispatched);
+    EXPECT_LT(elapsed, std::chrono::milliseconds(200));
+    ASSERT_EQ(leftover_sequences.size(), report.leftover);
+    for (std::size_t i = 0; i < leftover_sequences.size(); ++i)
+    {
+        EXPECT_EQ(leftover_sequences[i], report.dispatched + i);
+    }
+}
+
+TEST_F(EventBusTest, DeadlineStopSurvivesThrowingLeftoverCallback)
+{
+    event_bus_->setBatchOptions(EventBus::BatchOptions{1, std::chrono::microseconds(0)});
+    event_bus_->subscribe([](const Event::Event&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+
+    for (uint64_t i = 0; i < 200; ++i)
+    {
+        Event::SensorRecord record{};
+        record.sequence = i;
+        event_bus_->publish(std::make_unique<Event::SensorEvent>(record));
+    }
+
+    std::size_t handed = 0;
+    EventBus::ShutdownOptions options;
+    options.leftovers = EventBus::LeftoverPolicy::Callback;
+    options.on_leftovers = [&handed](std::vector<std::unique_ptr<Event::Event>> events) {
+        handed = events.size();
+        throw std::runtime_error("leftover sink unavailable");
+    };
+
+    event_bus_->start();
+    auto report = event_bus_->stop(std::chrono::steady_clock::now() + std::chrono::milliseconds(20), options);
+
+    EXPECT_TRUE(report.deadline_hit);
+    EXPECT_GT(report.leftover, 0u);
+    EXPECT_EQ(handed, report.leftover);
+}
+
+TEST_F(EventBusTest, DeadlineStopPersistsLeftovers)
+{
+    const std::string path = ::testing::TempDir() + "eventbus_leftovers.bin";
+    std::remove(path.c_str());
+
+    Event::SensorRecord record{};
+    record.timestamp_ns = Util::Clock::fromWallNs(1767225600123456789LL);
+    record.value = 21.5;
+    record.device_id = Event::internDeviceId(Event::SensorType::TempSensor, 7);
+    record.type = Event::SensorType::TempSensor;
+    for (int i = 0; i < 3; ++i)
+    {
+        record.sequence = i;
+        event_bus_->publish(std::make_unique<Event::SensorEvent>(record));
+    }
+
+    EventBus::ShutdownOptions options;
+    options.leftovers = EventBus::LeftoverPolicy::Persist;
+    options.persist_path = path;
+
+    // One event per pass; the worker may take the first before stop() runs
+    event_bus_->setBatchOptions(EventBus::BatchOptions{1, std::chrono::microseconds(0)});
+    event_bus_->subscribe([](const Event::Event&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    });
+    event_bus_->start();
+    auto report = event_bus_->stop(std::chrono::steady_clock::now() - std::chrono::seconds(1), options);
+
+    EXPECT_LE(report.dispatched, 1u);
+    EXPECT_EQ(report.dispatched + report.leftover, 3u);
+    EXPECT_EQ(report.persisted, report.leftover);
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    for (uint64_t i = report.dispatched; i < 3; ++i)
+    {
+        Event::SensorRecord stored{};
+        uint16_t name_length = 0;
+        char name[32] = {};
+        ASSERT_EQ(std::fread(&stored, sizeof(stored), 1, file), 1u);
+        ASSERT_EQ(std::fread(&name_length, sizeof(name_length), 1, file), 1u);
+        ASSERT_LT(name_length, sizeof(name));
+        ASSERT_EQ(std::fread(name, 1, name_length, file), name_length);
+
+        EXPECT_EQ(stored.timestamp_ns, 1767225600123456789LL);
+        EXPECT_EQ(stored.sequence, i);
+        EXPECT_EQ(stored.value, 21.5);
+        EXPECT_STREQ(name, "TempSensor_7");
+    }
+    EXPECT_EQ(std::fgetc(file), EOF);
+    std::fclose(file);
+    std::remove(path.c_str());
+}
+
+TEST_F(EventBusTest, DeadlineStopWithoutStartReportsNothing)
+{
+    auto report = event_bus_->stop(std::chrono::steady_clock::now(), EventBus::ShutdownOptions{});
+
+    EXPECT_EQ(report.dispatched, 0u);
+    EXPECT_EQ(report.leftover, 0u);
+    EXPECT_FALSE(report.deadline_hit);
+}
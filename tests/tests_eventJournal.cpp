@@ -0,0 +1,345 @@
+/**
+ * @file tests_eventJournal.cpp
+ * @brief Unit tests for Storage::EventJournal and Storage::JournalReader
+ *
+ * Test suite covering:
+ * - Round trip of readings (wall-clock timestamps, re-interned device ids)
+ * - Segment rolling and seeking through the sparse index
+ * - Recovery on reopen, including a torn last frame
+ * - Reader stopping at a device frame whose name overruns the frame
+ * - Refusing to reopen over segments it cannot read
+ * - Group commit: sync() and the durable sequence
+ * - Tailing a journal that is still being written
+ * - EventBus journaling every published event
+ */
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "Storage/EventJournal.h"
+#include "Storage/JournalReader.h"
+#include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+#include "Util/Clock.h"
+#include "testHelpers.h"
+
+using TestHelpers::makeRecord;
+
+/**
+ * @class EventJournalTest
+ * @brief Test fixture giving each test an empty journal directory
+ */
+class EventJournalTest : public TestHelpers::ScratchPathTest
+{
+protected:
+    /** @brief Names the journal directory "journal_<test name>" */
+    EventJournalTest() : ScratchPathTest("journal_") {}
+};
+
+TEST_F(EventJournalTest, ReadsBackAppendedReadings)
+{
+    std::vector<Event::SensorRecord> written;
+    {
+        Storage::EventJournal journal;
+        ASSERT_EQ(journal.open(path_), Event::Status::OK);
+        for (int i = 0; i < 100; ++i)
+        {
+            written.push_back(makeRecord(i % 7, i));
+            EXPECT_EQ(journal.append(written.back()), static_cast<uint64_t>(i));
+        }
+        EXPECT_EQ(journal.nextSequence(), 100u);
+    }
+
+    Storage::JournalReader reader;
+    ASSERT_EQ(reader.open(path_), Event::Status::OK);
+    Storage::JournalEntry entry;
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(reader.next(entry));
+        EXPECT_EQ(entry.sequence, i);
+        EXPECT_EQ(entry.record.value, written[i].value);
+        EXPECT_EQ(entry.record.sequence, written[i].sequence);
+        EXPECT_EQ(entry.record.type, Event::SensorType::TempSensor);
+        EXPECT_EQ(Util::Clock::toWallNs(entry.record.timestamp_ns), Util::Clock::toWallNs(written[i].timestamp_ns));
+        EXPECT_EQ(Event::deviceName(entry.record.device_id), Event::deviceName(written[i].device_id));
+    }
+    EXPECT_FALSE(reader.next(entry));
+}
+
+TEST_F(EventJournalTest, RollsSegmentsAndSeeks)
+{
+    Storage::EventJournal::Options options;
+    options.segment_size = 4096;
+    options.index_interval = 8;
+    {
+        Storage::EventJournal journal;
+        ASSERT_EQ(journal.open(path_, options), Event::Status::OK);
+        for (int i = 0; i < 1000; ++i)
+        {
+            journal.append(makeRecord(i % 3, i));
+        }
+    }
+
+    Storage::JournalReader reader;
+    ASSERT_EQ(reader.open(path_), Event::Status::OK);
+    EXPECT_GT(reader.segmentCount(), 10u);
+
+    Storage::JournalEntry entry;
+    for (uint64_t target : {537u, 0u, 999u, 64u, 65u})
+    {
+        ASSERT_EQ(reader.seek(target), Event::Status::OK);
+        ASSERT_TRUE(reader.next(entry));
+        EXPECT_EQ(entry.sequence, target);
+        EXPECT_EQ(entry.record.value, static_cast<double>(target));
+        EXPECT_EQ(Event::deviceName(entry.record.device_id), Event::deviceName(makeRecord(target % 3, 0).device_id));
+    }
+
+    // Readings continue across segment boundaries after a seek
+    ASSERT_EQ(reader.seek(990), Event::Status::OK);
+    uint64_t count = 0;
+    while (reader.next(entry))
+    {
+        EXPECT_EQ(entry.sequence, 990 + count);
+        count++;
+    }
+    EXPECT_EQ(count, 10u);
+
+    ASSERT_EQ(reader.seek(5000), Event::Status::OK);
+    EXPECT_FALSE(reader.next(entry));
+}
+
+TEST_F(EventJournalTest, ContinuesNumberingAfterReopen)
+{
+    {
+        Storage::EventJournal journal;
+        ASSERT_EQ(journal.open(path_), Event::Status::OK);
+        for (int i = 0; i < 10; ++i)
+        {
+            journal.append(makeRecord(1, i));
+        }
+    }
+    {
+        Storage::EventJournal journal;
+        ASSERT_EQ(journal.open(path_), Event::Status::OK);
+        EXPECT_EQ(journal.nextSequence(), 10u);
+        EXPECT_EQ(journal.append(makeRecord(1, 10)), 10u);
+    }
+
+    Storage::JournalReader reader;
+    ASSERT_EQ(reader.open(path_), Event::Status::OK);
+    Storage::JournalEntry entry;
+    uint64_t count = 0;
+    while (reader.next(entry))
+    {
+        EXPECT_EQ(entry.sequence, count);
+        EXPECT_EQ(entry.record.value, static_cast<double>(count));
+        count++;
+    }
+    EXPECT_EQ(count, 11u);
+}
+
+TEST_F(EventJournalTest, RecoveryCutsTornTail)
+{
+    {
+        Storage::EventJournal journal;
+        ASSERT_EQ(journal.open(path_), Event::Status::OK);
+        for (int i = 0; i < 20; ++i)
+        {
+            journal.append(makeRecord(2, i));
+        }
+    }
+
+    // Simulate a crash mid-write: no index and a corrupted last frame
+    const std::string log = path_ + "/" + Storage::JournalFormat::segmentFileName(0, ".log");
+    const std::string idx = path_ + "/" + Storage::JournalFormat::segmentFileName(0, ".idx");
+    Storage::JournalFormat::SegmentInfo info;
+    ASSERT_EQ(Storage::JournalFormat::readIndexFile(idx, info), Event::Status::OK);
+    std::remove(idx.c_str());
+    {
+        std::fstream file(log, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(info.used_size - 8));
+        file.put('\x5a');
+    }
+
+    Storage::EventJournal journal;
+    ASSERT_EQ(journal.open(path_), Event::Status::OK);
+    EXPECT_EQ(journal.nextSequence(), 19u);
+    journal.close();
+
+    Storage::JournalReader reader;
+    ASSERT_EQ(reader.open(path_), Event::Status::OK);
+    Storage::JournalEntry entry;
+    uint64_t count = 0;
+    while (reader.next(entry))
+    {
+        count++;
+    }
+    EXPECT_EQ(count, 19u);
+}
+
+TEST_F(EventJournalTest, ReaderStopsAtOverrunningDeviceFrame)
+{
+    {
+        Storage::EventJournal journal;
+        ASSERT_EQ(journal.open(path_), Event::Status::OK);
+        for (int i = 0; i < 20; ++i)
+        {
+            journal.append(makeRecord(5, i));
+        }
+    }
+
+    // An unsealed segment whose first device frame claims a longer name
+    // than it carries, with a checksum that still matches
+    using namespace Storage::JournalFormat;
+    const std::string log = path_ + "/" + segmentFileName(0, ".log");
+    std::remove((path_ + "/" + segmentFileName(0, ".idx")).c_str());
+    {
+        std::fstream file(log, std::ios::in | std::ios::out | std::ios::binary);
+        const auto offset = static_cast<std::streamoff>(sizeof(SegmentHeader));
+        FrameHeader frame{};
+        file.seekg(offset);
+        file.read(reinterpret_cast<char*>(&frame), sizeof(frame));
+        ASSERT_EQ(frame.kind, FrameKind::Device);
+        std::string payload(frame.size, '\0');
+        file.read(&payload[0], static_cast<std::streamsize>(payload.size()));
+
+        DevicePayload device{};
+        std::memcpy(&device, payload.data(), sizeof(device));
+        device.name_size = static_cast<uint16_t>(frame.size);
+        std::memcpy(&payload[0], &device, sizeof(device));
+        frame.checksum = checksum(payload.data(), payload.size());
+        file.seekp(offset);
+        file.write(reinterpret_cast<const char*>(&frame), sizeof(frame));
+        file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    }
+
+    Storage::JournalReader reader;
+    ASSERT_EQ(reader.open(path_), Event::Status::OK);
+    Storage::JournalEntry entry;
+    EXPECT_FALSE(reader.next(entry));
+}
+
+TEST_F(EventJournalTest, RefusesSegmentsItCannotRead)
+{
+    {
+        Storage::EventJournal journal;
+        ASSERT_EQ(journal.open(path_), Event::Status::OK);
+        for (int i = 0; i < 20; ++i)
+        {
+            journal.append(makeRecord(3, i));
+        }
+    }
+
+    // An unsealed segment of an older format version
+    const std::string log = path_ + "/" + Storage::JournalFormat::segmentFileName(0, ".log");
+    std::remove((path_ + "/" + Storage::JournalFormat::segmentFileName(0, ".idx")).c_str());
+    {
+        std::fstream file(log, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(offsetof(Storage::JournalFormat::SegmentHeader, version)));
+        const uint32_t old_version = 1;
+        file.write(reinterpret_cast<const char*>(&old_version), sizeof(old_version));
+    }
+    const auto size_before = std::filesystem::file_size(log);
+
+    Storage::EventJournal journal;
+    EXPECT_EQ(journal.open(path_), Event::Status::ERROR);
+    EXPECT_FALSE(journal.isOpen());
+    EXPECT_EQ(std::filesystem::file_size(log), size_before);
+    std::ifstream file(log, std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(offsetof(Storage::JournalFormat::SegmentHeader, version)));
+    uint32_t version = 0;
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    EXPECT_EQ(version, 1u);
+
+    // A segment created but never given a header is simply removed
+    std::filesystem::remove(log);
+    std::ofstream(log, std::ios::binary) << std::string(4096, '\0');
+    ASSERT_EQ(journal.open(path_), Event::Status::OK);
+    EXPECT_EQ(journal.nextSequence(), 0u);
+}
+
+TEST_F(EventJournalTest, SyncMakesAppendsDurable)
+{
+    Storage::EventJournal::Options options;
+    options.sync_interval = std::chrono::milliseconds(1000);
+    Storage::EventJournal journal;
+    ASSERT_EQ(journal.open(path_, options), Event::Status::OK);
+
+    for (int i = 0; i < 50; ++i)
+    {
+        journal.append(makeRecord(3, i));
+    }
+    journal.sync();
+
+    EXPECT_EQ(journal.durableSequence(), 50u);
+}
+
+TEST_F(EventJournalTest, ReaderTailsLiveJournal)
+{
+    Storage::EventJournal journal;
+    ASSERT_EQ(journal.open(path_), Event::Status::OK);
+    for (int i = 0; i < 10; ++i)
+    {
+        journal.append(makeRecord(4, i));
+    }
+
+    Storage::JournalReader reader;
+    ASSERT_EQ(reader.open(path_), Event::Status::OK);
+    Storage::JournalEntry entry;
+    uint64_t count = 0;
+    while (reader.next(entry))
+    {
+        count++;
+    }
+    EXPECT_EQ(count, 10u);
+
+    for (int i = 10; i < 15; ++i)
+    {
+        journal.append(makeRecord(4, i));
+    }
+    while (reader.next(entry))
+    {
+        EXPECT_EQ(entry.sequence, count);
+        count++;
+    }
+    EXPECT_EQ(count, 15u);
+}
+
+TEST_F(EventJournalTest, EventBusJournalsEveryEvent)
+{
+    auto journal = std::make_shared<Storage::EventJournal>();
+    ASSERT_EQ(journal->open(path_), Event::Status::OK);
+
+    std::vector<std::string> devices;
+    {
+        EventBus bus;
+        bus.setJournal(journal);
+        bus.subscribe([](const Event::Event&) {});
+        bus.start();
+        for (int i = 0; i < 30; ++i)
+        {
+            auto event = std::make_unique<Event::SensorEvent>(Event::SensorType::CoSensor);
+            devices.push_back(event->getDeviceId());
+            bus.publish(std::move(event));
+        }
+        bus.stop();
+    }
+    journal->close();
+
+    Storage::JournalReader reader;
+    ASSERT_EQ(reader.open(path_), Event::Status::OK);
+    Storage::JournalEntry entry;
+    for (uint64_t i = 0; i < 30; ++i)
+    {
+        ASSERT_TRUE(reader.next(entry));
+        EXPECT_EQ(entry.sequence, i);
+        EXPECT_EQ(Event::deviceName(entry.record.device_id), devices[i]);
+        EXPECT_EQ(entry.record.type, Event::SensorType::CoSensor);
+    }
+    EXPECT_FALSE(reader.next(entry));
+}
@@ -0,0 +1,229 @@
+/**
+ * @file tests_executor.cpp
+ * @brief Unit tests for the EventBus executors
+ * 
+ * Test suite covering:
+ * - InlineExecutor running tasks on the caller
+ * - DedicatedExecutor ordering, drain() and bounded-queue backpressure
+ * - ThreadPoolExecutor concurrency and drain()
+ * - tryExecute() declining when full or called from the executor's own thread
+ * - SerialExecutor keeping FIFO order on top of a pool, and its bounded queue
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "EventBus/Executor.h"
+
+/**
+ * @class ExecutorTest
+ * @brief Test fixture for executor tests
+ */
+class ExecutorTest : public ::testing::Test
+{
+};
+
+TEST_F(ExecutorTest, InlineRunsOnCaller)
+{
+    InlineExecutor executor;
+    std::thread::id ran_on;
+
+    executor.execute([&ran_on]() { ran_on = std::this_thread::get_id(); });
+
+    EXPECT_EQ(ran_on, std::this_thread::get_id());
+    EXPECT_TRUE(executor.isSequential());
+}
+
+TEST_F(ExecutorTest, DedicatedRunsInOrderOnOwnThread)
+{
+    DedicatedExecutor executor;
+    std::vector<int> order;
+    std::thread::id ran_on;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        executor.execute([&order, &ran_on, i]() {
+            order.push_back(i);
+            ran_on = std::this_thread::get_id();
+        });
+    }
+    executor.drain();
+
+    ASSERT_EQ(order.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(order[i], i);
+    }
+    EXPECT_NE(ran_on, std::this_thread::get_id());
+    EXPECT_EQ(executor.pending(), 0u);
+}
+
+TEST_F(ExecutorTest, DedicatedBlocksWhenFull)
+{
+    DedicatedExecutor executor(2);
+    std::atomic<bool> release{false};
+    std::atomic<int> submitted{0};
+
+    // First task occupies the thread, next two fill the queue
+    executor.execute([&release]() {
+        while (!release.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    std::thread producer([&executor, &submitted]() {
+        for (int i = 0; i < 3; ++i)
+        {
+            executor.execute([]() {});
+            submitted++;
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(submitted.load(), 2); // Third execute() waits for room
+
+    release = true;
+    producer.join();
+    executor.drain();
+    EXPECT_EQ(submitted.load(), 3);
+}
+
+TEST_F(ExecutorTest, DestructorRunsRemainingTasks)
+{
+    std::atomic<int> count{0};
+    {
+        DedicatedExecutor executor;
+        for (int i = 0; i < 50; ++i)
+        {
+            executor.execute([&count]() { count++; });
+        }
+    }
+    EXPECT_EQ(count.load(), 50);
+}
+
+TEST_F(ExecutorTest, PoolRunsTasksConcurrently)
+{
+    ThreadPoolExecutor pool(4);
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+
+    for (int i = 0; i < 8; ++i)
+    {
+        pool.execute([&running, &max_running]() {
+            const int now = ++running;
+            int seen = max_running.load();
+            while (now > seen && !max_running.compare_exchange_weak(seen, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            running--;
+        });
+    }
+    pool.drain();
+
+    EXPECT_EQ(pool.threadCount(), 4u);
+    EXPECT_FALSE(pool.isSequential());
+    EXPECT_GT(max_running.load(), 1);
+    EXPECT_EQ(running.load(), 0);
+}
+
+TEST_F(ExecutorTest, TryExecuteDeclinesWhenItWouldBlock)
+{
+    ThreadPoolExecutor pool(1, 1);
+    std::atomic<bool> release{false};
+    std::atomic<int> from_worker{-1};
+
+    // The worker's own attempt is declined, and so is the caller's once
+    // the single queue slot is taken
+    pool.execute([&]() {
+        Executor::Task nested = []() {};
+        from_worker = pool.tryExecute(nested) ? 1 : 0;
+        while (!release.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    while (from_worker.load() < 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    Executor::Task queued = []() {};
+    Executor::Task declined = []() {};
+    EXPECT_TRUE(pool.tryExecute(queued));
+    EXPECT_FALSE(pool.tryExecute(declined));
+    EXPECT_TRUE(static_cast<bool>(declined));
+
+    release = true;
+    pool.drain();
+    EXPECT_EQ(from_worker.load(), 0);
+}
+
+TEST_F(ExecutorTest, SerialKeepsOrderOnPool)
+{
+    auto pool = std::make_shared<ThreadPoolExecutor>(4);
+    auto strand_a = std::make_shared<SerialExecutor>(pool);
+    auto strand_b = std::make_shared<SerialExecutor>(pool);
+    std::vector<int> order_a;
+    std::vector<int> order_b;
+    std::atomic<bool> overlap{false};
+    std::atomic<int> in_a{0};
+
+    for (int i = 0; i < 500; ++i)
+    {
+        strand_a->execute([&order_a, &overlap, &in_a, i]() {
+            if (++in_a > 1)
+            {
+                overlap = true;
+            }
+            order_a.push_back(i);
+            in_a--;
+        });
+        strand_b->execute([&order_b, i]() { order_b.push_back(i); });
+    }
+    strand_a->drain();
+    strand_b->drain();
+
+    ASSERT_EQ(order_a.size(), 500u);
+    ASSERT_EQ(order_b.size(), 500u);
+    for (int i = 0; i < 500; ++i)
+    {
+        EXPECT_EQ(order_a[i], i);
+        EXPECT_EQ(order_b[i], i);
+    }
+    EXPECT_FALSE(overlap.load());
+}
+
+TEST_F(ExecutorTest, SerialBlocksWhenFull)
+{
+    auto pool = std::make_shared<ThreadPoolExecutor>(2);
+    auto strand = std::make_shared<SerialExecutor>(pool, 2);
+    std::atomic<bool> release{false};
+    std::atomic<int> submitted{0};
+
+    // First task occupies the strand, next two fill its queue
+    strand->execute([&release]() {
+        while (!release.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    std::thread producer([&strand, &submitted]() {
+        for (int i = 0; i < 3; ++i)
+        {
+            strand->execute([]() {});
+            submitted++;
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(submitted.load(), 2); // Third execute() waits for room
+
+    release = true;
+    producer.join();
+    strand->drain();
+    EXPECT_EQ(submitted.load(), 3);
+}
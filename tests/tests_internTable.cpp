@@ -0,0 +1,159 @@
+/**
+ * @file tests_internTable.cpp
+ * @brief Unit tests for the concurrent InternTable
+ * 
+ * Test suite covering:
+ * - Dense id assignment and idempotent interning
+ * - Lookup of known and unknown names and ids
+ * - Growth of the hash index past its initial capacity
+ * - Concurrent interning and lookup from several threads
+ * - Device id helpers built on the global table
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Util/InternTable.h"
+#include "Event/SensorType.h"
+
+/**
+ * @class InternTableTest
+ * @brief Test fixture providing a private InternTable per test
+ */
+class InternTableTest : public ::testing::Test
+{
+protected:
+    /** @brief Creates an empty table before each test */
+    void SetUp() override
+    {
+        table_ = std::make_unique<Util::InternTable>();
+    }
+
+    /** @brief Destroys the table after each test */
+    void TearDown() override
+    {
+        table_.reset();
+    }
+
+    std::unique_ptr<Util::InternTable> table_;  ///< Table under test
+};
+
+TEST_F(InternTableTest, AssignsDenseIds)
+{
+    EXPECT_EQ(table_->intern("CoSensor_0"), 0u);
+    EXPECT_EQ(table_->intern("CoSensor_1"), 1u);
+    EXPECT_EQ(table_->intern("TempSensor_0"), 2u);
+    EXPECT_EQ(table_->size(), 3u);
+}
+
+TEST_F(InternTableTest, InterningTwiceReturnsSameId)
+{
+    const uint32_t id = table_->intern("PressureSensor_7");
+    EXPECT_EQ(table_->intern(std::string("PressureSensor_7")), id);
+    EXPECT_EQ(table_->size(), 1u);
+}
+
+TEST_F(InternTableTest, FindAndName)
+{
+    const uint32_t id = table_->intern("CoSensor_3");
+
+    uint32_t found = Util::InternTable::kInvalidId;
+    EXPECT_TRUE(table_->find("CoSensor_3", found));
+    EXPECT_EQ(found, id);
+    EXPECT_FALSE(table_->find("CoSensor_4", found));
+
+    EXPECT_EQ(table_->name(id), "CoSensor_3");
+    EXPECT_TRUE(table_->name(id + 1).empty());
+    EXPECT_TRUE(table_->name(Util::InternTable::kInvalidId).empty());
+}
+
+TEST_F(InternTableTest, GrowsBeyondInitialCapacity)
+{
+    constexpr uint32_t kNames = 5000;
+    for (uint32_t i = 0; i < kNames; ++i)
+    {
+        ASSERT_EQ(table_->intern("device_" + std::to_string(i)), i);
+    }
+    for (uint32_t i = 0; i < kNames; ++i)
+    {
+        uint32_t id = Util::InternTable::kInvalidId;
+        ASSERT_TRUE(table_->find("device_" + std::to_string(i), id));
+        EXPECT_EQ(id, i);
+        EXPECT_EQ(table_->name(i), "device_" + std::to_string(i));
+    }
+}
+
+TEST_F(InternTableTest, ConcurrentInternAgreesOnIds)
+{
+    constexpr int kThreads = 4;
+    constexpr uint32_t kNames = 2000;
+    std::vector<std::vector<uint32_t>> ids(kThreads, std::vector<uint32_t>(kNames));
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([this, &ids, t]() {
+            // Each thread walks the names in a different order; the strides
+            // are coprime with kNames so every name is visited
+            static constexpr uint32_t kStrides[kThreads] = {1, 3, 7, 9};
+            for (uint32_t k = 0; k < kNames; ++k)
+            {
+                const uint32_t i = (k * kStrides[t]) % kNames;
+                ids[t][i] = table_->intern("sensor_" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(table_->size(), kNames);
+    for (uint32_t i = 0; i < kNames; ++i)
+    {
+        for (int t = 1; t < kThreads; ++t)
+        {
+            EXPECT_EQ(ids[t][i], ids[0][i]);
+        }
+        EXPECT_EQ(table_->name(ids[0][i]), "sensor_" + std::to_string(i));
+    }
+}
+
+TEST_F(InternTableTest, ReadersRunDuringGrowth)
+{
+    const uint32_t known = table_->intern("known");
+    std::atomic<bool> done{false};
+    std::atomic<bool> failed{false};
+
+    std::thread reader([this, known, &done, &failed]() {
+        while (!done.load())
+        {
+            uint32_t id = Util::InternTable::kInvalidId;
+            if (!table_->find("known", id) || id != known || table_->name(known) != "known")
+            {
+                failed = true;
+            }
+        }
+    });
+
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        table_->intern("grow_" + std::to_string(i));
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_FALSE(failed.load());
+}
+
+TEST_F(InternTableTest, DeviceIdHelpers)
+{
+    const uint32_t id = Event::internDeviceId(Event::SensorType::CoSensor, 3);
+
+    EXPECT_EQ(Event::internDeviceId(Event::SensorType::CoSensor, 3), id);
+    EXPECT_NE(Event::internDeviceId(Event::SensorType::TempSensor, 3), id);
+    EXPECT_EQ(Event::deviceName(id), "CoSensor_3");
+    EXPECT_LT(id, Util::InternTable::global().size());
+}
@@ -0,0 +1,333 @@
+/**
+ * @file tests_lineIngestor.cpp
+ * @brief Unit tests for Transport::LineParser, LineIngestor and the SensorEvent block pool
+ *
+ * Test suite covering:
+ * - Parsing readings, tags, faults, timestamps, comments and CRLF line ends
+ * - Counting and skipping malformed and over-long lines
+ * - Identical results at every SIMD level and for any split of the input
+ * - Ingesting a file to its end, including an unterminated last line
+ * - Ingesting from several writers on a Unix socket, in order per writer
+ * - SensorEvents reusing pooled storage across threads
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Transport/LineParser.h"
+#include "Transport/LineIngestor.h"
+#include "Transport/SocketAddress.h"
+#include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+#include "Util/Clock.h"
+#include "Util/InternTable.h"
+#include "testHelpers.h"
+
+using TestHelpers::waitFor;
+
+/**
+ * @class LineIngestorTest
+ * @brief Test fixture with a bus that records what it dispatches
+ */
+class LineIngestorTest : public TestHelpers::RecordingBusTest
+{
+protected:
+    /** @brief Names the scratch file "ingest_<test name>"; path_ + ".sock" is its socket */
+    LineIngestorTest() : RecordingBusTest("ingest_") {}
+
+    /** @brief Stops the bus and removes the file and the socket */
+    void TearDown() override
+    {
+        RecordingBusTest::TearDown();
+        std::filesystem::remove(path_ + ".sock");
+    }
+
+    /**
+     * @brief Parses text in one call
+     * @param parser Parser to use
+     * @param text Lines to parse
+     * @return Records of the parsed events
+     */
+    static std::vector<Event::SensorRecord> parseAll(Transport::LineParser& parser, const std::string& text)
+    {
+        Transport::LineParser::Batch batch;
+        EXPECT_EQ(parser.parse(text.data(), text.size(), batch), text.size());
+        return toRecords(batch);
+    }
+
+    /**
+     * @brief Extracts the records of parsed events
+     */
+    static std::vector<Event::SensorRecord> toRecords(const Transport::LineParser::Batch& batch)
+    {
+        std::vector<Event::SensorRecord> records;
+        for (const auto& event : batch) {
+            records.push_back(Event::event_cast<Event::SensorEvent>(*event)->getRecord());
+        }
+        return records;
+    }
+
+    /**
+     * @brief Builds lines of all types with timestamps, some malformed
+     * @param count Number of lines
+     */
+    static std::string makeMixedInput(std::size_t count)
+    {
+        static const char* const kTypes[] = {"CoSensor", "TempSensor", "PressureSensor"};
+        std::string text;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i % 97 == 0) {
+                text += "TempSensor,device=1 notanumber\n";
+                continue;
+            }
+            text += std::string(kTypes[i % 3]) + ",device=" + std::to_string(i % 50) + ",site=lab" +
+                    std::to_string(i % 7) + " " + (i % 11 == 0 ? "value=" : "") +
+                    std::to_string(static_cast<double>(i) * 0.25) + " " +
+                    std::to_string(1767225600000000000LL + static_cast<int64_t>(i)) + (i % 5 == 0 ? "\r\n" : "\n");
+        }
+        return text;
+    }
+};
+
+TEST_F(LineIngestorTest, ParsesReadingsTagsAndTimestamps)
+{
+    Transport::LineParser parser;
+    const int64_t before = Util::Clock::nowNs();
+    const std::vector<Event::SensorRecord> records = parseAll(parser,
+        "# comment, with = separators\n"
+        "TempSensor,device=3,site=lab 21.5 1767225600000000000\n"
+        "\n"
+        "CoSensor,site=roof,device=3 value=-1.25e2\r\n"
+        "PressureSensor,device=west-7 fault\n"
+        "TempSensor,device=3 22\n");
+    const int64_t after = Util::Clock::nowNs();
+    ASSERT_EQ(records.size(), 4u);
+
+    EXPECT_EQ(records[0].type, Event::SensorType::TempSensor);
+    EXPECT_EQ(records[0].device_id, Event::internDeviceId(Event::SensorType::TempSensor, 3));
+    EXPECT_DOUBLE_EQ(records[0].value, 21.5);
+    EXPECT_EQ(Util::Clock::toWallNs(records[0].timestamp_ns), 1767225600000000000LL);
+    EXPECT_EQ(records[0].sequence, 0u);
+    EXPECT_FALSE(records[0].isFault());
+
+    EXPECT_EQ(records[1].type, Event::SensorType::CoSensor);
+    EXPECT_EQ(Event::deviceName(records[1].device_id), "CoSensor_3");
+    EXPECT_DOUBLE_EQ(records[1].value, -125.0);
+    EXPECT_GE(records[1].timestamp_ns, before);
+    EXPECT_LE(records[1].timestamp_ns, after);
+
+    EXPECT_EQ(Event::deviceName(records[2].device_id), "PressureSensor_west-7");
+    EXPECT_TRUE(records[2].isFault());
+    EXPECT_EQ(records[2].value, 0.0);
+
+    // Sequence numbers count per device
+    EXPECT_EQ(records[3].device_id, records[0].device_id);
+    EXPECT_EQ(records[3].sequence, 1u);
+    EXPECT_DOUBLE_EQ(records[3].value, 22.0);
+
+    EXPECT_EQ(parser.getStats().lines, 4u);
+    EXPECT_EQ(parser.getStats().events, 4u);
+    EXPECT_EQ(parser.getStats().malformed, 0u);
+}
+
+TEST_F(LineIngestorTest, SkipsMalformedAndOverlongLines)
+{
+    const std::vector<std::string> malformed = {
+        "HumiditySensor,device=1 5",           // unknown type
+        "TempSensor 5",                        // no tags
+        "TempSensor,site=lab 5",               // no device
+        "TempSensor,device= 5",                // empty device
+        "TempSensor,device=1",                 // no value
+        "TempSensor,device=1 5x",              // bad value
+        "TempSensor,device=1 nan",             // not finite
+        "TempSensor,device=1 humidity=5",      // other field name
+        "TempSensor,device=1 5,other=6",       // several fields
+        "TempSensor,device=1 5 12a",           // bad timestamp
+        "TempSensor,device=1 5 1 2",           // trailing token
+        "TempSensor,device 5",                 // tag without '='
+    };
+    std::string text;
+    for (const std::string& line : malformed) {
+        text += line + "\nTempSensor,device=1 1.5\n";
+    }
+    Transport::LineParser parser;
+    const std::vector<Event::SensorRecord> records = parseAll(parser, text);
+    EXPECT_EQ(records.size(), malformed.size());
+    EXPECT_EQ(parser.getStats().malformed, malformed.size());
+    EXPECT_EQ(parser.getStats().lines, 2 * malformed.size());
+
+    // A line longer than a chunk is dropped whole, however it is split
+    const std::string overlong = "TempSensor,device=1 " + std::string(Transport::LineParser::kChunkSize + 100, '7') + "\n";
+    const std::string stream = overlong + "TempSensor,device=2 2.5\n";
+    Transport::LineParser split_parser;
+    Transport::LineParser::Batch batch;
+    std::size_t buffered = 0;
+    std::string buffer;
+    for (std::size_t offset = 0; offset < stream.size(); offset += 10000) {
+        buffer += stream.substr(offset, 10000);
+        buffer.erase(0, split_parser.parse(buffer.data(), buffer.size(), batch));
+        buffered = buffer.size();
+    }
+    EXPECT_EQ(buffered, 0u);
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_DOUBLE_EQ(toRecords(batch)[0].value, 2.5);
+    EXPECT_EQ(split_parser.getStats().malformed, 1u);
+}
+
+TEST_F(LineIngestorTest, SimdLevelsAndSplitsAgree)
+{
+    const std::string text = makeMixedInput(20000);
+    Transport::LineParser scalar(Util::SimdLevel::Scalar);
+    const std::vector<Event::SensorRecord> expected = parseAll(scalar, text);
+    EXPECT_EQ(scalar.simdLevel(), Util::SimdLevel::Scalar);
+    EXPECT_EQ(scalar.getStats().malformed, (20000 + 96) / 97);
+    ASSERT_EQ(expected.size() + scalar.getStats().malformed, 20000u);
+
+    for (const Util::SimdLevel level : {Util::SimdLevel::SSE2, Util::SimdLevel::AVX2}) {
+        for (const std::size_t slice : {std::size_t{1} << 20, std::size_t{4093}, std::size_t{61}}) {
+            Transport::LineParser parser(level);
+            Transport::LineParser::Batch batch;
+            std::string buffer;
+            for (std::size_t offset = 0; offset < text.size(); offset += slice) {
+                buffer += text.substr(offset, slice);
+                buffer.erase(0, parser.parse(buffer.data(), buffer.size(), batch));
+            }
+            EXPECT_TRUE(buffer.empty());
+            const std::vector<Event::SensorRecord> records = toRecords(batch);
+            ASSERT_EQ(records.size(), expected.size()) << "slice " << slice;
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                ASSERT_EQ(std::memcmp(&records[i], &expected[i], sizeof(records[i])), 0)
+                    << "line " << i << ", slice " << slice;
+            }
+            EXPECT_EQ(parser.getStats().malformed, scalar.getStats().malformed);
+        }
+    }
+}
+
+TEST_F(LineIngestorTest, IngestsFileToEnd)
+{
+    {
+        std::ofstream file(path_);
+        for (int i = 0; i < 5000; ++i) {
+            file << "CoSensor,device=" << i % 4 << " " << i << "\n";
+        }
+        file << "CoSensor,device=9 broken\n";
+        file << "CoSensor,device=9 5000";   // no final newline
+    }
+
+    Transport::LineIngestor ingestor(event_bus_);
+    EXPECT_EQ(ingestor.open(path_ + ".missing"), Event::Status::ERROR);
+    Transport::LineIngestor::Options options;
+    options.read_size = 4096;
+    options.max_in_flight = 256;
+    ASSERT_EQ(ingestor.open(path_, options), Event::Status::OK);
+    EXPECT_TRUE(ingestor.address().empty());
+    ASSERT_TRUE(waitFor([&] { return ingestor.finished(); }));
+    ASSERT_TRUE(waitFor([&] {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_.size() == 5001;
+    }));
+    ingestor.close();
+    EXPECT_FALSE(ingestor.isOpen());
+
+    const Transport::LineIngestor::Stats stats = ingestor.getStats();
+    EXPECT_EQ(stats.connections, 1u);
+    EXPECT_EQ(stats.lines, 5002u);
+    EXPECT_EQ(stats.published, 5001u);
+    EXPECT_EQ(stats.malformed, 1u);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < records_.size(); ++i) {
+        EXPECT_DOUBLE_EQ(records_[i].value, static_cast<double>(i));
+    }
+}
+
+TEST_F(LineIngestorTest, IngestsFromSocketWriters)
+{
+    Transport::LineIngestor ingestor(event_bus_);
+    ASSERT_EQ(ingestor.open("unix:" + path_ + ".sock"), Event::Status::OK);
+    Transport::SocketAddress address;
+    ASSERT_EQ(Transport::SocketAddress::parse(ingestor.address(), address), Event::Status::OK);
+
+    constexpr int kWriters = 3;
+    constexpr int kLinesPerWriter = 20000;
+    std::vector<std::thread> writers;
+    for (int writer = 0; writer < kWriters; ++writer) {
+        writers.emplace_back([&address, writer] {
+            const int fd = address.connect();
+            ASSERT_GE(fd, 0);
+            std::string text;
+            for (int i = 0; i < kLinesPerWriter; ++i) {
+                text += "PressureSensor,device=" + std::to_string(100 + writer) + " " + std::to_string(i) + "\n";
+            }
+            // Uneven writes split lines between reads
+            for (std::size_t offset = 0; offset < text.size();) {
+                const std::size_t size = std::min<std::size_t>(text.size() - offset, 777 + 111 * writer);
+                const ssize_t written = ::send(fd, text.data() + offset, size, MSG_NOSIGNAL);
+                ASSERT_GT(written, 0);
+                offset += static_cast<std::size_t>(written);
+            }
+            ::close(fd);
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+
+    ASSERT_TRUE(waitFor([&] {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_.size() == kWriters * kLinesPerWriter;
+    }));
+    ingestor.close();
+    EXPECT_EQ(ingestor.getStats().connections, static_cast<uint64_t>(kWriters));
+    EXPECT_FALSE(ingestor.finished());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<double> next(kWriters, 0.0);
+    for (const Event::SensorRecord& record : records_) {
+        const std::string_view name = Event::deviceName(record.device_id);
+        const int writer = name.back() - '0';
+        ASSERT_GE(writer, 0);
+        ASSERT_LT(writer, kWriters);
+        EXPECT_EQ(record.value, next[writer]);
+        EXPECT_EQ(record.sequence, static_cast<uint64_t>(next[writer]));
+        next[writer] += 1.0;
+    }
+}
+
+TEST_F(LineIngestorTest, SensorEventsReusePooledStorage)
+{
+    // Warm up, then check that churn does not grow the pool
+    std::vector<std::unique_ptr<Event::SensorEvent>> events;
+    for (int i = 0; i < 4096; ++i) {
+        events.push_back(std::make_unique<Event::SensorEvent>(Event::SensorRecord{}));
+    }
+    std::set<const void*> addresses;
+    for (const auto& event : events) {
+        addresses.insert(event.get());
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(event.get()) % alignof(Event::SensorEvent), 0u);
+    }
+    EXPECT_EQ(addresses.size(), events.size());
+    events.clear();
+    const uint64_t slabs = Event::SensorEventPool::slabCount();
+
+    // Created on one thread, destroyed on another, as producers and the dispatcher do
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::unique_ptr<Event::SensorEvent>> batch;
+        std::thread producer([&batch] {
+            for (int i = 0; i < 4096; ++i) {
+                batch.push_back(std::make_unique<Event::SensorEvent>(Event::SensorRecord{}));
+            }
+        });
+        producer.join();
+        batch.clear();
+    }
+    EXPECT_LE(Event::SensorEventPool::slabCount(), slabs + 8);
+}
@@ -8,12 +8,16 @@
  * - uniform_dist() with power-of-two and non-power-of-two ranges
  * - one_in() probability testing
  * - skewed() distribution testing
+ * - Bulk fill_* APIs: ranges, reproducibility and identical output on every SIMD level
+ * - Bulk lanes covering disjoint draws, within and across calls
  * - Edge cases and boundary conditions
  * 
  * All tests use a fixed seed (12345) in the fixture for reproducibility.
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
 #include "Util/RandomNumberGenerator.h"
 
 /**
@@ -175,3 +179,171 @@ TEST_F(RandomNumberGeneratorTest, SameSeedSameSequence)
         EXPECT_EQ(rng1.uniform_dist(1000), rng2.uniform_dist(1000));
     }
 }
+
+
+/**
+ * @brief Runs fn once per SIMD level and restores the detected level afterwards
+ */
+template<typename Fn>
+static void forEachSimdLevel(Fn fn)
+{
+    const Util::SimdLevel original = Util::RandomNumberGenerator::bulk_simd_level();
+    for (Util::SimdLevel level : {Util::SimdLevel::Scalar, Util::SimdLevel::SSE2, Util::SimdLevel::AVX2})
+    {
+        Util::RandomNumberGenerator::set_bulk_simd_level(level);
+        fn();
+    }
+    Util::RandomNumberGenerator::set_bulk_simd_level(original);
+}
+
+TEST_F(RandomNumberGeneratorTest, FillUniformDistRange)
+{
+    std::vector<uint32_t> values(1003);
+    rng_->fill_uniform_dist(values.data(), values.size(), 100);
+
+    for (uint32_t value : values)
+    {
+        EXPECT_LT(value, 100u);
+    }
+}
+
+TEST_F(RandomNumberGeneratorTest, FillDoubleRange)
+{
+    std::vector<double> values(1003);
+    rng_->fill_double(values.data(), values.size());
+
+    for (double value : values)
+    {
+        EXPECT_GE(value, 0.0);
+        EXPECT_LT(value, 1.0);
+    }
+}
+
+TEST_F(RandomNumberGeneratorTest, FillOneInProbability)
+{
+    std::vector<uint8_t> flags(100000);
+    rng_->fill_one_in(flags.data(), flags.size(), 100);
+
+    int true_count = 0;
+    for (uint8_t flag : flags)
+    {
+        EXPECT_LE(flag, 1);
+        true_count += flag;
+    }
+    // Expected about 1000 trues out of 100000 (1%)
+    EXPECT_GT(true_count, 800);
+    EXPECT_LT(true_count, 1200);
+}
+
+TEST_F(RandomNumberGeneratorTest, FillOneInWithOne)
+{
+    std::vector<uint8_t> flags(37, 0);
+    rng_->fill_one_in(flags.data(), flags.size(), 1);
+
+    for (uint8_t flag : flags)
+    {
+        EXPECT_EQ(flag, 1);
+    }
+}
+
+TEST_F(RandomNumberGeneratorTest, FillSameSeedSameSequence)
+{
+    Util::RandomNumberGenerator rng1(42);
+    Util::RandomNumberGenerator rng2(42);
+    std::vector<uint32_t> values1(257);
+    std::vector<uint32_t> values2(257);
+
+    for (int call = 0; call < 3; ++call)
+    {
+        rng1.fill_uniform(values1.data(), values1.size());
+        rng2.fill_uniform(values2.data(), values2.size());
+        EXPECT_EQ(values1, values2);
+    }
+}
+
+/** @test Bulk output is the scalar sequence reordered: no lane repeats another's draws */
+TEST_F(RandomNumberGeneratorTest, FillLanesCoverDisjointDraws)
+{
+    Util::RandomNumberGenerator scalar(12345);
+    std::vector<uint32_t> bulk(24);
+    rng_->fill_uniform(bulk.data(), bulk.size());
+
+    std::vector<uint32_t> expected(24);
+    for (uint32_t& value : expected)
+    {
+        value = scalar.next32();
+    }
+    std::vector<uint32_t> all = bulk;
+    std::sort(bulk.begin(), bulk.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(bulk, expected);
+
+    // 1021 values take 128 draws from each lane, so 3 draws go unused
+    bulk.resize(1021);
+    rng_->fill_uniform(bulk.data(), bulk.size());
+    expected.resize(1024);
+    for (uint32_t& value : expected)
+    {
+        value = scalar.next32();
+    }
+    std::sort(expected.begin(), expected.end());
+    for (uint32_t value : bulk)
+    {
+        EXPECT_TRUE(std::binary_search(expected.begin(), expected.end(), value));
+    }
+
+    // The following call starts where the scalar generator is now
+    all.insert(all.end(), bulk.begin(), bulk.end());
+    rng_->fill_uniform(bulk.data(), 8);
+    EXPECT_EQ(bulk[0], scalar.next32());
+    all.insert(all.end(), bulk.begin(), bulk.begin() + 8);
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+}
+
+/** @test Every SIMD level must produce the exact same output as the scalar lanes */
+TEST_F(RandomNumberGeneratorTest, FillBitIdenticalAcrossSimdLevels)
+{
+    // Odd size so both the vector body and the scalar tail are exercised
+    constexpr std::size_t kCount = 1021;
+    std::vector<std::vector<uint32_t>> uniforms;
+    std::vector<std::vector<uint32_t>> bounded;
+    std::vector<std::vector<uint8_t>> flags;
+    std::vector<std::vector<double>> doubles;
+
+    forEachSimdLevel([&]() {
+        Util::RandomNumberGenerator rng(12345);
+        uniforms.emplace_back(kCount);
+        bounded.emplace_back(kCount);
+        flags.emplace_back(kCount);
+        doubles.emplace_back(kCount);
+        rng.fill_uniform(uniforms.back().data(), kCount);
+        rng.fill_uniform_dist(bounded.back().data(), kCount, 1000);
+        rng.fill_one_in(flags.back().data(), kCount, 7);
+        rng.fill_double(doubles.back().data(), kCount);
+    });
+
+    for (std::size_t level = 1; level < uniforms.size(); ++level)
+    {
+        EXPECT_EQ(uniforms[level], uniforms[0]);
+        EXPECT_EQ(bounded[level], bounded[0]);
+        EXPECT_EQ(flags[level], flags[0]);
+        EXPECT_EQ(doubles[level], doubles[0]);
+    }
+}
+
+TEST_F(RandomNumberGeneratorTest, FillOneInMatchesUniformDistZero)
+{
+    Util::RandomNumberGenerator rng1(7);
+    Util::RandomNumberGenerator rng2(7);
+    std::vector<uint8_t> flags(5000);
+    std::vector<uint32_t> values(5000);
+
+    rng1.fill_one_in(flags.data(), flags.size(), 13);
+    rng2.fill_uniform_dist(values.data(), values.size(), 13);
+
+    for (std::size_t i = 0; i < flags.size(); ++i)
+    {
+        EXPECT_EQ(flags[i] == 1, values[i] == 0);
+    }
+}
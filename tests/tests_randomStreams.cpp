@@ -0,0 +1,210 @@
+/**
+ * @file tests_randomStreams.cpp
+ * @brief Unit tests for the jumpable generator family and RandomStreams
+ * 
+ * Test suite covering:
+ * - Xoshiro256 / Xoshiro128 reproducibility, jump() and split()
+ * - Pcg32 reference output, stream selection and advance()
+ * - Distributions inherited from RandomDistributions
+ * - RandomStreams fan-out: next() vs stream(index), reseeding, distinct streams
+ */
+
+#include <gtest/gtest.h>
+#include <set>
+#include "Util/SplitMix64.h"
+#include "Util/Xoshiro256.h"
+#include "Util/Xoshiro128.h"
+#include "Util/Pcg32.h"
+#include "Util/RandomStreams.h"
+
+/**
+ * @class RandomStreamsTest
+ * @brief Test fixture for the generator family
+ * 
+ * Provides a RandomStreams instance with a fixed master seed.
+ */
+class RandomStreamsTest : public ::testing::Test
+{
+protected:
+    /** @brief Creates a stream factory with a known master seed */
+    void SetUp() override
+    {
+        streams_ = std::make_unique<Util::RandomStreams>(12345);
+    }
+
+    /** @brief Releases the stream factory */
+    void TearDown() override
+    {
+        streams_.reset();
+    }
+
+    std::unique_ptr<Util::RandomStreams> streams_;  ///< Stream factory under test
+};
+
+TEST_F(RandomStreamsTest, Xoshiro256SameSeedSameSequence)
+{
+    Util::Xoshiro256 rng1(42);
+    Util::Xoshiro256 rng2(42);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(rng1.next(), rng2.next());
+    }
+}
+
+TEST_F(RandomStreamsTest, Xoshiro256ZeroSeedIsUsable)
+{
+    Util::Xoshiro256 rng(0);
+    std::set<uint64_t> values;
+    for (int i = 0; i < 16; ++i)
+    {
+        values.insert(rng.next());
+    }
+    EXPECT_EQ(values.size(), 16u);
+}
+
+TEST_F(RandomStreamsTest, Xoshiro256SplitReturnsCurrentStreamAndJumps)
+{
+    Util::Xoshiro256 rng(7);
+    Util::Xoshiro256 expected_child(7);
+    Util::Xoshiro256 expected_parent(7);
+    expected_parent.jump();
+
+    Util::Xoshiro256 child = rng.split();
+
+    EXPECT_EQ(child, expected_child);
+    EXPECT_EQ(rng, expected_parent);
+    EXPECT_NE(child.next(), rng.next());
+}
+
+TEST_F(RandomStreamsTest, Xoshiro256LongJumpDiffersFromJump)
+{
+    Util::Xoshiro256 jumped(7);
+    Util::Xoshiro256 long_jumped(7);
+    jumped.jump();
+    long_jumped.long_jump();
+
+    EXPECT_NE(jumped, long_jumped);
+}
+
+TEST_F(RandomStreamsTest, Xoshiro256UniformDistRange)
+{
+    Util::Xoshiro256 rng(3);
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_LT(rng.uniform_dist(100), 100u);
+    }
+}
+
+TEST_F(RandomStreamsTest, Xoshiro128JumpLeavesNearbySequence)
+{
+    Util::Xoshiro128 rng(9);
+    Util::Xoshiro128 jumped(9);
+    jumped.jump();
+
+    // A jump must land somewhere other than a nearby position of the sequence
+    for (int i = 0; i < 1000; ++i)
+    {
+        rng.next32();
+        bool same = true;
+        for (int word = 0; word < 4; ++word)
+        {
+            same = same && rng.state(word) == jumped.state(word);
+        }
+        EXPECT_FALSE(same);
+    }
+}
+
+TEST_F(RandomStreamsTest, Xoshiro128StepMatchesNext32)
+{
+    Util::Xoshiro128 rng(11);
+    uint32_t s0 = rng.state(0);
+    uint32_t s1 = rng.state(1);
+    uint32_t s2 = rng.state(2);
+    uint32_t s3 = rng.state(3);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(Util::Xoshiro128::step(s0, s1, s2, s3), rng.next32());
+    }
+}
+
+/** @test Matches the reference output of pcg32 seeded with (42, 54) */
+TEST_F(RandomStreamsTest, Pcg32ReferenceSequence)
+{
+    Util::Pcg32 rng(42, 54);
+    const uint32_t expected[] = { 0xa15c02b7u, 0x7b47f409u, 0xba1d3330u, 0x83d2f293u, 0xbfa4784bu, 0xcbed606eu };
+
+    for (uint32_t value : expected)
+    {
+        EXPECT_EQ(rng.next32(), value);
+    }
+}
+
+TEST_F(RandomStreamsTest, Pcg32StreamsDiffer)
+{
+    Util::Pcg32 rng1(42, 1);
+    Util::Pcg32 rng2(42, 2);
+
+    bool different = false;
+    for (int i = 0; i < 10; ++i)
+    {
+        different = different || rng1.next32() != rng2.next32();
+    }
+    EXPECT_TRUE(different);
+}
+
+TEST_F(RandomStreamsTest, Pcg32AdvanceMatchesRepeatedDraws)
+{
+    Util::Pcg32 stepped(5, 3);
+    Util::Pcg32 advanced(5, 3);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        stepped.next32();
+    }
+    advanced.advance(1000);
+
+    EXPECT_EQ(stepped.next32(), advanced.next32());
+}
+
+TEST_F(RandomStreamsTest, NextMatchesStreamByIndex)
+{
+    for (uint64_t index = 0; index < 5; ++index)
+    {
+        EXPECT_EQ(streams_->next(), streams_->stream(index));
+    }
+}
+
+TEST_F(RandomStreamsTest, StreamsAreDistinct)
+{
+    std::set<uint64_t> first_draws;
+    for (int i = 0; i < 64; ++i)
+    {
+        first_draws.insert(streams_->next().next());
+    }
+    EXPECT_EQ(first_draws.size(), 64u);
+}
+
+TEST_F(RandomStreamsTest, ReseedRestartsFanOut)
+{
+    Util::Xoshiro256 first = streams_->next();
+    streams_->next();
+
+    streams_->reseed(12345);
+
+    EXPECT_EQ(streams_->seed(), 12345u);
+    EXPECT_EQ(streams_->next(), first);
+}
+
+TEST_F(RandomStreamsTest, SameMasterSeedReproducible)
+{
+    Util::RandomStreams other(12345);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        Util::Xoshiro256 a = streams_->next();
+        Util::Xoshiro256 b = other.next();
+        EXPECT_EQ(a.next(), b.next());
+    }
+}
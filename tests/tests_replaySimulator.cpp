@@ -0,0 +1,238 @@
+/**
+ * @file tests_replaySimulator.cpp
+ * @brief Unit tests for SensorSimulator::ReplaySimulator and Storage::TraceReader
+ *
+ * Test suite covering:
+ * - Replaying trace files and journals in recorded order
+ * - Scaled timing (Nx speed) and as-fast-as-possible replay
+ * - Bounded backlog on the EventBus while a consumer is slow
+ * - Prompt stop while waiting for the next reading, and looping
+ * - Error handling for missing recordings
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SensorSimulator/ReplaySimulator.h"
+#include "Storage/EventJournal.h"
+#include "Storage/TraceReader.h"
+#include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+#include "Util/Clock.h"
+#include "testHelpers.h"
+
+using TestHelpers::makeRecord;
+
+/**
+ * @class ReplaySimulatorTest
+ * @brief Test fixture with a scratch path and a recording bus
+ */
+class ReplaySimulatorTest : public TestHelpers::RecordingBusTest
+{
+protected:
+    static constexpr uint32_t kDevice = 3;                                        ///< Device of every test reading
+    static constexpr Event::SensorType kType = Event::SensorType::PressureSensor;  ///< Type of every test reading
+
+    /** @brief Names the trace file or journal directory "replay_<test name>" */
+    ReplaySimulatorTest() : RecordingBusTest("replay_") {}
+
+    /**
+     * @brief Writes readings in the trace format of EventBus LeftoverPolicy::Persist
+     * @param records Readings with monotonic timestamps
+     */
+    void writeTrace(const std::vector<Event::SensorRecord>& records)
+    {
+        std::FILE* file = std::fopen(path_.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        for (Event::SensorRecord record : records)
+        {
+            const std::string_view name = Event::deviceName(record.device_id);
+            const auto name_size = static_cast<uint16_t>(name.size());
+            record.timestamp_ns = Util::Clock::toWallNs(record.timestamp_ns);
+            std::fwrite(&record, sizeof(record), 1, file);
+            std::fwrite(&name_size, sizeof(name_size), 1, file);
+            std::fwrite(name.data(), 1, name_size, file);
+        }
+        std::fclose(file);
+    }
+
+    /**
+     * @brief Writes readings to a journal at path_
+     * @param records Readings to journal
+     */
+    void writeJournal(const std::vector<Event::SensorRecord>& records)
+    {
+        Storage::EventJournal journal;
+        ASSERT_EQ(journal.open(path_), Event::Status::OK);
+        for (const auto& record : records)
+        {
+            journal.append(record);
+        }
+    }
+};
+
+TEST_F(ReplaySimulatorTest, TraceReaderRoundTrip)
+{
+    const int64_t base = 1767225600000000000LL;
+    writeTrace({makeRecord(kDevice, base, 0.0, 0, kType), makeRecord(kDevice, base + 5, 1.0, 1, kType)});
+
+    Storage::TraceReader reader;
+    ASSERT_EQ(reader.open(path_), Event::Status::OK);
+    Event::SensorRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(Util::Clock::toWallNs(record.timestamp_ns), base);
+    EXPECT_EQ(Event::deviceName(record.device_id), "PressureSensor_3");
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.sequence, 1u);
+    EXPECT_FALSE(reader.next(record));
+
+    reader.rewind();
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.sequence, 0u);
+}
+
+TEST_F(ReplaySimulatorTest, ReplaysTraceAsFastAsPossible)
+{
+    std::vector<Event::SensorRecord> records;
+    const int64_t base = 1767225600000000000LL;
+    for (uint64_t i = 0; i < 500; ++i)
+    {
+        const int64_t wall_ns = base + static_cast<int64_t>(i) * 1000000000LL; // 1 s apart
+        records.push_back(makeRecord(kDevice, wall_ns, static_cast<double>(i), i, kType));
+    }
+    writeTrace(records);
+
+    SensorSimulator::ReplaySimulator::ReplayOptions options;
+    options.speed = 0.0;
+    SensorSimulator::ReplaySimulator replay(event_bus_, path_, options);
+    const auto started = std::chrono::steady_clock::now();
+    replay.runSimulation();
+    event_bus_.stop();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(5));
+    EXPECT_EQ(replay.getReplayedCount(), 500u);
+    ASSERT_EQ(records_.size(), 500u);
+    for (uint64_t i = 0; i < 500; ++i)
+    {
+        EXPECT_EQ(records_[i].sequence, i);
+        EXPECT_EQ(Util::Clock::toWallNs(records_[i].timestamp_ns), base + static_cast<int64_t>(i) * 1000000000LL);
+    }
+}
+
+TEST_F(ReplaySimulatorTest, ReplaysJournalAtScaledSpeed)
+{
+    std::vector<Event::SensorRecord> records;
+    const int64_t base = 1767225600000000000LL;
+    for (uint64_t i = 0; i < 6; ++i)
+    {
+        const int64_t wall_ns = base + static_cast<int64_t>(i) * 40000000LL; // 40 ms apart
+        records.push_back(makeRecord(kDevice, wall_ns, static_cast<double>(i), i, kType));
+    }
+    writeJournal(records);
+
+    SensorSimulator::ReplaySimulator::ReplayOptions options;
+    options.speed = 10.0; // 200 ms recorded -> 20 ms replayed
+    SensorSimulator::ReplaySimulator replay(event_bus_, path_, options);
+    const auto started = std::chrono::steady_clock::now();
+    replay.runSimulation();
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    event_bus_.stop();
+
+    EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(150));
+    ASSERT_EQ(records_.size(), 6u);
+    for (uint64_t i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(records_[i].sequence, i);
+        EXPECT_EQ(Event::deviceName(records_[i].device_id), "PressureSensor_3");
+    }
+}
+
+TEST_F(ReplaySimulatorTest, BacklogStaysBounded)
+{
+    std::vector<Event::SensorRecord> records;
+    for (uint64_t i = 0; i < 200; ++i)
+    {
+        records.push_back(makeRecord(kDevice, 1767225600000000000LL, static_cast<double>(i), i, kType));
+    }
+    writeTrace(records);
+
+    std::atomic<uint64_t> max_backlog{0};
+    event_bus_.subscribe([this, &max_backlog](const Event::Event&) {
+        const EventBus::Stats stats = event_bus_.getStats();
+        const uint64_t backlog = stats.published - stats.dispatched;
+        if (backlog > max_backlog) {
+            max_backlog = backlog;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    });
+
+    SensorSimulator::ReplaySimulator::ReplayOptions options;
+    options.speed = 0.0;
+    options.batch_size = 4;
+    options.max_in_flight = 16;
+    SensorSimulator::ReplaySimulator replay(event_bus_, path_, options);
+    replay.runSimulation();
+    event_bus_.stop();
+
+    EXPECT_EQ(records_.size(), 200u);
+    EXPECT_LE(max_backlog.load(), 16u);
+}
+
+TEST_F(ReplaySimulatorTest, StopInterruptsWait)
+{
+    const int64_t base = 1767225600000000000LL;
+    writeTrace({makeRecord(kDevice, base, 0.0, 0, kType),
+                makeRecord(kDevice, base + 60LL * 1000000000LL, 1.0, 1, kType)}); // A minute apart
+
+    SensorSimulator::ReplaySimulator replay(event_bus_, path_);
+    std::thread runner([&replay]() { replay.runSimulation(); });
+    while (replay.getReplayedCount() == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto stop_time = std::chrono::steady_clock::now();
+    replay.stopSimulation();
+    runner.join();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - stop_time, std::chrono::milliseconds(200));
+    EXPECT_EQ(replay.getReplayedCount(), 1u);
+}
+
+TEST_F(ReplaySimulatorTest, LoopsUntilStopped)
+{
+    const int64_t base = 1767225600000000000LL;
+    writeTrace({makeRecord(kDevice, base, 0.0, 0, kType), makeRecord(kDevice, base, 1.0, 1, kType)});
+
+    SensorSimulator::ReplaySimulator::ReplayOptions options;
+    options.speed = 0.0;
+    options.loop = true;
+    SensorSimulator::ReplaySimulator replay(event_bus_, path_, options);
+    std::thread runner([&replay]() { replay.runSimulation(); });
+    while (replay.getReplayedCount() < 10)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    replay.stopSimulation();
+    runner.join();
+    event_bus_.stop();
+
+    ASSERT_GE(records_.size(), 10u);
+    for (std::size_t i = 0; i < records_.size(); ++i)
+    {
+        EXPECT_EQ(records_[i].sequence, i % 2);
+    }
+}
+
+TEST_F(ReplaySimulatorTest, MissingRecordingFailsToOpen)
+{
+    SensorSimulator::ReplaySimulator replay(event_bus_, path_ + "_missing");
+
+    EXPECT_EQ(replay.open(), Event::Status::ERROR);
+    replay.runSimulation(); // Returns at once
+    EXPECT_EQ(replay.getReplayedCount(), 0u);
+}
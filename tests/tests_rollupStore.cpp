@@ -0,0 +1,284 @@
+/**
+ * @file tests_rollupStore.cpp
+ * @brief Unit tests for Storage::RollupStore and Storage::QuantileSketch
+ *
+ * Test suite covering:
+ * - Quantile accuracy, merging and serialization of the sketch
+ * - Incremental 1 s / 1 min / 1 h buckets, including open ones in queries
+ * - Persistence across runs and recovery from a torn last entry
+ * - Late readings merged at query time, idle series closed, faults skipped
+ * - Queries reading only the indexed part of a tier file, rebuilt on open
+ * - Queries racing with buckets being closed never counting a reading twice
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Storage/RollupStore.h"
+#include "Storage/QuantileSketch.h"
+#include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+#include "testHelpers.h"
+
+using TestHelpers::makeRecord;
+
+/**
+ * @class RollupStoreTest
+ * @brief Test fixture giving each test an empty rollup directory
+ */
+class RollupStoreTest : public TestHelpers::ScratchPathTest
+{
+protected:
+    static constexpr int64_t kBase = 1767225600000000000LL;   ///< 2026-01-01T00:00:00Z, hour aligned
+    static constexpr int64_t kSecond = 1000000000LL;          ///< One second in nanoseconds
+
+    /** @brief Names the rollup directory "rollup_<test name>" */
+    RollupStoreTest() : ScratchPathTest("rollup_") {}
+};
+
+TEST_F(RollupStoreTest, SketchQuantilesWithinRelativeError)
+{
+    Storage::QuantileSketch low;
+    Storage::QuantileSketch high;
+    for (int i = 1; i <= 10000; ++i)
+    {
+        (i <= 5000 ? low : high).add(static_cast<double>(i));
+    }
+    ASSERT_EQ(low.merge(high), Event::Status::OK);
+    EXPECT_EQ(low.count(), 10000u);
+    for (double q : {0.01, 0.25, 0.5, 0.9, 0.99})
+    {
+        const double exact = std::floor(q * 9999.0) + 1.0;
+        EXPECT_NEAR(low.quantile(q), exact, exact * 0.011) << "q=" << q;
+    }
+
+    Storage::QuantileSketch mixed;
+    for (double value : {-100.0, -1.0, 0.0, 0.0, 1.0, 100.0, std::nan("")})
+    {
+        mixed.add(value);
+    }
+    EXPECT_EQ(mixed.count(), 6u);
+    EXPECT_NEAR(mixed.quantile(0.0), -100.0, 1.0);
+    EXPECT_EQ(mixed.quantile(0.5), 0.0);
+    EXPECT_NEAR(mixed.quantile(1.0), 100.0, 1.0);
+
+    std::vector<uint8_t> bytes;
+    mixed.serialize(bytes);
+    Storage::QuantileSketch copy(0.05);
+    ASSERT_EQ(Storage::QuantileSketch::deserialize(bytes.data(), bytes.size(), copy), Event::Status::OK);
+    EXPECT_EQ(copy.count(), mixed.count());
+    EXPECT_EQ(copy.quantile(0.2), mixed.quantile(0.2));
+    EXPECT_EQ(Storage::QuantileSketch::deserialize(bytes.data(), bytes.size() - 1, copy), Event::Status::ERROR);
+    EXPECT_EQ(Storage::QuantileSketch(0.05).merge(mixed), Event::Status::ERROR);
+    EXPECT_TRUE(std::isnan(Storage::QuantileSketch().quantile(0.5)));
+}
+
+TEST_F(RollupStoreTest, SketchStaysBounded)
+{
+    Storage::QuantileSketch sketch(0.01, 64);
+    std::vector<double> values;
+    for (int i = 0; i < 100000; ++i)
+    {
+        values.push_back(std::pow(10.0, (i % 1200) / 100.0)); // 12 orders of magnitude
+        sketch.add(values.back());
+    }
+    std::sort(values.begin(), values.end());
+    std::vector<uint8_t> bytes;
+    sketch.serialize(bytes);
+    EXPECT_LE(bytes.size(), 32u + 64u * 12u);
+    const double exact = values[98999]; // Upper values keep their accuracy
+    EXPECT_NEAR(sketch.quantile(0.99), exact, exact * 0.01);
+}
+
+TEST_F(RollupStoreTest, MaintainsTiersIncrementally)
+{
+    Storage::RollupStore store;
+    ASSERT_EQ(store.open(path_), Event::Status::OK);
+
+    // 10 readings per second for 130 s; value = second of the minute
+    for (int64_t i = 0; i < 1300; ++i)
+    {
+        const int64_t wall = kBase + i * (kSecond / 10);
+        store.add(makeRecord(1, wall, static_cast<double>((i / 10) % 60)));
+    }
+
+    const auto seconds = store.query(Storage::RollupTier::Second, "TempSensor_1", kBase, kBase + 130 * kSecond);
+    ASSERT_EQ(seconds.size(), 130u);
+    EXPECT_EQ(seconds[5].start_ns, kBase + 5 * kSecond);
+    EXPECT_EQ(seconds[5].count, 10u);
+    EXPECT_EQ(seconds[5].min, 5.0);
+    EXPECT_EQ(seconds[129].count, 10u); // Still open
+
+    const auto minutes = store.query(Storage::RollupTier::Minute, "", kBase, kBase + 3600 * kSecond);
+    ASSERT_EQ(minutes.size(), 3u);
+    EXPECT_EQ(minutes[0].count, 600u);
+    EXPECT_EQ(minutes[0].max, 59.0);
+    EXPECT_DOUBLE_EQ(minutes[0].mean(), 29.5);
+    EXPECT_NEAR(minutes[0].sketch.quantile(0.5), 29.5, 0.6);
+    EXPECT_EQ(minutes[2].count, 100u);
+
+    const auto hours = store.query(Storage::RollupTier::Hour, "", kBase, kBase + 3600 * kSecond);
+    ASSERT_EQ(hours.size(), 1u);
+    EXPECT_EQ(hours[0].count, 1300u);
+    EXPECT_EQ(hours[0].device, "TempSensor_1");
+    EXPECT_EQ(hours[0].type, Event::SensorType::TempSensor);
+
+    const auto stats = store.getStats();
+    EXPECT_EQ(stats.readings, 1300u);
+    EXPECT_EQ(stats.open_buckets, 3u);
+    EXPECT_EQ(stats.closed_buckets, 129u + 2u);
+}
+
+TEST_F(RollupStoreTest, PersistsAcrossRunsAndRecoversTornTail)
+{
+    {
+        Storage::RollupStore store;
+        ASSERT_EQ(store.open(path_), Event::Status::OK);
+        for (int64_t i = 0; i < 120; ++i)
+        {
+            store.add(makeRecord(2, kBase + i * kSecond, static_cast<double>(i)));
+        }
+    } // Destructor persists the open buckets
+
+    {
+        std::ofstream file(path_ + "/rollup-1m.log", std::ios::binary | std::ios::app);
+        file << "torn entry"; // A crash in the middle of an append
+    }
+
+    Storage::RollupStore store;
+    ASSERT_EQ(store.open(path_), Event::Status::OK);
+    store.add(makeRecord(2, kBase + 120 * kSecond, 120.0));
+    store.flush();
+
+    const auto minutes = store.query(Storage::RollupTier::Minute, "TempSensor_2", kBase, kBase + 3600 * kSecond);
+    ASSERT_EQ(minutes.size(), 3u);
+    EXPECT_EQ(minutes[1].count, 60u);
+    EXPECT_EQ(minutes[1].min, 60.0);
+    EXPECT_DOUBLE_EQ(minutes[1].sum, (60.0 + 119.0) * 30.0);
+    EXPECT_EQ(minutes[2].count, 1u);
+    EXPECT_EQ(store.query(Storage::RollupTier::Hour, "", kBase, kBase + 3600 * kSecond).at(0).count, 121u);
+}
+
+TEST_F(RollupStoreTest, LateReadingsMergeAtQueryTime)
+{
+    Storage::RollupStore store;
+    ASSERT_EQ(store.open(path_), Event::Status::OK);
+    for (int64_t i = 0; i < 5; ++i)
+    {
+        store.add(makeRecord(3, kBase + i * kSecond, 1.0));
+    }
+    store.add(makeRecord(3, kBase + 2 * kSecond + 500, 7.0)); // Second 2 was already closed
+
+    EXPECT_EQ(store.getStats().late_readings, 1u);
+    const auto seconds = store.query(Storage::RollupTier::Second, "TempSensor_3", kBase + 2 * kSecond,
+                                     kBase + 3 * kSecond);
+    ASSERT_EQ(seconds.size(), 1u);
+    EXPECT_EQ(seconds[0].count, 2u);
+    EXPECT_EQ(seconds[0].max, 7.0);
+    EXPECT_EQ(seconds[0].sketch.count(), 2u);
+    EXPECT_EQ(store.query(Storage::RollupTier::Minute, "", kBase, kBase + 60 * kSecond).at(0).count, 6u);
+}
+
+TEST_F(RollupStoreTest, QueriesReadOnlyIndexedRange)
+{
+    constexpr int64_t kSeconds = 3 * 3600;
+    const auto readOneMinute = [](Storage::RollupStore& store) {
+        const uint64_t before = store.getStats().bytes_queried;
+        const auto seconds = store.query(Storage::RollupTier::Second, "", kBase + 7200 * kSecond,
+                                         kBase + 7260 * kSecond);
+        EXPECT_EQ(seconds.size(), 60u);
+        EXPECT_EQ(seconds.at(0).count, 1u);
+        return store.getStats().bytes_queried - before;
+    };
+
+    uint64_t file_size = 0;
+    {
+        Storage::RollupStore store;
+        ASSERT_EQ(store.open(path_), Event::Status::OK);
+        for (int64_t i = 0; i < kSeconds; ++i)
+        {
+            store.add(makeRecord(6, kBase + i * kSecond, static_cast<double>(i)));
+        }
+        store.flush();
+        file_size = std::filesystem::file_size(path_ + "/rollup-1s.log");
+        EXPECT_LT(readOneMinute(store), 3 * 16 * 1024u);
+    }
+    ASSERT_GT(file_size, 10 * 16 * 1024u);
+
+    // The index is rebuilt from the file
+    Storage::RollupStore store;
+    ASSERT_EQ(store.open(path_), Event::Status::OK);
+    EXPECT_LT(readOneMinute(store), 3 * 16 * 1024u);
+    EXPECT_EQ(store.query(Storage::RollupTier::Second, "", kBase, kBase + kSeconds * kSecond).size(),
+              static_cast<std::size_t>(kSeconds));
+    EXPECT_GE(store.getStats().bytes_queried, file_size);
+}
+
+TEST_F(RollupStoreTest, QueryRacingFlushCountsEachReadingOnce)
+{
+    Storage::RollupStore store;
+    ASSERT_EQ(store.open(path_), Event::Status::OK);
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int64_t i = 0; i < 20000; ++i)
+        {
+            store.add(makeRecord(7, kBase, 1.0));   // Always the same bucket
+            if (i % 10 == 0) {
+                store.flush();
+            }
+        }
+        done = true;
+    });
+
+    while (!done)
+    {
+        const uint64_t before = store.getStats().readings;
+        const auto hours = store.query(Storage::RollupTier::Hour, "TempSensor_7", kBase, kBase + 3600 * kSecond);
+        const uint64_t after = store.getStats().readings;
+        const uint64_t counted = hours.empty() ? 0 : hours[0].count;
+        ASSERT_GE(counted, before);
+        ASSERT_LE(counted, after);
+    }
+    writer.join();
+    EXPECT_EQ(store.query(Storage::RollupTier::Hour, "", kBase, kBase + 3600 * kSecond).at(0).count, 20000u);
+}
+
+TEST_F(RollupStoreTest, ClosesIdleSeriesAndSkipsFaults)
+{
+    Storage::RollupStore store;
+    Storage::RollupStore::Options options;
+    options.idle_timeout = std::chrono::milliseconds(20);
+    ASSERT_EQ(store.open(path_, options), Event::Status::OK);
+
+    EventBus event_bus;
+    store.attach(event_bus);
+    event_bus.start();
+    event_bus.publish(std::make_unique<Event::SensorEvent>(makeRecord(4, kBase, 10.0)));
+    Event::SensorRecord fault = makeRecord(4, kBase, 0.0);
+    fault.flags = Event::SensorRecord::kFaultFlag;
+    event_bus.publish(std::make_unique<Event::SensorEvent>(fault));
+
+    // Another device keeps publishing; device 4's buckets close once it is idle
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (store.getStats().closed_buckets < 3 && std::chrono::steady_clock::now() < deadline)
+    {
+        event_bus.publish(std::make_unique<Event::SensorEvent>(makeRecord(5, kBase, 1.0)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    event_bus.stop();
+
+    const auto stats = store.getStats();
+    EXPECT_GE(stats.closed_buckets, 3u);
+    const auto hours = store.query(Storage::RollupTier::Hour, "TempSensor_4", kBase, kBase + 3600 * kSecond);
+    ASSERT_EQ(hours.size(), 1u);
+    EXPECT_EQ(hours[0].count, 1u); // The fault was not aggregated
+    EXPECT_EQ(hours[0].min, 10.0);
+}
@@ -5,11 +5,12 @@
  * Comprehensive test suite covering:
  * - Construction of all sensor types (CO, Temperature, Pressure)
  * - Device ID generation and formatting
- * - Timestamp handling (Unix time and formatted strings)
+ * - Timestamp handling (monotonic, wall-clock and formatted strings)
  * - Value ranges for each sensor type
- * - recalc() method for updating sensor readings
  * - Fault simulation (0.0 value with ~1% probability)
  * - Operator overloads (inequality comparison)
+ * - Type ids and event_cast downcasts
+ * - Compact SensorRecord representation and construction from a record
  * 
  * Tests validate that sensor events maintain correct type-specific characteristics
  * and ranges throughout their lifecycle.
@@ -20,6 +21,7 @@
 #include <chrono>
 #include "Event/Event.h"
 #include "Event/SensorEvent.h"
+#include "Event/SensorRecord.h"
 
 /**
  * @class SensorEventTest
@@ -106,39 +108,6 @@ TEST_F(SensorEventTest, TimestampStringCustomFormat)
     EXPECT_EQ(timestamp_str.length(), 10);
 }
 
-TEST_F(SensorEventTest, RecalcUpdatesValue)
-{
-    Event::SensorEvent event(Event::SensorType::CoSensor);
-    
-    double initial_value = event.getValue();
-    std::time_t initial_timestamp = event.getTimestamp();
-    
-    // Wait a bit to ensure timestamp changes
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    
-    event.recalc();
-    
-    // Timestamp should be updated
-    EXPECT_GE(event.getTimestamp(), initial_timestamp);
-    
-    // Value might be the same or different (due to randomness)
-    // but should still be in valid range
-    EXPECT_GE(event.getValue(), 0.0);
-    EXPECT_LE(event.getValue(), 150.0);
-}
-
-TEST_F(SensorEventTest, RecalcMultipleTimes)
-{
-    Event::SensorEvent event(Event::SensorType::TempSensor);
-    
-    for (int i = 0; i < 10; ++i)
-    {
-        event.recalc();
-        EXPECT_GE(event.getValue(), 0.0);
-        EXPECT_LE(event.getValue(), 30.0);
-    }
-}
-
 TEST_F(SensorEventTest, NotEqualOperatorSameType)
 {
     Event::SensorEvent event1(Event::SensorType::CoSensor);
@@ -177,24 +146,6 @@ TEST_F(SensorEventTest, FaultValueCanOccur)
     EXPECT_TRUE(fault_occurred);
 }
 
-TEST_F(SensorEventTest, RecalcFaultValueCanOccur)
-{
-    Event::SensorEvent event(Event::SensorType::TempSensor);
-    bool fault_occurred = false;
-    
-    for (int i = 0; i < 1000; ++i)
-    {
-        event.recalc();
-        if (event.getValue() == 0.0)
-        {
-            fault_occurred = true;
-            break;
-        }
-    }
-    
-    EXPECT_TRUE(fault_occurred);
-}
-
 TEST_F(SensorEventTest, BaseEventPointer)
 {
     Event::SensorEvent sensor_event(Event::SensorType::CoSensor);
@@ -208,6 +159,34 @@ TEST_F(SensorEventTest, BaseEventPointer)
     EXPECT_NE(derived_ptr, nullptr);
 }
 
+TEST_F(SensorEventTest, CarriesSensorTypeId)
+{
+    Event::SensorEvent sensor_event(Event::SensorType::TempSensor);
+    const Event::Event& base = sensor_event;
+
+    EXPECT_EQ(base.getType(), Event::EventType::Sensor);
+    EXPECT_EQ(Event::SensorEvent::kType, Event::EventType::Sensor);
+}
+
+TEST_F(SensorEventTest, EventCastMatchesTypeId)
+{
+    Event::SensorEvent sensor_event(Event::SensorType::PressureSensor);
+    Event::Event& base = sensor_event;
+    const Event::Event& const_base = sensor_event;
+
+    EXPECT_EQ(Event::event_cast<Event::SensorEvent>(base), &sensor_event);
+    EXPECT_EQ(Event::event_cast<Event::SensorEvent>(const_base), &sensor_event);
+}
+
+TEST_F(SensorEventTest, EventCastRejectsOtherEvents)
+{
+    struct OtherEvent : public Event::Event {};
+    OtherEvent other;
+
+    EXPECT_EQ(other.getType(), Event::EventType::Unknown);
+    EXPECT_EQ(Event::event_cast<Event::SensorEvent>(other), nullptr);
+}
+
 TEST_F(SensorEventTest, MultipleEventsHaveDifferentDeviceIds)
 {
     // Create multiple events and check they have different IDs
@@ -226,3 +205,46 @@ TEST_F(SensorEventTest, MultipleEventsHaveDifferentDeviceIds)
     
     EXPECT_GT(unique_count, 1);
 }
+
+
+TEST_F(SensorEventTest, RecordMatchesAccessors)
+{
+    Event::SensorEvent event(Event::SensorType::PressureSensor);
+    const Event::SensorRecord& record = event.getRecord();
+
+    EXPECT_EQ(record.type, Event::SensorType::PressureSensor);
+    EXPECT_EQ(record.value, event.getValue());
+    EXPECT_EQ(record.timestamp_ns, event.getTimestampNs());
+    EXPECT_EQ(Util::Clock::toWallNs(record.timestamp_ns), event.getWallTimestampNs());
+    EXPECT_EQ(event.getWallTimestampNs() / 1000000000, event.getTimestamp());
+    EXPECT_EQ(Event::deviceName(record.device_id), event.getDeviceId());
+    EXPECT_EQ(event.getDeviceName(), event.getDeviceId());
+    EXPECT_EQ(record.isFault(), event.getValue() == 0.0);
+}
+
+TEST_F(SensorEventTest, ConstructFromRecord)
+{
+    Event::SensorRecord record{};
+    record.timestamp_ns = Util::Clock::fromWallNs(1767225600123456789LL);
+    record.value = 21.5;
+    record.sequence = 7;
+    record.device_id = Event::internDeviceId(Event::SensorType::TempSensor, 42);
+    record.type = Event::SensorType::TempSensor;
+
+    Event::SensorEvent event(record);
+
+    EXPECT_EQ(event.getSensorType(), Event::SensorType::TempSensor);
+    EXPECT_EQ(event.getDeviceId(), "TempSensor_42");
+    EXPECT_EQ(event.getDeviceName(), "TempSensor_42");
+    EXPECT_EQ(event.getDeviceNumber(), record.device_id);
+    EXPECT_EQ(event.getWallTimestampNs(), 1767225600123456789LL);
+    EXPECT_EQ(event.getTimestamp(), 1767225600);
+    EXPECT_EQ(event.getValue(), 21.5);
+    EXPECT_EQ(event.getRecord().sequence, 7u);
+}
+
+TEST_F(SensorEventTest, RecordIsCompactPod)
+{
+    EXPECT_EQ(sizeof(Event::SensorRecord), 32u);
+    EXPECT_TRUE(std::is_trivially_copyable<Event::SensorRecord>::value);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file tests_sensorGenerator.cpp
+ * @brief Unit tests for the SensorGenerator generation model
+ * 
+ * Test suite covering:
+ * - Per-type value ranges and fault readings
+ * - Device number and sequence numbering
+ * - Timestamps of successive readings
+ * - Reproducibility for a fixed random stream
+ * - SensorEvent carrying only the generated observation
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+#include "SensorSimulator/SensorGenerator.h"
+#include "Event/SensorEvent.h"
+#include "Util/Xoshiro256.h"
+
+/**
+ * @class SensorGeneratorTest
+ * @brief Test fixture for SensorGenerator tests
+ * 
+ * Provides a clean test environment for each SensorGenerator test case.
+ */
+class SensorGeneratorTest : public ::testing::Test
+{
+protected:
+    /** @brief Sets up test fixture (currently empty, reserved for future use) */
+    void SetUp() override
+    {
+        // Setup code if needed
+    }
+
+    /** @brief Cleans up test fixture (currently empty, reserved for future use) */
+    void TearDown() override
+    {
+        // Cleanup code if needed
+    }
+};
+
+TEST_F(SensorGeneratorTest, NextUpdatesTimestampAndValue)
+{
+    SensorSimulator::SensorGenerator generator(Event::SensorType::CoSensor);
+
+    Event::SensorRecord first = generator.next();
+
+    // Wait a bit to ensure timestamp changes
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    Event::SensorRecord second = generator.next();
+
+    EXPECT_GT(second.timestamp_ns, first.timestamp_ns);
+    EXPECT_GE(second.value, 0.0);
+    EXPECT_LE(second.value, 150.0);
+}
+
+TEST_F(SensorGeneratorTest, ValuesWithinTypeRange)
+{
+    SensorSimulator::SensorGenerator generator(Event::SensorType::TempSensor);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        Event::SensorRecord record = generator.next();
+        EXPECT_EQ(record.type, Event::SensorType::TempSensor);
+        if (!record.isFault())
+        {
+            EXPECT_GE(record.value, 15.0);
+            EXPECT_LT(record.value, 30.0);
+        }
+    }
+}
+
+TEST_F(SensorGeneratorTest, FaultValueCanOccur)
+{
+    SensorSimulator::SensorGenerator generator(Event::SensorType::TempSensor);
+    bool fault_occurred = false;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        Event::SensorRecord record = generator.next();
+        EXPECT_EQ(record.isFault(), record.value == 0.0);
+        if (record.isFault())
+        {
+            fault_occurred = true;
+        }
+    }
+
+    EXPECT_TRUE(fault_occurred);
+}
+
+TEST_F(SensorGeneratorTest, SameDeviceAndIncreasingSequence)
+{
+    SensorSimulator::SensorGenerator generator(Event::SensorType::PressureSensor);
+
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+        Event::SensorRecord record = generator.next();
+        EXPECT_EQ(record.device_id, generator.getDeviceId());
+        EXPECT_LT(generator.getDeviceNumber(), 10u);
+        EXPECT_EQ(Event::deviceName(record.device_id),
+                  Event::formatDeviceId(Event::SensorType::PressureSensor, generator.getDeviceNumber()));
+        EXPECT_EQ(record.sequence, i);
+    }
+}
+
+TEST_F(SensorGeneratorTest, SameStreamSameReadings)
+{
+    SensorSimulator::SensorGenerator generator1(Event::SensorType::CoSensor, Util::Xoshiro256(99));
+    SensorSimulator::SensorGenerator generator2(Event::SensorType::CoSensor, Util::Xoshiro256(99));
+
+    EXPECT_EQ(generator1.getDeviceNumber(), generator2.getDeviceNumber());
+    EXPECT_EQ(generator1.getDeviceId(), generator2.getDeviceId());
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(generator1.next().value, generator2.next().value);
+    }
+}
+
+TEST_F(SensorGeneratorTest, EventCarriesGeneratedObservation)
+{
+    SensorSimulator::SensorGenerator generator(Event::SensorType::CoSensor);
+    Event::SensorRecord record = generator.next();
+
+    Event::SensorEvent event(record);
+
+    EXPECT_EQ(event.getValue(), record.value);
+    EXPECT_EQ(event.getTimestampNs(), record.timestamp_ns);
+    EXPECT_EQ(event.getDeviceNumber(), record.device_id);
+    EXPECT_EQ(sizeof(Event::SensorEvent), sizeof(Event::Event) + sizeof(Event::SensorRecord));
+}
@@ -0,0 +1,80 @@
+/**
+ * @file tests_sensorTraits.cpp
+ * @brief Unit tests for the compile-time SensorTraits table
+ * 
+ * Test suite covering:
+ * - Table contents and enum ordering
+ * - Compile-time access through sensorTraits<T>()
+ * - Run-time lookup, including unknown types
+ * - Traits surfaced through SensorEvent and the simulators
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include "Event/SensorTraits.h"
+#include "Event/SensorEvent.h"
+#include "EventBus/EventBus.h"
+#include "SensorSimulator/GenericSimulator.h"
+
+/**
+ * @class SensorTraitsTest
+ * @brief Test fixture for SensorTraits tests
+ */
+class SensorTraitsTest : public ::testing::Test
+{
+};
+
+// Trait rows are usable in constant expressions
+static_assert(Event::sensorTraits<Event::SensorType::CoSensor>().range == 100, "CO range");
+static_assert(Event::sensorTraits<Event::SensorType::PressureSensor>().base_value == 1013.25, "pressure base");
+static_assert(Event::findSensorTraits(static_cast<Event::SensorType>(200)) == nullptr, "unknown type");
+
+TEST_F(SensorTraitsTest, TableHasOneRowPerType)
+{
+    EXPECT_EQ(Event::kSensorTypeCount, 3u);
+    EXPECT_TRUE(Event::sensorTraitsInEnumOrder());
+}
+
+TEST_F(SensorTraitsTest, RowsDescribeEachType)
+{
+    const Event::SensorTraits& co = Event::sensorTraits<Event::SensorType::CoSensor>();
+    EXPECT_STREQ(co.name, "CoSensor");
+    EXPECT_STREQ(co.unit, "ppm");
+    EXPECT_EQ(co.base_value, 50.0);
+    EXPECT_EQ(co.fault_one_in, 100u);
+
+    const Event::SensorTraits& temp = Event::sensorTraits<Event::SensorType::TempSensor>();
+    EXPECT_STREQ(temp.name, "TempSensor");
+    EXPECT_EQ(temp.base_value, 15.0);
+    EXPECT_EQ(temp.range, 15u);
+
+    const Event::SensorTraits& pressure = Event::sensorTraits<Event::SensorType::PressureSensor>();
+    EXPECT_STREQ(pressure.unit, "hPa");
+    EXPECT_EQ(pressure.range, 20u);
+}
+
+TEST_F(SensorTraitsTest, RuntimeLookup)
+{
+    Event::SensorTraits traits{};
+    EXPECT_EQ(Event::getSensorTraits(Event::SensorType::TempSensor, traits), Event::Status::OK);
+    EXPECT_EQ(traits.type, Event::SensorType::TempSensor);
+    EXPECT_EQ(Event::getSensorTraits(static_cast<Event::SensorType>(99), traits), Event::Status::ERROR);
+
+    EXPECT_STREQ(Event::getSensorTypeName(Event::SensorType::PressureSensor), "PressureSensor");
+    EXPECT_STREQ(Event::getSensorTypeName(static_cast<Event::SensorType>(99)), "Unknown");
+}
+
+TEST_F(SensorTraitsTest, SensorEventReportsUnit)
+{
+    Event::SensorEvent co_event(Event::SensorType::CoSensor);
+    Event::SensorEvent temp_event(Event::SensorType::TempSensor);
+
+    EXPECT_STREQ(co_event.getUnit(), "ppm");
+    EXPECT_STREQ(temp_event.getUnit(), Event::sensorTraits<Event::SensorType::TempSensor>().unit);
+}
+
+TEST_F(SensorTraitsTest, SimulatorExposesTraits)
+{
+    using PressureSim = SensorSimulator::GenericSimulator<Event::SensorType::PressureSensor, 1>;
+    EXPECT_EQ(&PressureSim::kTraits, &Event::sensorTraits<Event::SensorType::PressureSensor>());
+}
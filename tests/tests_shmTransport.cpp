@@ -0,0 +1,306 @@
+/**
+ * @file tests_shmTransport.cpp
+ * @brief Unit tests for Transport::ShmRing, ShmSender and ShmReceiver
+ *
+ * Test suite covering:
+ * - Frame order and contents across many wraps of the ring
+ * - Uncommitted frames staying invisible, single holder per role
+ * - Readings published in a forked process dispatched in this one
+ * - A dead receiver not blocking the sender, and its frames re-delivered
+ * - A dead sender losing only uncommitted frames, and its role taken over
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Transport/ShmRing.h"
+#include "Transport/ShmSender.h"
+#include "Transport/ShmReceiver.h"
+#include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+#include "Event/WireFormat.h"
+#include "testHelpers.h"
+
+using TestHelpers::waitFor;
+using TestHelpers::makeRecord;
+
+/**
+ * @class ShmTransportTest
+ * @brief Test fixture giving each test its own ring name
+ *
+ * Peer processes are forked; the test reaps them with waitForChild() before
+ * expecting them to be seen as dead (an unreaped zombie still exists).
+ */
+class ShmTransportTest : public ::testing::Test
+{
+protected:
+    /** @brief Picks a ring name unique to the test and process */
+    void SetUp() override
+    {
+        name_ = "/evbus_test_" + std::to_string(::getpid()) + "_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        Transport::ShmRing::unlink(name_);
+    }
+
+    /** @brief Removes the ring */
+    void TearDown() override
+    {
+        Transport::ShmRing::unlink(name_);
+    }
+
+    /**
+     * @brief Runs a function in a forked child process
+     * @param body Child's work; its return value is the exit status
+     * @return Child's process id
+     */
+    static pid_t runChild(const std::function<int()>& body)
+    {
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            ::_exit(body()); // Skips gtest and coverage teardown in the child
+        }
+        return pid;
+    }
+
+    /**
+     * @brief Reaps a child process
+     * @param pid Child's process id
+     * @return Exit status, or 128 + signal if it was killed
+     */
+    static int waitForChild(pid_t pid)
+    {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    }
+
+    std::string name_;   ///< Ring name of the test
+};
+
+TEST_F(ShmTransportTest, RingKeepsFramesInOrderAcrossWraps)
+{
+    Transport::ShmRing producer;
+    Transport::ShmRing consumer;
+    ASSERT_EQ(producer.open(name_, Transport::ShmRing::Role::Producer, 4096), Event::Status::OK);
+    ASSERT_EQ(consumer.open(name_, Transport::ShmRing::Role::Consumer), Event::Status::OK);
+    EXPECT_EQ(consumer.capacity(), 4096u);
+    EXPECT_EQ(producer.reserve(producer.maxPayloadSize() + 1, std::chrono::milliseconds(0)), nullptr);
+
+    const auto payloadSize = [](uint32_t frame) { return 5 + (frame * 37) % 300; };
+    uint32_t written = 0;
+    uint32_t consumed = 0;
+    const auto check = [&](const uint8_t* payload, std::size_t size) {
+        uint32_t frame = 0;
+        std::memcpy(&frame, payload, sizeof(frame));
+        EXPECT_EQ(frame, consumed);
+        EXPECT_EQ(size, payloadSize(frame));
+        EXPECT_EQ(payload[size - 1], static_cast<uint8_t>(frame));
+        consumed++;
+    };
+    while (written < 2000)
+    {
+        for (int i = 0; i < 5; ++i) {
+            const std::size_t size = payloadSize(written);
+            uint8_t* payload = producer.reserve(size, std::chrono::milliseconds(0));
+            if (payload == nullptr) {
+                break; // Full until the consumer catches up
+            }
+            std::memset(payload, static_cast<uint8_t>(written), size);
+            std::memcpy(payload, &written, sizeof(written));
+            written++;
+        }
+        producer.commit();
+        consumer.consume(check, 3);
+    }
+    while (consumer.consume(check, 64) > 0) {}
+    EXPECT_EQ(consumed, written);
+
+    // Reserved frames stay invisible until committed
+    ASSERT_NE(producer.reserve(8, std::chrono::milliseconds(0)), nullptr);
+    EXPECT_FALSE(consumer.waitReadable(std::chrono::milliseconds(0)));
+    producer.commit();
+    EXPECT_TRUE(consumer.waitReadable(std::chrono::milliseconds(0)));
+
+    // One live holder per role
+    Transport::ShmRing second;
+    EXPECT_EQ(second.open(name_, Transport::ShmRing::Role::Producer), Event::Status::ERROR);
+    EXPECT_FALSE(producer.tookOver());
+}
+
+TEST_F(ShmTransportTest, DispatchesEventsPublishedInAnotherProcess)
+{
+    constexpr uint64_t kReadings = 20000;
+    for (uint32_t device = 1; device <= 4; ++device) {
+        Event::internDeviceId(Event::SensorType::TempSensor, device);
+    }
+
+    // Fork before this process starts any thread
+    const pid_t child = runChild([this]() {
+        Transport::ShmSender sender;
+        Transport::ShmSender::Options options;
+        options.capacity = 16384;   // Far smaller than the traffic: the sender has to wait
+        options.send_timeout = std::chrono::seconds(5);
+        if (sender.open(name_, options) == Event::Status::ERROR) {
+            return 2;
+        }
+        if (!waitFor([&sender]() { return sender.receiverAlive(); })) {
+            return 3;
+        }
+        for (uint64_t i = 0; i < kReadings; ++i) {
+            if (sender.send(makeRecord(static_cast<uint32_t>(i % 4) + 1, i)) == Event::Status::ERROR) {
+                return 4;
+            }
+        }
+        return 0;
+    });
+    ASSERT_GT(child, 0);
+
+    std::mutex mutex;
+    std::vector<Event::SensorRecord> records;
+    EventBus event_bus;
+    event_bus.subscribe([&](const Event::Event& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        records.push_back(Event::event_cast<Event::SensorEvent>(event)->getRecord());
+    });
+    event_bus.start();
+    Transport::ShmReceiver receiver(event_bus);
+    Transport::ShmReceiver::Options options;
+    options.capacity = 16384;
+    ASSERT_EQ(receiver.open(name_, options), Event::Status::OK);
+
+    EXPECT_EQ(waitForChild(child), 0);
+    EXPECT_TRUE(waitFor([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return records.size() == kReadings;
+    }));
+    EXPECT_FALSE(receiver.senderAlive());
+    receiver.close();
+    event_bus.stop();
+
+    ASSERT_EQ(records.size(), kReadings);
+    for (uint64_t i = 0; i < kReadings; i += 997) {
+        EXPECT_EQ(records[i].sequence, i);
+        EXPECT_EQ(records[i].value, static_cast<double>(i));
+        EXPECT_EQ(records[i].device_id, Event::internDeviceId(Event::SensorType::TempSensor,
+                                                              static_cast<uint32_t>(i % 4) + 1));
+    }
+    EXPECT_EQ(receiver.getStats().received, kReadings);
+    EXPECT_EQ(receiver.getStats().malformed, 0u);
+}
+
+TEST_F(ShmTransportTest, SenderSurvivesDeadReceiver)
+{
+    const pid_t child = runChild([this]() {
+        Transport::ShmRing ring;
+        if (ring.open(name_, Transport::ShmRing::Role::Consumer, 4096) == Event::Status::ERROR) {
+            return 2;
+        }
+        while (true) {
+            ::pause(); // Attached but never consuming, until killed
+        }
+    });
+    ASSERT_GT(child, 0);
+
+    Transport::ShmSender sender;
+    Transport::ShmSender::Options options;
+    options.capacity = 4096;
+    options.send_timeout = std::chrono::seconds(10);
+    ASSERT_EQ(sender.open(name_, options), Event::Status::OK);
+    ASSERT_TRUE(waitFor([&sender]() { return sender.receiverAlive(); }));
+
+    const std::size_t frame_size = Transport::ShmFormat::frameSize(
+        Event::WireFormat::sensorEventSize(Event::deviceName(makeRecord(1, 0).device_id).size()));
+    const uint64_t fits = 4096 / frame_size;
+    for (uint64_t i = 0; i < fits; ++i) {
+        ASSERT_EQ(sender.send(makeRecord(1, i)), Event::Status::OK);
+    }
+
+    ::kill(child, SIGKILL);
+    EXPECT_EQ(waitForChild(child), 128 + SIGKILL);
+    EXPECT_FALSE(sender.receiverAlive());
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(sender.send(makeRecord(1, fits)), Event::Status::ERROR); // Full, and nobody left to wait for
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_EQ(sender.getStats().dropped, 1u);
+
+    // A new receiver takes over the dead one's role and gets what it left behind
+    std::mutex mutex;
+    std::vector<uint64_t> sequences;
+    EventBus event_bus;
+    event_bus.subscribe([&](const Event::Event& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sequences.push_back(Event::event_cast<Event::SensorEvent>(event)->getRecord().sequence);
+    });
+    event_bus.start();
+    Transport::ShmReceiver receiver(event_bus);
+    ASSERT_EQ(receiver.open(name_), Event::Status::OK);
+    EXPECT_TRUE(waitFor([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return sequences.size() == fits;
+    }));
+    EXPECT_EQ(sender.send(makeRecord(1, fits + 1)), Event::Status::OK);
+    EXPECT_TRUE(waitFor([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return sequences.size() == fits + 1;
+    }));
+    receiver.close();
+    event_bus.stop();
+
+    ASSERT_EQ(sequences.size(), fits + 1);
+    EXPECT_EQ(sequences.front(), 0u);
+    EXPECT_EQ(sequences[fits - 1], fits - 1);
+    EXPECT_EQ(sequences.back(), fits + 1);
+}
+
+TEST_F(ShmTransportTest, ReceiverSurvivesDeadSender)
+{
+    const pid_t child = runChild([this]() {
+        Transport::ShmRing ring;
+        if (ring.open(name_, Transport::ShmRing::Role::Producer, 4096) == Event::Status::ERROR) {
+            return 2;
+        }
+        for (uint64_t i = 0; i < 10; ++i) {
+            uint8_t* payload = ring.reserve(sizeof(i), std::chrono::seconds(1));
+            std::memcpy(payload, &i, sizeof(i));
+            ring.commit();
+        }
+        const uint64_t torn = 99;
+        std::memcpy(ring.reserve(sizeof(torn), std::chrono::seconds(1)), &torn, sizeof(torn));
+        ::raise(SIGKILL); // Dies holding the role, with a frame reserved but not committed
+        return 0;
+    });
+    ASSERT_GT(child, 0);
+    EXPECT_EQ(waitForChild(child), 128 + SIGKILL);
+
+    Transport::ShmRing consumer;
+    ASSERT_EQ(consumer.open(name_, Transport::ShmRing::Role::Consumer), Event::Status::OK);
+    EXPECT_FALSE(consumer.peerAlive());
+    std::vector<uint64_t> values;
+    const auto collect = [&values](const uint8_t* payload, std::size_t size) {
+        uint64_t value = 0;
+        std::memcpy(&value, payload, std::min(size, sizeof(value)));
+        values.push_back(value);
+    };
+    EXPECT_EQ(consumer.consume(collect, 64), 10u);
+    EXPECT_EQ(values.back(), 9u);
+
+    Transport::ShmRing producer;
+    ASSERT_EQ(producer.open(name_, Transport::ShmRing::Role::Producer), Event::Status::OK);
+    EXPECT_TRUE(producer.tookOver());
+    EXPECT_TRUE(consumer.peerAlive());
+    const uint64_t next = 10;
+    std::memcpy(producer.reserve(sizeof(next), std::chrono::seconds(1)), &next, sizeof(next));
+    producer.commit();
+    ASSERT_TRUE(consumer.waitReadable(std::chrono::seconds(1)));
+    EXPECT_EQ(consumer.consume(collect, 64), 1u);
+    EXPECT_EQ(values.back(), 10u);
+    EXPECT_EQ(values.size(), 11u);
+}
@@ -0,0 +1,171 @@
+/**
+ * @file tests_simulatorBank.cpp
+ * @brief Unit tests for the structure-of-arrays SimulatorBank
+ *
+ * Test suite covering:
+ * - Construction with varying sensor counts
+ * - Interned device ID assignment per sensor
+ * - Value ranges and fault readings produced by generate()
+ * - Reproducibility for a fixed seed
+ * - Batch publishing through tick() and the runSimulation() stop mechanism
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include "SensorSimulator/SimulatorBank.h"
+#include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+
+/**
+ * @class SimulatorBankTest
+ * @brief Test fixture for SimulatorBank tests
+ *
+ * Provides an EventBus instance that is stopped and destroyed after each test.
+ */
+class SimulatorBankTest : public ::testing::Test
+{
+protected:
+    /** @brief Creates a fresh EventBus before each test */
+    void SetUp() override
+    {
+        event_bus_ = std::make_unique<EventBus>();
+    }
+
+    /** @brief Stops and destroys the EventBus after each test */
+    void TearDown() override
+    {
+        if (event_bus_)
+        {
+            event_bus_->stop();
+        }
+        event_bus_.reset();
+    }
+
+    std::unique_ptr<EventBus> event_bus_;  ///< EventBus instance for testing
+};
+
+/** @test Verifies the bank sizes all of its arrays to the requested sensor count */
+TEST_F(SimulatorBankTest, ConstructWithSensorCount)
+{
+    SensorSimulator::SimulatorBank<Event::SensorType::CoSensor, 1> bank(*event_bus_, 1000, 42);
+
+    EXPECT_EQ(bank.sensorCount(), 1000u);
+    EXPECT_EQ(bank.readings().size(), 1000u);
+    EXPECT_EQ(bank.deviceIds().size(), 1000u);
+}
+
+TEST_F(SimulatorBankTest, DeviceIdsAreUniquePerSensor)
+{
+    SensorSimulator::SimulatorBank<Event::SensorType::TempSensor, 1> bank(*event_bus_, 3, 42);
+
+    EXPECT_EQ(Event::deviceName(bank.deviceIds()[0]), "TempSensor_0");
+    EXPECT_EQ(Event::deviceName(bank.deviceIds()[1]), "TempSensor_1");
+    EXPECT_EQ(Event::deviceName(bank.deviceIds()[2]), "TempSensor_2");
+    EXPECT_NE(bank.deviceIds()[0], bank.deviceIds()[1]);
+}
+
+TEST_F(SimulatorBankTest, GeneratedValuesWithinRange)
+{
+    SensorSimulator::SimulatorBank<Event::SensorType::PressureSensor, 1> bank(*event_bus_, 4096, 7);
+
+    for (int tick = 0; tick < 10; ++tick)
+    {
+        bank.generate();
+        for (double value : bank.readings())
+        {
+            if (value != 0.0)
+            {
+                EXPECT_GE(value, 1013.25);
+                EXPECT_LT(value, 1033.25);
+            }
+        }
+    }
+}
+
+TEST_F(SimulatorBankTest, FaultReadingsOccur)
+{
+    SensorSimulator::SimulatorBank<Event::SensorType::CoSensor, 1> bank(*event_bus_, 10000, 3);
+    bank.generate();
+
+    int faults = 0;
+    for (double value : bank.readings())
+    {
+        if (value == 0.0)
+        {
+            faults++;
+        }
+    }
+
+    // Expected about 100 faults out of 10000 (1%)
+    EXPECT_GT(faults, 30);
+    EXPECT_LT(faults, 300);
+}
+
+TEST_F(SimulatorBankTest, SameSeedSameReadings)
+{
+    SensorSimulator::SimulatorBank<Event::SensorType::CoSensor, 1> bank1(*event_bus_, 256, 1234);
+    SensorSimulator::SimulatorBank<Event::SensorType::CoSensor, 1> bank2(*event_bus_, 256, 1234);
+
+    for (int tick = 0; tick < 5; ++tick)
+    {
+        bank1.generate();
+        bank2.generate();
+        EXPECT_EQ(bank1.readings(), bank2.readings());
+    }
+}
+
+TEST_F(SimulatorBankTest, TickPublishesOneEventPerSensor)
+{
+    std::atomic<int> event_count{0};
+    std::atomic<bool> wrong_type{false};
+
+    event_bus_->subscribe([&event_count, &wrong_type](const Event::Event& event) {
+        const Event::SensorEvent* sensor_event = dynamic_cast<const Event::SensorEvent*>(&event);
+        if (!sensor_event || sensor_event->getSensorType() != Event::SensorType::TempSensor)
+        {
+            wrong_type = true;
+        }
+        event_count++;
+    });
+
+    SensorSimulator::SimulatorBank<Event::SensorType::TempSensor, 1> bank(*event_bus_, 500, 99);
+
+    event_bus_->start();
+    bank.tick();
+    event_bus_->stop();
+
+    EXPECT_EQ(event_count.load(), 500);
+    EXPECT_FALSE(wrong_type.load());
+}
+
+TEST_F(SimulatorBankTest, RunAndStopSimulation)
+{
+    std::atomic<int> event_count{0};
+
+    event_bus_->subscribe([&event_count](const Event::Event&) {
+        event_count++;
+    });
+
+    event_bus_->start();
+
+    SensorSimulator::SimulatorBank<Event::SensorType::PressureSensor, 1> bank(*event_bus_, 100);
+
+    std::thread sim_thread([&bank]() {
+        bank.runSimulation();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    bank.stopSimulation();
+
+    if (sim_thread.joinable())
+    {
+        sim_thread.join();
+    }
+
+    event_bus_->stop();
+
+    // First tick is published immediately
+    EXPECT_EQ(event_count.load(), 100);
+}
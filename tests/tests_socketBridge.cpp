@@ -0,0 +1,304 @@
+/**
+ * @file tests_socketBridge.cpp
+ * @brief Unit tests for Transport::SocketAddress, BridgeSender and BridgeReceiver
+ *
+ * Test suite covering:
+ * - Parsing and formatting of TCP and Unix socket addresses
+ * - Readings forwarded over loopback TCP in order, batched into few frames
+ * - A partial frame sent once its linger expires, over a Unix socket
+ * - Several senders feeding one receiver
+ * - A backed-up receiving bus holding back the sender instead of queueing
+ * - Reconnecting to a restarted receiver, and rejecting malformed frames
+ * - Resending unacknowledged frames after a connection breaks mid-batch
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Transport/SocketAddress.h"
+#include "Transport/BridgeFormat.h"
+#include "Transport/BridgeSender.h"
+#include "Transport/BridgeReceiver.h"
+#include "EventBus/EventBus.h"
+#include "Event/SensorEvent.h"
+#include "testHelpers.h"
+
+using TestHelpers::waitFor;
+using TestHelpers::makeRecord;
+
+/**
+ * @class SocketBridgeTest
+ * @brief Test fixture with a receiving bus that records what it dispatches
+ */
+class SocketBridgeTest : public TestHelpers::RecordingBusTest
+{
+protected:
+    /** @brief Names the Unix socket "bridge_<test name>" */
+    SocketBridgeTest() : RecordingBusTest("bridge_") {}
+};
+
+TEST_F(SocketBridgeTest, ParsesAddresses)
+{
+    Transport::SocketAddress address;
+    ASSERT_EQ(Transport::SocketAddress::parse("tcp:127.0.0.1:9000", address), Event::Status::OK);
+    EXPECT_EQ(address.family, Transport::SocketAddress::Family::Tcp);
+    EXPECT_EQ(address.host, "127.0.0.1");
+    EXPECT_EQ(address.port, 9000);
+    EXPECT_EQ(address.toString(), "tcp:127.0.0.1:9000");
+
+    ASSERT_EQ(Transport::SocketAddress::parse("tcp:[::1]:0", address), Event::Status::OK);
+    EXPECT_EQ(address.host, "::1");
+    EXPECT_EQ(address.toString(), "tcp:[::1]:0");
+
+    ASSERT_EQ(Transport::SocketAddress::parse("unix:/tmp/bridge.sock", address), Event::Status::OK);
+    EXPECT_EQ(address.family, Transport::SocketAddress::Family::Unix);
+    EXPECT_EQ(address.path, "/tmp/bridge.sock");
+
+    for (const char* invalid : {"", "tcp:", "tcp:host", "tcp::9000", "tcp:host:", "tcp:host:70000",
+                                "tcp:host:9x", "udp:host:9000", "unix:"}) {
+        EXPECT_EQ(Transport::SocketAddress::parse(invalid, address), Event::Status::ERROR) << invalid;
+    }
+    Transport::BridgeSender sender;
+    EXPECT_EQ(sender.open("tcp:host"), Event::Status::ERROR);
+    EXPECT_FALSE(sender.isOpen());
+}
+
+TEST_F(SocketBridgeTest, ForwardsReadingsOverTcpInOrder)
+{
+    constexpr uint64_t kReadings = 10000;
+    Transport::BridgeReceiver receiver(event_bus_);
+    ASSERT_EQ(receiver.open("tcp:127.0.0.1:0"), Event::Status::OK);
+    EXPECT_NE(receiver.address(), "tcp:127.0.0.1:0");
+
+    std::vector<Event::SensorRecord> sent;
+    Transport::BridgeSender sender;
+    ASSERT_EQ(sender.open(receiver.address()), Event::Status::OK);
+    for (uint64_t i = 0; i < kReadings; ++i) {
+        sent.push_back(makeRecord(static_cast<uint32_t>(i % 4) + 1, i));
+        ASSERT_EQ(sender.send(sent.back()), Event::Status::OK);
+    }
+    ASSERT_EQ(sender.flush(), Event::Status::OK);
+    ASSERT_TRUE(waitFor([this]() { return receivedCount() == kReadings; }));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (uint64_t i = 0; i < kReadings; ++i) {
+            EXPECT_EQ(records_[i].sequence, i);
+            EXPECT_EQ(records_[i].device_id, sent[i].device_id);
+            EXPECT_EQ(records_[i].type, sent[i].type);
+            EXPECT_DOUBLE_EQ(records_[i].value, sent[i].value);
+            EXPECT_EQ(records_[i].timestamp_ns, sent[i].timestamp_ns);
+        }
+    }
+
+    // Readings travel in batches of up to 256, frames in vectored writes
+    const Transport::BridgeSender::Stats stats = sender.getStats();
+    EXPECT_EQ(stats.sent, kReadings);
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_EQ(stats.connects, 1u);
+    EXPECT_GE(stats.frames, kReadings / 256);
+    EXPECT_LT(stats.frames, kReadings / 10);
+    EXPECT_LE(stats.writes, stats.frames);
+    EXPECT_EQ(receiver.getStats().frames, stats.frames);
+    EXPECT_EQ(receiver.getStats().received, kReadings);
+    EXPECT_EQ(receiver.getStats().malformed, 0u);
+    sender.close();
+    receiver.close();
+    EXPECT_EQ(receiver.address(), "");
+}
+
+TEST_F(SocketBridgeTest, LingerSendsPartialFrameOverUnixSocket)
+{
+    Transport::BridgeReceiver receiver(event_bus_);
+    ASSERT_EQ(receiver.open("unix:" + path_), Event::Status::OK);
+
+    Transport::BridgeSender::Options options;
+    options.linger = std::chrono::milliseconds(20);
+    Transport::BridgeSender sender;
+    ASSERT_EQ(sender.open("unix:" + path_, options), Event::Status::OK);
+    for (uint64_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(sender.send(makeRecord(1, i)), Event::Status::OK);
+    }
+
+    // No flush: the open frame goes out once the first reading has lingered
+    ASSERT_TRUE(waitFor([this]() { return receivedCount() == 5; }));
+    ASSERT_TRUE(waitFor([&sender]() { return sender.getStats().frames == 1; }));   // Once acknowledged
+    EXPECT_EQ(receiver.getStats().frames, 1u);
+    EXPECT_TRUE(sender.isConnected());
+}
+
+TEST_F(SocketBridgeTest, AcceptsSeveralSenders)
+{
+    constexpr uint64_t kReadings = 5000;
+    Transport::BridgeReceiver receiver(event_bus_);
+    ASSERT_EQ(receiver.open("tcp:127.0.0.1:0"), Event::Status::OK);
+
+    std::vector<std::thread> threads;
+    for (uint32_t device = 1; device <= 2; ++device) {
+        threads.emplace_back([&receiver, device]() {
+            Transport::BridgeSender sender;
+            ASSERT_EQ(sender.open(receiver.address()), Event::Status::OK);
+            for (uint64_t i = 0; i < kReadings; ++i) {
+                ASSERT_EQ(sender.send(makeRecord(device, i)), Event::Status::OK);
+            }
+            EXPECT_EQ(sender.flush(), Event::Status::OK);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(waitFor([this]() { return receivedCount() == 2 * kReadings; }));
+    EXPECT_EQ(receiver.getStats().connections, 2u);
+
+    // Each connection's readings keep their order
+    std::map<uint32_t, uint64_t> next;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Event::SensorRecord& record : records_) {
+        EXPECT_EQ(record.sequence, next[record.device_id]++);
+    }
+    EXPECT_EQ(next.size(), 2u);
+}
+
+TEST_F(SocketBridgeTest, BackedUpBusHoldsBackSender)
+{
+    constexpr std::size_t kMaxInFlight = 64;
+    constexpr std::size_t kReadSize = 4096;
+    std::atomic<bool> released{false};
+    event_bus_.subscribe([&released](const Event::Event&) {
+        while (!released.load()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    Transport::BridgeReceiver::Options receiver_options;
+    receiver_options.max_in_flight = kMaxInFlight;
+    receiver_options.read_size = kReadSize;
+    Transport::BridgeReceiver receiver(event_bus_);
+    ASSERT_EQ(receiver.open("unix:" + path_, receiver_options), Event::Status::OK);
+
+    Transport::BridgeSender::Options options;
+    options.batch_size = 32;
+    options.max_pending_bytes = 64u << 10;
+    options.send_timeout = std::chrono::milliseconds(20);
+    Transport::BridgeSender sender;
+    ASSERT_EQ(sender.open("unix:" + path_, options), Event::Status::OK);
+
+    // Far more than socket buffers and max_pending_bytes hold
+    uint64_t accepted = 0;
+    std::size_t largest_backlog = 0;
+    for (uint64_t i = 0; i < 100000 && sender.getStats().dropped == 0; ++i) {
+        if (sender.send(makeRecord(1, i)) == Event::Status::OK) {
+            accepted++;
+        }
+        const EventBus::Stats stats = event_bus_.getStats();
+        largest_backlog = std::max<std::size_t>(largest_backlog, stats.published - stats.dispatched);
+    }
+    EXPECT_GT(sender.getStats().dropped, 0u);
+    EXPECT_LE(largest_backlog, kMaxInFlight + kReadSize / sizeof(Event::WireFormat::SensorEventLayout));
+
+    // Everything the sender accepted arrives once the bus drains
+    released.store(true);
+    ASSERT_TRUE(waitFor([&sender]() { return sender.flush() == Event::Status::OK; }));
+    ASSERT_TRUE(waitFor([this, accepted]() { return receivedCount() == accepted; }));
+    EXPECT_EQ(sender.getStats().sent, accepted);
+    EXPECT_EQ(receiver.getStats().received, accepted);
+}
+
+TEST_F(SocketBridgeTest, ReconnectsAndRejectsMalformedFrames)
+{
+    Transport::BridgeSender::Options options;
+    options.reconnect_interval = std::chrono::milliseconds(10);
+    Transport::BridgeSender sender;
+    ASSERT_EQ(sender.open("unix:" + path_, options), Event::Status::OK);
+
+    // Readings sent before the receiver exists are buffered
+    for (uint64_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(sender.send(makeRecord(1, i)), Event::Status::OK);
+    }
+    EXPECT_FALSE(sender.isConnected());
+    {
+        Transport::BridgeReceiver receiver(event_bus_);
+        ASSERT_EQ(receiver.open("unix:" + path_), Event::Status::OK);
+        ASSERT_TRUE(waitFor([this]() { return receivedCount() == 100; }));
+    }
+
+    // Restarted receiver at the same address
+    Transport::BridgeReceiver receiver(event_bus_);
+    ASSERT_EQ(receiver.open("unix:" + path_), Event::Status::OK);
+    for (uint64_t i = 100; i < 200; ++i) {
+        ASSERT_EQ(sender.send(makeRecord(1, i)), Event::Status::OK);
+    }
+    ASSERT_TRUE(waitFor([this]() { return receivedCount() == 200; }));
+    EXPECT_EQ(sender.getStats().connects, 2u);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (uint64_t i = 0; i < 200; ++i) {
+            EXPECT_EQ(records_[i].sequence, i);
+        }
+    }
+
+    // An entry overrunning its frame closes the connection without publishing
+    Transport::SocketAddress address;
+    ASSERT_EQ(Transport::SocketAddress::parse(receiver.address(), address), Event::Status::OK);
+    const int fd = address.connect();
+    ASSERT_GE(fd, 0);
+    Event::WireFormat::SensorEventLayout entry{};
+    Event::WireFormat::encodeSensorEvent(makeRecord(1, 0), {}, &entry);
+    entry.name_size = 100;
+    Transport::BridgeFormat::FrameHeader header{Transport::BridgeFormat::kFrameMagic, sizeof(entry), 1, 0};
+    ASSERT_EQ(::send(fd, &header, sizeof(header), MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(header)));
+    ASSERT_EQ(::send(fd, &entry, sizeof(entry), MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(entry)));
+    ASSERT_TRUE(waitFor([&receiver]() { return receiver.getStats().malformed == 1; }));
+    ASSERT_TRUE(waitFor([&receiver]() { return receiver.getStats().active_connections == 1; }));
+    ::close(fd);
+    EXPECT_EQ(receivedCount(), 200u);
+}
+
+TEST_F(SocketBridgeTest, ResendsUnacknowledgedFramesAfterBreak)
+{
+    constexpr uint64_t kReadings = 2000;
+    Transport::SocketAddress address;
+    ASSERT_EQ(Transport::SocketAddress::parse("unix:" + path_, address), Event::Status::OK);
+    const int listen_fd = address.listen(1);
+    ASSERT_GE(listen_fd, 0);
+
+    Transport::BridgeSender::Options options;
+    options.batch_size = 50;
+    options.reconnect_interval = std::chrono::milliseconds(10);
+    Transport::BridgeSender sender;
+    ASSERT_EQ(sender.open("unix:" + path_, options), Event::Status::OK);
+    for (uint64_t i = 0; i < kReadings; ++i) {
+        ASSERT_EQ(sender.send(makeRecord(1, i)), Event::Status::OK);
+    }
+
+    // A peer that takes a few frames, never acknowledges them and goes away
+    const int fd = ::accept(listen_fd, nullptr, nullptr);
+    ASSERT_GE(fd, 0);
+    std::vector<uint8_t> bytes(3000);
+    ASSERT_EQ(::recv(fd, bytes.data(), bytes.size(), MSG_WAITALL), static_cast<ssize_t>(bytes.size()));
+    ::close(fd);
+    ::close(listen_fd);
+    ::unlink(path_.c_str());
+
+    Transport::BridgeReceiver receiver(event_bus_);
+    ASSERT_EQ(receiver.open("unix:" + path_), Event::Status::OK);
+    ASSERT_EQ(sender.flush(), Event::Status::OK);
+    ASSERT_TRUE(waitFor([this]() { return receivedCount() == kReadings; }));
+
+    const Transport::BridgeSender::Stats stats = sender.getStats();
+    EXPECT_EQ(stats.sent, kReadings);
+    EXPECT_GE(stats.connects, 2u);   // The sender may get in once more before the listener closes
+    EXPECT_GE(stats.resent, options.batch_size);   // At least the frames the peer took in full
+    EXPECT_EQ(stats.dropped, 0u);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint64_t i = 0; i < kReadings; ++i) {
+        EXPECT_EQ(records_[i].sequence, i);
+    }
+}
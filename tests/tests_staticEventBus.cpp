@@ -0,0 +1,186 @@
+/**
+ * @file tests_staticEventBus.cpp
+ * @brief Unit tests for the compile-time StaticEventBus
+ * 
+ * Test suite covering:
+ * - Lifecycle: start, stop, idempotency, destructor drain
+ * - Dispatch of value-stored events to inlined handlers
+ * - Handlers accepting only some of the event types
+ * - FIFO ordering across single and batch publishing
+ * - Concurrent publishers
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "EventBus/StaticEventBus.h"
+#include "Event/SensorEvent.h"
+
+namespace
+{
+
+/** @brief Small non-sensor event used to test multi-type buses */
+struct TextEvent
+{
+    std::string text;  ///< Payload
+};
+
+/** @brief Builds a SensorEvent with a given sequence number */
+Event::SensorEvent makeSensorEvent(uint64_t sequence, double value = 1.0)
+{
+    Event::SensorRecord record{};
+    record.sequence = sequence;
+    record.value = value;
+    record.type = Event::SensorType::TempSensor;
+    return Event::SensorEvent(record);
+}
+
+} // namespace
+
+/**
+ * @class StaticEventBusTest
+ * @brief Test fixture for StaticEventBus tests
+ */
+class StaticEventBusTest : public ::testing::Test
+{
+};
+
+TEST_F(StaticEventBusTest, DispatchesToHandler)
+{
+    double sum = 0.0;
+    StaticEventBus bus(EventList<Event::SensorEvent>{},
+                       [&sum](const Event::SensorEvent& event) { sum += event.getValue(); });
+
+    bus.start();
+    for (int i = 0; i < 100; ++i)
+    {
+        bus.publish(makeSensorEvent(i, 2.0));
+    }
+    bus.stop();
+
+    EXPECT_DOUBLE_EQ(sum, 200.0);
+    EXPECT_EQ(bus.publishedCount(), 100u);
+    EXPECT_EQ(bus.dispatchedCount(), 100u);
+}
+
+TEST_F(StaticEventBusTest, HandlersSelectEventTypes)
+{
+    int sensor_count = 0;
+    int text_count = 0;
+    int any_count = 0;
+    StaticEventBus bus(EventList<Event::SensorEvent, TextEvent>{},
+                       [&sensor_count](const Event::SensorEvent&) { sensor_count++; },
+                       [&text_count](const TextEvent&) { text_count++; },
+                       [&any_count](const auto&) { any_count++; });
+
+    bus.start();
+    bus.publish(makeSensorEvent(0));
+    bus.publish(TextEvent{"hello"});
+    bus.publish(makeSensorEvent(1));
+    bus.stop();
+
+    EXPECT_EQ(sensor_count, 2);
+    EXPECT_EQ(text_count, 1);
+    EXPECT_EQ(any_count, 3);
+}
+
+TEST_F(StaticEventBusTest, PreservesOrderAcrossBatches)
+{
+    std::vector<uint64_t> order;
+    StaticEventBus bus(EventList<Event::SensorEvent>{},
+                       [&order](const Event::SensorEvent& event) { order.push_back(event.getRecord().sequence); });
+
+    bus.publish(makeSensorEvent(0));
+    std::vector<Event::SensorEvent> batch;
+    for (uint64_t i = 1; i < 50; ++i)
+    {
+        batch.push_back(makeSensorEvent(i));
+    }
+    bus.publishBatch(std::move(batch));
+    bus.start();
+    bus.publish(makeSensorEvent(50));
+    bus.stop();
+
+    ASSERT_EQ(order.size(), 51u);
+    for (uint64_t i = 0; i < order.size(); ++i)
+    {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST_F(StaticEventBusTest, HandlerStateIsAccessible)
+{
+    struct Counter
+    {
+        int count = 0;
+        void operator()(const TextEvent&) { count++; }
+    };
+
+    StaticEventBus bus(EventList<TextEvent>{}, Counter{});
+    bus.start();
+    bus.publish(TextEvent{"a"});
+    bus.publish(TextEvent{"b"});
+    bus.stop();
+
+    EXPECT_EQ(bus.handler<0>().count, 2);
+}
+
+TEST_F(StaticEventBusTest, StopIsIdempotentAndRestartable)
+{
+    std::atomic<int> count{0};
+    StaticEventBus bus(EventList<TextEvent>{}, [&count](const TextEvent&) { count++; });
+
+    bus.stop();
+    bus.start();
+    bus.start();
+    bus.publish(TextEvent{"x"});
+    bus.stop();
+    bus.stop();
+    bus.start();
+    bus.publish(TextEvent{"y"});
+    bus.stop();
+
+    EXPECT_EQ(count.load(), 2);
+}
+
+TEST_F(StaticEventBusTest, DestructorDrainsQueue)
+{
+    int count = 0;
+    {
+        StaticEventBus bus(EventList<TextEvent>{}, [&count](const TextEvent&) { count++; });
+        bus.start();
+        for (int i = 0; i < 10; ++i)
+        {
+            bus.publish(TextEvent{"x"});
+        }
+    }
+    EXPECT_EQ(count, 10);
+}
+
+TEST_F(StaticEventBusTest, ConcurrentPublishers)
+{
+    std::atomic<int> count{0};
+    StaticEventBus bus(EventList<Event::SensorEvent>{},
+                       [&count](const Event::SensorEvent&) { count++; });
+    bus.start();
+
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < 4; ++t)
+    {
+        publishers.emplace_back([&bus]() {
+            for (int i = 0; i < 1000; ++i)
+            {
+                bus.publish(makeSensorEvent(i));
+            }
+        });
+    }
+    for (auto& publisher : publishers)
+    {
+        publisher.join();
+    }
+    bus.stop();
+
+    EXPECT_EQ(count.load(), 4000);
+}
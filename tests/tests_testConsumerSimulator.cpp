@@ -183,7 +183,7 @@ TEST_F(TestConsumerSimulatorTest, HandlesBaseEventType)
     
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     
-    // Should not crash - dynamic_cast will return nullptr for non-SensorEvent
+    // Should not crash - event_cast will return nullptr for non-SensorEvent
     SUCCEED();
 }
 
@@ -0,0 +1,129 @@
+/**
+ * @file tests_timestampFormatter.cpp
+ * @brief Unit tests for the cached ISO-8601 TimestampFormatter
+ * 
+ * Test suite covering:
+ * - UTC output at every precision
+ * - Local output agreeing with localtime_r/strftime, including the offset
+ * - Minute-cache reuse and rollover across minute, day and year boundaries
+ * - Pre-epoch timestamps
+ * - Buffer size handling
+ * - SensorEvent::formatTimestamp()
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include "Util/TimestampFormatter.h"
+#include "Event/SensorEvent.h"
+
+/**
+ * @class TimestampFormatterTest
+ * @brief Test fixture for TimestampFormatter tests
+ */
+class TimestampFormatterTest : public ::testing::Test
+{
+protected:
+    static constexpr int64_t kNewYear2026Ns = 1767225600LL * 1000000000LL; ///< 2026-01-01T00:00:00Z
+
+    /** @brief Formats with the given formatter and returns the result as a string */
+    static std::string formatToString(Util::TimestampFormatter& formatter, int64_t wall_ns)
+    {
+        char buffer[Util::TimestampFormatter::kBufferSize];
+        const std::size_t length = formatter.format(wall_ns, buffer, sizeof(buffer));
+        EXPECT_EQ(length, std::strlen(buffer));
+        return std::string(buffer, length);
+    }
+};
+
+TEST_F(TimestampFormatterTest, UtcPrecisions)
+{
+    const int64_t ts = kNewYear2026Ns + 45LL * 1000000000LL + 123456789;
+
+    Util::TimestampFormatter seconds(Util::TimestampPrecision::Seconds, Util::TimestampZone::Utc);
+    Util::TimestampFormatter millis(Util::TimestampPrecision::Millis, Util::TimestampZone::Utc);
+    Util::TimestampFormatter micros(Util::TimestampPrecision::Micros, Util::TimestampZone::Utc);
+    Util::TimestampFormatter nanos(Util::TimestampPrecision::Nanos, Util::TimestampZone::Utc);
+
+    EXPECT_EQ(formatToString(seconds, ts), "2026-01-01T00:00:45Z");
+    EXPECT_EQ(formatToString(millis, ts), "2026-01-01T00:00:45.123Z");
+    EXPECT_EQ(formatToString(micros, ts), "2026-01-01T00:00:45.123456Z");
+    EXPECT_EQ(formatToString(nanos, ts), "2026-01-01T00:00:45.123456789Z");
+}
+
+TEST_F(TimestampFormatterTest, RollsOverMinuteDayAndYear)
+{
+    Util::TimestampFormatter formatter(Util::TimestampPrecision::Millis, Util::TimestampZone::Utc);
+
+    EXPECT_EQ(formatToString(formatter, kNewYear2026Ns - 1000000), "2025-12-31T23:59:59.999Z");
+    EXPECT_EQ(formatToString(formatter, kNewYear2026Ns), "2026-01-01T00:00:00.000Z");
+    EXPECT_EQ(formatToString(formatter, kNewYear2026Ns + 59LL * 1000000000LL), "2026-01-01T00:00:59.000Z");
+    EXPECT_EQ(formatToString(formatter, kNewYear2026Ns + 60LL * 1000000000LL), "2026-01-01T00:01:00.000Z");
+    // Going back to an earlier minute refreshes the cache again
+    EXPECT_EQ(formatToString(formatter, kNewYear2026Ns + 1000000000LL), "2026-01-01T00:00:01.000Z");
+}
+
+TEST_F(TimestampFormatterTest, PreEpochTimestamps)
+{
+    Util::TimestampFormatter formatter(Util::TimestampPrecision::Nanos, Util::TimestampZone::Utc);
+
+    EXPECT_EQ(formatToString(formatter, -1), "1969-12-31T23:59:59.999999999Z");
+    EXPECT_EQ(formatToString(formatter, 0), "1970-01-01T00:00:00.000000000Z");
+}
+
+TEST_F(TimestampFormatterTest, LocalMatchesStrftime)
+{
+    Util::TimestampFormatter formatter(Util::TimestampPrecision::Seconds, Util::TimestampZone::Local);
+
+    for (int64_t offset_s : {0LL, 3599LL, 86400LL * 180 + 7, -86400LL * 90})
+    {
+        const int64_t seconds = 1767225600LL + offset_s;
+        const std::time_t time = static_cast<std::time_t>(seconds);
+        std::tm tm_buf{};
+        localtime_r(&time, &tm_buf);
+        char expected[32];
+        std::strftime(expected, sizeof(expected), "%Y-%m-%dT%H:%M:%S", &tm_buf);
+        char zone[8];
+        std::strftime(zone, sizeof(zone), "%z", &tm_buf);
+        const std::string expected_zone = std::string(zone, 3) + ":" + std::string(zone + 3);
+
+        const std::string formatted = formatToString(formatter, seconds * 1000000000LL);
+        EXPECT_EQ(formatted, std::string(expected) + expected_zone);
+    }
+}
+
+TEST_F(TimestampFormatterTest, RejectsSmallBuffer)
+{
+    Util::TimestampFormatter formatter(Util::TimestampPrecision::Millis, Util::TimestampZone::Utc);
+    char buffer[24];
+    std::memset(buffer, 'x', sizeof(buffer));
+
+    // "2026-01-01T00:00:00.000Z" needs 24 characters plus the NUL
+    EXPECT_EQ(formatter.format(kNewYear2026Ns, buffer, sizeof(buffer)), 0u);
+    EXPECT_EQ(buffer[0], 'x');
+    EXPECT_EQ(formatter.format(kNewYear2026Ns, nullptr, 64), 0u);
+}
+
+TEST_F(TimestampFormatterTest, FitsInBufferSize)
+{
+    Util::TimestampFormatter formatter(Util::TimestampPrecision::Nanos, Util::TimestampZone::Local);
+    char buffer[Util::TimestampFormatter::kBufferSize];
+
+    EXPECT_GT(formatter.format(kNewYear2026Ns, buffer, sizeof(buffer)), 0u);
+}
+
+TEST_F(TimestampFormatterTest, SensorEventFormatsWallTime)
+{
+    Event::SensorRecord record{};
+    record.timestamp_ns = Util::Clock::fromWallNs(kNewYear2026Ns + 250000000);
+    record.type = Event::SensorType::CoSensor;
+    Event::SensorEvent event(record);
+
+    char buffer[Util::TimestampFormatter::kBufferSize];
+    ASSERT_GT(event.formatTimestamp(buffer, sizeof(buffer)), 0u);
+
+    Util::TimestampFormatter formatter(Util::TimestampPrecision::Millis, Util::TimestampZone::Local);
+    EXPECT_EQ(std::string(buffer), formatToString(formatter, kNewYear2026Ns + 250000000));
+    EXPECT_EQ(std::string(buffer).substr(0, 19), event.getTimestampString("%Y-%m-%dT%H:%M:%S"));
+}
@@ -0,0 +1,208 @@
+/**
+ * @file tests_wireFormat.cpp
+ * @brief Unit tests for Event::WireFormat
+ *
+ * Test suite covering:
+ * - Encoding a reading and reading every field back in place, at any alignment
+ * - The schema matching the layout, and its text description
+ * - Rejection of truncated, mistyped and inconsistent events
+ * - Reading events of a newer version with appended fixed fields
+ * - Events without a device name, and over-long names
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Event/WireFormat.h"
+#include "Event/SensorEvent.h"
+#include "Util/Clock.h"
+
+/**
+ * @class WireFormatTest
+ * @brief Test fixture providing a sample reading
+ */
+class WireFormatTest : public ::testing::Test
+{
+protected:
+    /**
+     * @brief Builds a fault reading of device "PressureSensor_7"
+     */
+    static Event::SensorRecord makeRecord()
+    {
+        Event::SensorRecord record{};
+        record.timestamp_ns = Util::Clock::nowNs();
+        record.value = 1021.25;
+        record.sequence = 123456789;
+        record.device_id = Event::internDeviceId(Event::SensorType::PressureSensor, 7);
+        record.type = Event::SensorType::PressureSensor;
+        record.flags = Event::SensorRecord::kFaultFlag;
+        return record;
+    }
+
+    /**
+     * @brief Encodes a reading into a buffer at a given misalignment
+     * @param record Reading to encode
+     * @param name Device name to embed
+     * @param shift Bytes before the event in the buffer
+     * @return Buffer holding shift bytes of 0xAA and then the event
+     */
+    static std::vector<uint8_t> encode(const Event::SensorRecord& record, std::string_view name, std::size_t shift)
+    {
+        std::vector<uint8_t> buffer(shift + Event::WireFormat::sensorEventSize(name.size()), 0xAA);
+        EXPECT_EQ(Event::WireFormat::encodeSensorEvent(record, name, buffer.data() + shift), buffer.size() - shift);
+        return buffer;
+    }
+};
+
+TEST_F(WireFormatTest, ReadsFieldsInPlaceAtAnyAlignment)
+{
+    const Event::SensorRecord record = makeRecord();
+    const std::string_view name = Event::deviceName(record.device_id);
+    for (std::size_t shift = 0; shift < 8; ++shift) {
+        const std::vector<uint8_t> buffer = encode(record, name, shift);
+        Event::WireFormat::SensorEventView view;
+        ASSERT_EQ(Event::WireFormat::SensorEventView::parse(buffer.data() + shift, buffer.size() - shift, view),
+                  Event::Status::OK);
+        EXPECT_EQ(view.encodedSize(), buffer.size() - shift);
+        EXPECT_EQ(view.encodedSize() % Event::WireFormat::kAlignment, 0u);
+        EXPECT_EQ(view.version(), Event::WireFormat::kSensorVersion);
+        EXPECT_EQ(view.wallTimestampNs(), Util::Clock::toWallNs(record.timestamp_ns));
+        EXPECT_EQ(view.timestampNs(), record.timestamp_ns);
+        EXPECT_DOUBLE_EQ(view.value(), record.value);
+        EXPECT_EQ(view.sequence(), record.sequence);
+        EXPECT_EQ(view.deviceId(), record.device_id);
+        EXPECT_EQ(view.sensorType(), record.type);
+        EXPECT_EQ(view.flags(), record.flags);
+
+        // The name is a view into the buffer, not a copy
+        EXPECT_EQ(view.deviceName(), name);
+        EXPECT_EQ(reinterpret_cast<const uint8_t*>(view.deviceName().data()),
+                  buffer.data() + shift + sizeof(Event::WireFormat::SensorEventLayout));
+        for (std::size_t i = shift + sizeof(Event::WireFormat::SensorEventLayout) + name.size(); i < buffer.size(); ++i) {
+            EXPECT_EQ(buffer[i], 0) << "padding byte " << i;
+        }
+
+        const Event::SensorRecord decoded = view.toRecord();
+        EXPECT_EQ(std::memcmp(&decoded, &record, sizeof(record)), 0);
+    }
+}
+
+TEST_F(WireFormatTest, SchemaMatchesLayout)
+{
+    const Event::WireFormat::Schema& schema = Event::WireFormat::sensorSchema();
+    EXPECT_STREQ(schema.name, "SensorEvent");
+    EXPECT_EQ(schema.type, Event::EventType::Sensor);
+    EXPECT_EQ(schema.version, Event::WireFormat::kSensorVersion);
+    EXPECT_EQ(schema.fixed_size, sizeof(Event::WireFormat::SensorEventLayout));
+
+    // Fixed fields tile the fixed part without gaps or overlaps
+    std::size_t end = 0;
+    for (std::size_t i = 0; i < schema.field_count; ++i) {
+        const Event::WireFormat::FieldDescriptor& field = schema.fields[i];
+        if (field.kind == Event::WireFormat::FieldKind::Bytes) {
+            continue;
+        }
+        EXPECT_EQ(field.offset, end) << field.name;
+        end = field.offset + field.size;
+    }
+    EXPECT_EQ(end, schema.fixed_size);
+
+    // A generic reader can find a field by name through the schema
+    const Event::SensorRecord record = makeRecord();
+    const std::vector<uint8_t> buffer = encode(record, "x", 0);
+    for (std::size_t i = 0; i < schema.field_count; ++i) {
+        if (std::string(schema.fields[i].name) == "value") {
+            double value = 0;
+            std::memcpy(&value, buffer.data() + schema.fields[i].offset, sizeof(value));
+            EXPECT_DOUBLE_EQ(value, record.value);
+        }
+    }
+
+    const std::string text = Event::WireFormat::describe(schema);
+    EXPECT_EQ(text.rfind("SensorEvent v1, 40 fixed bytes\n", 0), 0u);
+    EXPECT_NE(text.find("  16 value f64 since v1\n"), std::string::npos);
+    EXPECT_NE(text.find("name bytes"), std::string::npos);
+}
+
+TEST_F(WireFormatTest, RejectsMalformedEvents)
+{
+    const std::vector<uint8_t> valid = encode(makeRecord(), "PressureSensor_7", 0);
+    Event::WireFormat::SensorEventView view;
+    const auto parse = [&view](std::vector<uint8_t> bytes, std::size_t size) {
+        return Event::WireFormat::SensorEventView::parse(bytes.data(), size, view);
+    };
+    const auto patched = [&valid](std::size_t offset, const void* value, std::size_t size) {
+        std::vector<uint8_t> bytes = valid;
+        std::memcpy(bytes.data() + offset, value, size);
+        return bytes;
+    };
+
+    EXPECT_EQ(parse(valid, valid.size()), Event::Status::OK);
+    EXPECT_EQ(parse(valid, valid.size() - 1), Event::Status::ERROR);
+    EXPECT_EQ(parse(valid, 8), Event::Status::ERROR);
+    EXPECT_EQ(parse(valid, 0), Event::Status::ERROR);
+
+    const auto unknown_type = Event::EventType::Unknown;
+    EXPECT_EQ(parse(patched(offsetof(Event::WireFormat::EventHeader, type), &unknown_type, 2), valid.size()),
+              Event::Status::ERROR);
+    const uint16_t version_zero = 0;
+    EXPECT_EQ(parse(patched(offsetof(Event::WireFormat::EventHeader, version), &version_zero, 2), valid.size()),
+              Event::Status::ERROR);
+    const uint16_t short_fixed = 32;
+    EXPECT_EQ(parse(patched(offsetof(Event::WireFormat::EventHeader, fixed_size), &short_fixed, 2), valid.size()),
+              Event::Status::ERROR);
+    const uint16_t long_name = 17;
+    EXPECT_EQ(parse(patched(offsetof(Event::WireFormat::SensorEventLayout, name_size), &long_name, 2), valid.size()),
+              Event::Status::ERROR);
+    const uint16_t oversized = 4000;
+    EXPECT_EQ(parse(patched(offsetof(Event::WireFormat::EventHeader, size), &oversized, 2), valid.size()),
+              Event::Status::ERROR);
+    const uint8_t bad_sensor = 200;
+    EXPECT_EQ(parse(patched(offsetof(Event::WireFormat::SensorEventLayout, sensor_type), &bad_sensor, 1), valid.size()),
+              Event::Status::ERROR);
+}
+
+TEST_F(WireFormatTest, ReadsNewerVersionWithAppendedFields)
+{
+    // A future version appends 8 bytes to the fixed part; the name moves behind them
+    const Event::SensorRecord record = makeRecord();
+    const std::string name = "PressureSensor_7";
+    Event::WireFormat::SensorEventLayout layout{};
+    Event::WireFormat::encodeSensorEvent(record, {}, &layout);
+    layout.header.version = 2;
+    layout.header.fixed_size = sizeof(layout) + 8;
+    layout.header.size = static_cast<uint16_t>(layout.header.fixed_size + name.size());
+    layout.name_size = static_cast<uint16_t>(name.size());
+
+    std::vector<uint8_t> buffer(Event::WireFormat::alignEvent(layout.header.size), 0);
+    std::memcpy(buffer.data(), &layout, sizeof(layout));
+    std::memset(buffer.data() + sizeof(layout), 0x5A, 8);
+    std::memcpy(buffer.data() + layout.header.fixed_size, name.data(), name.size());
+
+    Event::WireFormat::SensorEventView view;
+    ASSERT_EQ(Event::WireFormat::SensorEventView::parse(buffer.data(), buffer.size(), view), Event::Status::OK);
+    EXPECT_EQ(view.version(), 2);
+    EXPECT_EQ(view.encodedSize(), buffer.size());
+    EXPECT_EQ(view.deviceName(), name);
+    EXPECT_DOUBLE_EQ(view.value(), record.value);
+    EXPECT_EQ(view.toRecord().device_id, record.device_id);
+}
+
+TEST_F(WireFormatTest, HandlesMissingAndOverlongNames)
+{
+    const Event::SensorRecord record = makeRecord();
+    const std::vector<uint8_t> nameless = encode(record, {}, 0);
+    EXPECT_EQ(nameless.size(), sizeof(Event::WireFormat::SensorEventLayout));
+    Event::WireFormat::SensorEventView view;
+    ASSERT_EQ(Event::WireFormat::SensorEventView::parse(nameless.data(), nameless.size(), view), Event::Status::OK);
+    EXPECT_TRUE(view.deviceName().empty());
+    EXPECT_EQ(view.toRecord().device_id, record.device_id);
+    EXPECT_EQ(view.toRecord(42).device_id, 42u);
+
+    const std::string name(Event::WireFormat::kMaxNameSize + 100, 'n');
+    std::vector<uint8_t> buffer(Event::WireFormat::sensorEventSize(Event::WireFormat::kMaxNameSize));
+    EXPECT_EQ(Event::WireFormat::encodeSensorEvent(record, name, buffer.data()), buffer.size());
+    ASSERT_EQ(Event::WireFormat::SensorEventView::parse(buffer.data(), buffer.size(), view), Event::Status::OK);
+    EXPECT_EQ(view.deviceName().size(), Event::WireFormat::kMaxNameSize);
+}